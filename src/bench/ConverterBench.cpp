@@ -0,0 +1,67 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common/signalk/SKNMEAConverter.h"
+#include "common/signalk/SKNMEA2000Converter.h"
+#include "LegacyConverters.h"
+#include "KBoxBenchCorpus.h"
+#include "KBoxBench.h"
+
+/*
+ * Compares the converters (dispatch table) with the previous implementation
+ * (probing every supported path). Every operation is one update of the corpus.
+ */
+
+template <class Converter, class Output>
+static void convertAll(Converter &converter, Output &output, const std::vector<KBoxBenchUpdate> &updates) {
+  for (const KBoxBenchUpdate &update : updates) {
+    converter.convert(update, output);
+  }
+  benchSink += output.count;
+}
+
+void benchConverters(KBoxBench &bench, const KBoxBenchCorpus &corpus) {
+  const std::vector<KBoxBenchUpdate> &updates = corpus.updates;
+  SKNMEAConverterConfig config;
+
+  LegacyNMEAConverter legacyNMEA(config);
+  SKNMEAConverter nmea(config);
+  LegacyNMEA2000Converter legacyN2k;
+  SKNMEA2000Converter n2k;
+  NullNMEAOutput nmeaOutput;
+  NullNMEA2000Output n2kOutput;
+
+  bench.run("SKNMEAConverter.convert (probing)", updates.size(), [&]() {
+    convertAll(legacyNMEA, nmeaOutput, updates);
+  });
+  bench.run("SKNMEAConverter.convert", updates.size(), [&]() {
+    convertAll(nmea, nmeaOutput, updates);
+  });
+  bench.run("SKNMEA2000Converter.convert (probing)", updates.size(), [&]() {
+    convertAll(legacyN2k, n2kOutput, updates);
+  });
+  bench.run("SKNMEA2000Converter.convert", updates.size(), [&]() {
+    convertAll(n2k, n2kOutput, updates);
+  });
+}
@@ -0,0 +1,44 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common/signalk/SKJSONWriter.h"
+#include "KBoxBenchCorpus.h"
+#include "KBoxBench.h"
+
+/*
+ * Serialization of the updates to SignalK JSON deltas, as done for every
+ * update sent to the WiFi module and written to the SD card log.
+ */
+void benchJSON(KBoxBench &bench, const KBoxBenchCorpus &corpus) {
+  const std::vector<KBoxBenchUpdate> &updates = corpus.updates;
+
+  SKJSONWriter writer("urn:mrn:signalk:uuid:c0d79334-4e25-4245-8892-54e8ccc8021d");
+
+  bench.run("SKJSONWriter.write", updates.size(), [&]() {
+    char json[1024];
+    for (const KBoxBenchUpdate &update : updates) {
+      benchSink += writer.write(update, json, sizeof(json));
+    }
+  });
+}
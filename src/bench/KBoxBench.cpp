@@ -0,0 +1,52 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common/version/KBoxVersion.h"
+#include "KBoxBenchCorpus.h"
+#include "KBoxBench.h"
+
+volatile uint32_t benchSink = 0;
+
+void KBoxBench::printText(FILE *out) const {
+  fprintf(out, "%-48s %12s %14s %10s\n", "benchmark", "ns/op", "ops/s", "allocs/op");
+  for (const Result &r : _results) {
+    fprintf(out, "%-48s %12.1f %14.0f %10.2f\n", r.name.c_str(), r.nsPerOp, 1e9 / r.nsPerOp, r.allocationsPerOp);
+  }
+}
+
+void KBoxBench::printJSON(FILE *out, const KBoxBenchCorpus &corpus) const {
+  fprintf(out, "{\n");
+  fprintf(out, "  \"version\": \"%s\",\n", KBOX_VERSION);
+  fprintf(out, "  \"corpus\": { \"nmeaSentences\": %zu, \"nmea2000Messages\": %zu, \"updates\": %zu },\n",
+          corpus.nmeaSentences.size(), corpus.nmea2000Messages.size(), corpus.updates.size());
+  fprintf(out, "  \"benchmarks\": [\n");
+  for (size_t i = 0; i < _results.size(); i++) {
+    const Result &r = _results[i];
+    fprintf(out, "    { \"name\": \"%s\", \"ops\": %llu, \"nsPerOp\": %.2f, \"opsPerSecond\": %.0f, \"allocationsPerOp\": %.3f }%s\n",
+            r.name.c_str(), (unsigned long long)r.ops, r.nsPerOp, 1e9 / r.nsPerOp, r.allocationsPerOp,
+            i + 1 < _results.size() ? "," : "");
+  }
+  fprintf(out, "  ]\n");
+  fprintf(out, "}\n");
+}
@@ -0,0 +1,164 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "common/signalk/SKNMEAOutput.h"
+#include "common/signalk/SKNMEA2000Output.h"
+#include "test/KBoxTestAllocations.h"
+
+class KBoxBenchCorpus;
+
+/**
+ * Runs microbenchmarks and collects their results.
+ *
+ * A benchmark is a function performing a known number of operations. It is
+ * called once to warm up, once to count the heap allocations and then
+ * repeatedly until a sample lasts at least the minimum sample time. The
+ * fastest of a few samples is kept because it is the most repeatable number
+ * on a busy machine.
+ */
+class KBoxBench {
+  public:
+    struct Result {
+      std::string name;
+      uint64_t ops;
+      double nsPerOp;
+      double allocationsPerOp;
+    };
+
+  private:
+    static const int Samples = 5;
+
+    std::vector<Result> _results;
+    std::string _filter;
+    double _minimumSampleNs;
+
+  public:
+    KBoxBench(const std::string &filter, int minimumSampleMs) :
+      _filter(filter), _minimumSampleNs(minimumSampleMs * 1e6) {};
+
+    /**
+     * Returns true if this benchmark was not excluded by the filter.
+     */
+    bool shouldRun(const std::string &name) const {
+      return _filter.empty() || name.find(_filter) != std::string::npos;
+    };
+
+    /**
+     * Measure fn which performs opsPerCall operations every time it is
+     * called.
+     */
+    template <typename F> void run(const std::string &name, uint64_t opsPerCall, F fn) {
+      if (!shouldRun(name) || opsPerCall == 0) {
+        return;
+      }
+
+      fn();
+
+      KBoxTestAllocations allocations;
+      fn();
+      unsigned long allocationsPerCall = allocations.total();
+
+      uint64_t calls = 1;
+      uint64_t ops = 0;
+      double bestNsPerOp = 0;
+      for (int sample = 0; sample < Samples; sample++) {
+        double ns;
+        while (true) {
+          auto start = std::chrono::steady_clock::now();
+          for (uint64_t i = 0; i < calls; i++) {
+            fn();
+          }
+          auto end = std::chrono::steady_clock::now();
+          ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+          if (ns >= _minimumSampleNs) {
+            break;
+          }
+          calls *= 2;
+        }
+        ops += calls * opsPerCall;
+
+        double nsPerOp = ns / (calls * opsPerCall);
+        if (sample == 0 || nsPerOp < bestNsPerOp) {
+          bestNsPerOp = nsPerOp;
+        }
+      }
+
+      _results.push_back(Result { name, ops, bestNsPerOp, (double)allocationsPerCall / opsPerCall });
+    };
+
+    const std::vector<Result>& getResults() const {
+      return _results;
+    };
+
+    void printText(FILE *out) const;
+    void printJSON(FILE *out, const KBoxBenchCorpus &corpus) const;
+};
+
+/**
+ * Keeps the compiler from optimizing away the computation of an unused
+ * result.
+ */
+extern volatile uint32_t benchSink;
+
+/*
+ * Benchmarks. Each function registers its measures with bench.run().
+ */
+void benchNMEAParsing(KBoxBench &bench, const KBoxBenchCorpus &corpus);
+void benchNMEA2000Parsing(KBoxBench &bench, const KBoxBenchCorpus &corpus);
+void benchConverters(KBoxBench &bench, const KBoxBenchCorpus &corpus);
+void benchJSON(KBoxBench &bench, const KBoxBenchCorpus &corpus);
+void benchSlipStream(KBoxBench &bench, const KBoxBenchCorpus &corpus);
+void benchSKHubPublish(KBoxBench &bench, const KBoxBenchCorpus &corpus);
+void benchLogging(KBoxBench &bench, const KBoxBenchCorpus &corpus);
+
+/*
+ * Outputs that discard the messages.
+ */
+class NullNMEAOutput : public SKNMEAOutput {
+  public:
+    int count = 0;
+
+    bool write(const NMEAFixedSentence& sentence) override {
+      count++;
+      return true;
+    };
+};
+
+class NullNMEA2000Output : public SKNMEA2000Output {
+  public:
+    int count = 0;
+
+    bool write(const tN2kMsg& msg) override {
+      count++;
+      return true;
+    };
+};
@@ -0,0 +1,136 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <fstream>
+#include <stdio.h>
+#include <Seasmart.h>
+#include "common/signalk/SKNMEA2000Converter.h"
+#include "common/signalk/SKNMEA2000Output.h"
+#include "KBoxBenchCorpus.h"
+
+/*
+ * Reads the sentences in a log. Lines may be prefixed by a timestamp
+ * ("108254:$GPGGA,...") and sentences cut by the logger are kept: the parsers
+ * see them in real life too.
+ */
+static bool readSentences(const std::string &filename, std::vector<std::string> &sentences) {
+  std::ifstream log(filename);
+  if (!log) {
+    fprintf(stderr, "%s: not found (run from the root of the repository)\n", filename.c_str());
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(log, line)) {
+    size_t start = line.find_first_of("$!");
+    if (start != std::string::npos) {
+      sentences.push_back(line.substr(start));
+    }
+  }
+  return true;
+}
+
+static void addSensorUpdates(std::vector<KBoxBenchUpdate> &updates) {
+  KBoxBenchUpdate imu;
+  imu.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxIMU));
+  imu.setNavigationHeadingMagnetic(1.2);
+  imu.setNavigationAttitude(SKTypeAttitude(0.1, 0.05, 0));
+
+  KBoxBenchUpdate baro;
+  baro.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxBarometer));
+  baro.setEnvironmentOutsidePressure(101325);
+
+  KBoxBenchUpdate adc;
+  adc.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxADC));
+  adc.setElectricalBatteriesVoltage("engine", 12.6);
+  adc.setElectricalBatteriesVoltage("house", 12.4);
+  adc.setElectricalBatteriesVoltage("dc3", 0);
+  adc.setElectricalBatteriesVoltage("kbox-supply", 12.5);
+
+  KBoxBenchUpdate wind;
+  wind.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_2, "WI", "MWV"));
+  wind.setEnvironmentWindAngleApparent(0.7);
+  wind.setEnvironmentWindSpeedApparent(6.2);
+
+  KBoxBenchUpdate depth;
+  depth.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_2, "SD", "DPT"));
+  depth.setEnvironmentDepthBelowTransducer(4.2);
+  depth.setEnvironmentDepthTransducerToKeel(0.3);
+
+  // IMU is sampled at 20Hz, the other sensors at 1Hz.
+  for (int i = 0; i < 20; i++) {
+    updates.push_back(imu);
+  }
+  updates.push_back(baro);
+  updates.push_back(adc);
+  updates.push_back(wind);
+  updates.push_back(depth);
+}
+
+class CorpusNMEA2000Output : public SKNMEA2000Output {
+  public:
+    std::vector<tN2kMsg> &messages;
+
+    CorpusNMEA2000Output(std::vector<tN2kMsg> &m) : messages(m) {};
+
+    bool write(const tN2kMsg& msg) override {
+      messages.push_back(msg);
+      return true;
+    };
+};
+
+bool KBoxBenchCorpus::load(const std::string &directory) {
+  std::vector<std::string> lines;
+  bool found = readSentences(directory + "/nmea-sample.log", lines);
+
+  SKNMEAParser parser;
+  for (const std::string &line : lines) {
+    String sentence(line.c_str());
+    nmeaSentences.push_back(sentence);
+
+    KBoxBenchUpdate update;
+    if (parser.parse(SKSourceInputNMEA0183_1, sentence, SKTime(0), update) && update.getSize() > 0) {
+      updates.push_back(update);
+    }
+  }
+  addSensorUpdates(updates);
+
+  std::vector<std::string> pcdin;
+  readSentences(directory + "/pcdin-sample.log", pcdin);
+  for (const std::string &line : pcdin) {
+    tN2kMsg msg;
+    uint32_t timestamp;
+    if (SeasmartToN2k(line.c_str(), timestamp, msg)) {
+      nmea2000Messages.push_back(msg);
+    }
+  }
+
+  SKNMEA2000Converter converter;
+  CorpusNMEA2000Output output(nmea2000Messages);
+  for (const KBoxBenchUpdate &update : updates) {
+    converter.convert(update, output);
+  }
+
+  return found;
+}
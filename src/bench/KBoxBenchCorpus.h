@@ -0,0 +1,57 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <N2kMsg.h>
+#include <WString.h>
+#include "common/signalk/SKNMEAParser.h"
+#include "common/signalk/SKUpdateStatic.h"
+
+typedef SKUpdateStatic<SKNMEAParser::MaxValuesPerUpdate> KBoxBenchUpdate;
+
+/**
+ * Inputs shared by all the benchmarks.
+ *
+ * - NMEA sentences from the recorded log in tools/nmea-tester/nmea-sample.log
+ * - NMEA2000 messages from the PCDIN sentences in
+ *   tools/nmea-tester/pcdin-sample.log and the messages generated by
+ *   SKNMEA2000Converter from the updates below
+ * - the updates parsed from the NMEA sentences plus one second of the
+ *   updates generated by the KBox sensors
+ */
+class KBoxBenchCorpus {
+  public:
+    std::vector<String> nmeaSentences;
+    std::vector<tN2kMsg> nmea2000Messages;
+    std::vector<KBoxBenchUpdate> updates;
+
+    /**
+     * Load the corpus from the given directory. Problems are reported on
+     * stderr. Returns false if the NMEA log could not be read.
+     */
+    bool load(const std::string &directory);
+};
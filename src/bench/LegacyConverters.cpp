@@ -0,0 +1,276 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <N2kMsg.h>
+#include <N2kMessages.h>
+#include "common/nmea/NMEASentenceBuilder.h"
+#include "common/signalk/SKUnits.h"
+#include "common/signalk/SKValue.h"
+#include "LegacyConverters.h"
+
+void LegacyNMEAConverter::convert(const SKUpdate& update, SKNMEAOutput& output) {
+  _currentOutput = &output;
+
+  if (_config.dbt && update.hasEnvironmentDepthBelowTransducer()) {
+    NMEASentenceBuilder sb("II", "DBT", 7);
+    sb.setField(1, SKMeterToFeet(update.getEnvironmentDepthBelowTransducer()), 2);
+    sb.setField(2, "f");
+    sb.setField(3, update.getEnvironmentDepthBelowTransducer(), 2);
+    sb.setField(4, "M");
+    sb.setField(5, SKMeterToFathom(update.getEnvironmentDepthBelowTransducer()), 2);
+    sb.setField(6, "F");
+    output.write(sb.toSentence());
+  }
+
+  if (_config.dpt && update.hasEnvironmentDepthBelowTransducer()) {
+    NMEASentenceBuilder sb("II", "DPT", 2);
+    sb.setField(1, update.getEnvironmentDepthBelowTransducer(), 1);
+    if (update.hasEnvironmentDepthSurfaceToTransducer()) {
+      sb.setField(2, update.getEnvironmentDepthSurfaceToTransducer(), 1);
+    }
+    else if (update.hasEnvironmentDepthTransducerToKeel()) {
+      sb.setField(2, -update.getEnvironmentDepthTransducerToKeel(), 1);
+    }
+    output.write(sb.toSentence());
+  }
+
+  if (_config.hdm && update.hasNavigationHeadingMagnetic()) {
+    NMEASentenceBuilder sb("II", "HDM", 2);
+    sb.setField(1, SKRadToDeg(update.getNavigationHeadingMagnetic()), 1);
+    sb.setField(2, "M");
+    output.write(sb.toSentence());
+  }
+
+  if (_config.mwv && update.hasEnvironmentWindAngleApparent()
+      && update.hasEnvironmentWindSpeedApparent()) {
+    generateMWV(output, update.getEnvironmentWindAngleApparent(), update.getEnvironmentWindSpeedApparent(), true);
+  }
+
+  if (_config.mwv && update.hasEnvironmentWindAngleTrueWater()
+      && update.hasEnvironmentWindSpeedTrue()) {
+    generateMWV(output, update.getEnvironmentWindAngleTrueWater(), update.getEnvironmentWindSpeedTrue(), false);
+  }
+
+  //  ***********************************************
+  //    RSA Rudder Sensor Angle
+  //    Talker-ID: AG - Autopilot general
+  //    also seen: ERRSA
+  //    Expedition: IIXDR
+  //
+  //            1  2  3  4
+  //            |  |  |  |
+  //    $--RSA,x.x,A,x.x,A*hh
+  //      1) Starboard (or single) rudder sensor, "-" means Turn To Port
+  //      2) Status, A means data is valid
+  //      3) Port rudder sensor
+  //      4) Status, A means data is valid
+  // *********************************************** */
+  if (_config.rsa && update.hasSteeringRudderAngle()) {
+    NMEASentenceBuilder sb("II", "RSA", 4);
+    sb.setField(1, SKRadToDeg(SKNormalizeAngle(update.getSteeringRudderAngle())),1 );
+    sb.setField(2, "A");
+    sb.setField(3, "");
+    sb.setField(4, "");
+    output.write(sb.toSentence());
+  }
+
+  if (_config.xdrAttitude && update.hasNavigationAttitude()) {
+    NMEASentenceBuilder sb( "II", "XDR", 8);
+    sb.setField(1, "A");
+    if (update.getNavigationAttitude().pitch == SKDoubleNAN) {
+      sb.setField(2, "");
+    } else {
+      sb.setField(2, SKRadToDeg(update.getNavigationAttitude().pitch), 1);
+    }
+    sb.setField(3, "D");
+    sb.setField(4, "PTCH");
+    sb.setField(5, "A");
+    if (update.getNavigationAttitude().roll == SKDoubleNAN) {
+      sb.setField(6, "");
+    } else {
+      sb.setField(6, SKRadToDeg(update.getNavigationAttitude().roll), 1);
+    }
+    sb.setField(7, "D");
+    sb.setField(8, "ROLL");
+    output.write(sb.toSentence());
+  }
+
+  // Trigger a call of visitSKElectricalBatteriesVoltage for every key with that path
+  // (there can be more than one and we do not know how they are called)
+  if (_config.xdrBattery) {
+    update.accept(*this, SKPathElectricalBatteriesVoltage);
+  }
+
+  if (_config.xdrPressure && update.hasEnvironmentOutsidePressure()) {
+    NMEASentenceBuilder sb("II", "XDR", 4);
+    sb.setField(1, "P");
+    sb.setField(2, SKPascalToBar(update.getEnvironmentOutsidePressure()), 5);
+    sb.setField(3, "B");
+    sb.setField(4, "Barometer");
+    output.write(sb.toSentence());
+  }
+
+
+  //  ***********************************************
+  //  New NMEA 0183 sentence Leeway
+  //  https://www.nmea.org/Assets/20170303%20nautical%20leeway%20angle%20measurement%20sentence%20amendment.pdf
+  //         1  2
+  //         |  |
+  //  $--LWY,A,x.x*hh<CR><LF>
+  //      1) Valid or not A/V
+  //      2) leeway in degrees and decimal degrees, positiv slipping to starboard
+  //  ***********************************************
+  //  TODO!
+}
+
+void LegacyNMEAConverter::visitSKElectricalBatteriesVoltage(const SKUpdate& u, const SKPath &p, const SKValue &v) {
+  NMEASentenceBuilder sb("II", "XDR", 4);
+  sb.setField(1, "V");
+  sb.setField(2, v.getNumberValue(), 2);
+  sb.setField(3, "V");
+  sb.setField(4, p.getIndex());
+
+  _currentOutput->write(sb.toSentence());
+}
+
+// ***********************  Wind Speed and Angle  ************************
+//  Talker ID: WI Weather Instruments
+//             VW Velocity Sensor, Mechanical?
+//  also seen: IIVWR
+//
+//
+//  NMEA0183  MWV Wind Speed and Angle  --> recommended
+//              1  2  3  4 5
+//              |  |  |  | |
+//      $--MWV,x.x,a,x.x,a,A*hh
+//  1) Wind Angle, 0 to 360 degrees
+//  2) Reference, R = Relative, T = True
+//  3) Wind Speed
+//  4) Wind Speed Units: K = km/s, M = m/s, N = Knots
+//  5) Status, A = Data Valid
+// ************************************************************************
+void LegacyNMEAConverter::generateMWV(SKNMEAOutput &output, double windAngle, double windSpeed, bool apparent) {
+  NMEASentenceBuilder sb( "II", "MWV", 5);
+  sb.setField(1, SKRadToDeg(SKNormalizeDirection(windAngle)), 1);
+  sb.setField(2, apparent ? "R" : "T");
+  sb.setField(3, windSpeed, 2 );
+  sb.setField(4, "M");
+  sb.setField(5, "A");
+  output.write(sb.toSentence());
+}
+
+void LegacyNMEA2000Converter::convert(const SKUpdate& update, SKNMEA2000Output& out) {
+  // Trigger a call of visitSKElectricalBatteriesVoltage for every key with that path
+  // (there can be more than one and we do not know how they are called)
+  _currentOutput = &out;
+  update.accept(*this, SKPathElectricalBatteriesVoltage);
+
+  if (update.hasEnvironmentOutsidePressure()) {
+    tN2kMsg msg;
+    // PGN 130310 seems to be better supported
+    SetN2kOutsideEnvironmentalParameters(msg, 0, N2kDoubleNA, N2kDoubleNA, update.getEnvironmentOutsidePressure());
+    out.write(msg);
+    // PGN 130314 is more specific and more precise (.1) to pressure but not supported by all displays (ie: Raymarine i70)
+    SetN2kPressure(msg, /* sid */ 0, /* source */ 0, N2kps_Atmospheric, update.getEnvironmentOutsidePressure());
+    out.write(msg);
+  }
+
+  if (update.hasEnvironmentOutsideTemperature()) {
+    tN2kMsg msg;
+    // PGN 130310 seems to be better supported
+    SetN2kOutsideEnvironmentalParameters(msg, 0, N2kDoubleNA, update.getEnvironmentOutsideTemperature(), N2kDoubleNA);
+    out.write(msg);
+  }
+
+  if (update.hasNavigationAttitude()) {
+    tN2kMsg msg;
+    SKTypeAttitude attitude = update.getNavigationAttitude();
+    SetN2kAttitude(msg, 0, attitude.yaw, attitude.pitch, attitude.roll);
+    out.write(msg);
+  }
+
+  // PGN 129026: Fast COG/SOG
+  if (update.hasNavigationSpeedOverGround() && update.hasNavigationCourseOverGroundTrue()) {
+    tN2kMsg msg;
+    SetN2kPGN129026(msg, (uint8_t)0, N2khr_true,
+        update.getNavigationCourseOverGroundTrue(),
+        update.getNavigationSpeedOverGround());
+    out.write(msg);
+  }
+
+  if (update.hasNavigationHeadingMagnetic()) {
+    tN2kMsg msg;
+    SetN2kMagneticHeading(msg, 0, update.getNavigationHeadingMagnetic());
+    out.write(msg);
+  }
+
+  if (update.hasEnvironmentWindAngleApparent() && update.hasEnvironmentWindSpeedApparent()) {
+    generateWind(out, update.getEnvironmentWindAngleApparent(), update.getEnvironmentWindSpeedApparent(), N2kWind_Apparent);
+  }
+
+  if (update.hasEnvironmentWindAngleTrueWater() && update.hasEnvironmentWindSpeedTrue()) {
+    generateWind(out, update.getEnvironmentWindAngleTrueWater(), update.getEnvironmentWindSpeedTrue(), N2kWind_True_water);
+  }
+
+  if (update.hasEnvironmentWindAngleTrueGround() && update.hasEnvironmentWindSpeedOverGround()) {
+    generateWind(out, update.getEnvironmentWindAngleTrueGround(), update.getEnvironmentWindSpeedOverGround(), N2kWind_True_boat);
+  }
+
+  if (update.hasEnvironmentWindDirectionMagnetic() && update.hasEnvironmentWindSpeedOverGround()) {
+    generateWind(out, update.getEnvironmentWindDirectionMagnetic(), update.getEnvironmentWindSpeedOverGround(), N2kWind_Magnetic);
+  }
+
+  if (update.hasEnvironmentWindDirectionTrue() && update.hasEnvironmentWindSpeedOverGround()) {
+    generateWind(out, update.getEnvironmentWindDirectionTrue(), update.getEnvironmentWindSpeedOverGround(), N2kWind_True_North);
+  }
+}
+
+void LegacyNMEA2000Converter::visitSKElectricalBatteriesVoltage(const SKUpdate& u, const SKPath &p, const SKValue &v) {
+  // PGN127508: Battery Status
+  // FIXME: The mapping of Battery instance names to ids should be configurable
+  static const SKIndexId engineIndex = skIndexTable.intern("engine");
+  static const SKIndexId houseIndex = skIndexTable.intern("house");
+
+  unsigned char instance = 255;
+  if (p.getIndexId() == engineIndex) {
+    instance = 0;
+  }
+  else if (p.getIndexId() == houseIndex) {
+    instance = 1;
+  }
+
+  tN2kMsg msg;
+  SetN2kDCBatStatus(msg, instance, v.getNumberValue());
+  _currentOutput->write(msg);
+}
+
+void LegacyNMEA2000Converter::generateWind(SKNMEA2000Output &out, double windAngle, double windSpeed, tN2kWindReference windReference) {
+  tN2kMsg msg;
+
+  // We need to normalize wind to a direction because it is stored as an
+  // unsigned double.
+  SetN2kWindSpeed(msg, 0, windSpeed, SKNormalizeDirection(windAngle), windReference);
+
+  out.write(msg);
+}
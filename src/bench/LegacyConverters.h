@@ -0,0 +1,65 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <N2kMessages.h>
+#include "common/signalk/SKNMEA2000Output.h"
+#include "common/signalk/SKNMEAConverterConfig.h"
+#include "common/signalk/SKNMEAOutput.h"
+#include "common/signalk/SKUpdate.h"
+#include "common/signalk/SKVisitor.generated.h"
+
+/*
+ * Copies of SKNMEAConverter and SKNMEA2000Converter as they were before
+ * they used a SKPathDispatchTable: every supported path is probed for every
+ * update. Only used to compare the two implementations.
+ */
+
+class LegacyNMEAConverter : SKVisitor {
+  private:
+    const SKNMEAConverterConfig &_config;
+    SKNMEAOutput *_currentOutput;
+    void visitSKElectricalBatteriesVoltage(const SKUpdate& u, const SKPath &p, const SKValue &v) override;
+
+    void generateMWV(SKNMEAOutput& out, double windAngle, double windSpeed, bool apparent);
+
+  public:
+    LegacyNMEAConverter(const SKNMEAConverterConfig &config) : _config(config), _currentOutput(nullptr) {};
+
+    void convert(const SKUpdate& update, SKNMEAOutput& output);
+};
+
+class LegacyNMEA2000Converter : private SKVisitor {
+  private:
+    SKNMEA2000Output *_currentOutput = 0;
+
+    void generateWind(SKNMEA2000Output &out, double windAngle, double windSpeed, tN2kWindReference windReference);
+
+  protected:
+    void visitSKElectricalBatteriesVoltage(const SKUpdate& u, const SKPath &p, const SKValue &v) override;
+
+  public:
+    void convert(const SKUpdate& update, SKNMEA2000Output& conversionOutput);
+};
@@ -0,0 +1,127 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <string.h>
+#include <Print.h>
+#include <Seasmart.h>
+#include "common/algo/List.h"
+#include "common/nmea/NMEA2000LogFormat.h"
+#include "common/nmea/NMEAEncodedMessage.h"
+#include "common/signalk/SKTime.h"
+#include "KBoxBenchCorpus.h"
+#include "KBoxBench.h"
+
+/*
+ * Logging of the NMEA2000 messages of the corpus by SDLoggingService: as
+ * $PCDIN lines, or as binary records. Every operation is one message written
+ * to a file that discards the bytes.
+ *
+ * Binary records are received every MessageInterval ms, each followed by a
+ * loop() of the service which writes the sector once it is full or old.
+ */
+static const uint32_t MessageInterval = 10;
+
+/* A file that counts the bytes written, the way SdFile gets them. */
+class NullFile : public Print {
+  public:
+    size_t bytes = 0;
+
+    using Print::write;
+
+    size_t write(uint8_t b) override {
+      bytes++;
+      return 1;
+    };
+
+    size_t write(const uint8_t *buffer, size_t size) override {
+      bytes += size;
+      return size;
+    };
+};
+
+/* What SDLoggingService keeps in memory for a text line. */
+struct LoggedMessage {
+  SKTime timestamp;
+  NMEAEncodedMessage message;
+};
+
+static void logAsText(const std::vector<tN2kMsg> &messages, NullFile &file) {
+  LinkedList<LoggedMessage> received;
+
+  // NMEA2000Service encodes each message, SDLoggingService keeps it...
+  for (const tN2kMsg &msg : messages) {
+    NMEAEncodedMessage pcdin = NMEAEncodedMessage::allocate(NMEAEncodedMessage::NMEA2000, 30 + msg.DataLen * 2);
+    size_t length = N2kToSeasmart(msg, msg.MsgTime, pcdin.getBuffer(), pcdin.capacity() + 1);
+    pcdin.setLength(length);
+    received.add(LoggedMessage { SKTime(1500000000, 42), pcdin });
+  }
+
+  // ... and prints it in its next loop.
+  for (LinkedList<LoggedMessage>::iterator it = received.begin(); it != received.end(); it++) {
+    file.print(it->timestamp.getTime());
+    file.print(it->timestamp.getMilliseconds());
+    file.print(";");
+    file.print("P");
+    file.print(";");
+    file.write(it->message.c_str(), it->message.length());
+    file.println();
+  }
+  benchSink += file.bytes;
+}
+
+static void logAsBinary(const std::vector<tN2kMsg> &messages, NullFile &file) {
+  NMEA2000LogSector sector;
+  uint32_t now = 0;
+
+  sector.reset(now);
+  sector.appendClock(file, 1500000000042, now, now);
+  for (const tN2kMsg &msg : messages) {
+    NMEA2000Frame frame;
+    frame.pgn = msg.PGN;
+    frame.timestamp = msg.MsgTime;
+    frame.priority = msg.Priority;
+    frame.source = msg.Source;
+    frame.destination = msg.Destination;
+    frame.length = msg.DataLen;
+    memcpy(frame.data, msg.Data, msg.DataLen);
+    sector.appendMessage(file, frame, now);
+
+    now += MessageInterval;
+    sector.poll(file, now);
+  }
+  sector.flush(file, now);
+  benchSink += file.bytes;
+}
+
+void benchLogging(KBoxBench &bench, const KBoxBenchCorpus &corpus) {
+  const std::vector<tN2kMsg> &messages = corpus.nmea2000Messages;
+  NullFile file;
+
+  bench.run("SDLoggingService NMEA2000 (text)", messages.size(), [&]() {
+    logAsText(messages, file);
+  });
+  bench.run("SDLoggingService NMEA2000 (binary)", messages.size(), [&]() {
+    logAsBinary(messages, file);
+  });
+}
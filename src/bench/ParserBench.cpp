@@ -0,0 +1,92 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common/nmea/NMEASentenceReader.h"
+#include "common/signalk/SKAISParser.h"
+#include "common/signalk/SKNMEAParser.h"
+#include "common/signalk/SKNMEA2000Parser.h"
+#include "KBoxBenchCorpus.h"
+#include "KBoxBench.h"
+
+/*
+ * Parsing of the incoming NMEA0183 and NMEA2000 traffic. Every operation is
+ * one sentence or one message of the corpus.
+ */
+
+void benchNMEAParsing(KBoxBench &bench, const KBoxBenchCorpus &corpus) {
+  const std::vector<String> &sentences = corpus.nmeaSentences;
+
+  bench.run("NMEASentenceReader.isValid", sentences.size(), [&]() {
+    for (const String &sentence : sentences) {
+      NMEASentenceReader reader(sentence);
+      benchSink += reader.isValid();
+    }
+  });
+
+  bench.run("NMEASentenceReader.getFieldAsDouble", sentences.size(), [&]() {
+    for (const String &sentence : sentences) {
+      NMEASentenceReader reader(sentence);
+      int fields = reader.countFields();
+      for (int i = 1; i <= fields; i++) {
+        benchSink += reader.getFieldAsDouble(i) > 0;
+      }
+    }
+  });
+
+  bench.run("SKNMEAParser.parse", sentences.size(), [&]() {
+    SKNMEAParser parser;
+    KBoxBenchUpdate update;
+    for (const String &sentence : sentences) {
+      benchSink += parser.parse(SKSourceInputNMEA0183_1, sentence, SKTime(0), update);
+    }
+  });
+
+  std::vector<String> aisSentences;
+  for (const String &sentence : sentences) {
+    if (sentence[0] == '!') {
+      aisSentences.push_back(sentence);
+    }
+  }
+
+  bench.run("SKAISParser.parse", aisSentences.size(), [&]() {
+    AISTargetTable targets;
+    SKAISParser parser(targets);
+    uint32_t now = 0;
+    for (const String &sentence : aisSentences) {
+      benchSink += parser.parse(SKSourceInputNMEA0183_1, sentence, SKTime(0), now++).getSize();
+    }
+  });
+}
+
+void benchNMEA2000Parsing(KBoxBench &bench, const KBoxBenchCorpus &corpus) {
+  const std::vector<tN2kMsg> &messages = corpus.nmea2000Messages;
+
+  bench.run("SKNMEA2000Parser.parse", messages.size(), [&]() {
+    SKNMEA2000Parser parser;
+    SKUpdateStatic<SKNMEA2000Parser::MaxValuesPerUpdate> update;
+    for (const tN2kMsg &msg : messages) {
+      benchSink += parser.parse(SKSourceInputNMEA2000, msg, SKTime(0), update);
+    }
+  });
+}
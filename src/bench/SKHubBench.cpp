@@ -0,0 +1,184 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common/signalk/SKHub.h"
+#include "common/signalk/SKSubscriber.h"
+#include "common/signalk/SKUpdateStatic.h"
+#include "common/signalk/SKNMEAConverter.h"
+#include "common/signalk/SKNMEA2000Converter.h"
+#include "KBoxBenchCorpus.h"
+#include "KBoxBench.h"
+
+/*
+ * Measures the cost of publishing updates on a SKHub with the same
+ * subscribers (and the same filters) as the firmware in src/host/main.cpp.
+ *
+ * The services themselves depend on the hardware so they are replaced by
+ * subscribers that run the same conversions into outputs that discard the
+ * messages.
+ *
+ * The cost of the hub itself is measured with 1 to 32 subscribers that only
+ * count the updates.
+ */
+
+/* SerialService, USBService and the NMEA part of WiFiService */
+class NMEAConvertingSubscriber : public SKSubscriber {
+  private:
+    const SKNMEAConverterConfig &_config;
+    NullNMEAOutput _output;
+
+  public:
+    NMEAConvertingSubscriber(const SKNMEAConverterConfig &config) : _config(config) {};
+
+    void updateReceived(const SKUpdate& update) override {
+      SKNMEAConverter converter(_config);
+      converter.convert(update, _output);
+    };
+};
+
+/* NMEA2000Service */
+class NMEA2000ConvertingSubscriber : public SKSubscriber {
+  private:
+    NullNMEA2000Output _output;
+
+  public:
+    void updateReceived(const SKUpdate& update) override {
+      if (update.getSource().getInput() != SKSourceInputNMEA2000) {
+        SKNMEA2000Converter converter;
+        converter.convert(update, _output);
+      }
+    };
+};
+
+/* SDLoggingService, TimeService and the pages */
+class CountingSubscriber : public SKSubscriber {
+  public:
+    int count = 0;
+
+    void updateReceived(const SKUpdate& update) override {
+      count++;
+    };
+};
+
+struct ProductionSubscribers {
+  SKNMEAConverterConfig serial1Config;
+  SKNMEAConverterConfig serial2Config;
+  SKNMEAConverterConfig usbConfig;
+  SKNMEAConverterConfig wifiConfig;
+
+  NMEAConvertingSubscriber serial1;
+  NMEAConvertingSubscriber serial2;
+  NMEAConvertingSubscriber usb;
+  NMEAConvertingSubscriber wifi;
+  NMEA2000ConvertingSubscriber nmea2000;
+  CountingSubscriber sdLogging;
+  CountingSubscriber time;
+  CountingSubscriber imuPage;
+  CountingSubscriber batteryPage;
+
+  ProductionSubscribers() : serial1(serial1Config), serial2(serial2Config), usb(usbConfig), wifi(wifiConfig) {
+    // Same as KBoxConfigParser::defaultConfig()
+    serial2Config.xdrPressure = false;
+    serial2Config.xdrAttitude = false;
+    serial2Config.xdrBattery = false;
+  };
+
+  /* Subscribe everyone to all the updates (previous behavior). */
+  void subscribeAll(SKHub &hub) {
+    hub.subscribe(&usb);
+    hub.subscribe(&sdLogging);
+    hub.subscribe(&wifi);
+    hub.subscribe(&nmea2000);
+    hub.subscribe(&serial1);
+    hub.subscribe(&serial2);
+    hub.subscribe(&time);
+    hub.subscribe(&imuPage);
+    hub.subscribe(&batteryPage);
+  };
+
+  /* Subscribe with the filters used in the firmware. */
+  void subscribeFiltered(SKHub &hub) {
+    hub.subscribe(&usb, SKNMEAConverter::subscriptionFilter(usbConfig));
+    hub.subscribe(&sdLogging);
+    hub.subscribe(&wifi);
+    hub.subscribe(&nmea2000, SKNMEA2000Converter::subscriptionFilter().excludeSourceInput(SKSourceInputNMEA2000));
+    hub.subscribe(&serial1, SKNMEAConverter::subscriptionFilter(serial1Config));
+    hub.subscribe(&serial2, SKNMEAConverter::subscriptionFilter(serial2Config));
+    hub.subscribe(&time, SKSubscriptionFilter().addPath(SKPathNavigationDatetime));
+    hub.subscribe(&imuPage, SKSubscriptionFilter());
+    hub.subscribe(&batteryPage, SKSubscriptionFilter().addPath(SKPathElectricalBatteriesVoltage));
+  };
+};
+
+template <int N> struct CountingSubscribers {
+  CountingSubscriber subscribers[N];
+
+  CountingSubscribers(SKHub &hub) {
+    for (int i = 0; i < N; i++) {
+      hub.subscribe(&subscribers[i]);
+    }
+  };
+};
+
+static void publishAll(SKHub &hub, const std::vector<KBoxBenchUpdate> &updates) {
+  for (const KBoxBenchUpdate &update : updates) {
+    hub.publish(update);
+  }
+}
+
+void benchSKHubPublish(KBoxBench &bench, const KBoxBenchCorpus &corpus) {
+  const std::vector<KBoxBenchUpdate> &updates = corpus.updates;
+
+  ProductionSubscribers broadcastSubscribers;
+  SKHub broadcastHub;
+  broadcastSubscribers.subscribeAll(broadcastHub);
+  bench.run("SKHub.publish (production, broadcast)", updates.size(), [&]() {
+    publishAll(broadcastHub, updates);
+  });
+
+  ProductionSubscribers filteredSubscribers;
+  SKHub filteredHub;
+  filteredSubscribers.subscribeFiltered(filteredHub);
+  bench.run("SKHub.publish (production, filtered)", updates.size(), [&]() {
+    publishAll(filteredHub, updates);
+  });
+
+  SKHub hub1;
+  CountingSubscribers<1> subscribers1(hub1);
+  bench.run("SKHub.publish (1 subscriber)", updates.size(), [&]() {
+    publishAll(hub1, updates);
+  });
+
+  SKHub hub8;
+  CountingSubscribers<8> subscribers8(hub8);
+  bench.run("SKHub.publish (8 subscribers)", updates.size(), [&]() {
+    publishAll(hub8, updates);
+  });
+
+  SKHub hub32;
+  CountingSubscribers<32> subscribers32(hub32);
+  bench.run("SKHub.publish (32 subscribers)", updates.size(), [&]() {
+    publishAll(hub32, updates);
+  });
+}
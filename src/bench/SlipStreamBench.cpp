@@ -0,0 +1,119 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <Stream.h>
+#include "common/comms/SlipStream.h"
+#include "common/comms/SKBinaryDelta.h"
+#include "KBoxBenchCorpus.h"
+#include "KBoxBench.h"
+
+/*
+ * SLIP framing of the kommands exchanged with the WiFi module. The frames are
+ * the binary deltas of the updates of the corpus so they are escaped like the
+ * real traffic.
+ */
+
+/* A Stream writing to and reading from a fixed buffer. */
+class MemoryStream : public Stream {
+  private:
+    std::vector<uint8_t> _buffer;
+    size_t _readIndex = 0;
+
+  public:
+    void clear() {
+      _buffer.clear();
+      _readIndex = 0;
+    };
+
+    void rewind() {
+      _readIndex = 0;
+    };
+
+    size_t write(uint8_t b) override {
+      _buffer.push_back(b);
+      return 1;
+    };
+
+    int available() override {
+      return _buffer.size() - _readIndex;
+    };
+
+    int read() override {
+      if (_readIndex < _buffer.size()) {
+        return _buffer[_readIndex++];
+      }
+      return -1;
+    };
+
+    int peek() override {
+      if (_readIndex < _buffer.size()) {
+        return _buffer[_readIndex];
+      }
+      return -1;
+    };
+
+    void flush() override {
+    };
+};
+
+class FrameCollector : public SKBinaryDeltaOutput {
+  public:
+    std::vector<std::vector<uint8_t>> frames;
+
+    void write(Kommand &k) override {
+      frames.push_back(std::vector<uint8_t>(k.getBytes(), k.getBytes() + k.getSize()));
+    };
+};
+
+void benchSlipStream(KBoxBench &bench, const KBoxBenchCorpus &corpus) {
+  SKBinaryDeltaEncoder encoder;
+  FrameCollector collector;
+  for (const KBoxBenchUpdate &update : corpus.updates) {
+    encoder.encode(update, collector);
+  }
+  const std::vector<std::vector<uint8_t>> &frames = collector.frames;
+
+  MemoryStream stream;
+  SlipStream slip(stream, 2048);
+
+  // Reserve the memory once so that the stream does not count as allocations.
+  for (const std::vector<uint8_t> &frame : frames) {
+    slip.writeFrame(frame.data(), frame.size());
+  }
+
+  bench.run("SlipStream.writeFrame", frames.size(), [&]() {
+    stream.clear();
+    for (const std::vector<uint8_t> &frame : frames) {
+      benchSink += slip.writeFrame(frame.data(), frame.size());
+    }
+  });
+
+  bench.run("SlipStream.readFrame", frames.size(), [&]() {
+    uint8_t frame[2048];
+    stream.rewind();
+    while (slip.available()) {
+      benchSink += slip.readFrame(frame, sizeof(frame));
+    }
+  });
+}
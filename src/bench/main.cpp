@@ -0,0 +1,81 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "KBoxBenchCorpus.h"
+#include "KBoxBench.h"
+
+static void usage(const char *name) {
+  fprintf(stderr, "Usage: %s [--json] [--filter <name>] [--min-time <ms>] [--corpus <directory>]\n", name);
+}
+
+int main(int argc, char **argv) {
+  bool json = false;
+  std::string filter;
+  int minimumSampleMs = 100;
+  std::string corpusDirectory = "tools/nmea-tester";
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0) {
+      json = true;
+    }
+    else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      filter = argv[++i];
+    }
+    else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+      minimumSampleMs = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--corpus") == 0 && i + 1 < argc) {
+      corpusDirectory = argv[++i];
+    }
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  KBoxBenchCorpus corpus;
+  if (!corpus.load(corpusDirectory)) {
+    return 1;
+  }
+
+  KBoxBench bench(filter, minimumSampleMs);
+  benchNMEAParsing(bench, corpus);
+  benchNMEA2000Parsing(bench, corpus);
+  benchConverters(bench, corpus);
+  benchJSON(bench, corpus);
+  benchSlipStream(bench, corpus);
+  benchSKHubPublish(bench, corpus);
+  benchLogging(bench, corpus);
+
+  if (json) {
+    bench.printJSON(stdout, corpus);
+  }
+  else {
+    bench.printText(stdout);
+  }
+  return 0;
+}
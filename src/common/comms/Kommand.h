@@ -90,6 +90,54 @@ enum KommandIdentifier {
   KommandNMEASentence = 0x40,
   KommandSKData = 0x42,
 
+  /**
+   * Compact binary version of KommandSKData. Only used for updates about our
+   * own vessel. Sources and indexes are referenced by ids which must have been
+   * defined before with KommandSKSource and KommandSKIndex.
+   *
+   * Data:
+   *  - uint8_t: sourceId
+   *  - uint32_t: timestamp (seconds)
+   *  - uint16_t: milliseconds (0xffff if unknown)
+   *  - uint8_t: number of values
+   *  - for each value:
+   *    - uint8_t: path (SKPathEnum)
+   *    - uint8_t: indexId (only for indexed paths)
+   *    - uint8_t: type (SKValueType)
+   *    - payload: nothing, 1 or 3 doubles (64 bits) or uint32_t + uint16_t
+   *      for timestamps
+   */
+  KommandSKDelta = 0x43,
+
+  /**
+   * Defines the source referenced by sourceId in KommandSKDelta.
+   *
+   * Data:
+   *  - uint8_t: sourceId
+   *  - uint8_t: input (SKSourceInput)
+   *  - NMEA0183 inputs: char[] talker, char[] sentence
+   *  - NMEA2000 input: uint32_t pgn, uint8_t priority, uint8_t sourceAddress
+   */
+  KommandSKSource = 0x44,
+
+  /**
+   * Defines the index referenced by indexId in KommandSKDelta.
+   *
+   * Data:
+   *  - uint8_t: indexId
+   *  - char[]: name
+   */
+  KommandSKIndex = 0x45,
+
+  /**
+   * Sent by the WiFi module when a KommandSKDelta references a source or an
+   * index it does not know (its definition was lost). KBox answers by sending
+   * all the definitions again.
+   *
+   * No data.
+   */
+  KommandSKUnknownReference = 0x46,
+
   /**
    * Sends information about WiFi module status.
    *
@@ -116,6 +164,31 @@ enum KommandIdentifier {
    *
    */
   KommandWiFiConfiguration = 0x51,
+
+  /**
+   * Requests the NMEA2000 bus statistics.
+   *
+   * No data. Replies with KommandNMEA2000BusStatsReply.
+   */
+  KommandNMEA2000BusStats = 0x60,
+
+  /**
+   * NMEA2000 traffic by PGN and source address, busiest first.
+   *
+   * Data:
+   *  - uint8_t: busLoad - percent of the bus used during the last second
+   *  - uint32_t: messages - received and sent since boot
+   *  - uint32_t: evictions - entries replaced because the table was full
+   *  - uint8_t: number of entries
+   *  - for each entry:
+   *    - uint32_t: pgn
+   *    - uint8_t: sourceAddress
+   *    - uint32_t: messages
+   *    - uint32_t: bytes
+   *    - uint16_t: rate - messages per second, in hundredths
+   *    - uint32_t: age - milliseconds since the last message
+   */
+  KommandNMEA2000BusStatsReply = 0x61,
 };
 
 enum class KommandFileErrors {
@@ -156,6 +229,14 @@ template <uint16_t maxDataSize> class FixedSizeKommand : public Kommand, public
       _bytes[_index++] = (w>>24) & 0xff;
     };
 
+    void append64(uint64_t w) {
+      if (_index + 8 > bufferSize) {
+        return;
+      }
+      append32(w & 0xffffffff);
+      append32(w >> 32);
+    };
+
     void append16(uint16_t w) {
       if (_index + 2 > bufferSize) {
         return;
@@ -187,11 +268,11 @@ template <uint16_t maxDataSize> class FixedSizeKommand : public Kommand, public
           return;
         }
 
-        strncpy((char*)_bytes + _index, s, len);
+        memcpy(_bytes + _index, s, len);
         _index += len;
 
       }
-      // Always add 0 because strncpy(a,b, strlen(s)) will not!
+      // Always add 0 because we only copied the content of the string
       append8((uint8_t) 0);
     };
 
@@ -0,0 +1,56 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "KommandHandlerNMEA2000BusStats.h"
+
+static const int EntrySize = 4 + 1 + 4 + 4 + 2 + 4;
+
+bool KommandHandlerNMEA2000BusStats::handleKommand(KommandReader &kreader, SlipStream &replyStream) {
+  if (kreader.getKommandIdentifier() != KommandNMEA2000BusStats || !_stats) {
+    return false;
+  }
+
+  uint32_t now = millis();
+  const NMEA2000BusStatsEntry *entries[NMEA2000BusStats::Capacity];
+  int count = _stats->busiest(entries, NMEA2000BusStats::Capacity, now);
+
+  FixedSizeKommand<1 + 4 + 4 + 1 + NMEA2000BusStats::Capacity * EntrySize> reply(KommandNMEA2000BusStatsReply);
+  reply.append8(_stats->busLoad(now));
+  reply.append32(_stats->messages());
+  reply.append32(_stats->evictions());
+  reply.append8(count);
+  for (int i = 0; i < count; i++) {
+    float rate = entries[i]->rate(now) * 100;
+    reply.append32(entries[i]->pgn);
+    reply.append8(entries[i]->source);
+    reply.append32(entries[i]->messages);
+    reply.append32(entries[i]->bytes);
+    reply.append16(rate < 0xffff ? (uint16_t)rate : 0xffff);
+    reply.append32(now - entries[i]->lastSeen);
+  }
+
+  replyStream.writeFrame(reply.getBytes(), reply.getSize());
+  return true;
+}
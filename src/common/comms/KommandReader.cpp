@@ -62,6 +62,18 @@ uint32_t KommandReader::read32() {
   return w;
 }
 
+uint64_t KommandReader::read64() {
+  if (index + 7 >= size) {
+    return 0;
+  }
+  uint64_t w = 0;
+  for (int i = 7; i >= 0; i--) {
+    w = (w << 8) + buffer[index + i];
+  }
+  index += 8;
+  return w;
+}
+
 const char *KommandReader::readNullTerminatedString() {
   char *s = (char*)buffer + index;
 
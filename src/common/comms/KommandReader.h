@@ -70,6 +70,11 @@ class KommandReader {
      */
     uint32_t read32();
 
+    /**
+     * Read the next eight bytes and advance pointer by 8.
+     */
+    uint64_t read64();
+
     /**
      * Read null-terminated string and advance pointer to end of string.
      *
@@ -0,0 +1,334 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <string.h>
+#include "SKBinaryDelta.h"
+
+static_assert(SKPathEnumCount <= 256, "SKPathEnum is encoded on 8 bits");
+static_assert(SKIndexTable::MaxIndexes < 64, "_definedIndexes has one bit per index");
+static_assert(8 + SKBinaryDeltaEncoder::MaxValues * 27 <= SKBinaryDeltaEncoder::MaxDeltaSize,
+              "A delta with MaxValues values must fit in MaxDeltaSize");
+
+static const uint16_t unknownMilliseconds = 0xffff;
+
+static uint64_t doubleToBits(double d) {
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  return bits;
+}
+
+static double bitsToDouble(uint64_t bits) {
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+SKBinaryDeltaEncoder::SKBinaryDeltaEncoder() {
+  reset();
+}
+
+void SKBinaryDeltaEncoder::reset() {
+  _sourcesCount = 0;
+  _definedIndexes = 0;
+}
+
+int SKBinaryDeltaEncoder::sourceId(const SKSource &source, SKBinaryDeltaOutput &output) {
+  for (int i = 0; i < _sourcesCount; i++) {
+    if (_sources[i] == source) {
+      return i;
+    }
+  }
+  if (_sourcesCount >= MaxSources) {
+    return -1;
+  }
+
+  int id = _sourcesCount++;
+  _sources[id] = source;
+
+  FixedSizeKommand<32> k(KommandSKSource);
+  k.append8(id);
+  k.append8(source.getInput());
+  switch (source.getInput()) {
+    case SKSourceInputNMEA0183_1:
+    case SKSourceInputNMEA0183_2:
+      k.appendNullTerminatedString(source.getTalker());
+      k.appendNullTerminatedString(source.getSentence());
+      break;
+    case SKSourceInputNMEA2000:
+      k.append32(source.getPGN());
+      k.append8(source.getPriority());
+      k.append8(source.getSourceAddress());
+      break;
+    default:
+      break;
+  }
+  output.write(k);
+  return id;
+}
+
+void SKBinaryDeltaEncoder::defineIndex(SKIndexId index, SKBinaryDeltaOutput &output) {
+  if (_definedIndexes & (1ULL << index)) {
+    return;
+  }
+  _definedIndexes |= 1ULL << index;
+
+  FixedSizeKommand<SKIndexTable::MaxIndexLength + 2> k(KommandSKIndex);
+  k.append8(index);
+  k.appendNullTerminatedString(skIndexTable.name(index));
+  output.write(k);
+}
+
+bool SKBinaryDeltaEncoder::encode(const SKUpdate &update, SKBinaryDeltaOutput &output) {
+  if (&update.getContext() != &SKContextSelf || update.getSize() > MaxValues) {
+    return false;
+  }
+
+  int source = sourceId(update.getSource(), output);
+  if (source < 0) {
+    return false;
+  }
+
+  for (int i = 0; i < update.getSize(); i++) {
+    const SKPath &path = update.getPath(i);
+    if (path.isIndexed()) {
+      defineIndex(path.getIndexId(), output);
+    }
+  }
+
+  FixedSizeKommand<MaxDeltaSize> k(KommandSKDelta);
+  k.append8(source);
+  k.append32(update.getTimestamp().getTime());
+  if (update.getTimestamp().hasMilliseconds()) {
+    k.append16(update.getTimestamp().getMilliseconds());
+  }
+  else {
+    k.append16(unknownMilliseconds);
+  }
+  k.append8(update.getSize());
+
+  for (int i = 0; i < update.getSize(); i++) {
+    const SKPath &path = update.getPath(i);
+    const SKValue &value = update.getValue(i);
+
+    k.append8(path.getStaticPath());
+    if (path.isIndexed()) {
+      k.append8(path.getIndexId());
+    }
+    k.append8(value.getType());
+    switch (value.getType()) {
+      case SKValue::SKValueTypeNone:
+        break;
+      case SKValue::SKValueTypeNumber:
+        k.append64(doubleToBits(value.getNumberValue()));
+        break;
+      case SKValue::SKValueTypePosition:
+        k.append64(doubleToBits(value.getPositionValue().latitude));
+        k.append64(doubleToBits(value.getPositionValue().longitude));
+        k.append64(doubleToBits(value.getPositionValue().altitude));
+        break;
+      case SKValue::SKValueTypeAttitude:
+        k.append64(doubleToBits(value.getAttitudeValue().roll));
+        k.append64(doubleToBits(value.getAttitudeValue().pitch));
+        k.append64(doubleToBits(value.getAttitudeValue().yaw));
+        break;
+      case SKValue::SKValueTypeTimestamp:
+        k.append32(value.getTimestampValue().getTime());
+        if (value.getTimestampValue().hasMilliseconds()) {
+          k.append16(value.getTimestampValue().getMilliseconds());
+        }
+        else {
+          k.append16(unknownMilliseconds);
+        }
+        break;
+    }
+  }
+  output.write(k);
+  return true;
+}
+
+SKBinaryDeltaDecoder::SKBinaryDeltaDecoder() {
+  reset();
+}
+
+void SKBinaryDeltaDecoder::reset() {
+  for (int i = 0; i < SKBinaryDeltaEncoder::MaxSources; i++) {
+    _definedSources[i] = false;
+  }
+  for (int i = 0; i <= SKIndexTable::MaxIndexes; i++) {
+    _indexes[i] = SKIndexInvalid;
+  }
+  _missingDefinition = false;
+}
+
+bool SKBinaryDeltaDecoder::decodeDefinition(KommandReader &kreader) {
+  if (kreader.getKommandIdentifier() == KommandSKIndex) {
+    SKIndexId id = kreader.read8();
+    const char *name = kreader.readNullTerminatedString();
+    if (id == SKIndexInvalid || id > SKIndexTable::MaxIndexes || name == nullptr) {
+      return false;
+    }
+    _indexes[id] = skIndexTable.intern(name);
+    return _indexes[id] != SKIndexInvalid;
+  }
+
+  if (kreader.getKommandIdentifier() != KommandSKSource) {
+    return false;
+  }
+
+  uint8_t id = kreader.read8();
+  SKSourceInput input = static_cast<SKSourceInput>(kreader.read8());
+  if (id >= SKBinaryDeltaEncoder::MaxSources || kreader.dataIndex() != 2
+      || input >= SKSourceInputCount) {
+    return false;
+  }
+
+  SKSource source = SKSourceUnknown;
+  switch (input) {
+    case SKSourceInputNMEA0183_1:
+    case SKSourceInputNMEA0183_2:
+      {
+        const char *talker = kreader.readNullTerminatedString();
+        const char *sentence = kreader.readNullTerminatedString();
+        if (talker == nullptr || sentence == nullptr) {
+          return false;
+        }
+        source = SKSource::sourceForNMEA0183(input, talker, sentence);
+      }
+      break;
+    case SKSourceInputNMEA2000:
+      {
+        uint32_t pgn = kreader.read32();
+        uint8_t priority = kreader.read8();
+        uint8_t sourceAddress = kreader.read8();
+        source = SKSource::sourceForNMEA2000(input, pgn, priority, sourceAddress);
+      }
+      break;
+    case SKSourceInputUnknown:
+      break;
+    default:
+      source = SKSource::sourceForKBoxSensor(input);
+  }
+  if (kreader.dataIndex() != kreader.dataSize()) {
+    return false;
+  }
+
+  _sources[id] = source;
+  _definedSources[id] = true;
+  return true;
+}
+
+bool SKBinaryDeltaDecoder::decodeDelta(KommandReader &kreader, SKUpdate &update) {
+  if (kreader.getKommandIdentifier() != KommandSKDelta) {
+    return false;
+  }
+
+  update.clear();
+  _missingDefinition = false;
+
+  uint8_t sourceId = kreader.read8();
+  if (sourceId >= SKBinaryDeltaEncoder::MaxSources) {
+    return false;
+  }
+  if (!_definedSources[sourceId]) {
+    _missingDefinition = true;
+    return false;
+  }
+  update.setSource(_sources[sourceId]);
+
+  uint32_t time = kreader.read32();
+  uint16_t ms = kreader.read16();
+  if (ms == unknownMilliseconds) {
+    update.setTimestamp(SKTime(time));
+  }
+  else {
+    update.setTimestamp(SKTime(time, ms));
+  }
+
+  uint8_t count = kreader.read8();
+  for (int i = 0; i < count; i++) {
+    uint8_t p = kreader.read8();
+    if (p >= SKPathEnumCount) {
+      return false;
+    }
+    SKPathEnum staticPath = static_cast<SKPathEnum>(p);
+
+    SKPath path;
+    if (staticPath > SKPathEnumIndexedPaths) {
+      uint8_t remoteIndex = kreader.read8();
+      if (remoteIndex == SKIndexInvalid || remoteIndex > SKIndexTable::MaxIndexes) {
+        return false;
+      }
+      if (_indexes[remoteIndex] == SKIndexInvalid) {
+        _missingDefinition = true;
+        return false;
+      }
+      path = SKPath(staticPath, _indexes[remoteIndex]);
+    }
+    else {
+      path = SKPath(staticPath);
+    }
+
+    SKValue value;
+    switch (kreader.read8()) {
+      case SKValue::SKValueTypeNone:
+        break;
+      case SKValue::SKValueTypeNumber:
+        value = SKValue(bitsToDouble(kreader.read64()));
+        break;
+      case SKValue::SKValueTypePosition:
+        {
+          double latitude = bitsToDouble(kreader.read64());
+          double longitude = bitsToDouble(kreader.read64());
+          double altitude = bitsToDouble(kreader.read64());
+          value = SKValue(SKTypePosition(latitude, longitude, altitude));
+        }
+        break;
+      case SKValue::SKValueTypeAttitude:
+        {
+          double roll = bitsToDouble(kreader.read64());
+          double pitch = bitsToDouble(kreader.read64());
+          double yaw = bitsToDouble(kreader.read64());
+          value = SKValue(SKTypeAttitude(roll, pitch, yaw));
+        }
+        break;
+      case SKValue::SKValueTypeTimestamp:
+        {
+          uint32_t t = kreader.read32();
+          uint16_t tms = kreader.read16();
+          value = SKValue(tms == unknownMilliseconds ? SKTime(t) : SKTime(t, tms));
+        }
+        break;
+      default:
+        return false;
+    }
+
+    // setValue() rejects invalid paths (unknown index) and full updates.
+    if (!update.setValue(path, value)) {
+      return false;
+    }
+  }
+
+  // Reads beyond the end of the buffer do not move the index.
+  return kreader.dataIndex() == kreader.dataSize();
+}
@@ -0,0 +1,127 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "common/signalk/SKUpdate.h"
+#include "Kommand.h"
+#include "KommandReader.h"
+
+/**
+ * Receives the Kommands generated by SKBinaryDeltaEncoder.
+ */
+class SKBinaryDeltaOutput {
+  public:
+    virtual void write(Kommand &k) = 0;
+};
+
+/**
+ * Encodes SKUpdate into KommandSKDelta.
+ *
+ * The first time a source or an index is used, the encoder emits a
+ * KommandSKSource or a KommandSKIndex defining it. Later deltas only carry the
+ * id. The encoder must be reset when the receiver restarts or reports an
+ * unknown reference (KommandSKUnknownReference) so that the definitions are
+ * sent again.
+ */
+class SKBinaryDeltaEncoder {
+  public:
+    static const int MaxSources = 32;
+    static const int MaxValues = 16;
+    static const uint16_t MaxDeltaSize = 512;
+
+  private:
+    SKSource _sources[MaxSources];
+    int _sourcesCount;
+
+    // One bit per SKIndexId already defined
+    uint64_t _definedIndexes;
+
+    int sourceId(const SKSource &source, SKBinaryDeltaOutput &output);
+    void defineIndex(SKIndexId index, SKBinaryDeltaOutput &output);
+
+  public:
+    SKBinaryDeltaEncoder();
+
+    /**
+     * Forget all the sources and indexes defined so far.
+     */
+    void reset();
+
+    /**
+     * Encode the update and write it to the output, preceded by any
+     * definition it needs.
+     *
+     * Returns false if the update can not be represented in a KommandSKDelta
+     * (context is not self, too many values or too many sources). The caller
+     * should then fall back to KommandSKData.
+     */
+    bool encode(const SKUpdate &update, SKBinaryDeltaOutput &output);
+};
+
+/**
+ * Rebuilds SKUpdate from the Kommands generated by SKBinaryDeltaEncoder.
+ */
+class SKBinaryDeltaDecoder {
+  private:
+    SKSource _sources[SKBinaryDeltaEncoder::MaxSources];
+    bool _definedSources[SKBinaryDeltaEncoder::MaxSources];
+
+    // Maps the index ids of the sender to the ids in our skIndexTable
+    SKIndexId _indexes[SKIndexTable::MaxIndexes + 1];
+
+    bool _missingDefinition;
+
+  public:
+    SKBinaryDeltaDecoder();
+
+    /**
+     * Forget all the sources and indexes defined so far.
+     */
+    void reset();
+
+    /**
+     * Process a KommandSKSource or a KommandSKIndex.
+     *
+     * Returns false if this is not a definition or if it is invalid.
+     */
+    bool decodeDefinition(KommandReader &kreader);
+
+    /**
+     * Decode a KommandSKDelta into update, which is cleared first.
+     *
+     * Returns false if the Kommand is invalid, references a source or an index
+     * that was not defined, or does not fit in update.
+     */
+    bool decodeDelta(KommandReader &kreader, SKUpdate &update);
+
+    /**
+     * True if the last call to decodeDelta() failed because the delta
+     * references a source or an index that was not defined. The sender should
+     * then be asked to define them again.
+     */
+    bool missingDefinition() const {
+      return _missingDefinition;
+    };
+};
@@ -0,0 +1,146 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "AISFragmentAssembler.h"
+#include "NMEASentenceReader.h"
+
+AISFragmentAssembler::AISFragmentAssembler() : _dropped(0) {
+  for (int i = 0; i < MaxPendingMessages; i++) {
+    _pending[i].used = false;
+  }
+}
+
+AISFragmentAssembler::PendingMessage* AISFragmentAssembler::find(uint8_t sequenceId, char channel) {
+  for (int i = 0; i < MaxPendingMessages; i++) {
+    if (_pending[i].used && _pending[i].sequenceId == sequenceId && _pending[i].channel == channel) {
+      return &_pending[i];
+    }
+  }
+  return nullptr;
+}
+
+AISFragmentAssembler::PendingMessage* AISFragmentAssembler::allocate() {
+  PendingMessage *oldest = &_pending[0];
+  for (int i = 0; i < MaxPendingMessages; i++) {
+    if (!_pending[i].used) {
+      return &_pending[i];
+    }
+    if ((int32_t)(_pending[i].lastFragmentTime - oldest->lastFragmentTime) < 0) {
+      oldest = &_pending[i];
+    }
+  }
+  // All slots are used: give up on the oldest message.
+  _dropped++;
+  return oldest;
+}
+
+void AISFragmentAssembler::expire(uint32_t now) {
+  for (int i = 0; i < MaxPendingMessages; i++) {
+    if (_pending[i].used && now - _pending[i].lastFragmentTime > FragmentTimeout) {
+      _pending[i].used = false;
+      _dropped++;
+    }
+  }
+}
+
+/*
+ * Parses a field containing a single digit. Returns -1 if the field is not a
+ * digit.
+ */
+static int digitField(const NMEASentenceReader& reader, int field) {
+  NMEAField f = reader.getField(field);
+  if (f.getLength() != 1 || f.getData()[0] < '0' || f.getData()[0] > '9') {
+    return -1;
+  }
+  return f.getData()[0] - '0';
+}
+
+const AISPayload* AISFragmentAssembler::add(const NMEASentenceReader& reader, uint32_t now) {
+  // !AIVDM,<count>,<number>,<sequence id>,<channel>,<payload>,<fill bits>*hh
+  int count = digitField(reader, 1);
+  int number = digitField(reader, 2);
+  char channel = reader.getFieldAsChar(4);
+  NMEAField payload = reader.getField(5);
+  int fillBits = digitField(reader, 6);
+
+  if (count < 1 || number < 1 || number > count || fillBits < 0) {
+    _dropped++;
+    return nullptr;
+  }
+
+  if (count == 1) {
+    _single.clear();
+    if (!_single.append(payload.getData(), payload.getLength(), fillBits)) {
+      _dropped++;
+      return nullptr;
+    }
+    return &_single;
+  }
+
+  expire(now);
+
+  // Multi-fragment messages always have a sequence id.
+  int sequenceId = digitField(reader, 3);
+  if (sequenceId < 0) {
+    _dropped++;
+    return nullptr;
+  }
+
+  PendingMessage *message = find(sequenceId, channel);
+  if (number == 1) {
+    if (message) {
+      // The previous message with this id was never completed.
+      _dropped++;
+    }
+    else {
+      message = allocate();
+    }
+    message->used = true;
+    message->channel = channel;
+    message->sequenceId = sequenceId;
+    message->fragmentsCount = count;
+    message->nextFragment = 1;
+    message->payload.clear();
+  }
+  else if (!message) {
+    // We missed the beginning of this message.
+    _dropped++;
+    return nullptr;
+  }
+
+  if (message->fragmentsCount != count || message->nextFragment != number
+      || !message->payload.append(payload.getData(), payload.getLength(), fillBits)) {
+    message->used = false;
+    _dropped++;
+    return nullptr;
+  }
+  message->lastFragmentTime = now;
+  message->nextFragment++;
+
+  if (number == count) {
+    message->used = false;
+    return &message->payload;
+  }
+  return nullptr;
+}
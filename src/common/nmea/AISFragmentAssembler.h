@@ -0,0 +1,83 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "AISPayload.h"
+
+class NMEASentenceReader;
+
+/**
+ * Reassembles AIS messages sent over several !AIVDM/!AIVDO sentences.
+ *
+ * Fragments of one message share a sequential message id and a radio channel.
+ * Up to MaxPendingMessages messages can be reassembled at the same time.
+ * A message is dropped if its fragments do not arrive in order or if the
+ * next fragment does not arrive within FragmentTimeout milliseconds.
+ */
+class AISFragmentAssembler {
+  public:
+    static const int MaxPendingMessages = 4;
+    static const uint32_t FragmentTimeout = 2000;
+
+  private:
+    struct PendingMessage {
+      bool used;
+      char channel;
+      uint8_t sequenceId;
+      uint8_t fragmentsCount;
+      uint8_t nextFragment;
+      uint32_t lastFragmentTime;
+      AISPayload payload;
+    };
+
+    PendingMessage _pending[MaxPendingMessages];
+    AISPayload _single;
+    uint32_t _dropped;
+
+    PendingMessage* find(uint8_t sequenceId, char channel);
+    PendingMessage* allocate();
+    void expire(uint32_t now);
+
+  public:
+    AISFragmentAssembler();
+
+    /**
+     * Adds the fragment in sentence (which must be a valid !AIVDM or !AIVDO
+     * sentence) received at time now (in milliseconds).
+     *
+     * @return the complete payload if this was the last fragment of a message,
+     * or a null pointer. The payload is only valid until the next call.
+     */
+    const AISPayload* add(const NMEASentenceReader& sentence, uint32_t now);
+
+    /**
+     * Number of messages dropped because of missing, out of order or
+     * invalid fragments.
+     */
+    uint32_t dropped() const {
+      return _dropped;
+    };
+};
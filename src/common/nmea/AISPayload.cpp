@@ -0,0 +1,114 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "AISPayload.h"
+
+/*
+ * Armoured character to 6-bit value. Valid characters are '0' to 'W' and '`'
+ * to 'w'. 0xff marks invalid characters.
+ */
+static const uint8_t dearmour[128] = {
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+  0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+  0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+/*
+ * 6-bit value to character in text fields ("6-bit ASCII").
+ */
+static const char sixbitAscii[65] =
+  "@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_ !\"#$%&'()*+,-./0123456789:;<=>?";
+
+bool AISPayload::append(const char *armoured, size_t length, uint8_t fillBits) {
+  if (_length + length * 6 > MaxBits || fillBits > 5 || fillBits > length * 6) {
+    return false;
+  }
+
+  uint16_t position = _length;
+  for (size_t i = 0; i < length; i++) {
+    uint8_t c = armoured[i];
+    uint8_t value = c < 128 ? dearmour[c] : 0xff;
+    if (value == 0xff) {
+      return false;
+    }
+
+    // Write the 6 bits, most significant first, over one or two bytes.
+    uint16_t byte = position / 8;
+    uint8_t offset = position % 8;
+    uint16_t window = (uint16_t)value << (10 - offset);
+    // Keep the bits before position, they may be followed by padding.
+    uint8_t mask = 0xff00 >> offset;
+    _bits[byte] = (_bits[byte] & mask) | (window >> 8);
+    if (offset > 2) {
+      _bits[byte + 1] = window & 0xff;
+    }
+    position += 6;
+  }
+  _length = position - fillBits;
+  return true;
+}
+
+uint32_t AISPayload::getUnsigned(uint16_t start, uint8_t width) const {
+  uint32_t value = 0;
+  for (uint16_t position = start; position < start + width; position++) {
+    uint32_t bit = 0;
+    if (position < _length) {
+      bit = (_bits[position / 8] >> (7 - position % 8)) & 1;
+    }
+    value = (value << 1) | bit;
+  }
+  return value;
+}
+
+int32_t AISPayload::getSigned(uint16_t start, uint8_t width) const {
+  uint32_t value = getUnsigned(start, width);
+  if (width > 0 && width < 32 && (value & (1u << (width - 1)))) {
+    value |= ~((1u << width) - 1);
+  }
+  return (int32_t)value;
+}
+
+size_t AISPayload::getString(uint16_t start, uint8_t count, char *buffer, size_t size) const {
+  if (size == 0) {
+    return 0;
+  }
+  size_t length = 0;
+  for (uint8_t i = 0; i < count && length < size - 1; i++) {
+    char c = sixbitAscii[getUnsigned(start + 6 * i, 6)];
+    if (c == '@') {
+      break;
+    }
+    buffer[length++] = c;
+  }
+  while (length > 0 && buffer[length - 1] == ' ') {
+    length--;
+  }
+  buffer[length] = '\0';
+  return length;
+}
@@ -0,0 +1,98 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The binary payload of an AIS message.
+ *
+ * AIS messages are transmitted in the payload field of !AIVDM/!AIVDO
+ * sentences "armoured" in 6-bit characters. The payload is decoded in a fixed
+ * size bit buffer and fields are read by bit offset and width as described in
+ * http://catb.org/gpsd/AIVDM.html
+ */
+class AISPayload {
+  public:
+    /**
+     * The longest AIS messages use 5 slots (1008 bits).
+     */
+    static const uint16_t MaxBits = 1008;
+
+  private:
+    uint8_t _bits[MaxBits / 8];
+    uint16_t _length;
+
+  public:
+    AISPayload() : _length(0) {};
+
+    void clear() {
+      _length = 0;
+    };
+
+    /**
+     * Decodes length armoured characters at the end of the payload. The last
+     * fillBits bits are padding and are discarded.
+     *
+     * @return false if a character is not valid or if the payload would
+     * become longer than MaxBits. The payload is then left unchanged.
+     */
+    bool append(const char *armoured, size_t length, uint8_t fillBits);
+
+    /**
+     * Number of bits in the payload.
+     */
+    uint16_t getLength() const {
+      return _length;
+    };
+
+    /**
+     * Unsigned value of width bits (at most 32) starting at bit start. Bits
+     * after the end of the payload are read as 0.
+     */
+    uint32_t getUnsigned(uint16_t start, uint8_t width) const;
+
+    /**
+     * Same as getUnsigned() for a two's complement signed field.
+     */
+    int32_t getSigned(uint16_t start, uint8_t width) const;
+
+    /**
+     * Decodes count 6-bit characters starting at bit start in buffer (always
+     * null-terminated). The '@' padding and trailing spaces are removed.
+     *
+     * @return the length of the string.
+     */
+    size_t getString(uint16_t start, uint8_t count, char *buffer, size_t size) const;
+
+    uint8_t getMessageType() const {
+      return getUnsigned(0, 6);
+    };
+
+    uint32_t getMMSI() const {
+      return getUnsigned(8, 30);
+    };
+};
@@ -0,0 +1,79 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <math.h>
+#include <string.h>
+#include "AISTargetTable.h"
+
+void AISTarget::reset(uint32_t m) {
+  mmsi = m;
+  lastSeen = 0;
+  classB = false;
+  latitude = NAN;
+  longitude = NAN;
+  speedOverGround = NAN;
+  courseOverGround = NAN;
+  heading = NAN;
+  shipType = 0;
+  length = 0;
+  beam = 0;
+  draught = 0;
+  name[0] = '\0';
+  callsign[0] = '\0';
+}
+
+AISTargetTable::AISTargetTable() : _size(0), _evictions(0) {
+}
+
+AISTarget* AISTargetTable::find(uint32_t mmsi) {
+  for (int i = 0; i < _size; i++) {
+    if (_targets[i].mmsi == mmsi) {
+      return &_targets[i];
+    }
+  }
+  return nullptr;
+}
+
+AISTarget& AISTargetTable::touch(uint32_t mmsi, uint32_t now) {
+  AISTarget *target = find(mmsi);
+
+  if (!target) {
+    if (_size < Capacity) {
+      target = &_targets[_size++];
+    }
+    else {
+      // Replace the target that has not been seen for the longest time.
+      target = &_targets[0];
+      for (int i = 1; i < _size; i++) {
+        if (now - _targets[i].lastSeen > now - target->lastSeen) {
+          target = &_targets[i];
+        }
+      }
+      _evictions++;
+    }
+    target->reset(mmsi);
+  }
+  target->lastSeen = now;
+  return *target;
+}
@@ -0,0 +1,107 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * What we know about one AIS target. Dynamic values are in SI units (like
+ * SignalK) and are NaN when they are not available.
+ */
+struct AISTarget {
+  uint32_t mmsi;
+  // millis() when the last message from this target was received
+  uint32_t lastSeen;
+  bool classB;
+
+  double latitude;
+  double longitude;
+  // m/s
+  float speedOverGround;
+  // radians
+  float courseOverGround;
+  float heading;
+
+  // Static data: 0 or empty when unknown.
+  uint8_t shipType;
+  uint16_t length;
+  uint8_t beam;
+  // decimeters
+  uint8_t draught;
+  char name[21];
+  char callsign[8];
+
+  void reset(uint32_t mmsi);
+};
+
+/**
+ * Fixed size table of the AIS targets in range.
+ *
+ * When the table is full, the target that was seen least recently is
+ * replaced so the memory used does not depend on the number of vessels
+ * around.
+ */
+class AISTargetTable {
+  public:
+    static const int Capacity = 32;
+
+  private:
+    AISTarget _targets[Capacity];
+    int _size;
+    uint32_t _evictions;
+
+  public:
+    AISTargetTable();
+
+    /**
+     * The target with this MMSI or a null pointer.
+     */
+    AISTarget* find(uint32_t mmsi);
+
+    /**
+     * Returns the target with this MMSI, marked as seen at time now (in
+     * milliseconds). A new target is created (replacing the least recently
+     * seen one if the table is full) if needed.
+     */
+    AISTarget& touch(uint32_t mmsi, uint32_t now);
+
+    int size() const {
+      return _size;
+    };
+
+    /**
+     * Target i, 0 <= i < size(). Targets are not sorted.
+     */
+    const AISTarget& operator[](int i) const {
+      return _targets[i];
+    };
+
+    /**
+     * Number of targets that were replaced by new ones.
+     */
+    uint32_t evictions() const {
+      return _evictions;
+    };
+};
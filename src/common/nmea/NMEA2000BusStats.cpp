@@ -0,0 +1,194 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common/stats/KBoxMetrics.h"
+#include "NMEA2000BusStats.h"
+#include "NMEA2000Frame.h"
+
+static const uint32_t BusBitsPerSecond = 250000;
+
+// Longer gaps do not change the average much more and would overflow it.
+static const uint32_t MaxInterval = 3600000;
+
+float NMEA2000BusStatsEntry::rate(uint32_t now) const {
+  if (messages < 2) {
+    return 0;
+  }
+  uint32_t interval = averageInterval;
+  uint32_t silence = now - lastSeen;
+  if (silence < MaxInterval && silence * 16 > interval) {
+    interval = silence * 16;
+  }
+  if (interval == 0) {
+    interval = 1;
+  }
+  return 16000.0f / interval;
+}
+
+NMEA2000BusStats::NMEA2000BusStats() : _size(0), _evictions(0), _messages(0),
+  _windowStart(0), _windowBits(0), _lastWindowBits(0) {
+  for (int i = 0; i < Capacity; i++) {
+    _entries[i].messages = 0;
+  }
+}
+
+int NMEA2000BusStats::slotFor(uint32_t pgn, uint8_t source) {
+  // Fibonacci hashing: the high bits of the product are well mixed.
+  uint32_t hash = ((pgn << 8) | source) * 2654435761u;
+  return ((uint64_t)hash * Capacity) >> 32;
+}
+
+void NMEA2000BusStats::record(uint32_t pgn, uint8_t source, size_t length, uint32_t now) {
+  _messages++;
+  if (now - _windowStart >= 1000) {
+    // Nothing was received during the last second if it ended long ago.
+    _lastWindowBits = now - _windowStart < 2000 ? _windowBits : 0;
+    _windowBits = 0;
+    _windowStart = now;
+  }
+  _windowBits += NMEA2000Frame::busBits(length);
+
+  int home = slotFor(pgn, source);
+  NMEA2000BusStatsEntry *oldest = nullptr;
+  for (int probe = 0; probe < MaxProbes; probe++) {
+    NMEA2000BusStatsEntry &entry = _entries[(home + probe) % Capacity];
+
+    if (entry.messages > 0 && entry.pgn == pgn && entry.source == source) {
+      uint32_t interval = now - entry.lastSeen;
+      if (interval > MaxInterval) {
+        interval = MaxInterval;
+      }
+      if (entry.messages == 1) {
+        entry.averageInterval = interval * 16;
+      }
+      else {
+        entry.averageInterval = entry.averageInterval - entry.averageInterval / 8 + interval * 2;
+      }
+      entry.messages++;
+      entry.bytes += length;
+      entry.lastSeen = now;
+      return;
+    }
+
+    if (entry.messages == 0) {
+      // Linear probing never leaves holes: the entry is not in the table.
+      _size++;
+      oldest = &entry;
+      break;
+    }
+    if (!oldest || now - entry.lastSeen > now - oldest->lastSeen) {
+      oldest = &entry;
+    }
+  }
+
+  if (oldest->messages > 0) {
+    _evictions++;
+    KBoxMetrics.event(KBoxEventNMEA2000BusStatsEvicted);
+  }
+  oldest->pgn = pgn;
+  oldest->source = source;
+  oldest->messages = 1;
+  oldest->bytes = length;
+  oldest->lastSeen = now;
+  oldest->averageInterval = 0;
+}
+
+/*
+ * Empties slot index and moves back the entries that follow it so that no
+ * entry is separated from its hash by an empty slot.
+ */
+void NMEA2000BusStats::remove(int index) {
+  _entries[index].messages = 0;
+  _size--;
+
+  int hole = index;
+  for (int i = (index + 1) % Capacity; _entries[i].messages > 0; i = (i + 1) % Capacity) {
+    int home = slotFor(_entries[i].pgn, _entries[i].source);
+    // Can the entry move to the hole (is the hole between its hash and i)?
+    if ((i - home + Capacity) % Capacity >= (i - hole + Capacity) % Capacity) {
+      _entries[hole] = _entries[i];
+      _entries[i].messages = 0;
+      hole = i;
+    }
+  }
+}
+
+void NMEA2000BusStats::expire(uint32_t now) {
+  for (int i = 0; i < Capacity; i++) {
+    // An entry moved into slot i by remove() is checked again.
+    while (_entries[i].messages > 0 && now - _entries[i].lastSeen > StaleTime) {
+      remove(i);
+    }
+  }
+}
+
+const NMEA2000BusStatsEntry* NMEA2000BusStats::find(uint32_t pgn, uint8_t source) const {
+  int home = slotFor(pgn, source);
+  for (int probe = 0; probe < MaxProbes; probe++) {
+    const NMEA2000BusStatsEntry &entry = _entries[(home + probe) % Capacity];
+    if (entry.messages == 0) {
+      return nullptr;
+    }
+    if (entry.pgn == pgn && entry.source == source) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+int NMEA2000BusStats::busiest(const NMEA2000BusStatsEntry **entries, int count, uint32_t now) const {
+  int found = 0;
+  for (int i = 0; i < Capacity; i++) {
+    if (_entries[i].messages == 0) {
+      continue;
+    }
+    // Insertion sort into the (short) list of results.
+    float rate = _entries[i].rate(now);
+    int position = found;
+    while (position > 0 && entries[position - 1]->rate(now) < rate) {
+      if (position < count) {
+        entries[position] = entries[position - 1];
+      }
+      position--;
+    }
+    if (position < count) {
+      entries[position] = &_entries[i];
+      if (found < count) {
+        found++;
+      }
+    }
+  }
+  return found;
+}
+
+uint8_t NMEA2000BusStats::busLoad(uint32_t now) const {
+  uint32_t bits = _lastWindowBits;
+  if (now - _windowStart >= 2000) {
+    bits = 0;
+  }
+  else if (now - _windowStart >= 1000) {
+    bits = _windowBits;
+  }
+  return bits * 100 / BusBitsPerSecond;
+}
@@ -0,0 +1,138 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Traffic of one PGN sent by one device (source address).
+ */
+struct NMEA2000BusStatsEntry {
+  uint32_t pgn;
+  uint8_t source;
+  // Messages and bytes of data received since the entry was created. An entry
+  // with no messages is an empty slot of the table.
+  uint32_t messages;
+  uint32_t bytes;
+  // millis() when the last message was received
+  uint32_t lastSeen;
+  // Moving average of the time between two messages, in 1/16 of ms
+  uint32_t averageInterval;
+
+  /**
+   * Messages per second. Goes down when the device stops sending.
+   */
+  float rate(uint32_t now) const;
+};
+
+/**
+ * Fixed size table of the NMEA2000 traffic by PGN and source address, with an
+ * estimate of the bus load.
+ *
+ * Entries are stored with open addressing (linear probing) and are never
+ * further than MaxProbes slots from their hash so recording a message takes
+ * constant time and can be done from the message handler. When those slots
+ * are all used, the entry that was seen least recently is replaced. Entries
+ * that have not been seen for StaleTime are removed by expire().
+ */
+class NMEA2000BusStats {
+  public:
+    static const int Capacity = 64;
+    static const int MaxProbes = 8;
+    static const uint32_t StaleTime = 60000;
+
+  private:
+    NMEA2000BusStatsEntry _entries[Capacity];
+    int _size;
+    uint32_t _evictions;
+    uint32_t _messages;
+    // Bits received during the current and the last complete second
+    uint32_t _windowStart;
+    uint32_t _windowBits;
+    uint32_t _lastWindowBits;
+
+    static int slotFor(uint32_t pgn, uint8_t source);
+    void remove(int index);
+
+  public:
+    NMEA2000BusStats();
+
+    /**
+     * Counts a message of length bytes of data seen on the bus at time now
+     * (in milliseconds).
+     */
+    void record(uint32_t pgn, uint8_t source, size_t length, uint32_t now);
+
+    /**
+     * Removes the entries that have not been seen for StaleTime.
+     */
+    void expire(uint32_t now);
+
+    /**
+     * The entry of this PGN and source or a null pointer.
+     */
+    const NMEA2000BusStatsEntry* find(uint32_t pgn, uint8_t source) const;
+
+    /**
+     * Fills entries with (at most count) pointers to the entries with the
+     * highest rate, highest first.
+     *
+     * @return the number of entries written.
+     */
+    int busiest(const NMEA2000BusStatsEntry **entries, int count, uint32_t now) const;
+
+    /**
+     * Slot i of the table, 0 <= i < Capacity. Empty slots have no messages.
+     */
+    const NMEA2000BusStatsEntry& operator[](int i) const {
+      return _entries[i];
+    };
+
+    int size() const {
+      return _size;
+    };
+
+    /**
+     * Number of entries that were replaced by new ones (stale entries removed
+     * by expire() are not counted).
+     */
+    uint32_t evictions() const {
+      return _evictions;
+    };
+
+    /**
+     * Number of messages recorded, including the ones of removed entries.
+     */
+    uint32_t messages() const {
+      return _messages;
+    };
+
+    /**
+     * Estimated share of the bus (250kbit/s) used during the last complete
+     * second, in percent.
+     */
+    uint8_t busLoad(uint32_t now) const;
+};
@@ -0,0 +1,66 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A NMEA2000 message, copied out of the NMEA2000 library so that it can wait
+ * in a NMEA2000FrameRing or be written to the log.
+ */
+struct NMEA2000Frame {
+  /** Same as tN2kMsg::MaxDataLen (a fast packet message). */
+  static const size_t MaxDataLength = 223;
+
+  uint32_t pgn;
+  // millis() when the message was received
+  uint32_t timestamp;
+  uint8_t priority;
+  uint8_t source;
+  uint8_t destination;
+  uint8_t length;
+  uint8_t data[MaxDataLength];
+
+  /**
+   * Estimated number of bits needed to send a message with this number of
+   * bytes of data on the bus, including the frame overhead.
+   */
+  static uint32_t busBits(size_t length);
+};
+
+/*
+ * A CAN 2.0B frame has 67 bits of overhead plus its data. About one bit in
+ * five of the 54 + 8n bits before the CRC delimiter is a stuff bit in the
+ * worst case. Messages longer than 8 bytes are sent as fast packets: 6 bytes
+ * in the first frame and 7 in each of the others, all with 8 bytes of data.
+ */
+inline uint32_t NMEA2000Frame::busBits(size_t length) {
+  if (length <= 8) {
+    return 67 + 8 * length + (54 + 8 * length) / 5;
+  }
+  uint32_t frames = 1 + (length - 6 + 7 - 1) / 7;
+  return frames * busBits(8);
+}
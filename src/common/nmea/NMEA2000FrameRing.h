@@ -0,0 +1,133 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "NMEA2000Frame.h"
+
+/**
+ * Fixed size queue of NMEA2000 frames.
+ *
+ * Frames are stored one after the other in a ring of bytes and only take the
+ * room they need: a single frame message uses 24 bytes, a 43 bytes GNSS
+ * position uses 59. When there is not enough room, the frame is dropped and
+ * counted in overflows().
+ *
+ * push() and pop() must be called from the same context (both are called
+ * from NMEA2000Service::loop()): the ring is not safe to use from an
+ * interrupt.
+ *
+ * Bytes must be a power of two.
+ */
+template <uint16_t Bytes> class NMEA2000FrameRing {
+  static_assert(Bytes >= 256 && (Bytes & (Bytes - 1)) == 0 && Bytes <= 32768,
+                "Bytes must be a power of two between 256 and 32768");
+
+  public:
+    /** Room taken by a frame in the ring in addition to its data. */
+    static const size_t HeaderLength = offsetof(NMEA2000Frame, data);
+
+  private:
+    uint8_t _bytes[Bytes];
+    // Free running counters. Byte index is counter % Bytes.
+    uint16_t _head;
+    uint16_t _tail;
+    uint16_t _pushed;
+    uint16_t _popped;
+    uint32_t _overflows;
+
+    void write(uint16_t position, const void *source, size_t length) {
+      size_t offset = position % Bytes;
+      size_t first = length < Bytes - offset ? length : Bytes - offset;
+      memcpy(_bytes + offset, source, first);
+      memcpy(_bytes, (const uint8_t*)source + first, length - first);
+    };
+
+    void read(uint16_t position, void *destination, size_t length) const {
+      size_t offset = position % Bytes;
+      size_t first = length < Bytes - offset ? length : Bytes - offset;
+      memcpy(destination, _bytes + offset, first);
+      memcpy((uint8_t*)destination + first, _bytes, length - first);
+    };
+
+  public:
+    NMEA2000FrameRing() : _head(0), _tail(0), _pushed(0), _popped(0), _overflows(0) {};
+
+    /**
+     * Copy a frame in the ring.
+     *
+     * Returns false if there is not enough room left (the frame is counted as
+     * an overflow) or if the frame is longer than MaxDataLength.
+     */
+    bool push(const NMEA2000Frame &frame) {
+      if (frame.length > NMEA2000Frame::MaxDataLength) {
+        return false;
+      }
+      uint16_t head = _head;
+      size_t length = HeaderLength + frame.length;
+      if ((size_t)(Bytes - (uint16_t)(head - _tail)) < length) {
+        _overflows++;
+        return false;
+      }
+
+      write(head, &frame, length);
+      _head = head + length;
+      _pushed++;
+      return true;
+    };
+
+    /**
+     * Move the oldest frame out of the ring.
+     *
+     * Returns false if the ring is empty.
+     */
+    bool pop(NMEA2000Frame &frame) {
+      uint16_t tail = _tail;
+      if (_head == tail) {
+        return false;
+      }
+      read(tail, &frame, HeaderLength);
+      read(tail + HeaderLength, frame.data, frame.length);
+      _tail = tail + HeaderLength + frame.length;
+      _popped++;
+      return true;
+    };
+
+    /**
+     * Number of frames waiting in the ring.
+     */
+    uint16_t size() const {
+      return _pushed - _popped;
+    };
+
+    /**
+     * Number of frames dropped because the ring was full.
+     */
+    uint32_t overflows() const {
+      return _overflows;
+    };
+};
@@ -0,0 +1,76 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "NMEA2000Ingress.h"
+#include "common/stats/KBoxMetrics.h"
+
+NMEA2000IngressLane NMEA2000Ingress::laneForPGN(uint32_t pgn) {
+  switch (pgn) {
+    case 127245: // Rudder
+    case 127250: // Vessel Heading
+    case 127251: // Rate of Turn
+    case 127257: // Attitude
+    case 129025: // Position, Rapid Update
+    case 129026: // COG & SOG, Rapid Update
+    case 130306: // Wind Data
+      return NMEA2000IngressLaneNavigation;
+    default:
+      return NMEA2000IngressLaneOther;
+  }
+}
+
+bool NMEA2000Ingress::push(const NMEA2000Frame &frame) {
+  if (laneForPGN(frame.pgn) == NMEA2000IngressLaneNavigation) {
+    if (!_navigation.push(frame)) {
+      KBoxMetrics.event(KBoxEventNMEA2000IngressNavigationOverflow);
+      return false;
+    }
+  }
+  else {
+    if (!_other.push(frame)) {
+      KBoxMetrics.event(KBoxEventNMEA2000IngressOtherOverflow);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NMEA2000Ingress::pop(NMEA2000Frame &frame) {
+  return _navigation.pop(frame) || _other.pop(frame);
+}
+
+uint16_t NMEA2000Ingress::size() const {
+  return _navigation.size() + _other.size();
+}
+
+uint32_t NMEA2000Ingress::overflows(NMEA2000IngressLane lane) const {
+  switch (lane) {
+    case NMEA2000IngressLaneNavigation:
+      return _navigation.overflows();
+    case NMEA2000IngressLaneOther:
+      return _other.overflows();
+    default:
+      return 0;
+  }
+}
@@ -0,0 +1,101 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "NMEA2000FrameRing.h"
+
+// Room reserved for the frames waiting to be processed. One frame messages
+// take 24 bytes so 1024 bytes hold ~40 navigation messages, about 20ms of
+// a bus at 100% load.
+#ifndef KBOX_N2K_INGRESS_NAVIGATION_BYTES
+#define KBOX_N2K_INGRESS_NAVIGATION_BYTES 1024
+#endif
+#ifndef KBOX_N2K_INGRESS_OTHER_BYTES
+#define KBOX_N2K_INGRESS_OTHER_BYTES 2048
+#endif
+// Frames buffered by the CAN driver under interrupt until loop() moves them
+// to the ingress. It must cover the longest stall of loop() (SD card sync,
+// screen repaint): 128 frames are ~60ms of a bus at 100% load. Frames lost
+// there can not be counted.
+#ifndef KBOX_N2K_INGRESS_CAN_FRAMES
+#define KBOX_N2K_INGRESS_CAN_FRAMES 128
+#endif
+
+enum NMEA2000IngressLane {
+  // High rate navigation data: heading, attitude, position, wind, ...
+  NMEA2000IngressLaneNavigation,
+  // Everything else
+  NMEA2000IngressLaneOther,
+
+  NMEA2000IngressLaneCount
+};
+
+/**
+ * Holds the NMEA2000 frames received from the bus until NMEA2000Service has
+ * time to repeat and decode them.
+ *
+ * The CAN driver buffers KBOX_N2K_INGRESS_CAN_FRAMES frames under interrupt;
+ * loop() moves them all to the ingress, which is then emptied of navigation
+ * frames first so that a burst of large messages (AIS, product
+ * information, ...) cannot delay or push out the heading and the position.
+ * Frames dropped because a lane is full are counted in KBoxMetrics.
+ */
+class NMEA2000Ingress {
+  private:
+    NMEA2000FrameRing<KBOX_N2K_INGRESS_NAVIGATION_BYTES> _navigation;
+    NMEA2000FrameRing<KBOX_N2K_INGRESS_OTHER_BYTES> _other;
+
+  public:
+    /**
+     * Lane used for frames of this PGN.
+     */
+    static NMEA2000IngressLane laneForPGN(uint32_t pgn);
+
+    /**
+     * Queue a frame in its lane.
+     *
+     * Returns false if the lane is full. The frame is then dropped and
+     * counted.
+     */
+    bool push(const NMEA2000Frame &frame);
+
+    /**
+     * Move the next frame to process out of the ingress: the oldest
+     * navigation frame if there is one, the oldest other frame otherwise.
+     *
+     * Returns false if there are no frames waiting.
+     */
+    bool pop(NMEA2000Frame &frame);
+
+    /**
+     * Number of frames waiting in all the lanes.
+     */
+    uint16_t size() const;
+
+    /**
+     * Number of frames dropped because their lane was full.
+     */
+    uint32_t overflows(NMEA2000IngressLane lane) const;
+};
@@ -0,0 +1,244 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <string.h>
+#include <Print.h>
+#include "NMEA2000LogFormat.h"
+
+static size_t writeVarint(uint8_t *buffer, size_t capacity, uint64_t value) {
+  size_t length = 0;
+  do {
+    if (length >= capacity) {
+      return 0;
+    }
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    buffer[length++] = value ? byte | 0x80 : byte;
+  } while (value);
+  return length;
+}
+
+/*
+ * Returns the number of bytes read, or 0 if the varint is not complete or
+ * longer than maxLength bytes (which is then stored in invalid).
+ */
+static size_t readVarint(const uint8_t *buffer, size_t available, size_t maxLength,
+                         uint64_t &value, bool &invalid) {
+  value = 0;
+  for (size_t i = 0; i < available; i++) {
+    if (i >= maxLength) {
+      invalid = true;
+      return 0;
+    }
+    value |= (uint64_t)(buffer[i] & 0x7f) << (7 * i);
+    if (!(buffer[i] & 0x80)) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+static uint32_t zigzag(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+size_t NMEA2000LogWriter::writeClock(uint8_t *buffer, size_t capacity, uint64_t wallClockMs,
+                                     uint32_t uptimeMs) {
+  if (capacity < 1) {
+    return 0;
+  }
+  buffer[0] = ClockMarker;
+  size_t length = 1;
+
+  size_t n = writeVarint(buffer + length, capacity - length, wallClockMs);
+  if (n == 0) {
+    return 0;
+  }
+  length += n;
+  n = writeVarint(buffer + length, capacity - length, uptimeMs);
+  if (n == 0) {
+    return 0;
+  }
+  length += n;
+
+  _lastTime = uptimeMs;
+  return length;
+}
+
+size_t NMEA2000LogWriter::writeMessage(uint8_t *buffer, size_t capacity, const NMEA2000Frame &frame) {
+  if (capacity < 1 || frame.length > NMEA2000Frame::MaxDataLength) {
+    return 0;
+  }
+  buffer[0] = MessageMarker;
+  size_t length = 1;
+
+  size_t n = writeVarint(buffer + length, capacity - length, zigzag((int32_t)(frame.timestamp - _lastTime)));
+  if (n == 0) {
+    return 0;
+  }
+  length += n;
+  n = writeVarint(buffer + length, capacity - length, frame.pgn);
+  if (n == 0) {
+    return 0;
+  }
+  length += n;
+  if (capacity - length < 3) {
+    return 0;
+  }
+  buffer[length++] = frame.priority;
+  buffer[length++] = frame.source;
+  buffer[length++] = frame.destination;
+  n = writeVarint(buffer + length, capacity - length, frame.length);
+  if (n == 0 || capacity - length - n < frame.length) {
+    return 0;
+  }
+  length += n;
+  memcpy(buffer + length, frame.data, frame.length);
+  length += frame.length;
+
+  _lastTime = frame.timestamp;
+  return length;
+}
+
+void NMEA2000LogSector::reset(uint32_t now) {
+  _length = 0;
+  _lastFlush = now;
+  _writer.reset();
+}
+
+template <typename F> bool NMEA2000LogSector::append(Print &output, uint32_t now, F writeRecord) {
+  size_t length = writeRecord(_buffer + _length, Size - _length);
+  if (length == 0) {
+    flush(output, now);
+    length = writeRecord(_buffer, Size);
+  }
+  _length += length;
+  return length > 0;
+}
+
+bool NMEA2000LogSector::appendClock(Print &output, uint64_t wallClockMs, uint32_t uptimeMs, uint32_t now) {
+  return append(output, now, [&](uint8_t *buffer, size_t capacity) {
+    return _writer.writeClock(buffer, capacity, wallClockMs, uptimeMs);
+  });
+}
+
+bool NMEA2000LogSector::appendMessage(Print &output, const NMEA2000Frame &frame, uint32_t now) {
+  return append(output, now, [&](uint8_t *buffer, size_t capacity) {
+    return _writer.writeMessage(buffer, capacity, frame);
+  });
+}
+
+void NMEA2000LogSector::poll(Print &output, uint32_t now) {
+  if (now - _lastFlush >= FlushInterval) {
+    flush(output, now);
+  }
+}
+
+void NMEA2000LogSector::flush(Print &output, uint32_t now) {
+  if (_length > 0) {
+    output.write(_buffer, _length);
+    _length = 0;
+  }
+  _lastFlush = now;
+}
+
+NMEA2000LogReader::Record NMEA2000LogReader::read(const uint8_t *buffer, size_t available, size_t &length,
+                                                  uint64_t &wallClockMs, uint32_t &uptimeMs,
+                                                  NMEA2000Frame &frame) {
+  if (available < 1) {
+    return Incomplete;
+  }
+  bool invalid = false;
+  uint64_t value;
+  size_t position = 1;
+  size_t n;
+
+  if (buffer[0] == NMEA2000LogWriter::ClockMarker) {
+    n = readVarint(buffer + position, available - position, 10, value, invalid);
+    if (n == 0) {
+      return invalid ? Invalid : Incomplete;
+    }
+    position += n;
+    wallClockMs = value;
+    n = readVarint(buffer + position, available - position, 5, value, invalid);
+    if (n == 0) {
+      return invalid ? Invalid : Incomplete;
+    }
+    position += n;
+    uptimeMs = value;
+
+    _lastTime = uptimeMs;
+    length = position;
+    return Clock;
+  }
+
+  if (buffer[0] != NMEA2000LogWriter::MessageMarker) {
+    return Invalid;
+  }
+
+  n = readVarint(buffer + position, available - position, 5, value, invalid);
+  if (n == 0) {
+    return invalid ? Invalid : Incomplete;
+  }
+  position += n;
+  uint32_t timestamp = _lastTime + unzigzag(value);
+
+  n = readVarint(buffer + position, available - position, 5, value, invalid);
+  if (n == 0) {
+    return invalid ? Invalid : Incomplete;
+  }
+  position += n;
+  frame.pgn = value;
+
+  if (available - position < 3) {
+    return Incomplete;
+  }
+  frame.priority = buffer[position++];
+  frame.source = buffer[position++];
+  frame.destination = buffer[position++];
+
+  n = readVarint(buffer + position, available - position, 2, value, invalid);
+  if (n == 0) {
+    return invalid ? Invalid : Incomplete;
+  }
+  position += n;
+  if (value > NMEA2000Frame::MaxDataLength) {
+    return Invalid;
+  }
+  if (available - position < value) {
+    return Incomplete;
+  }
+  frame.length = value;
+  memcpy(frame.data, buffer + position, frame.length);
+  position += frame.length;
+
+  frame.timestamp = timestamp;
+  _lastTime = timestamp;
+  length = position;
+  return Message;
+}
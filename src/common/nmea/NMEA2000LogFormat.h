@@ -0,0 +1,173 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "NMEA2000Frame.h"
+
+class Print;
+
+/**
+ * Compact binary records of NMEA2000 messages, written in the SD card log
+ * between the text lines instead of $PCDIN sentences.
+ *
+ * Text lines always start with a digit (their timestamp) so records start
+ * with a byte that is not printable:
+ *
+ *  - Message: 0xB2, time since the previous message in ms (signed varint),
+ *    PGN (varint), priority, source, destination, length (varint), data.
+ *  - Clock: 0xB3, wall clock time in ms (varint), millis() at that time
+ *    (varint). Gives the wall clock time of the messages that follow and
+ *    the time base of the next message.
+ *
+ * Varints are unsigned LEB128, signed values are zigzag encoded first. A
+ * single frame message takes 17 or 18 bytes instead of about 65 for
+ * its text line. tools/log-converter/kbox-log-to-text.py converts the
+ * records back to text.
+ */
+class NMEA2000LogWriter {
+  public:
+    static const uint8_t MessageMarker = 0xB2;
+    static const uint8_t ClockMarker = 0xB3;
+
+    /** Longest record: a clock with two maximal varints. */
+    static const size_t MaxClockLength = 1 + 10 + 5;
+    /** Longest record: a fast packet message of 223 bytes. */
+    static const size_t MaxMessageLength = 1 + 5 + 5 + 3 + 2 + NMEA2000Frame::MaxDataLength;
+
+  private:
+    uint32_t _lastTime;
+
+  public:
+    NMEA2000LogWriter() : _lastTime(0) {};
+
+    /**
+     * Forget the time of the last message. Call this when starting a new
+     * file, before writing the first clock record.
+     */
+    void reset() {
+      _lastTime = 0;
+    };
+
+    /**
+     * Writes a clock record in buffer.
+     *
+     * @return the length of the record or 0 if it did not fit.
+     */
+    size_t writeClock(uint8_t *buffer, size_t capacity, uint64_t wallClockMs, uint32_t uptimeMs);
+
+    /**
+     * Writes a message record in buffer.
+     *
+     * @return the length of the record or 0 if it did not fit.
+     */
+    size_t writeMessage(uint8_t *buffer, size_t capacity, const NMEA2000Frame &frame);
+};
+
+/**
+ * Collects the records of NMEA2000LogWriter in a buffer of one SD card sector
+ * so that a busy bus is written to the file one full sector at a time. A
+ * partial sector is only written by poll() once it has waited FlushInterval,
+ * or by flush() before the file is closed.
+ */
+class NMEA2000LogSector {
+  public:
+    static const size_t Size = 512;
+    static const uint32_t FlushInterval = 1000;
+
+  private:
+    uint8_t _buffer[Size];
+    size_t _length;
+    uint32_t _lastFlush;
+    NMEA2000LogWriter _writer;
+
+    template <typename F> bool append(Print &output, uint32_t now, F writeRecord);
+
+  public:
+    NMEA2000LogSector() : _length(0), _lastFlush(0) {};
+
+    /**
+     * Drop the records not written yet and start over for a new file.
+     */
+    void reset(uint32_t now);
+
+    /**
+     * Add a record to the sector. When the sector is full, it is written to
+     * output first.
+     *
+     * @return false if the record could not be added.
+     */
+    bool appendClock(Print &output, uint64_t wallClockMs, uint32_t uptimeMs, uint32_t now);
+    bool appendMessage(Print &output, const NMEA2000Frame &frame, uint32_t now);
+
+    /**
+     * Write the sector to output if it has waited FlushInterval.
+     */
+    void poll(Print &output, uint32_t now);
+
+    /**
+     * Write the sector to output now.
+     */
+    void flush(Print &output, uint32_t now);
+
+    size_t length() const {
+      return _length;
+    };
+};
+
+/**
+ * Reads the records written by NMEA2000LogWriter.
+ */
+class NMEA2000LogReader {
+  public:
+    enum Record {
+      // Not enough bytes for a complete record
+      Incomplete,
+      // The bytes are not a record
+      Invalid,
+      Clock,
+      Message
+    };
+
+  private:
+    uint32_t _lastTime;
+
+  public:
+    NMEA2000LogReader() : _lastTime(0) {};
+
+    void reset() {
+      _lastTime = 0;
+    };
+
+    /**
+     * Reads the record at the beginning of buffer. A clock record is
+     * returned in wallClockMs and uptimeMs, a message in frame.
+     *
+     * @param length where the length of the record is stored.
+     */
+    Record read(const uint8_t *buffer, size_t available, size_t &length,
+                uint64_t &wallClockMs, uint32_t &uptimeMs, NMEA2000Frame &frame);
+};
@@ -0,0 +1,320 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include <N2kMsg.h>
+#include <string.h>
+#include "NMEA2000OutputScheduler.h"
+
+// NMEA2000 runs at 250kbit/s. Budgets are counted in hundredths of bit,
+// which is 250 * 100 per millisecond for the whole bus.
+static const uint32_t BusBitsPerSecond = 250000;
+
+// Never let the budget grow above what the longest fast packet (32 frames)
+// needs so that a quiet period does not allow a long burst afterwards.
+static const uint32_t MaxCredit = 32 * 160 * 100;
+
+// Messages of PGNs that are not listed here can be sent every 100ms.
+static const uint16_t DefaultInterval = 100;
+
+// Standard transmission intervals in milliseconds, from the NMEA2000
+// appendix B.
+static const struct {
+  uint32_t pgn;
+  uint16_t interval;
+} standardIntervals[] = {
+  { 127245, 100 },  // Rudder
+  { 127250, 100 },  // Vessel Heading
+  { 127251, 100 },  // Rate of Turn
+  { 127257, 1000 }, // Attitude
+  { 127488, 100 },  // Engine Parameters, Rapid Update
+  { 127508, 1500 }, // Battery Status
+  { 128259, 1000 }, // Speed, Water referenced
+  { 128267, 1000 }, // Water Depth
+  { 129025, 100 },  // Position, Rapid Update
+  { 129026, 250 },  // COG & SOG, Rapid Update
+  { 130306, 100 },  // Wind Data
+  { 130310, 500 },  // Environmental Parameters
+  { 130311, 500 },  // Environmental Parameters
+  { 130312, 2000 }, // Temperature
+  { 130314, 2000 }, // Actual Pressure
+  { 130316, 2000 }  // Temperature, Extended Range
+};
+
+static uint16_t fieldIsSet(const tN2kMsg &msg, int index) {
+  if (index + 1 >= msg.DataLen) {
+    return 0;
+  }
+  return msg.Data[index] != 0xff || msg.Data[index + 1] != 0xff ? 1 : 0;
+}
+
+/*
+ * Tells apart the messages of one PGN that carry different values and must not
+ * replace each other.
+ */
+static uint16_t messageKey(const tN2kMsg &msg) {
+  switch (msg.PGN) {
+    case 127245: // Rudder instance
+    case 127488: // Engine instance
+    case 127508: // Battery instance
+      return msg.DataLen > 0 ? msg.Data[0] : 0;
+    case 127250: // Heading reference
+      return msg.DataLen > 7 ? msg.Data[7] & 0x03 : 0;
+    case 129026: // COG reference
+      return msg.DataLen > 1 ? msg.Data[1] & 0x03 : 0;
+    case 130306: // Wind reference
+      return msg.DataLen > 5 ? msg.Data[5] & 0x07 : 0;
+    case 130310:
+      // Temperatures and pressure are sometimes sent in separate messages.
+      return fieldIsSet(msg, 1) | fieldIsSet(msg, 3) << 1 | fieldIsSet(msg, 5) << 2;
+    case 130312: // Instance and source
+    case 130314:
+    case 130316:
+      return msg.DataLen > 2 ? msg.Data[1] | msg.Data[2] << 8 : 0;
+    default:
+      return 0;
+  }
+}
+
+NMEA2000OutputScheduler::NMEA2000OutputScheduler(const NMEA2000OutputSchedulerConfig &config,
+                                                 SKNMEA2000Output &bus) :
+  _config(config), _bus(bus), _credit(MaxCredit), _creditTime(0),
+  _windowStart(0), _windowBits(0), _lastWindowBits(0) {
+  for (int i = 0; i < MaxMessages; i++) {
+    _slots[i].used = false;
+    _slots[i].pending = false;
+  }
+}
+
+uint32_t NMEA2000OutputScheduler::messageBits(size_t length) {
+  return NMEA2000Frame::busBits(length);
+}
+
+uint16_t NMEA2000OutputScheduler::minInterval(uint32_t pgn) const {
+  for (int i = 0; i < NMEA2000OutputSchedulerConfig::MaxPGNs; i++) {
+    if (_config.pgns[i].pgn == pgn) {
+      return _config.pgns[i].maxRate > 0 ? 1000 / _config.pgns[i].maxRate : 0;
+    }
+  }
+  for (size_t i = 0; i < sizeof(standardIntervals) / sizeof(standardIntervals[0]); i++) {
+    if (standardIntervals[i].pgn == pgn) {
+      return standardIntervals[i].interval;
+    }
+  }
+  return DefaultInterval;
+}
+
+/*
+ * Finds a slot for a new value: a free slot, or the one that was sent the
+ * longest time ago. When all the slots are waiting, the oldest message with
+ * the lowest priority (highest number) is dropped if it is less important
+ * than the new one.
+ */
+NMEA2000OutputScheduler::Slot* NMEA2000OutputScheduler::allocate(uint8_t priority) {
+  Slot *idle = nullptr;
+  Slot *victim = nullptr;
+
+  for (int i = 0; i < MaxMessages; i++) {
+    Slot &slot = _slots[i];
+    if (!slot.used) {
+      return &slot;
+    }
+    if (!slot.pending) {
+      if (!idle || (int32_t)(slot.sentTime - idle->sentTime) < 0) {
+        idle = &slot;
+      }
+    }
+    else if (!victim || slot.priority > victim->priority
+             || (slot.priority == victim->priority && (int32_t)(slot.queuedTime - victim->queuedTime) < 0)) {
+      victim = &slot;
+    }
+  }
+
+  if (idle) {
+    return idle;
+  }
+  if (victim->priority > priority) {
+    KBoxMetrics.event(KBoxEventNMEA2000TXDropped);
+    return victim;
+  }
+  return nullptr;
+}
+
+bool NMEA2000OutputScheduler::enqueue(const tN2kMsg &msg, uint32_t now) {
+  if (msg.DataLen < 0 || (size_t)msg.DataLen > MaxDataLength) {
+    // Fast packets are not held, but they still need room on the bus.
+    if (msg.DataLen > 0 && spend(messageBits(msg.DataLen), now)) {
+      return _bus.write(msg);
+    }
+    KBoxMetrics.event(KBoxEventNMEA2000TXDropped);
+    return false;
+  }
+
+  uint16_t key = messageKey(msg);
+  Slot *slot = nullptr;
+  for (int i = 0; i < MaxMessages; i++) {
+    if (_slots[i].used && _slots[i].pgn == msg.PGN && _slots[i].key == key) {
+      slot = &_slots[i];
+      break;
+    }
+  }
+
+  if (slot) {
+    if (slot->pending) {
+      // The new message replaces the old one and keeps its place in line.
+      KBoxMetrics.event(KBoxEventNMEA2000TXCoalesced);
+    }
+    else {
+      slot->pending = true;
+      slot->queuedTime = now;
+    }
+  }
+  else {
+    slot = allocate(msg.Priority);
+    if (!slot) {
+      KBoxMetrics.event(KBoxEventNMEA2000TXDropped);
+      return false;
+    }
+    slot->used = true;
+    slot->pending = true;
+    slot->sent = false;
+    slot->pgn = msg.PGN;
+    slot->key = key;
+    slot->minInterval = minInterval(msg.PGN);
+    slot->queuedTime = now;
+  }
+
+  slot->priority = msg.Priority;
+  slot->source = msg.Source;
+  slot->destination = msg.Destination;
+  slot->length = msg.DataLen;
+  memcpy(slot->data, msg.Data, msg.DataLen);
+  return true;
+}
+
+bool NMEA2000OutputScheduler::write(const tN2kMsg &msg) {
+  return enqueue(msg, millis());
+}
+
+/*
+ * The waiting message with the lowest priority number that is not held back
+ * by its maximum rate. The oldest one goes first when priorities are equal.
+ */
+NMEA2000OutputScheduler::Slot* NMEA2000OutputScheduler::next(uint32_t now) {
+  Slot *best = nullptr;
+
+  for (int i = 0; i < MaxMessages; i++) {
+    Slot &slot = _slots[i];
+    if (!slot.pending || (slot.sent && now - slot.sentTime < slot.minInterval)) {
+      continue;
+    }
+    if (!best || slot.priority < best->priority
+        || (slot.priority == best->priority && (int32_t)(slot.queuedTime - best->queuedTime) < 0)) {
+      best = &slot;
+    }
+  }
+  return best;
+}
+
+void NMEA2000OutputScheduler::refillCredit(uint32_t now) {
+  uint32_t elapsed = now - _creditTime;
+  _creditTime = now;
+  if (elapsed > 1000) {
+    elapsed = 1000;
+  }
+  _credit += elapsed * (BusBitsPerSecond / 1000) * _config.maxBusLoad;
+  if (_credit > MaxCredit) {
+    _credit = MaxCredit;
+  }
+
+  if (now - _windowStart >= 1000) {
+    // Nothing was sent during the last second if it ended long ago.
+    _lastWindowBits = now - _windowStart < 2000 ? _windowBits : 0;
+    _windowBits = 0;
+    _windowStart = now;
+  }
+}
+
+/*
+ * Takes the bits needed by a message out of the budget. Returns false if
+ * there is not enough left.
+ */
+bool NMEA2000OutputScheduler::spend(uint32_t bits, uint32_t now) {
+  refillCredit(now);
+  if (_config.maxBusLoad > 0) {
+    if (bits * 100 > _credit) {
+      return false;
+    }
+    _credit -= bits * 100;
+  }
+  _windowBits += bits;
+  return true;
+}
+
+int NMEA2000OutputScheduler::flush(uint32_t now) {
+  refillCredit(now);
+
+  int sent = 0;
+  Slot *slot;
+  tN2kMsg msg;
+  while ((slot = next(now)) != nullptr) {
+    uint32_t bits = messageBits(slot->length);
+    if (_config.maxBusLoad > 0 && bits * 100 > _credit) {
+      break;
+    }
+
+    msg.Clear();
+    msg.SetPGN(slot->pgn);
+    msg.Priority = slot->priority;
+    msg.Source = slot->source;
+    msg.Destination = slot->destination;
+    msg.DataLen = slot->length;
+    memcpy(msg.Data, slot->data, slot->length);
+    if (!_bus.write(msg)) {
+      // The transmit buffers are full: try again on the next flush.
+      break;
+    }
+    spend(bits, now);
+
+    slot->pending = false;
+    slot->sent = true;
+    slot->sentTime = now;
+    sent++;
+  }
+  return sent;
+}
+
+int NMEA2000OutputScheduler::pending() const {
+  int count = 0;
+  for (int i = 0; i < MaxMessages; i++) {
+    if (_slots[i].pending) {
+      count++;
+    }
+  }
+  return count;
+}
+
+uint8_t NMEA2000OutputScheduler::busLoad() const {
+  return _lastWindowBits * 100 / BusBitsPerSecond;
+}
@@ -0,0 +1,134 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common/signalk/SKNMEA2000Output.h"
+#include "common/stats/KBoxMetrics.h"
+#include "NMEA2000Frame.h"
+#include "NMEA2000OutputSchedulerConfig.h"
+
+/**
+ * Schedules the messages that KBox sends on the NMEA2000 bus.
+ *
+ * Messages written to the scheduler are held until flush() and sent no more
+ * often than the standard transmission interval of their PGN (or the rate
+ * configured for it). Only the last message of each value is kept: a new one
+ * replaces (coalesces) the one waiting to be sent. Values are told apart by
+ * their PGN and by the field that identifies them (battery instance, wind
+ * reference, pressure source, ...).
+ *
+ * The number of bits sent is estimated for each message so that KBox never
+ * uses more than maxBusLoad percent of the bus. Messages longer than one
+ * CAN frame (fast packets) are not held but still count in that budget.
+ */
+class NMEA2000OutputScheduler : public SKNMEA2000Output {
+  public:
+    /**
+     * Number of different values that can be waiting at the same time.
+     */
+    static const int MaxMessages = 16;
+
+    /**
+     * Longest message that can wait in the scheduler: one CAN frame.
+     */
+    static const size_t MaxDataLength = 8;
+
+  private:
+    struct Slot {
+      bool used;
+      bool pending;
+      bool sent;
+      uint8_t priority;
+      uint8_t source;
+      uint8_t destination;
+      uint8_t length;
+      uint16_t key;
+      uint16_t minInterval;
+      uint32_t pgn;
+      uint32_t queuedTime;
+      uint32_t sentTime;
+      uint8_t data[MaxDataLength];
+    };
+
+    const NMEA2000OutputSchedulerConfig &_config;
+    SKNMEA2000Output &_bus;
+    Slot _slots[MaxMessages];
+    // Bits that can be sent, in hundredths of bit
+    uint32_t _credit;
+    uint32_t _creditTime;
+    // Bits sent during the current and the last complete second
+    uint32_t _windowStart;
+    uint32_t _windowBits;
+    uint32_t _lastWindowBits;
+
+    uint16_t minInterval(uint32_t pgn) const;
+    Slot* allocate(uint8_t priority);
+    Slot* next(uint32_t now);
+    void refillCredit(uint32_t now);
+    bool spend(uint32_t bits, uint32_t now);
+
+  public:
+    NMEA2000OutputScheduler(const NMEA2000OutputSchedulerConfig &config, SKNMEA2000Output &bus);
+
+    /**
+     * Estimated number of bits needed to send a message with this number of
+     * bytes of data on the bus, including the frame overhead.
+     */
+    static uint32_t messageBits(size_t length);
+
+    /**
+     * Queues a message created at time now (in milliseconds).
+     *
+     * @return false if the message was dropped.
+     */
+    bool enqueue(const tN2kMsg &msg, uint32_t now);
+
+    /**
+     * SKNMEA2000Output: queues a message created now.
+     */
+    bool write(const tN2kMsg &msg) override;
+
+    /**
+     * Sends the waiting messages to the bus, most important (lowest NMEA2000
+     * priority) first, as long as their maximum rate and the bus budget
+     * allow it. Messages that the bus refuses stay queued.
+     *
+     * @return the number of messages sent.
+     */
+    int flush(uint32_t now);
+
+    /**
+     * Number of messages waiting to be sent.
+     */
+    int pending() const;
+
+    /**
+     * Estimated share of the bus (in percent) used by KBox during the last
+     * complete second.
+     */
+    uint8_t busLoad() const;
+};
@@ -0,0 +1,51 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Maximum rate of one PGN sent on the NMEA2000 bus.
+ */
+struct NMEA2000OutputPGNConfig {
+  uint32_t pgn;
+  // Maximum number of messages per second for each value (0 means no limit).
+  uint8_t maxRate;
+};
+
+/**
+ * Configuration for an instance of NMEA2000OutputScheduler.
+ */
+struct NMEA2000OutputSchedulerConfig {
+  static const int MaxPGNs = 8;
+
+  // Maximum share of the bus (in percent) used by the messages sent by KBox
+  // (0 means no limit).
+  uint8_t maxBusLoad = 20;
+
+  // PGNs with a maximum rate different from their standard transmission
+  // interval. Unused entries have a pgn of 0.
+  NMEA2000OutputPGNConfig pgns[MaxPGNs] = {};
+};
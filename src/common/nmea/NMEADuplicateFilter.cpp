@@ -0,0 +1,59 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "NMEADuplicateFilter.h"
+
+NMEADuplicateFilter::NMEADuplicateFilter(uint32_t window) : _size(0), _next(0), _window(window) {
+}
+
+bool NMEADuplicateFilter::isDuplicate(uint8_t input, const char *sentence, size_t length, uint32_t now) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ (uint8_t)sentence[i]) * 16777619u;
+  }
+
+  for (int i = 0; i < _size; i++) {
+    Entry &entry = _entries[i];
+    if (entry.hash != hash || now - entry.received >= _window) {
+      continue;
+    }
+    if (entry.input != input) {
+      return true;
+    }
+    // Repeated on the same input: this is new data, just remember it longer.
+    entry.received = now;
+    return false;
+  }
+
+  // The oldest entry is replaced when the table is full.
+  _entries[_next].hash = hash;
+  _entries[_next].received = now;
+  _entries[_next].input = input;
+  _next = (_next + 1) % Capacity;
+  if (_size < Capacity) {
+    _size++;
+  }
+  return false;
+}
@@ -0,0 +1,65 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Recognizes sentences that were just received, identical, on another input.
+ *
+ * When the same instrument is wired to both NMEA ports, each sentence comes
+ * in twice within a few milliseconds. Only the first copy needs to be
+ * repeated and parsed.
+ */
+class NMEADuplicateFilter {
+  public:
+    static const int Capacity = 16;
+
+  private:
+    struct Entry {
+      uint32_t hash;
+      uint32_t received;
+      uint8_t input;
+    };
+
+    Entry _entries[Capacity];
+    int _size;
+    int _next;
+    uint32_t _window;
+
+  public:
+    /**
+     * @param window how long (in milliseconds) a sentence is remembered.
+     */
+    NMEADuplicateFilter(uint32_t window = 500);
+
+    /**
+     * Returns true if the same sentence was received on another input less
+     * than `window` milliseconds before now. Otherwise the sentence is
+     * remembered and false is returned.
+     */
+    bool isDuplicate(uint8_t input, const char *sentence, size_t length, uint32_t now);
+};
@@ -0,0 +1,95 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "NMEAEncodedMessage.h"
+
+NMEAEncodedMessage::NMEAEncodedMessage(const NMEAEncodedMessage &other) : _buffer(other._buffer) {
+  if (_buffer) {
+    _buffer->references++;
+  }
+}
+
+NMEAEncodedMessage& NMEAEncodedMessage::operator=(const NMEAEncodedMessage &other) {
+  // other can be this message.
+  Buffer *buffer = other._buffer;
+  if (buffer) {
+    buffer->references++;
+  }
+  release();
+  _buffer = buffer;
+  return *this;
+}
+
+NMEAEncodedMessage::~NMEAEncodedMessage() {
+  release();
+}
+
+void NMEAEncodedMessage::release() {
+  if (_buffer && --_buffer->references == 0) {
+    free(_buffer);
+  }
+  _buffer = nullptr;
+}
+
+NMEAEncodedMessage NMEAEncodedMessage::allocate(Type type, size_t capacity) {
+  NMEAEncodedMessage message;
+
+  if (capacity > UINT16_MAX - 3) {
+    return message;
+  }
+  void *memory = malloc(sizeof(Buffer) + 2 + capacity + 1);
+  if (!memory) {
+    return message;
+  }
+
+  message._buffer = static_cast<Buffer*>(memory);
+  message._buffer->references = 1;
+  message._buffer->capacity = capacity;
+  message._buffer->type = type;
+
+  uint8_t *bytes = message.kommandBytes();
+  bytes[0] = KommandNMEASentence & 0xff;
+  bytes[1] = (KommandNMEASentence >> 8) & 0xff;
+  message.setLength(0);
+  return message;
+}
+
+NMEAEncodedMessage NMEAEncodedMessage::fromSentence(const char *sentence, size_t length) {
+  NMEAEncodedMessage message = allocate(NMEA0183, length);
+  if (message.isValid()) {
+    memcpy(message.getBuffer(), sentence, length);
+    message.setLength(length);
+  }
+  return message;
+}
+
+void NMEAEncodedMessage::setLength(size_t length) {
+  if (length > _buffer->capacity) {
+    length = _buffer->capacity;
+  }
+  _buffer->length = length;
+  getBuffer()[length] = '\0';
+}
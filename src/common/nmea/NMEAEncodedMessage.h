@@ -0,0 +1,146 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common/comms/Kommand.h"
+
+/**
+ * A message received on one of the NMEA inputs, encoded once for all the
+ * outputs that repeat it: a NMEA0183 sentence, or a NMEA2000 message
+ * converted to a PCDIN sentence.
+ *
+ * The text is stored inside a complete KommandNMEASentence so that it can be
+ * sent to the WiFi module as-is. Copies of a NMEAEncodedMessage share the
+ * same buffer, which is freed when the last copy is destroyed.
+ */
+class NMEAEncodedMessage : public Kommand {
+  public:
+    enum Type : uint8_t {
+      NMEA0183,
+      NMEA2000
+    };
+
+  private:
+    // Followed in memory by the Kommand: identifier, text and '\0'.
+    struct Buffer {
+      uint16_t references;
+      uint16_t capacity;
+      uint16_t length;
+      Type type;
+    };
+
+    Buffer *_buffer;
+
+    uint8_t* kommandBytes() const {
+      return reinterpret_cast<uint8_t*>(_buffer + 1);
+    };
+
+    void release();
+
+  public:
+    /**
+     * Creates an invalid message.
+     */
+    NMEAEncodedMessage() : _buffer(nullptr) {};
+    NMEAEncodedMessage(const NMEAEncodedMessage &other);
+    NMEAEncodedMessage& operator=(const NMEAEncodedMessage &other);
+    virtual ~NMEAEncodedMessage();
+
+    /**
+     * Allocates a message for a text of at most capacity characters. The text
+     * is written with getBuffer() and setLength().
+     *
+     * The message is invalid if memory could not be allocated.
+     */
+    static NMEAEncodedMessage allocate(Type type, size_t capacity);
+
+    /**
+     * Copies a NMEA0183 sentence (without its <CR><LF>).
+     */
+    static NMEAEncodedMessage fromSentence(const char *sentence, size_t length);
+
+    bool isValid() const {
+      return _buffer != nullptr;
+    };
+
+    Type getType() const {
+      return _buffer->type;
+    };
+
+    /**
+     * Buffer of capacity() + 1 bytes where the text can be written.
+     */
+    char* getBuffer() {
+      return reinterpret_cast<char*>(kommandBytes() + 2);
+    };
+
+    size_t capacity() const {
+      return _buffer->capacity;
+    };
+
+    /**
+     * Sets the length of the text written in getBuffer() (at most capacity()).
+     */
+    void setLength(size_t length);
+
+    const char* c_str() const {
+      return reinterpret_cast<const char*>(kommandBytes() + 2);
+    };
+
+    size_t length() const {
+      return _buffer->length;
+    };
+
+    /**
+     * Number of copies sharing this message.
+     */
+    int references() const {
+      return _buffer ? _buffer->references : 0;
+    };
+
+    const uint8_t* getBytes() const override {
+      return kommandBytes();
+    };
+
+    const size_t getSize() const override {
+      return 2 + _buffer->length + 1;
+    };
+};
+
+/**
+ * An output that repeats the messages received on the NMEA inputs.
+ */
+class NMEARepeater {
+  public:
+    virtual ~NMEARepeater() {};
+
+    /**
+     * Repeats a message. Outputs that need the message after returning keep a
+     * copy of it, which does not copy the text.
+     */
+    virtual void repeat(const NMEAEncodedMessage &message) = 0;
+};
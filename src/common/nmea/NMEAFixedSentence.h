@@ -0,0 +1,101 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <WString.h>
+
+/**
+ * A NMEA sentence stored in a fixed size buffer.
+ *
+ * The NMEA standard limits sentences to 82 characters including the final
+ * <CR><LF>. The buffer holds the sentence without its line terminator and a
+ * terminating null character so it never needs dynamic memory.
+ */
+class NMEAFixedSentence {
+  public:
+    static const size_t Capacity = 83;
+
+  private:
+    char _data[Capacity];
+    uint8_t _length;
+
+  public:
+    NMEAFixedSentence() : _length(0) {
+      _data[0] = '\0';
+    };
+
+    const char* c_str() const {
+      return _data;
+    };
+
+    size_t length() const {
+      return _length;
+    };
+
+    /**
+     * Number of characters that can still be appended.
+     */
+    size_t available() const {
+      return Capacity - 1 - _length;
+    };
+
+    void clear() {
+      _length = 0;
+      _data[0] = '\0';
+    };
+
+    /**
+     * Appends length bytes of data. Returns false and leaves the sentence
+     * untouched if they do not fit.
+     */
+    bool append(const char *data, size_t length) {
+      if (length > available()) {
+        return false;
+      }
+      memcpy(_data + _length, data, length);
+      _length += length;
+      _data[_length] = '\0';
+      return true;
+    };
+
+    bool append(char c) {
+      return append(&c, 1);
+    };
+
+    String toString() const {
+      return String(_data);
+    };
+
+    bool operator==(const char *s) const {
+      return strcmp(_data, s) == 0;
+    };
+
+    bool operator!=(const char *s) const {
+      return !(*this == s);
+    };
+};
@@ -0,0 +1,269 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <Print.h>
+#include <string.h>
+#include "NMEAOutputScheduler.h"
+
+// Never let the baud rate budget grow above two full sentences so that a
+// quiet period does not allow a long burst afterwards.
+static const uint32_t MaxCredit = 2 * (NMEAFixedSentence::Capacity + 1) * 1000;
+
+// Sentences that carry different values of the same type: the given field
+// is added to their key so that they do not replace each other.
+static const struct {
+  const char *code;
+  int field;
+} keyFields[] = {
+  { "MWV", 2 },
+  { "XDR", 4 }
+};
+
+/*
+ * Builds the key of a sentence: its address, followed by the value of its key
+ * field if it has one. Returns false if this is not a NMEA sentence.
+ */
+static bool sentenceKey(const char *sentence, size_t length, char *key, size_t size) {
+  if (length < 2 || (sentence[0] != '$' && sentence[0] != '!')) {
+    return false;
+  }
+
+  size_t keyLength = 0;
+  size_t i = 1;
+  while (i < length && sentence[i] != ',' && sentence[i] != '*' && keyLength < size - 1) {
+    key[keyLength++] = sentence[i++];
+  }
+  key[keyLength] = '\0';
+  if (keyLength != 5) {
+    return true;
+  }
+
+  for (size_t k = 0; k < sizeof(keyFields) / sizeof(keyFields[0]); k++) {
+    if (strcmp(key + 2, keyFields[k].code) != 0) {
+      continue;
+    }
+    // Skip to the beginning of the key field
+    int field = 0;
+    for (i = 0; i < length && field < keyFields[k].field; i++) {
+      if (sentence[i] == ',') {
+        field++;
+      }
+    }
+    key[keyLength++] = ',';
+    while (i < length && sentence[i] != ',' && sentence[i] != '*' && keyLength < size - 1) {
+      key[keyLength++] = sentence[i++];
+    }
+    key[keyLength] = '\0';
+    break;
+  }
+  return true;
+}
+
+// A byte is sent with one start bit, 8 bits of data and one stop bit.
+NMEAOutputScheduler::NMEAOutputScheduler(const NMEAOutputSchedulerConfig &config, uint32_t baudRate,
+                                         enum KBoxEvent sentEvent, enum KBoxEvent droppedEvent,
+                                         enum KBoxEvent coalescedEvent) :
+  _config(config), _bytesPerSecond(baudRate / 10), _credit(MaxCredit), _creditTime(0),
+  _sentEvent(sentEvent), _droppedEvent(droppedEvent), _coalescedEvent(coalescedEvent) {
+  for (int i = 0; i < MaxSentences; i++) {
+    _slots[i].used = false;
+    _slots[i].pending = false;
+  }
+}
+
+const NMEAOutputSentenceConfig& NMEAOutputScheduler::sentenceConfig(const char *key) const {
+  if (strlen(key) >= 5) {
+    const char *code = key + 2;
+    if (strncmp(code, "DBT", 3) == 0) {
+      return _config.dbt;
+    }
+    if (strncmp(code, "DPT", 3) == 0) {
+      return _config.dpt;
+    }
+    if (strncmp(code, "HDM", 3) == 0) {
+      return _config.hdm;
+    }
+    if (strncmp(code, "MWV", 3) == 0) {
+      return _config.mwv;
+    }
+    if (strncmp(code, "RSA", 3) == 0) {
+      return _config.rsa;
+    }
+    if (strncmp(code, "XDR", 3) == 0) {
+      return _config.xdr;
+    }
+  }
+  return _config.other;
+}
+
+/*
+ * Finds a slot for a new type of sentence: a free slot, or the one that was
+ * sent the longest time ago. When all the slots are waiting, the oldest
+ * sentence with the lowest priority is dropped if it is less important than
+ * the new one.
+ */
+NMEAOutputScheduler::Slot* NMEAOutputScheduler::allocate(uint8_t priority) {
+  Slot *idle = nullptr;
+  Slot *victim = nullptr;
+
+  for (int i = 0; i < MaxSentences; i++) {
+    Slot &slot = _slots[i];
+    if (!slot.used) {
+      return &slot;
+    }
+    if (!slot.pending) {
+      if (!idle || (int32_t)(slot.sentTime - idle->sentTime) < 0) {
+        idle = &slot;
+      }
+    }
+    else if (!victim || slot.priority < victim->priority
+             || (slot.priority == victim->priority && (int32_t)(slot.queuedTime - victim->queuedTime) < 0)) {
+      victim = &slot;
+    }
+  }
+
+  if (idle) {
+    return idle;
+  }
+  if (victim->priority < priority) {
+    KBoxMetrics.event(_droppedEvent);
+    return victim;
+  }
+  return nullptr;
+}
+
+bool NMEAOutputScheduler::enqueue(const char *sentence, size_t length, uint32_t now) {
+  char key[sizeof(Slot::key)];
+  if (length >= NMEAFixedSentence::Capacity || !sentenceKey(sentence, length, key, sizeof(key))) {
+    KBoxMetrics.event(_droppedEvent);
+    return false;
+  }
+
+  Slot *slot = nullptr;
+  for (int i = 0; i < MaxSentences; i++) {
+    if (_slots[i].used && strcmp(_slots[i].key, key) == 0) {
+      slot = &_slots[i];
+      break;
+    }
+  }
+
+  if (slot) {
+    if (slot->pending) {
+      // The new sentence replaces the old one and keeps its place in line.
+      KBoxMetrics.event(_coalescedEvent);
+    }
+    else {
+      slot->pending = true;
+      slot->queuedTime = now;
+    }
+  }
+  else {
+    const NMEAOutputSentenceConfig &config = sentenceConfig(key);
+    slot = allocate(config.priority);
+    if (!slot) {
+      KBoxMetrics.event(_droppedEvent);
+      return false;
+    }
+    slot->used = true;
+    slot->pending = true;
+    slot->sent = false;
+    slot->priority = config.priority;
+    slot->minInterval = config.maxRate > 0 ? 1000 / config.maxRate : 0;
+    slot->queuedTime = now;
+    strcpy(slot->key, key);
+  }
+
+  slot->sentence.clear();
+  slot->sentence.append(sentence, length);
+  return true;
+}
+
+/*
+ * The waiting sentence with the highest priority that is not held back by its
+ * maximum rate. The oldest one goes first when priorities are equal.
+ */
+NMEAOutputScheduler::Slot* NMEAOutputScheduler::next(uint32_t now) {
+  Slot *best = nullptr;
+
+  for (int i = 0; i < MaxSentences; i++) {
+    Slot &slot = _slots[i];
+    if (!slot.pending || (slot.sent && now - slot.sentTime < slot.minInterval)) {
+      continue;
+    }
+    if (!best || slot.priority > best->priority
+        || (slot.priority == best->priority && (int32_t)(slot.queuedTime - best->queuedTime) < 0)) {
+      best = &slot;
+    }
+  }
+  return best;
+}
+
+void NMEAOutputScheduler::refillCredit(uint32_t now) {
+  uint32_t elapsed = now - _creditTime;
+  _creditTime = now;
+  if (elapsed > 1000) {
+    elapsed = 1000;
+  }
+  _credit += elapsed * _bytesPerSecond;
+  if (_credit > MaxCredit) {
+    _credit = MaxCredit;
+  }
+}
+
+int NMEAOutputScheduler::flush(Print &output, size_t availableForWrite, uint32_t now) {
+  refillCredit(now);
+
+  int written = 0;
+  Slot *slot;
+  while ((slot = next(now)) != nullptr) {
+    size_t size = slot->sentence.length() + 2;
+    if (size > availableForWrite || (_bytesPerSecond > 0 && size * 1000 > _credit)) {
+      break;
+    }
+
+    output.write(slot->sentence.c_str(), slot->sentence.length());
+    output.write("\r\n", 2);
+    availableForWrite -= size;
+    if (_bytesPerSecond > 0) {
+      _credit -= size * 1000;
+    }
+
+    slot->pending = false;
+    slot->sent = true;
+    slot->sentTime = now;
+    KBoxMetrics.event(_sentEvent);
+    written++;
+  }
+  return written;
+}
+
+int NMEAOutputScheduler::pending() const {
+  int count = 0;
+  for (int i = 0; i < MaxSentences; i++) {
+    if (_slots[i].pending) {
+      count++;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,111 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common/stats/KBoxMetrics.h"
+#include "NMEAFixedSentence.h"
+#include "NMEAOutputSchedulerConfig.h"
+
+class Print;
+
+/**
+ * Schedules the sentences sent on a serial port so that the most important
+ * ones go out first when there is more data than the port can carry.
+ *
+ * Sentences are queued with enqueue() and written by flush() as space frees
+ * up in the UART and within the byte budget of the baud rate. Only the last
+ * sentence of each type is kept: a new one replaces (coalesces) the one
+ * waiting to be sent. MWV and XDR sentences are also told apart by their
+ * reference and transducer name so that true and apparent wind or the
+ * voltages of two batteries do not replace each other.
+ */
+class NMEAOutputScheduler {
+  public:
+    /**
+     * Number of different sentences that can be waiting at the same time.
+     */
+    static const int MaxSentences = 12;
+
+  private:
+    struct Slot {
+      bool used;
+      bool pending;
+      bool sent;
+      uint8_t priority;
+      uint16_t minInterval;
+      uint32_t queuedTime;
+      uint32_t sentTime;
+      // Address of the sentence and the value of its key field, if any
+      char key[16];
+      NMEAFixedSentence sentence;
+    };
+
+    const NMEAOutputSchedulerConfig &_config;
+    Slot _slots[MaxSentences];
+    uint32_t _bytesPerSecond;
+    // Bytes that can be sent, in thousandths of byte
+    uint32_t _credit;
+    uint32_t _creditTime;
+    enum KBoxEvent _sentEvent, _droppedEvent, _coalescedEvent;
+
+    const NMEAOutputSentenceConfig& sentenceConfig(const char *key) const;
+    Slot* allocate(uint8_t priority);
+    Slot* next(uint32_t now);
+    void refillCredit(uint32_t now);
+
+  public:
+    /**
+     * Creates a scheduler for a port configured at baudRate (0 if the port
+     * has no speed limit). Each sentence sent, dropped because there is no
+     * room to queue it, or replaced by a newer one is counted with the given
+     * KBoxMetrics events.
+     */
+    NMEAOutputScheduler(const NMEAOutputSchedulerConfig &config, uint32_t baudRate,
+                        enum KBoxEvent sentEvent, enum KBoxEvent droppedEvent,
+                        enum KBoxEvent coalescedEvent);
+
+    /**
+     * Queues a sentence (without <CR><LF>) received at time now (in
+     * milliseconds).
+     *
+     * @return false if the sentence was dropped.
+     */
+    bool enqueue(const char *sentence, size_t length, uint32_t now);
+
+    /**
+     * Writes the waiting sentences to output, by order of priority, as long
+     * as they fit in availableForWrite bytes and in the baud rate budget.
+     *
+     * @return the number of sentences written.
+     */
+    int flush(Print &output, size_t availableForWrite, uint32_t now);
+
+    /**
+     * Number of sentences waiting to be sent.
+     */
+    int pending() const;
+};
@@ -0,0 +1,51 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Transmit settings of one type of NMEA sentence.
+ */
+struct NMEAOutputSentenceConfig {
+  // When the port is busy, sentences with a higher priority are sent first.
+  uint8_t priority;
+  // Maximum number of sentences per second for each value (0 means no limit).
+  uint8_t maxRate;
+};
+
+/**
+ * Configuration for an instance of NMEAOutputScheduler.
+ */
+struct NMEAOutputSchedulerConfig {
+  NMEAOutputSentenceConfig dbt = { 2, 0 };
+  NMEAOutputSentenceConfig dpt = { 2, 0 };
+  NMEAOutputSentenceConfig hdm = { 1, 0 };
+  NMEAOutputSentenceConfig mwv = { 2, 0 };
+  NMEAOutputSentenceConfig rsa = { 1, 0 };
+  NMEAOutputSentenceConfig xdr = { 0, 0 };
+  // All the other sentences
+  NMEAOutputSentenceConfig other = { 1, 0 };
+};
@@ -22,57 +22,167 @@
   THE SOFTWARE.
 */
 
+#include <math.h>
+#include <string.h>
 #include "NMEASentenceBuilder.h"
-#include "nmea.h"
 
 static const char *hex = "0123456789ABCDEF";
 
-NMEASentenceBuilder::NMEASentenceBuilder(String talkerId, String sentenceId, int numFields) :
-  talkerId(talkerId), sentenceId(sentenceId), numFields(numFields)
-{
-  fields = new String[numFields];
-}
+static const uint32_t powersOfTen[] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
 
-NMEASentenceBuilder::~NMEASentenceBuilder() {
-  delete[] fields;
-}
+static const int MaxFastPrecision = 9;
 
-NMEASentenceBuilder& NMEASentenceBuilder::operator=(const NMEASentenceBuilder& other) {
-  talkerId = other.talkerId;
-  sentenceId = other.sentenceId;
-  numFields = other.numFields;
+/*
+ * Formats v with exactly precision decimals, right-aligned in a field of
+ * precision + 2 characters, like dtostrf() does for String(v, precision).
+ *
+ * A float is m * 2^e with m on 24 bits. For the values we care about, v *
+ * 10^precision fits in 64 bits and can be rounded exactly (half to even, like
+ * printf) with integer operations only. Returns the number of characters
+ * written or 0 if the value needs to go through dtostrf().
+ */
+static size_t formatFixed(float v, int precision, char *buffer) {
+  if (precision < 0 || precision > MaxFastPrecision || isnan(v) || isinf(v)) {
+    return 0;
+  }
 
-  delete[] fields;
+  uint32_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  bool negative = bits >> 31;
+  int exponent = (bits >> 23) & 0xff;
+  uint64_t mantissa = bits & 0x7fffff;
+  if (exponent == 0) {
+    // Denormalized numbers
+    exponent = 1;
+  }
+  else {
+    mantissa |= 0x800000;
+  }
+  // v = mantissa * 2^exponent
+  exponent -= 127 + 23;
+
+  uint64_t scaled;
+  if (exponent >= 0) {
+    if (exponent > 8) {
+      return 0;
+    }
+    scaled = (mantissa << exponent) * powersOfTen[precision];
+  }
+  else {
+    // mantissa * 10^precision < 2^54
+    uint64_t x = mantissa * powersOfTen[precision];
+    int shift = -exponent;
+    if (shift > 55) {
+      scaled = 0;
+    }
+    else {
+      scaled = x >> shift;
+      uint64_t remainder = x & ((((uint64_t)1) << shift) - 1);
+      uint64_t half = ((uint64_t)1) << (shift - 1);
+      if (remainder > half || (remainder == half && (scaled & 1))) {
+        scaled++;
+      }
+    }
+  }
 
-  fields = new String[numFields];
-  for (int i = 0; i < numFields; i++) {
-    fields[i] = other.fields[i];
+  // Digits are generated backwards, starting with the decimals.
+  char digits[24];
+  char *p = digits + sizeof(digits);
+  uint32_t integerPart = scaled / powersOfTen[precision];
+  uint32_t decimals = scaled % powersOfTen[precision];
+  if (precision > 0) {
+    for (int i = 0; i < precision; i++) {
+      *--p = '0' + decimals % 10;
+      decimals /= 10;
+    }
+    *--p = '.';
+  }
+  do {
+    *--p = '0' + integerPart % 10;
+    integerPart /= 10;
+  } while (integerPart > 0);
+  if (negative) {
+    *--p = '-';
   }
-  return *this;
+
+  size_t length = digits + sizeof(digits) - p;
+  size_t width = precision + 2;
+  size_t padding = length < width ? width - length : 0;
+  memset(buffer, ' ', padding);
+  memcpy(buffer + padding, p, length);
+  return padding + length;
 }
 
-void NMEASentenceBuilder::setField(int fieldId, String v) {
-  if (fieldId > 0 && fieldId <= numFields) {
-    fields[fieldId - 1] = v;
+NMEASentenceBuilder::NMEASentenceBuilder(const char *talkerId, const char *sentenceId, int numFields) :
+  _numFields(numFields), _lastField(0), _checksum(0), _overflow(false), _finished(false)
+{
+  _sentence.append('$');
+  append(talkerId, strlen(talkerId));
+  append(sentenceId, strlen(sentenceId));
+}
+
+void NMEASentenceBuilder::append(const char *data, size_t length) {
+  // Always keep enough room for the checksum.
+  if (length + 3 > _sentence.available()) {
+    _overflow = true;
+    return;
+  }
+  _sentence.append(data, length);
+  for (size_t i = 0; i < length; i++) {
+    _checksum ^= data[i];
   }
 }
 
-void NMEASentenceBuilder::setField(int fieldId, float v, int precision) {
-  setField(fieldId, String(v, precision));
+void NMEASentenceBuilder::appendField(int fieldId, const char *value, size_t length) {
+  if (_finished || fieldId <= _lastField || fieldId > _numFields) {
+    return;
+  }
+  while (_lastField < fieldId) {
+    append(",", 1);
+    _lastField++;
+  }
+  append(value, length);
 }
 
-SKNMEASentence NMEASentenceBuilder::toNMEA() {
-  SKNMEASentence nmea = SKNMEASentence("$" + talkerId + sentenceId);
+void NMEASentenceBuilder::setField(int fieldId, const char *s) {
+  appendField(fieldId, s, strlen(s));
+}
 
-  for (int i = 0; i < numFields; i++) {
-    nmea += "," + fields[i];
-  }
+void NMEASentenceBuilder::setField(int fieldId, const String &s) {
+  appendField(fieldId, s.c_str(), s.length());
+}
 
-  nmea += "*";
+void NMEASentenceBuilder::setField(int fieldId, float v, int precision) {
+  if (_finished || fieldId <= _lastField || fieldId > _numFields) {
+    return;
+  }
+  char buffer[24];
+  size_t length = formatFixed(v, precision, buffer);
+  if (length > 0) {
+    appendField(fieldId, buffer, length);
+  }
+  else {
+    // Very large numbers, NaN and infinity are rare enough.
+    setField(fieldId, String(v, precision));
+  }
+}
 
-  uint8_t checksum = nmea_compute_checksum(nmea.c_str());
-  nmea += hex[checksum / 16];
-  nmea += hex[checksum % 16];
+void NMEASentenceBuilder::finish() {
+  if (_finished) {
+    return;
+  }
+  while (_lastField < _numFields) {
+    append(",", 1);
+    _lastField++;
+  }
+  char checksum[3] = { '*', hex[_checksum / 16], hex[_checksum % 16] };
+  _sentence.append(checksum, sizeof(checksum));
+  _finished = true;
+}
 
-  return nmea;
+const NMEAFixedSentence& NMEASentenceBuilder::toSentence() {
+  finish();
+  return _sentence;
 }
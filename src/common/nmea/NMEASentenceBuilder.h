@@ -22,18 +22,33 @@
   THE SOFTWARE.
 */
 
+#pragma once
+
 #include <WString.h>
-#include "common/signalk/SKNMEASentence.h"
+#include "NMEAFixedSentence.h"
 
-/** A utility class to generate a properly formatted and checksum'd NMEA
- * sentence.
+/**
+ * Builds a NMEA sentence directly into a NMEAFixedSentence, without any
+ * dynamic memory allocation. The checksum is computed while the fields are
+ * appended.
+ *
+ * Fields must be set in increasing order. Fields that are skipped are left
+ * empty, setting a field again or going back to a previous field is ignored.
+ * If a value does not fit in the sentence, the field is left empty and
+ * hasOverflowed() will return true.
  */
 class NMEASentenceBuilder {
   private:
-    String talkerId;
-    String sentenceId;
-    int numFields = 0;
-    String *fields;
+    NMEAFixedSentence _sentence;
+    int _numFields;
+    int _lastField;
+    uint8_t _checksum;
+    bool _overflow;
+    bool _finished;
+
+    void appendField(int fieldId, const char *value, size_t length);
+    void append(const char *data, size_t length);
+    void finish();
 
   public:
     /** Creates a new instance
@@ -43,10 +58,7 @@ class NMEASentenceBuilder {
      * three upper-case letters.
      * @param largest field identifier that will be used in this sentence.
      */
-    NMEASentenceBuilder(String talkerId, String sentenceId, int numFields);
-    ~NMEASentenceBuilder();
-
-    NMEASentenceBuilder& operator=(const NMEASentenceBuilder& other);
+    NMEASentenceBuilder(const char *talkerId, const char *sentenceId, int numFields);
 
     /** Set the value of one of the field.
      * Note that fields are numbered from 1 so as to match the NMEA reference:
@@ -56,11 +68,22 @@ class NMEASentenceBuilder {
      * included)
      * @param s the new value
      */
-    void setField(int fieldId, String s);
+    void setField(int fieldId, const char *s);
+    void setField(int fieldId, const String &s);
+
+    /** Set the value of a field to a number with a fixed number of decimals.
+     * The output is identical to String(v, precision).
+     */
     void setField(int fieldId, float v, int precision);
 
-    /** Returns a string with a properly formatted NMEA sentence, terminated by
-     * a checksum and "\r\n\0".
+    /** True if at least one field did not fit in the sentence.
+     */
+    bool hasOverflowed() const {
+      return _overflow;
+    };
+
+    /** Returns the properly formatted NMEA sentence, terminated by a checksum
+     * but without "\r\n". No field can be added after this.
      */
-    SKNMEASentence toNMEA();
+    const NMEAFixedSentence& toSentence();
 };
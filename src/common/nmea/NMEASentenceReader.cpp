@@ -23,102 +23,224 @@
 */
 
 #include <math.h> // NAN
+#include <stdlib.h>
 #include "NMEASentenceReader.h"
 #include "nmea.h"
 
-bool NMEASentenceReader::isValid() const {
-  return nmea_is_valid(_sentence.c_str());
+size_t NMEAField::copyTo(char *buffer, size_t size) const {
+  if (size == 0) {
+    return 0;
+  }
+  size_t len = _length < size - 1 ? _length : size - 1;
+  memcpy(buffer, _data, len);
+  buffer[len] = '\0';
+  return len;
 }
 
-const String NMEASentenceReader::getTalkerId() const {
-  return _sentence.substring(1, 3);
+String NMEAField::toString() const {
+  String s;
+  s.reserve(_length);
+  for (size_t i = 0; i < _length; i++) {
+    s += _data[i];
+  }
+  return s;
 }
 
-const String NMEASentenceReader::getSentenceCode() const {
-  return _sentence.substring(3, _sentence.indexOf(','));
-}
+/*
+ * Powers of ten that are exactly representable in a double.
+ */
+static const double powersOfTen[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int maxDecimals = sizeof(powersOfTen) / sizeof(powersOfTen[0]) - 1;
+static const uint64_t maxExactMantissa = (uint64_t)1 << 53;
 
-int NMEASentenceReader::countFields() const {
-  const char *s = _sentence.c_str();
-  int count = 0;
+/*
+ * Parse a number formatted as NMEA does ([+-]digits[.digits]) into an integer
+ * and a number of decimals.
+ *
+ * Returns false if the number has another format (exponent, garbage) or too
+ * many digits to be exactly represented in a double.
+ */
+static bool parseDecimal(const char *s, size_t length, bool &negative, uint64_t &mantissa, int &decimals) {
+  size_t i = 0;
+  negative = false;
+  mantissa = 0;
+  decimals = 0;
+
+  if (i < length && (s[i] == '-' || s[i] == '+')) {
+    negative = s[i] == '-';
+    i++;
+  }
 
-  int i = 0;
-  while (s[i] != '\0') {
-    if (s[i] == ',') {
-      count++;
+  bool digits = false;
+  bool dot = false;
+  for (; i < length; i++) {
+    if (s[i] >= '0' && s[i] <= '9') {
+      mantissa = mantissa * 10 + (s[i] - '0');
+      if (mantissa >= maxExactMantissa) {
+        return false;
+      }
+      if (dot) {
+        decimals++;
+      }
+      digits = true;
+    }
+    else if (s[i] == '.' && !dot) {
+      dot = true;
+    }
+    else {
+      return false;
     }
-    i++;
   }
-  return count;
+  return digits && decimals <= maxDecimals;
 }
 
-const String NMEASentenceReader::getFieldAsString(int id) const {
-  int pos = 0;
-  int index = 0;
+/*
+ * Same result as strtod() on the field, bit for bit.
+ *
+ * Most NMEA numbers are small decimal numbers: they are read as integers and
+ * converted with one division by an exact power of ten. Both operands are
+ * exact so the division is correctly rounded, like strtod(). Other numbers
+ * are passed to strtod().
+ */
+static double parseDouble(const char *s, size_t length) {
+  bool negative;
+  uint64_t mantissa;
+  int decimals;
+
+  if (parseDecimal(s, length, negative, mantissa, decimals)) {
+    double value = (double)mantissa / powersOfTen[decimals];
+    return negative ? -value : value;
+  }
+  // Fields are followed by ',' or '*' which stop the conversion.
+  return strtod(s, 0);
+}
 
-  while(index < id) {
-    pos = _sentence.indexOf(',', pos + 1);
-    if (pos == -1) {
-      break;
+/*
+ * Find the fields and compute the checksum in one pass over the sentence.
+ */
+void NMEASentenceReader::tokenize() {
+  _fieldsCount = 0;
+  _lastFieldTerminated = false;
+  _valid = false;
+
+  if (_sentence[0] == '\0') {
+    // Field 0 is empty
+    _fieldStart[0] = 0;
+    _fieldStart[1] = 1;
+    return;
+  }
+
+  // Skip the '$' or '!'
+  _fieldStart[0] = 1;
+
+  uint8_t checksum = 0;
+  size_t i = 1;
+  while (_sentence[i] != '\0' && _sentence[i] != '*' && i < UINT16_MAX) {
+    checksum ^= _sentence[i];
+    if (_sentence[i] == ',') {
+      if (_fieldsCount < MaxFields) {
+        _fieldsCount++;
+        _fieldStart[_fieldsCount] = i + 1;
+      }
+      else if (!_lastFieldTerminated) {
+        _fieldStart[MaxFields + 1] = i + 1;
+        _lastFieldTerminated = true;
+      }
     }
-    index++;
+    i++;
+  }
+
+  bool hasChecksum = _sentence[i] == '*';
+  if (!_lastFieldTerminated) {
+    _fieldStart[_fieldsCount + 1] = i + 1;
+    _lastFieldTerminated = hasChecksum;
   }
-  if (pos == -1) {
-    return "";
+
+  if (hasChecksum && (_sentence[0] == '$' || _sentence[0] == '!')) {
+    _valid = nmea_read_checksum(_sentence + i) == checksum;
   }
-  else {
-    // fields are terminated by another ',' or by '*'
-    int end = _sentence.indexOf(',', pos + 1);
-    if (end == -1) {
-      end = _sentence.indexOf('*', pos + 1);
-    }
-    if (end == -1) {
-      // Something went wrong here :(
-      return "";
-    }
+}
 
-    return _sentence.substring(pos + 1, end);
+NMEAField NMEASentenceReader::getField(int id) const {
+  if (id < 0 || id > _fieldsCount || (id == _fieldsCount && !_lastFieldTerminated)) {
+    return NMEAField();
   }
+  return NMEAField(_sentence + _fieldStart[id], _fieldStart[id + 1] - 1 - _fieldStart[id]);
+}
+
+NMEAField NMEASentenceReader::getTalkerId() const {
+  NMEAField address = getField(0);
+  return NMEAField(address.getData(), address.getLength() < 2 ? address.getLength() : 2);
+}
+
+NMEAField NMEASentenceReader::getSentenceCode() const {
+  NMEAField address = getField(0);
+  if (address.getLength() < 2) {
+    return NMEAField();
+  }
+  return NMEAField(address.getData() + 2, address.getLength() - 2);
+}
+
+const String NMEASentenceReader::getFieldAsString(int id) const {
+  return getField(id).toString();
 }
 
 char NMEASentenceReader::getFieldAsChar(int id) const {
-  String f = getFieldAsString(id);
-  if (f.length() != 1) {
+  NMEAField f = getField(id);
+  if (f.getLength() != 1) {
     return '\0';
   }
   else {
-    return f.c_str()[0];
+    return f.getData()[0];
   }
 }
 
 double NMEASentenceReader::getFieldAsDouble(int id) const {
-  String f = getFieldAsString(id);
+  NMEAField f = getField(id);
 
-  if (f.length() == 0) {
+  if (f.isEmpty()) {
     return NAN;
   }
-  return strtod(f.c_str(), 0);
+  return parseDouble(f.getData(), f.getLength());
 }
 
 double NMEASentenceReader::getFieldAsLatLon(int id) const {
-  String value = getFieldAsString(id);
+  NMEAField value = getField(id);
   char sign = getFieldAsChar(id+1);
 
-  if (value.length() == 0 || sign == 0) {
+  if (value.isEmpty() || sign == 0) {
     return NAN;
   }
 
   // There are normally two digits for minutes before the '.':
   //   DDMM.MMM
-  int degreesDigits = value.indexOf('.') - 2;
+  const char *dot = (const char*)memchr(value.getData(), '.', value.getLength());
+  int degreesDigits = dot ? dot - value.getData() - 2 : 0;
   if (degreesDigits < 0) {
     degreesDigits = 0;
   }
 
-  String angle = value.substring(0, degreesDigits);
-  String minutes = value.substring(degreesDigits);
+  long degrees;
+  bool negative;
+  uint64_t mantissa;
+  int decimals;
+  if (degreesDigits == 0) {
+    degrees = 0;
+  }
+  else if (degreesDigits <= 3 && parseDecimal(value.getData(), degreesDigits, negative, mantissa, decimals)) {
+    degrees = negative ? -(long)mantissa : (long)mantissa;
+  }
+  else {
+    char buffer[8];
+    NMEAField(value.getData(), degreesDigits).copyTo(buffer, sizeof(buffer));
+    degrees = atol(buffer);
+  }
 
-  double latlon = angle.toInt() + strtod(minutes.c_str(), 0) / 60;
+  double minutes = parseDouble(value.getData() + degreesDigits, value.getLength() - degreesDigits);
+  double latlon = degrees + minutes / 60;
 
   switch (sign) {
     case 'N':
@@ -131,4 +253,3 @@ double NMEASentenceReader::getFieldAsLatLon(int id) const {
       return NAN;
   }
 }
-
@@ -24,73 +24,177 @@
 
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include <WString.h>
 
+/**
+ * Pack a talker id or a sentence code in an integer so that it can be
+ * compared and sorted as a number. Only the first four characters are used.
+ *
+ *     NMEAPackCode("RMC") == 0x524d43
+ */
+constexpr uint32_t NMEAPackCode(const char *code, int i = 0, uint32_t packed = 0) {
+  return (i < 4 && code[i] != '\0') ? NMEAPackCode(code, i + 1, (packed << 8) | (uint8_t)code[i]) : packed;
+}
+
+/**
+ * A field of a NMEA sentence. This does not copy the data: it is only valid
+ * as long as the sentence it was read from.
+ */
+class NMEAField {
+  private:
+    const char *_data;
+    size_t _length;
+
+  public:
+    NMEAField() : _data(""), _length(0) {};
+    NMEAField(const char *data, size_t length) : _data(data), _length(length) {};
+
+    /**
+     * Pointer to the first character of the field. This is not
+     * null-terminated!
+     */
+    const char* getData() const {
+      return _data;
+    };
+
+    size_t getLength() const {
+      return _length;
+    };
+
+    bool isEmpty() const {
+      return _length == 0;
+    };
+
+    bool operator==(const char *s) const {
+      return strlen(s) == _length && memcmp(s, _data, _length) == 0;
+    };
+
+    bool operator!=(const char *s) const {
+      return !(*this == s);
+    };
+
+    /**
+     * Same as NMEAPackCode() for the content of this field.
+     */
+    uint32_t pack() const {
+      uint32_t packed = 0;
+      for (size_t i = 0; i < _length && i < 4; i++) {
+        packed = (packed << 8) | (uint8_t)_data[i];
+      }
+      return packed;
+    };
+
+    /**
+     * Copy the field in buffer as a null-terminated string. The field is
+     * truncated if the buffer is too small.
+     *
+     * Returns the number of characters copied.
+     */
+    size_t copyTo(char *buffer, size_t size) const;
+
+    /**
+     * Return a copy of the field (this allocates memory).
+     */
+    String toString() const;
+};
+
 /**
  * This class provides a set of functions to make parsing NMEA sentences easier.
  *
+ * The sentence is split in fields and its checksum is verified once when the
+ * reader is created. The reader does not copy the sentence so it must not be
+ * modified or destroyed while the reader is used.
+ *
  * All the getFieldAs...() functions have a few important things in common:
  *  - Fields are numbered starting at 1 to match the amazing NMEA reference
  *    produced by Eric S Raymond (http://www.catb.org/gpsd/NMEA.html)
- *  - If you do not pass a field id, the reader will auto-increment.
+ *  - Field 0 is the address field (talker id and sentence code).
+ *  - Only the first MaxFields fields can be read.
  */
 class NMEASentenceReader {
+  public:
+    static const int MaxFields = 40;
+
   private:
-    String _sentence;
+    const char *_sentence;
+
+    // _fieldStart[i] is the index of the first character of field i and
+    // _fieldStart[i + 1] - 1 the index of the separator that ends it.
+    uint16_t _fieldStart[MaxFields + 2];
+    uint8_t _fieldsCount;
+    // True if the last field is followed by a '*' (or another field that we
+    // did not index)
+    bool _lastFieldTerminated;
+    bool _valid;
+
+    void tokenize();
 
   public:
     /**
      * Creates a new instance of NMEASentenceReader to parse a NMEASentence.
      */
-    NMEASentenceReader(const String &sentence)
-      : _sentence(sentence) {
+    NMEASentenceReader(const String &sentence) : _sentence(sentence.c_str()) {
+      tokenize();
+    };
+
+    NMEASentenceReader(const char *sentence) : _sentence(sentence ? sentence : "") {
+      tokenize();
     };
 
     /**
      * Return true if this is a valid NMEA sentence.
      */
-    bool isValid() const;
+    bool isValid() const {
+      return _valid;
+    };
 
     /**
-     * Return a two characters long string identifying the talker.
+     * Return the two characters identifying the talker.
      */
-    const String getTalkerId() const;
+    NMEAField getTalkerId() const;
 
     /**
-     * Return a three (at most) characters long identifying the sentence.
+     * Return the characters identifying the sentence (three in standard
+     * sentences).
      */
-    const String getSentenceCode() const;
+    NMEAField getSentenceCode() const;
 
     /**
      * Return the number of fields in the sentence
      * This only counts data fields, not the prefix and checksum.
      */
-    int countFields() const;
+    int countFields() const {
+      return _fieldsCount;
+    };
+
+    /**
+     * Return field i or an empty field if it does not exist.
+     */
+    NMEAField getField(int i) const;
 
     /**
      * Return the value of field i as a double or NaN if the field does not
      * exist, or is empty. If a conversion error occurs (the string is not a
      * valid number), 0 will be returned.
-     *
-     * If i is omitted, auto-incrementation will be used.
      */
-    double getFieldAsDouble(int i = 0) const;
+    double getFieldAsDouble(int i) const;
 
     /**
      * Return the value of field i as a char or '\0` if the field does not
      * exist, is empty or is longer than 1 byte.
-     *
-     * If i is omitted, auto-incrementation will be used.
      */
-    char getFieldAsChar(int i = 0) const;
+    char getFieldAsChar(int i) const;
 
     /**
      * Return the value of field i as a String or an empty string if the field
      * does not exist or is empty.
      *
-     * If i is omitted, auto-incrementation will be used.
+     * This allocates memory. Prefer getField() when possible.
      */
-    const String getFieldAsString(int i = 0) const;
+    const String getFieldAsString(int i) const;
 
     /**
      * Return the value of field i and i+1 as an angle parsed as latitude or longitude.
@@ -101,8 +205,5 @@ class NMEASentenceReader {
      *
      * Will return NaN if an error occurs while parsing the field.
      */
-    double getFieldAsLatLon(int i = 0) const;
+    double getFieldAsLatLon(int i) const;
 };
-
-
-
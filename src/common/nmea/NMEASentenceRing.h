@@ -0,0 +1,133 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Fixed size queue of NMEA sentences between one producer (the function that
+ * reads the serial port) and one consumer (the task that parses the
+ * sentences).
+ *
+ * The producer only writes the head index and the consumer only writes the
+ * tail index so neither side needs to lock the other one out. The ring never
+ * allocates memory: when it is full, new sentences are dropped and counted in
+ * overflows().
+ *
+ * Slots must be a power of two.
+ */
+template <uint16_t Slots> class NMEASentenceRing {
+  static_assert(Slots > 0 && (Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+
+  public:
+    /**
+     * Defined by the NMEA standard: 82 characters including the final
+     * <CR><LF> plus a terminating null character.
+     */
+    static const size_t MaxSentenceLength = 83;
+
+    struct Slot {
+      uint32_t timestamp;
+      uint8_t length;
+      char sentence[MaxSentenceLength];
+    };
+
+  private:
+    Slot _slots[Slots];
+    // Free running counters. Slot index is counter % Slots.
+    volatile uint16_t _head;
+    volatile uint16_t _tail;
+    volatile uint32_t _overflows;
+
+  public:
+    NMEASentenceRing() : _head(0), _tail(0), _overflows(0) {};
+
+    /**
+     * Producer side: copy a sentence (without its line terminator) in the
+     * ring.
+     *
+     * Returns false if the ring is full (the sentence is counted as an
+     * overflow) or if the sentence is longer than MaxSentenceLength - 1.
+     */
+    bool push(const char *sentence, size_t length, uint32_t timestamp) {
+      if (length >= MaxSentenceLength) {
+        return false;
+      }
+      uint16_t head = _head;
+      if ((uint16_t)(head - _tail) >= Slots) {
+        _overflows = _overflows + 1;
+        return false;
+      }
+
+      Slot &slot = _slots[head % Slots];
+      memcpy(slot.sentence, sentence, length);
+      slot.sentence[length] = '\0';
+      slot.length = length;
+      slot.timestamp = timestamp;
+
+      // Make sure the slot is written before the consumer can see it.
+      __sync_synchronize();
+      _head = head + 1;
+      return true;
+    };
+
+    /**
+     * Consumer side: the oldest sentence in the ring or a null pointer if the
+     * ring is empty. The slot stays valid until pop() is called.
+     */
+    const Slot* peek() const {
+      if (_head == _tail) {
+        return nullptr;
+      }
+      return &_slots[_tail % Slots];
+    };
+
+    /**
+     * Consumer side: release the oldest sentence.
+     */
+    void pop() {
+      if (_head != _tail) {
+        // Make sure we are done reading the slot before releasing it.
+        __sync_synchronize();
+        _tail = _tail + 1;
+      }
+    };
+
+    /**
+     * Number of sentences waiting in the ring.
+     */
+    uint16_t size() const {
+      return _head - _tail;
+    };
+
+    /**
+     * Number of sentences dropped because the ring was full.
+     */
+    uint32_t overflows() const {
+      return _overflows;
+    };
+};
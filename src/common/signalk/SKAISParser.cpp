@@ -0,0 +1,197 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include "common/nmea/NMEASentenceReader.h"
+#include "SKAISParser.h"
+#include "SKUnits.h"
+
+// Values used by AIS when a field is not available.
+static const int32_t AISLongitudeNotAvailable = 181 * 600000;
+static const int32_t AISLatitudeNotAvailable = 91 * 600000;
+static const uint32_t AISSpeedNotAvailable = 1023;
+static const uint32_t AISCourseNotAvailable = 3600;
+static const uint32_t AISHeadingNotAvailable = 511;
+static const int32_t AISRateOfTurnNotAvailable = -128;
+
+SKAISParser::SKAISParser(AISTargetTable &targets) :
+  _targets(targets), _context("urn:mrn:imo:mmsi:000000000"), _update(_context) {
+}
+
+const SKUpdate& SKAISParser::parse(const SKSourceInput& input, const String& sentence,
+                                   const SKTime& timestamp, uint32_t now) {
+  _update.clear();
+
+  NMEASentenceReader reader(sentence);
+  if (!reader.isValid() || reader.getSentenceCode() != "VDM") {
+    return _invalidSku;
+  }
+
+  const AISPayload *payload = _assembler.add(reader, now);
+  if (!payload || payload->getMMSI() == 0) {
+    return _invalidSku;
+  }
+
+  uint32_t mmsi = payload->getMMSI();
+  uint16_t length = payload->getLength();
+  float rateOfTurn = NAN;
+
+  switch (payload->getMessageType()) {
+    case 1:
+    case 2:
+    case 3: {
+      // Class A position report
+      if (length < 137) {
+        return _invalidSku;
+      }
+      AISTarget &target = _targets.touch(mmsi, now);
+      target.classB = false;
+      decodePositionReport(*payload, 50, target);
+
+      // The sensor value is encoded as 4.733 * sqrt(degrees/minute).
+      int32_t rot = payload->getSigned(42, 8);
+      if (rot != AISRateOfTurnNotAvailable && rot != 127 && rot != -127) {
+        float degreesPerMinute = (rot / 4.733) * (rot / 4.733);
+        rateOfTurn = SKDegToRad((rot < 0 ? -degreesPerMinute : degreesPerMinute) / 60);
+      }
+      publishTarget(target, rateOfTurn);
+      break;
+    }
+    case 18:
+    case 19: {
+      // Class B position report (19 also has static data)
+      if (length < 133) {
+        return _invalidSku;
+      }
+      AISTarget &target = _targets.touch(mmsi, now);
+      target.classB = true;
+      decodePositionReport(*payload, 46, target);
+      if (payload->getMessageType() == 19 && length >= 301) {
+        payload->getString(143, 20, target.name, sizeof(target.name));
+        target.shipType = payload->getUnsigned(263, 8);
+        decodeDimensions(*payload, 271, target);
+      }
+      publishTarget(target, rateOfTurn);
+      break;
+    }
+    case 5: {
+      // Class A static and voyage data
+      if (length < 302) {
+        return _invalidSku;
+      }
+      AISTarget &target = _targets.touch(mmsi, now);
+      target.classB = false;
+      payload->getString(70, 7, target.callsign, sizeof(target.callsign));
+      payload->getString(112, 20, target.name, sizeof(target.name));
+      target.shipType = payload->getUnsigned(232, 8);
+      decodeDimensions(*payload, 240, target);
+      target.draught = payload->getUnsigned(294, 8);
+      break;
+    }
+    case 24: {
+      // Class B static data, in two parts
+      uint32_t part = payload->getUnsigned(38, 2);
+      if ((part == 0 && length < 160) || (part == 1 && length < 162) || part > 1) {
+        return _invalidSku;
+      }
+      AISTarget &target = _targets.touch(mmsi, now);
+      target.classB = true;
+      if (part == 0) {
+        payload->getString(40, 20, target.name, sizeof(target.name));
+      }
+      else {
+        target.shipType = payload->getUnsigned(40, 8);
+        payload->getString(90, 7, target.callsign, sizeof(target.callsign));
+        decodeDimensions(*payload, 132, target);
+      }
+      break;
+    }
+  }
+
+  if (_update.getSize() == 0) {
+    return _invalidSku;
+  }
+  _update.setTimestamp(timestamp);
+  _update.setSource(SKSource::sourceForNMEA0183(input, "AI", "VDM"));
+  return _update;
+}
+
+/*
+ * Class A and class B position reports use the same encoding. Only the
+ * offset of the fields changes.
+ */
+void SKAISParser::decodePositionReport(const AISPayload& payload, uint16_t offset, AISTarget& target) {
+  uint32_t sog = payload.getUnsigned(offset, 10);
+  int32_t longitude = payload.getSigned(offset + 11, 28);
+  int32_t latitude = payload.getSigned(offset + 39, 27);
+  uint32_t cog = payload.getUnsigned(offset + 66, 12);
+  uint32_t heading = payload.getUnsigned(offset + 78, 9);
+
+  if (longitude != AISLongitudeNotAvailable && latitude != AISLatitudeNotAvailable
+      && longitude >= -180 * 600000 && longitude <= 180 * 600000
+      && latitude >= -90 * 600000 && latitude <= 90 * 600000) {
+    // 1/10000 minutes
+    target.longitude = longitude / 600000.0;
+    target.latitude = latitude / 600000.0;
+  }
+  else {
+    target.longitude = NAN;
+    target.latitude = NAN;
+  }
+  target.speedOverGround = sog != AISSpeedNotAvailable ? SKKnotToMs(sog / 10.0) : NAN;
+  target.courseOverGround = cog < AISCourseNotAvailable ? SKDegToRad(cog / 10.0) : NAN;
+  target.heading = heading < 360 && heading != AISHeadingNotAvailable ? SKDegToRad(heading) : NAN;
+}
+
+/*
+ * Distances from the reference point (GPS antenna) to the bow, stern, port
+ * and starboard.
+ */
+void SKAISParser::decodeDimensions(const AISPayload& payload, uint16_t offset, AISTarget& target) {
+  target.length = payload.getUnsigned(offset, 9) + payload.getUnsigned(offset + 9, 9);
+  target.beam = payload.getUnsigned(offset + 18, 6) + payload.getUnsigned(offset + 24, 6);
+}
+
+void SKAISParser::publishTarget(const AISTarget& target, float rateOfTurn) {
+  char urn[sizeof("urn:mrn:imo:mmsi:") + 10];
+  snprintf(urn, sizeof(urn), "urn:mrn:imo:mmsi:%09lu", (unsigned long)target.mmsi);
+  _context.setURN(urn);
+
+  if (!isnan(target.latitude)) {
+    _update.setNavigationPosition(SKTypePosition(target.latitude, target.longitude, SKDoubleNAN));
+  }
+  if (!isnan(target.courseOverGround)) {
+    _update.setNavigationCourseOverGroundTrue(target.courseOverGround);
+  }
+  if (!isnan(target.speedOverGround)) {
+    _update.setNavigationSpeedOverGround(target.speedOverGround);
+  }
+  if (!isnan(target.heading)) {
+    _update.setNavigationHeadingTrue(target.heading);
+  }
+  if (!isnan(rateOfTurn)) {
+    _update.setNavigationRateOfTurn(rateOfTurn);
+  }
+}
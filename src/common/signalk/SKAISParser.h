@@ -0,0 +1,77 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "common/nmea/AISFragmentAssembler.h"
+#include "common/nmea/AISTargetTable.h"
+#include "SKContext.h"
+#include "SKUpdateStatic.h"
+
+/**
+ * Decodes AIS messages received in !AIVDM sentences into SignalK updates
+ * about other vessels.
+ *
+ * Position reports (message types 1, 2, 3, 18 and 19) generate an update
+ * with the context "urn:mrn:imo:mmsi:<mmsi>" of the vessel. Static data
+ * (types 5, 19 and 24) is only stored in the target table.
+ *
+ * !AIVDO sentences describe our own vessel and are ignored.
+ */
+class SKAISParser {
+  public:
+    /**
+     * Maximum number of values in one update: position, course, speed,
+     * heading and rate of turn.
+     */
+    static const uint16_t MaxValuesPerUpdate = 5;
+
+  private:
+    AISTargetTable &_targets;
+    AISFragmentAssembler _assembler;
+    SKContext _context;
+    SKUpdateStatic<MaxValuesPerUpdate> _update;
+    SKUpdateStatic<0> _invalidSku = SKUpdateStatic<0>();
+
+    static void decodePositionReport(const AISPayload& payload, uint16_t offset, AISTarget& target);
+    static void decodeDimensions(const AISPayload& payload, uint16_t offset, AISTarget& target);
+    void publishTarget(const AISTarget& target, float rateOfTurn);
+
+  public:
+    SKAISParser(AISTargetTable &targets);
+
+    /**
+     * Parses a !AIVDM sentence received on input at time now (in
+     * milliseconds, used to reassemble messages and to track targets).
+     *
+     * Returns an update that is valid until parse() is called again. It is
+     * empty if the sentence did not complete a position report. Its context
+     * is only valid until the next call too.
+     */
+    const SKUpdate& parse(const SKSourceInput& input, const String& sentence, const SKTime& timestamp, uint32_t now);
+
+    const AISFragmentAssembler& getAssembler() const {
+      return _assembler;
+    };
+};
@@ -44,10 +44,18 @@ class SKContext {
      */
     SKContext(const String& urn) : _urn(urn) {};
 
+    /**
+     * Changes the URN of this context. This does not allocate memory if the
+     * new URN is not longer than the previous one.
+     */
+    void setURN(const char *urn) {
+      _urn = urn;
+    };
+
     /**
      * @return a unique identifier for a vessel.
      */
-    const String getURN() const {
+    const String& getURN() const {
       return _urn;
     };
 
@@ -0,0 +1,140 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "SKDataModel.h"
+#include "SKUpdate.h"
+
+SKDataModel::SKDataModel(uint16_t capacity) :
+  _capacity(capacity > MaxCapacity ? MaxCapacity : capacity), _size(0), _sequence(0), _dropped(0) {
+  _entries = new SKDataModelEntry[_capacity];
+
+  // Keep the load factor under 50% so that probe sequences stay short.
+  uint32_t buckets = 1;
+  while (buckets < 2 * _capacity) {
+    buckets = buckets << 1;
+  }
+  _buckets = new uint16_t[buckets];
+  _bucketsMask = buckets - 1;
+
+  clear();
+}
+
+SKDataModel::~SKDataModel() {
+  delete[] _entries;
+  delete[] _buckets;
+}
+
+void SKDataModel::clear() {
+  _size = 0;
+  for (uint16_t i = 0; i <= _bucketsMask; i++) {
+    _buckets[i] = 0;
+  }
+}
+
+uint16_t SKDataModel::bucketForPath(const SKPath &path) const {
+  uint32_t key = ((uint32_t)path.getStaticPath() << 8) | path.getIndexId();
+  // Knuth multiplicative hash
+  return (key * 2654435761u) >> 16 & _bucketsMask;
+}
+
+int SKDataModel::findEntry(const SKPath &path, const SKSource &source) const {
+  for (uint16_t b = bucketForPath(path); _buckets[b] != 0; b = (b + 1) & _bucketsMask) {
+    const SKDataModelEntry &e = _entries[_buckets[b] - 1];
+    if (e.path == path && e.source == source) {
+      return _buckets[b] - 1;
+    }
+  }
+  return -1;
+}
+
+void SKDataModel::updateReceived(const SKUpdate &update) {
+  // Entries are not keyed by context: updates about other vessels (AIS
+  // targets) would overwrite our own values.
+  if (&update.getContext() != &SKContextSelf) {
+    return;
+  }
+
+  _sequence++;
+  for (uint16_t i = 0; i < update.getSize(); i++) {
+    storeValue(update, update.getPath(i), update.getValue(i));
+  }
+}
+
+void SKDataModel::storeValue(const SKUpdate &update, const SKPath &path, const SKValue &value) {
+  int index = findEntry(path, update.getSource());
+
+  if (index < 0) {
+    if (_size >= _capacity) {
+      _dropped++;
+      return;
+    }
+    index = _size++;
+    _entries[index].path = path;
+    _entries[index].source = update.getSource();
+
+    uint16_t b = bucketForPath(path);
+    while (_buckets[b] != 0) {
+      b = (b + 1) & _bucketsMask;
+    }
+    _buckets[b] = index + 1;
+  }
+
+  SKDataModelEntry &e = _entries[index];
+  e.timestamp = update.getTimestamp();
+  e.value = value;
+  e.sequence = _sequence;
+}
+
+const SKDataModelEntry* SKDataModel::get(const SKPath &path, const SKSource &source) const {
+  int index = findEntry(path, source);
+  if (index < 0) {
+    return nullptr;
+  }
+  return &_entries[index];
+}
+
+const SKDataModelEntry* SKDataModel::getLatest(const SKPath &path) const {
+  const SKDataModelEntry *latest = nullptr;
+  for (uint16_t b = bucketForPath(path); _buckets[b] != 0; b = (b + 1) & _bucketsMask) {
+    const SKDataModelEntry &e = _entries[_buckets[b] - 1];
+    if (e.path == path && (latest == nullptr || e.sequence > latest->sequence)) {
+      latest = &e;
+    }
+  }
+  return latest;
+}
+
+void SKDataModel::accept(SKDataModelVisitor &visitor) const {
+  for (uint16_t i = 0; i < _size; i++) {
+    visitor.visit(_entries[i]);
+  }
+}
+
+void SKDataModel::acceptChangedSince(SKDataModelVisitor &visitor, uint32_t sequence) const {
+  for (uint16_t i = 0; i < _size; i++) {
+    if (_entries[i].sequence > sequence) {
+      visitor.visit(_entries[i]);
+    }
+  }
+}
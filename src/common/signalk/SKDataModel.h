@@ -0,0 +1,162 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "SKPath.h"
+#include "SKSource.h"
+#include "SKSubscriber.h"
+#include "SKTime.h"
+#include "SKValue.h"
+
+/**
+ * Latest known value of one path from one source.
+ */
+struct SKDataModelEntry {
+  SKPath path;
+  SKSource source;
+  SKTime timestamp;
+  SKValue value;
+
+  /**
+   * Sequence number of the update that last modified this entry.
+   */
+  uint32_t sequence;
+};
+
+class SKDataModelVisitor {
+  public:
+    virtual void visit(const SKDataModelEntry &entry) = 0;
+};
+
+/**
+ * Keeps the latest value of every path received about our own vessel, per
+ * source. Updates about other vessels are ignored.
+ *
+ * Subscribe it to a SKHub to build the current state of the boat. All the
+ * memory is allocated when the model is created: when it is full, values for
+ * new (path, source) pairs are dropped.
+ *
+ * Each update received increments the model sequence number and the entries
+ * it modifies are tagged with that number so that consumers can ask for the
+ * entries changed since the last time they looked at the model.
+ */
+class SKDataModel : public SKSubscriber {
+  public:
+    static const uint16_t DefaultCapacity = 64;
+    // The buckets are twice the capacity and must be indexed on 16 bits.
+    static const uint16_t MaxCapacity = 16384;
+
+  private:
+    // Entries are stored densely in the order they were created.
+    SKDataModelEntry *_entries;
+    uint16_t _capacity;
+    uint16_t _size;
+
+    // Open-addressing index on the path. Each bucket contains the index of
+    // an entry + 1, or 0 if it is empty.
+    uint16_t *_buckets;
+    uint16_t _bucketsMask;
+
+    uint32_t _sequence;
+    uint32_t _dropped;
+
+    uint16_t bucketForPath(const SKPath &path) const;
+    int findEntry(const SKPath &path, const SKSource &source) const;
+    void storeValue(const SKUpdate &update, const SKPath &path, const SKValue &value);
+
+  public:
+    /**
+     * Capacities larger than MaxCapacity are reduced to MaxCapacity.
+     */
+    SKDataModel(uint16_t capacity = DefaultCapacity);
+    ~SKDataModel();
+
+    void updateReceived(const SKUpdate &update) override;
+
+    /**
+     * Forget all the values. The sequence number is not reset.
+     */
+    void clear();
+
+    /**
+     * Sequence number of the last update received.
+     */
+    uint32_t getSequence() const {
+      return _sequence;
+    };
+
+    /**
+     * Number of entries in the model.
+     */
+    uint16_t getSize() const {
+      return _size;
+    };
+
+    uint16_t getCapacity() const {
+      return _capacity;
+    };
+
+    /**
+     * Number of values that were dropped because the model was full.
+     */
+    uint32_t getDroppedCount() const {
+      return _dropped;
+    };
+
+    /**
+     * Returns the entry at this position (0 to getSize() - 1). Entries never
+     * move so this can be used to iterate over the model.
+     */
+    const SKDataModelEntry& getEntry(uint16_t index) const {
+      return _entries[index];
+    };
+
+    /**
+     * Returns the value of this path from this source, or nullptr.
+     */
+    const SKDataModelEntry* get(const SKPath &path, const SKSource &source) const;
+
+    /**
+     * Returns the most recently updated value of this path, whatever its
+     * source, or nullptr.
+     */
+    const SKDataModelEntry* getLatest(const SKPath &path) const;
+
+    /**
+     * Visit all the entries.
+     */
+    void accept(SKDataModelVisitor &visitor) const;
+
+    /**
+     * Visit the entries modified after the given sequence number.
+     *
+     *     uint32_t seen = model.getSequence();
+     *     // ... later
+     *     model.acceptChangedSince(visitor, seen);
+     *     seen = model.getSequence();
+     */
+    void acceptChangedSince(SKDataModelVisitor &visitor, uint32_t sequence) const;
+};
@@ -22,23 +22,168 @@
   THE SOFTWARE.
 */
 
+#include <Arduino.h>
 #include <KBoxLogging.h>
 #include "SKHub.h"
+#include "SKSourceMultiplexer.h"
 #include "SKSubscriber.h"
+#include "SKUpdate.h"
+#include "stats/KBoxMetrics.h"
 
+static_assert(SKHub::SelectedUpdateMaxValues <= 32, "The multiplexer suppresses values with a 32 bits mask");
 
-SKHub::SKHub() {
+SKHub::SKHub() : _subscribersCount(0), _unfilteredSubscribers(0), _multiplexer(nullptr),
+  _queue(nullptr), _queueRecipients(nullptr), _queueCapacity(0), _queueHead(0), _queueCount(0),
+  _queueHighWaterMark(0) {
+  for (int p = 0; p < SKPathEnumCount; p++) {
+    _pathRoutes[p] = 0;
+  }
+  for (int i = 0; i < SKSourceInputCount; i++) {
+    _sourceInputRoutes[i] = 0;
+  }
 }
 
 SKHub::~SKHub() {
+  delete[] _queue;
+  delete[] _queueRecipients;
 }
 
-void SKHub::subscribe(SKSubscriber* subscriber) {
-  _subscribers.add(subscriber);
+bool SKHub::subscribe(SKSubscriber* subscriber) {
+  if (!subscribe(subscriber, SKSubscriptionFilter::allPaths())) {
+    return false;
+  }
+  _unfilteredSubscribers |= (uint32_t)1 << (_subscribersCount - 1);
+  return true;
+}
+
+bool SKHub::subscribe(SKSubscriber* subscriber, const SKSubscriptionFilter &filter) {
+  if (_subscribersCount >= MaxSubscribers) {
+    ERROR("Too many subscribers on SKHub (max %i)", MaxSubscribers);
+    return false;
+  }
+
+  uint32_t mask = (uint32_t)1 << _subscribersCount;
+  _subscribers[_subscribersCount++] = subscriber;
+
+  for (int p = 0; p < SKPathEnumCount; p++) {
+    if (filter.matchesPath((SKPathEnum)p)) {
+      _pathRoutes[p] |= mask;
+    }
+  }
+  for (int i = 0; i < SKSourceInputCount; i++) {
+    if (filter.matchesSourceInput((SKSourceInput)i)) {
+      _sourceInputRoutes[i] |= mask;
+    }
+  }
+  return true;
+}
+
+uint32_t SKHub::recipientsForUpdate(const SKUpdate &update) const {
+  uint32_t recipients = 0;
+  for (int i = 0; i < update.getSize(); i++) {
+    recipients |= _pathRoutes[update.getPath(i).getStaticPath()];
+  }
+
+  SKSourceInput input = update.getSource().getInput();
+  if (input >= 0 && input < SKSourceInputCount) {
+    recipients &= _sourceInputRoutes[input];
+  }
+  return recipients | _unfilteredSubscribers;
+}
+
+void SKHub::deliver(const SKUpdate &update, uint32_t recipients) {
+  for (int s = 0; recipients != 0; s++, recipients >>= 1) {
+    if (recipients & 1) {
+      _subscribers[s]->updateReceived(update);
+    }
+  }
 }
 
 void SKHub::publish(const SKUpdate& update) {
-  for (LinkedListIterator<SKSubscriber*> it = _subscribers.begin(); it != _subscribers.end(); it++) {
-    (*it)->updateReceived(update);
+  if (_multiplexer != nullptr && update.getSize() > SelectedUpdateMaxValues) {
+    // The selected values would not fit in publishSelected(): deliver the
+    // update unchanged rather than losing some of its values.
+    KBoxMetrics.event(KBoxEventSKHubUpdateNotFiltered);
+  }
+  else if (_multiplexer != nullptr) {
+    uint32_t suppressed = _multiplexer->suppressedValues(update, millis());
+    if (suppressed != 0) {
+      publishSelected(update, suppressed);
+      return;
+    }
   }
+  route(update);
+}
+
+void SKHub::publishSelected(const SKUpdate &update, uint32_t suppressed) {
+  // The multiplexer only filters updates about self, the copy can use the
+  // default context.
+  SKUpdateStatic<SelectedUpdateMaxValues> selected;
+  selected.setSource(update.getSource());
+  selected.setTimestamp(update.getTimestamp());
+  for (int i = 0; i < update.getSize(); i++) {
+    if (suppressed & ((uint32_t)1 << i)) {
+      continue;
+    }
+    selected.setValue(update.getPath(i), update.getValue(i));
+  }
+  if (selected.getSize() > 0) {
+    route(selected);
+  }
+}
+
+void SKHub::route(const SKUpdate& update) {
+  uint32_t recipients = recipientsForUpdate(update);
+  if (recipients == 0) {
+    return;
+  }
+
+  if (_queue == nullptr || update.getSize() > QueuedUpdateMaxValues
+      || &update.getContext() != &SKContextSelf) {
+    deliver(update, recipients);
+    return;
+  }
+
+  if (_queueCount >= _queueCapacity) {
+    KBoxMetrics.event(KBoxEventSKHubQueueDropped);
+    return;
+  }
+
+  uint16_t tail = (_queueHead + _queueCount) % _queueCapacity;
+  SKUpdateStatic<QueuedUpdateMaxValues> &slot = _queue[tail];
+  slot.clear();
+  slot.setSource(update.getSource());
+  slot.setTimestamp(update.getTimestamp());
+  for (int i = 0; i < update.getSize(); i++) {
+    slot.setValue(update.getPath(i), update.getValue(i));
+  }
+  _queueRecipients[tail] = recipients;
+
+  _queueCount++;
+  if (_queueCount > _queueHighWaterMark) {
+    _queueHighWaterMark = _queueCount;
+  }
+}
+
+void SKHub::enableQueue(uint16_t capacity) {
+  if (_queue != nullptr || capacity == 0) {
+    return;
+  }
+  _queue = new SKUpdateStatic<QueuedUpdateMaxValues>[capacity];
+  _queueRecipients = new uint32_t[capacity];
+  _queueCapacity = capacity;
+}
+
+bool SKHub::dispatchQueued() {
+  if (_queueCount == 0) {
+    return false;
+  }
+
+  uint16_t head = _queueHead;
+  // Release the slot only after delivery: a subscriber publishing from
+  // updateReceived() must not overwrite the update being delivered.
+  deliver(_queue[head], _queueRecipients[head]);
+  _queueHead = (_queueHead + 1) % _queueCapacity;
+  _queueCount--;
+  return true;
 }
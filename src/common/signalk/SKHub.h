@@ -24,9 +24,11 @@
 
 #pragma once
 
-#include "common/algo/List.h"
+#include <stdint.h>
+#include "SKSubscriptionFilter.h"
+#include "SKUpdateStatic.h"
 
-class SKUpdate;
+class SKSourceMultiplexer;
 class SKSubscriber;
 
 /** An instance of SKHub is used to concentrate SignalK updates and distributes
@@ -34,6 +36,13 @@ class SKSubscriber;
  *
  * An instance of SKSubscriber can subscribe to updates with a filter defining
  * which updates to get.
+ *
+ * By default, updates are delivered to the subscribers from within publish().
+ * In queued mode, publish() copies the update in a ring buffer and the
+ * updates are delivered later when dispatchQueued() is called.
+ *
+ * With a multiplexer, values which are already provided by a preferred input
+ * are removed from the updates before they reach the subscribers.
  */
 class SKHub {
   public:
@@ -41,18 +50,118 @@ class SKHub {
     ~SKHub();
 
     /**
-     * Adds a new subscriber which will be notified when updates
-     * are received by the hub.
+     * Maximum number of subscribers on one hub.
+     */
+    static const int MaxSubscribers = 32;
+
+    /**
+     * Adds a new subscriber which will be notified of all the updates
+     * received by the hub.
+     *
+     * @return false if the hub already has MaxSubscribers subscribers.
      */
-    void subscribe(SKSubscriber* subscriber);
+    bool subscribe(SKSubscriber* subscriber);
 
     /**
-     * Publish a new update on the hub. All the subscribers will be notified.
+     * Adds a new subscriber which will only be notified of updates matching
+     * the filter.
+     *
+     * @return false if the hub already has MaxSubscribers subscribers.
+     */
+    bool subscribe(SKSubscriber* subscriber, const SKSubscriptionFilter &filter);
+
+    /**
+     * Publish a new update on the hub. Subscribers whose filter matches the
+     * update will be notified, in the order they subscribed.
      * They should process the update as fast as possible and return control so
      * that calling publish should never take "a long time".
+     *
+     * In queued mode, the update is copied and will be delivered by
+     * dispatchQueued(). If the queue is full, the update is dropped.
+     * Updates which can not be copied in the queue (more than
+     * QueuedUpdateMaxValues values or a context other than SKContextSelf) are
+     * delivered immediately.
+     *
+     * If a multiplexer is set, the values it suppresses are removed first and
+     * an update left without values is not delivered at all.
      */
     void publish(const SKUpdate&);
 
+    /**
+     * Maximum number of values kept when the multiplexer removes some values
+     * from an update. Larger updates are not filtered.
+     */
+    static const uint16_t SelectedUpdateMaxValues = 16;
+
+    /**
+     * Filter the updates published with this multiplexer. The multiplexer is
+     * not owned by the hub.
+     */
+    void setMultiplexer(SKSourceMultiplexer *multiplexer) {
+      _multiplexer = multiplexer;
+    };
+
+    /**
+     * Maximum number of values in an update copied in the queue.
+     */
+    static const uint16_t QueuedUpdateMaxValues = 8;
+
+    /**
+     * Switch the hub to queued mode. Memory for `capacity` updates is
+     * allocated once here.
+     */
+    void enableQueue(uint16_t capacity);
+
+    bool isQueued() const {
+      return _queue != nullptr;
+    };
+
+    /**
+     * Delivers the oldest update of the queue to its subscribers.
+     *
+     * @return false if the queue was empty.
+     */
+    bool dispatchQueued();
+
+    /**
+     * Number of updates waiting in the queue.
+     */
+    uint16_t getQueueDepth() const {
+      return _queueCount;
+    };
+
+    /**
+     * Maximum number of updates that were waiting in the queue at the same
+     * time.
+     */
+    uint16_t getQueueHighWaterMark() const {
+      return _queueHighWaterMark;
+    };
+
   private:
-    LinkedList<SKSubscriber*> _subscribers;
+    SKSubscriber* _subscribers[MaxSubscribers];
+    int _subscribersCount;
+
+    // Routing table: for each path (and each source input) a bitmask of the
+    // subscribers (by subscription index) interested in it.
+    uint32_t _pathRoutes[SKPathEnumCount];
+    uint32_t _sourceInputRoutes[SKSourceInputCount];
+
+    // Subscribers without a filter get every update, even empty ones.
+    uint32_t _unfilteredSubscribers;
+
+    SKSourceMultiplexer *_multiplexer;
+
+    // Ring buffer of updates (and their recipients) for queued mode.
+    SKUpdateStatic<QueuedUpdateMaxValues> *_queue;
+    uint32_t *_queueRecipients;
+    uint16_t _queueCapacity;
+    uint16_t _queueHead;
+    uint16_t _queueCount;
+    uint16_t _queueHighWaterMark;
+
+    uint32_t recipientsForUpdate(const SKUpdate &update) const;
+    void publishSelected(const SKUpdate &update, uint32_t suppressed);
+    void route(const SKUpdate &update);
+    void deliver(const SKUpdate &update, uint32_t recipients);
 };
@@ -0,0 +1,90 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <string.h>
+#include "common/stats/KBoxMetrics.h"
+#include "SKIndexTable.h"
+
+SKIndexTable skIndexTable;
+
+SKIndexId SKIndexTable::find(const char *name) const {
+  if (name == nullptr) {
+    return SKIndexInvalid;
+  }
+  for (int i = 0; i < _count; i++) {
+    if (strcmp(_names[i], name) == 0) {
+      return i + 1;
+    }
+  }
+  return SKIndexInvalid;
+}
+
+SKIndexId SKIndexTable::add(const char *name) {
+  if (name == nullptr) {
+    return SKIndexInvalid;
+  }
+  size_t len = strlen(name);
+  if (len == 0 || len > MaxIndexLength) {
+    return SKIndexInvalid;
+  }
+  if (_count >= MaxIndexes) {
+    KBoxMetrics.event(KBoxEventSKIndexTableFull);
+    return SKIndexInvalid;
+  }
+
+  memcpy(_names[_count], name, len + 1);
+  _count++;
+  return _count;
+}
+
+SKIndexId SKIndexTable::intern(const char *name) {
+  SKIndexId id = find(name);
+  if (id != SKIndexInvalid) {
+    return id;
+  }
+  return add(name);
+}
+
+SKIndexId SKIndexTable::internInput(const char *name) {
+  SKIndexId id = find(name);
+  if (id != SKIndexInvalid) {
+    return id;
+  }
+  if (_inputCount >= MaxInputIndexes) {
+    KBoxMetrics.event(KBoxEventSKIndexTableFull);
+    return SKIndexInvalid;
+  }
+  id = add(name);
+  if (id != SKIndexInvalid) {
+    _inputCount++;
+  }
+  return id;
+}
+
+const char* SKIndexTable::name(SKIndexId id) const {
+  if (id == SKIndexInvalid || id > _count) {
+    return "";
+  }
+  return _names[id - 1];
+}
@@ -0,0 +1,111 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Small integer identifying an interned path index (like "engine" in
+ * electrical.batteries.engine.voltage).
+ *
+ * 0 is never a valid identifier.
+ */
+typedef uint8_t SKIndexId;
+
+static const SKIndexId SKIndexInvalid = 0;
+
+/**
+ * Fixed-capacity table of the index strings used by indexed SKPath.
+ *
+ * Strings are copied in the table the first time they are interned and are
+ * never released. Once interned, an index is represented by its id so
+ * SKPath can be copied and compared without touching the heap.
+ *
+ * Names received from the NMEA inputs are interned with internInput(), which
+ * can only use MaxInputIndexes entries: a device sending many different names
+ * can not take the room of the names used by KBox itself.
+ */
+class SKIndexTable {
+  public:
+    static const int MaxIndexes = 32;
+    static const int MaxIndexLength = 23;
+    static const int MaxInputIndexes = 24;
+
+  private:
+    char _names[MaxIndexes][MaxIndexLength + 1];
+    int _count;
+    int _inputCount;
+
+    SKIndexId add(const char *name);
+
+  public:
+    /**
+     * constexpr so that the global instance is initialized before any other
+     * static object (which might intern an index in its constructor).
+     */
+    constexpr SKIndexTable() : _names(), _count(0), _inputCount(0) {};
+
+    /**
+     * Returns the id of this index, adding it to the table if needed.
+     *
+     * Returns SKIndexInvalid if the name is empty, too long or if the table
+     * is full.
+     */
+    SKIndexId intern(const char *name);
+
+    /**
+     * Same as intern() for a name received from one of the inputs. New names
+     * are refused once MaxInputIndexes names were added this way.
+     */
+    SKIndexId internInput(const char *name);
+
+    /**
+     * Returns the id of this index if it was already interned,
+     * SKIndexInvalid otherwise.
+     */
+    SKIndexId find(const char *name) const;
+
+    /**
+     * Returns the string for this id, or an empty string if the id is not
+     * valid.
+     */
+    const char* name(SKIndexId id) const;
+
+    /**
+     * Number of indexes currently interned.
+     */
+    int size() const {
+      return _count;
+    };
+
+    /**
+     * Number of indexes added by internInput().
+     */
+    int inputSize() const {
+      return _inputCount;
+    };
+};
+
+extern SKIndexTable skIndexTable;
@@ -34,6 +34,12 @@
 #include "SKVisitor.generated.h"
 
 
+/**
+ * Converts a SKUpdate into an ArduinoJson tree.
+ *
+ * To print the JSON, prefer SKJSONWriter which produces the same output
+ * without building the tree.
+ */
 class SKJSONVisitor {
   private:
     const String _vesselURN;
@@ -0,0 +1,444 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <math.h>
+#include "SKJSONWriter.h"
+#include "SKUnits.h"
+
+/*
+ * ArduinoJson stores numbers as float in embedded mode and as double
+ * everywhere else. We need to do the same to format them identically.
+ */
+#if defined(ARDUINO)
+typedef float SKJSONFloat;
+#else
+typedef double SKJSONFloat;
+#endif
+
+template <typename TFloat> struct SKJSONFloatTraits;
+
+template <> struct SKJSONFloatTraits<double> {
+  static const int binaryPowers = 9;
+  static const int decimalPlaces = 9;
+  static const uint32_t maxDecimalPart = 1000000000;
+
+  static double positivePowerOfTen(int index) {
+    static const double powers[] = { 1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256 };
+    return powers[index];
+  };
+
+  static double negativePowerOfTen(int index) {
+    static const double powers[] = { 1e-1, 1e-2, 1e-4, 1e-8, 1e-16, 1e-32, 1e-64, 1e-128, 1e-256 };
+    return powers[index];
+  };
+
+  static double negativePowerOfTenPlusOne(int index) {
+    static const double powers[] = { 1e0, 1e-1, 1e-3, 1e-7, 1e-15, 1e-31, 1e-63, 1e-127, 1e-255 };
+    return powers[index];
+  };
+};
+
+template <> struct SKJSONFloatTraits<float> {
+  static const int binaryPowers = 6;
+  static const int decimalPlaces = 6;
+  static const uint32_t maxDecimalPart = 1000000;
+
+  static float positivePowerOfTen(int index) {
+    static const float powers[] = { 1e1f, 1e2f, 1e4f, 1e8f, 1e16f, 1e32f };
+    return powers[index];
+  };
+
+  static float negativePowerOfTen(int index) {
+    static const float powers[] = { 1e-1f, 1e-2f, 1e-4f, 1e-8f, 1e-16f, 1e-32f };
+    return powers[index];
+  };
+
+  static float negativePowerOfTenPlusOne(int index) {
+    static const float powers[] = { 1e0f, 1e-1f, 1e-3f, 1e-7f, 1e-15f, 1e-31f };
+    return powers[index];
+  };
+};
+
+/*
+ * Small helper to write JSON tokens and count the bytes written.
+ */
+class SKJSONStream {
+  private:
+    Print &_out;
+    size_t _count;
+
+  public:
+    SKJSONStream(Print &out) : _out(out), _count(0) {};
+
+    size_t count() const {
+      return _count;
+    };
+
+    void raw(char c) {
+      _count += _out.write((uint8_t)c);
+    };
+
+    void raw(const char *s) {
+      _count += _out.write(s);
+    };
+
+    // Escapes the same characters as ArduinoJson.
+    void escaped(const char *s) {
+      for (; *s; s++) {
+        switch (*s) {
+          case '"': raw("\\\""); break;
+          case '\\': raw("\\\\"); break;
+          case '\b': raw("\\b"); break;
+          case '\f': raw("\\f"); break;
+          case '\n': raw("\\n"); break;
+          case '\r': raw("\\r"); break;
+          case '\t': raw("\\t"); break;
+          default: raw(*s);
+        }
+      }
+    };
+
+    void string(const char *s) {
+      raw('"');
+      escaped(s);
+      raw('"');
+    };
+
+    void key(const char *k) {
+      raw('"');
+      raw(k);
+      raw("\":");
+    };
+
+    void integer(uint32_t n) {
+      char digits[11];
+      char *p = digits + sizeof(digits) - 1;
+      *p = 0;
+      do {
+        *--p = '0' + n % 10;
+        n /= 10;
+      } while (n > 0);
+      raw(p);
+    };
+
+    void number(double n) {
+      writeFloat<SKJSONFloat>(n);
+    };
+
+  private:
+    /*
+     * Same algorithm as ArduinoJson: at most 9 significant decimals for
+     * doubles (6 for floats), trailing zeros removed and exponent notation
+     * outside of [1e-5, 1e7).
+     */
+    template <typename TFloat> void writeFloat(TFloat value) {
+      typedef SKJSONFloatTraits<TFloat> traits;
+
+      if (isnan(value)) {
+        raw("NaN");
+        return;
+      }
+      if (value < 0.0) {
+        raw('-');
+        value = -value;
+      }
+      if (isinf(value)) {
+        raw("Infinity");
+        return;
+      }
+
+      // Normalize the value in [1, 10) if it is very large or very small
+      int exponent = 0;
+      int index = traits::binaryPowers - 1;
+      int bit = 1 << index;
+      if (value >= 1e7) {
+        for (; index >= 0; index--) {
+          if (value >= traits::positivePowerOfTen(index)) {
+            value *= traits::negativePowerOfTen(index);
+            exponent += bit;
+          }
+          bit >>= 1;
+        }
+      }
+      if (value > 0 && value <= 1e-5) {
+        for (; index >= 0; index--) {
+          if (value < traits::negativePowerOfTenPlusOne(index)) {
+            value *= traits::positivePowerOfTen(index);
+            exponent -= bit;
+          }
+          bit >>= 1;
+        }
+      }
+
+      uint32_t integral = uint32_t(value);
+      uint32_t maxDecimalPart = traits::maxDecimalPart;
+      int decimalPlaces = traits::decimalPlaces;
+      for (uint32_t tmp = integral; tmp >= 10; tmp /= 10) {
+        maxDecimalPart /= 10;
+        decimalPlaces--;
+      }
+
+      TFloat remainder = (value - TFloat(integral)) * TFloat(maxDecimalPart);
+      uint32_t decimal = uint32_t(remainder);
+      remainder = remainder - TFloat(decimal);
+
+      // Round up if remainder >= 0.5
+      decimal += uint32_t(remainder * 2);
+      if (decimal >= maxDecimalPart) {
+        decimal = 0;
+        integral++;
+        if (exponent && integral >= 10) {
+          exponent++;
+          integral = 1;
+        }
+      }
+
+      while (decimal % 10 == 0 && decimalPlaces > 0) {
+        decimal /= 10;
+        decimalPlaces--;
+      }
+
+      integer(integral);
+      if (decimalPlaces > 0) {
+        char decimals[16];
+        char *p = decimals + sizeof(decimals) - 1;
+        *p = 0;
+        while (decimalPlaces--) {
+          *--p = '0' + decimal % 10;
+          decimal /= 10;
+        }
+        *--p = '.';
+        raw(p);
+      }
+      if (exponent < 0) {
+        raw("e-");
+        integer(-exponent);
+      }
+      if (exponent > 0) {
+        raw('e');
+        integer(exponent);
+      }
+    };
+};
+
+/*
+ * Print into a fixed size buffer, always keeping room for the terminating 0.
+ */
+class SKJSONBufferPrint : public Print {
+  private:
+    char *_buffer;
+    size_t _size;
+    size_t _index;
+
+  public:
+    SKJSONBufferPrint(char *buffer, size_t size) : _buffer(buffer), _size(size), _index(0) {};
+
+    size_t write(uint8_t c) override {
+      if (_index + 1 >= _size) {
+        return 0;
+      }
+      _buffer[_index++] = c;
+      return 1;
+    };
+
+    size_t terminate() {
+      if (_size > 0) {
+        _buffer[_index] = 0;
+      }
+      return _index;
+    };
+};
+
+/*
+ * Print appending to a String. Only used to prepare the header once.
+ */
+class SKJSONStringPrint : public Print {
+  private:
+    String &_string;
+
+  public:
+    SKJSONStringPrint(String &s) : _string(s) {};
+
+    size_t write(uint8_t c) override {
+      _string += (char)c;
+      return 1;
+    };
+};
+
+static void writeSource(SKJSONStream &json, const SKSource &source) {
+  json.raw('{');
+  switch (source.getInput()) {
+    case SKSourceInputUnknown:
+      json.raw("\"label\":\"unknown\",\"type\":\"unknown\"");
+      break;
+    case SKSourceInputNMEA2000:
+      json.raw("\"label\":\"NMEA2000\",\"type\":\"NMEA2000\",\"pgn\":");
+      json.integer(source.getPGN());
+      json.raw(",\"src\":\"");
+      json.integer(source.getSourceAddress());
+      json.raw("\",\"priority\":");
+      json.integer(source.getPriority());
+      break;
+    case SKSourceInputNMEA0183_1:
+    case SKSourceInputNMEA0183_2:
+      // SKJSONVisitor has always labelled both NMEA0183 inputs "NMEA0183.2"
+      json.raw("\"label\":\"NMEA0183.2\",\"type\":\"NMEA0183\",\"talker\":");
+      json.string(source.getTalker());
+      json.raw(",\"sentence\":");
+      json.string(source.getSentence());
+      break;
+    case SKSourceInputKBoxIMU:
+      json.raw("\"label\":\"KBox.IMU\"");
+      break;
+    case SKSourceInputKBoxADC:
+      json.raw("\"label\":\"KBox.ADC\"");
+      break;
+    case SKSourceInputKBoxBarometer:
+      json.raw("\"label\":\"KBox.Barometer\"");
+      break;
+  }
+  json.raw('}');
+}
+
+static void writeTime(SKJSONStream &json, const SKTime &time) {
+  char buffer[SKTime::MaxStringLength + 1];
+  time.toString(buffer, sizeof(buffer));
+  json.string(buffer);
+}
+
+static void writeValue(SKJSONStream &json, const SKValue &v) {
+  switch (v.getType()) {
+    case SKValue::SKValueTypeNone:
+      json.raw("{}");
+      break;
+    case SKValue::SKValueTypeNumber:
+      json.number(v.getNumberValue());
+      break;
+    case SKValue::SKValueTypeAttitude:
+      {
+        SKTypeAttitude attitude = v.getAttitudeValue();
+        const char *separator = "";
+        json.raw('{');
+        if (attitude.pitch != SKDoubleNAN) {
+          json.key("pitch");
+          json.number(attitude.pitch);
+          separator = ",";
+        }
+        if (attitude.roll != SKDoubleNAN) {
+          json.raw(separator);
+          json.key("roll");
+          json.number(attitude.roll);
+          separator = ",";
+        }
+        if (attitude.yaw != SKDoubleNAN) {
+          json.raw(separator);
+          json.key("yaw");
+          json.number(attitude.yaw);
+        }
+        json.raw('}');
+      }
+      break;
+    case SKValue::SKValueTypePosition:
+      {
+        SKTypePosition position = v.getPositionValue();
+        json.raw("{\"latitude\":");
+        json.number(position.latitude);
+        json.raw(",\"longitude\":");
+        json.number(position.longitude);
+        if (position.altitude != SKDoubleNAN) {
+          json.raw(",\"altitude\":");
+          json.number(position.altitude);
+        }
+        json.raw('}');
+      }
+      break;
+    case SKValue::SKValueTypeTimestamp:
+      writeTime(json, v.getTimestampValue());
+      break;
+  }
+}
+
+static String contextHeader(const char *urn) {
+  String header;
+  SKJSONStringPrint out(header);
+  SKJSONStream json(out);
+
+  json.raw("{\"context\":\"vessels.");
+  json.escaped(urn);
+  json.raw("\",\"updates\":[{\"source\":");
+  return header;
+}
+
+SKJSONWriter::SKJSONWriter(const String &vesselURN) : _selfHeader(contextHeader(vesselURN.c_str())) {
+}
+
+void SKJSONWriter::setVesselURN(const String &vesselURN) {
+  _selfHeader = contextHeader(vesselURN.c_str());
+}
+
+size_t SKJSONWriter::write(const SKUpdate &update, Print &out) const {
+  SKJSONStream json(out);
+
+  if (update.getContext() == SKContextSelf) {
+    json.raw(_selfHeader.c_str());
+  }
+  else {
+    json.raw("{\"context\":\"vessels.");
+    json.escaped(update.getContext().getURN().c_str());
+    json.raw("\",\"updates\":[{\"source\":");
+  }
+  writeSource(json, update.getSource());
+
+  if (update.getTimestamp().getTime() != 0) {
+    json.raw(",\"timestamp\":");
+    writeTime(json, update.getTimestamp());
+  }
+
+  json.raw(",\"values\":[");
+  for (int i = 0; i < update.getSize(); i++) {
+    const SKPath &p = update.getPath(i);
+
+    if (i > 0) {
+      json.raw(',');
+    }
+    json.raw("{\"path\":\"");
+    json.escaped(p.getPathPrefix());
+    if (p.isIndexed()) {
+      json.escaped(p.getIndex());
+      json.escaped(p.getPathSuffix());
+    }
+    json.raw("\",\"value\":");
+    writeValue(json, update.getValue(i));
+    json.raw('}');
+  }
+  json.raw("]}]}");
+
+  return json.count();
+}
+
+size_t SKJSONWriter::write(const SKUpdate &update, char *buffer, size_t size) const {
+  SKJSONBufferPrint out(buffer, size);
+  write(update, out);
+  return out.terminate();
+}
@@ -0,0 +1,65 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <Print.h>
+#include <WString.h>
+#include "SKUpdate.h"
+
+/**
+ * Writes SKUpdate as SignalK delta JSON directly to a Print.
+ *
+ * Nothing is allocated while writing: path strings come from the static
+ * table behind SKPath::getPathPrefix() and the beginning of the delta for our
+ * own vessel is rendered once in the constructor.
+ *
+ * The output is the same, byte for byte, as what SKJSONVisitor produces with
+ * ArduinoJson (including the way numbers are formatted).
+ */
+class SKJSONWriter {
+  private:
+    String _selfHeader;
+
+  public:
+    SKJSONWriter(const String &vesselURN);
+
+    /**
+     * Change the URN used for updates about our own vessel.
+     */
+    void setVesselURN(const String &vesselURN);
+
+    /**
+     * Write the update to out and return the number of bytes written.
+     */
+    size_t write(const SKUpdate &update, Print &out) const;
+
+    /**
+     * Write the update in a null-terminated string. The output is truncated
+     * if the buffer is too small.
+     *
+     * Returns the length of the string.
+     */
+    size_t write(const SKUpdate &update, char *buffer, size_t size) const;
+};
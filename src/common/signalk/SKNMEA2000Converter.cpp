@@ -30,80 +30,148 @@
 #include "SKValue.h"
 #include "SKUnits.h"
 
+const SKNMEA2000Converter::GeneratorEntry SKNMEA2000Converter::_generators[] = {
+  { SKPathElectricalBatteriesVoltage, &SKNMEA2000Converter::generateBatteryStatus },
+  { SKPathEnvironmentOutsidePressure, &SKNMEA2000Converter::generatePressure },
+  { SKPathEnvironmentOutsideTemperature, &SKNMEA2000Converter::generateTemperature },
+  { SKPathNavigationAttitude, &SKNMEA2000Converter::generateAttitude },
+  { SKPathNavigationSpeedOverGround, &SKNMEA2000Converter::generateCOGSOG },
+  { SKPathNavigationHeadingMagnetic, &SKNMEA2000Converter::generateHeading },
+  { SKPathEnvironmentWindAngleApparent, &SKNMEA2000Converter::generateWindApparent },
+  { SKPathEnvironmentWindAngleTrueWater, &SKNMEA2000Converter::generateWindTrueWater },
+  { SKPathEnvironmentWindAngleTrueGround, &SKNMEA2000Converter::generateWindTrueGround },
+  { SKPathEnvironmentWindDirectionMagnetic, &SKNMEA2000Converter::generateWindMagnetic },
+  { SKPathEnvironmentWindDirectionTrue, &SKNMEA2000Converter::generateWindTrueNorth },
+};
+
+SKPathDispatchTable SKNMEA2000Converter::buildDispatchTable() {
+  static_assert(sizeof(_generators) / sizeof(_generators[0]) <= SKPathDispatchTable::MaxHandlers,
+                "Too many generators for one dispatch table");
+
+  SKPathDispatchTable table;
+  for (unsigned int i = 0; i < sizeof(_generators) / sizeof(_generators[0]); i++) {
+    table.add(_generators[i].trigger, i);
+  }
+  return table;
+}
+
+const SKPathDispatchTable SKNMEA2000Converter::_dispatchTable = SKNMEA2000Converter::buildDispatchTable();
+
 void SKNMEA2000Converter::convert(const SKUpdate& update, SKNMEA2000Output& out) {
+  // Updates about other vessels (AIS targets) must not be sent as our own
+  // data.
+  if (&update.getContext() != &SKContextSelf) {
+    return;
+  }
+
+  _currentOutput = &out;
+
+  uint32_t generators = _dispatchTable.handlersForUpdate(update);
+  for (int g = 0; generators != 0; g++, generators >>= 1) {
+    if (generators & 1) {
+      (this->*_generators[g].generate)(update, out);
+    }
+  }
+}
+
+void SKNMEA2000Converter::generateBatteryStatus(const SKUpdate& update, SKNMEA2000Output& out) {
   // Trigger a call of visitSKElectricalBatteriesVoltage for every key with that path
   // (there can be more than one and we do not know how they are called)
-  _currentOutput = &out;
   update.accept(*this, SKPathElectricalBatteriesVoltage);
+}
 
-  if (update.hasEnvironmentOutsidePressure()) {
-    tN2kMsg msg;
-    // PGN 130310 seems to be better supported
-    SetN2kOutsideEnvironmentalParameters(msg, 0, N2kDoubleNA, N2kDoubleNA, update.getEnvironmentOutsidePressure());
-    out.write(msg);
-    // PGN 130314 is more specific and more precise (.1) to pressure but not supported by all displays (ie: Raymarine i70)
-    SetN2kPressure(msg, /* sid */ 0, /* source */ 0, N2kps_Atmospheric, update.getEnvironmentOutsidePressure());
-    out.write(msg);
-  }
+void SKNMEA2000Converter::generatePressure(const SKUpdate& update, SKNMEA2000Output& out) {
+  tN2kMsg msg;
+  // PGN 130310 seems to be better supported
+  SetN2kOutsideEnvironmentalParameters(msg, 0, N2kDoubleNA, N2kDoubleNA, update.getEnvironmentOutsidePressure());
+  out.write(msg);
+  // PGN 130314 is more specific and more precise (.1) to pressure but not supported by all displays (ie: Raymarine i70)
+  SetN2kPressure(msg, /* sid */ 0, /* source */ 0, N2kps_Atmospheric, update.getEnvironmentOutsidePressure());
+  out.write(msg);
+}
 
-  if (update.hasEnvironmentOutsideTemperature()) {
-    tN2kMsg msg;
-    // PGN 130310 seems to be better supported
-    SetN2kOutsideEnvironmentalParameters(msg, 0, N2kDoubleNA, update.getEnvironmentOutsideTemperature(), N2kDoubleNA);
-    out.write(msg);
-  }
+void SKNMEA2000Converter::generateTemperature(const SKUpdate& update, SKNMEA2000Output& out) {
+  tN2kMsg msg;
+  // PGN 130310 seems to be better supported
+  SetN2kOutsideEnvironmentalParameters(msg, 0, N2kDoubleNA, update.getEnvironmentOutsideTemperature(), N2kDoubleNA);
+  out.write(msg);
+}
 
-  if (update.hasNavigationAttitude()) {
-    tN2kMsg msg;
-    SKTypeAttitude attitude = update.getNavigationAttitude();
-    SetN2kAttitude(msg, 0, attitude.yaw, attitude.pitch, attitude.roll);
-    out.write(msg);
-  }
+void SKNMEA2000Converter::generateAttitude(const SKUpdate& update, SKNMEA2000Output& out) {
+  tN2kMsg msg;
+  SKTypeAttitude attitude = update.getNavigationAttitude();
+  SetN2kAttitude(msg, 0, attitude.yaw, attitude.pitch, attitude.roll);
+  out.write(msg);
+}
 
-  // PGN 129026: Fast COG/SOG
-  if (update.hasNavigationSpeedOverGround() && update.hasNavigationCourseOverGroundTrue()) {
+// PGN 129026: Fast COG/SOG
+void SKNMEA2000Converter::generateCOGSOG(const SKUpdate& update, SKNMEA2000Output& out) {
+  if (update.hasNavigationCourseOverGroundTrue()) {
     tN2kMsg msg;
     SetN2kPGN129026(msg, (uint8_t)0, N2khr_true,
         update.getNavigationCourseOverGroundTrue(),
         update.getNavigationSpeedOverGround());
     out.write(msg);
   }
+}
 
-  if (update.hasNavigationHeadingMagnetic()) {
-    tN2kMsg msg;
-    SetN2kMagneticHeading(msg, 0, update.getNavigationHeadingMagnetic());
-    out.write(msg);
-  }
+void SKNMEA2000Converter::generateHeading(const SKUpdate& update, SKNMEA2000Output& out) {
+  tN2kMsg msg;
+  SetN2kMagneticHeading(msg, 0, update.getNavigationHeadingMagnetic());
+  out.write(msg);
+}
 
-  if (update.hasEnvironmentWindAngleApparent() && update.hasEnvironmentWindSpeedApparent()) {
+void SKNMEA2000Converter::generateWindApparent(const SKUpdate& update, SKNMEA2000Output& out) {
+  if (update.hasEnvironmentWindSpeedApparent()) {
     generateWind(out, update.getEnvironmentWindAngleApparent(), update.getEnvironmentWindSpeedApparent(), N2kWind_Apparent);
   }
+}
 
-  if (update.hasEnvironmentWindAngleTrueWater() && update.hasEnvironmentWindSpeedTrue()) {
+void SKNMEA2000Converter::generateWindTrueWater(const SKUpdate& update, SKNMEA2000Output& out) {
+  if (update.hasEnvironmentWindSpeedTrue()) {
     generateWind(out, update.getEnvironmentWindAngleTrueWater(), update.getEnvironmentWindSpeedTrue(), N2kWind_True_water);
   }
+}
 
-  if (update.hasEnvironmentWindAngleTrueGround() && update.hasEnvironmentWindSpeedOverGround()) {
+void SKNMEA2000Converter::generateWindTrueGround(const SKUpdate& update, SKNMEA2000Output& out) {
+  if (update.hasEnvironmentWindSpeedOverGround()) {
     generateWind(out, update.getEnvironmentWindAngleTrueGround(), update.getEnvironmentWindSpeedOverGround(), N2kWind_True_boat);
   }
+}
 
-  if (update.hasEnvironmentWindDirectionMagnetic() && update.hasEnvironmentWindSpeedOverGround()) {
+void SKNMEA2000Converter::generateWindMagnetic(const SKUpdate& update, SKNMEA2000Output& out) {
+  if (update.hasEnvironmentWindSpeedOverGround()) {
     generateWind(out, update.getEnvironmentWindDirectionMagnetic(), update.getEnvironmentWindSpeedOverGround(), N2kWind_Magnetic);
   }
+}
 
-  if (update.hasEnvironmentWindDirectionTrue() && update.hasEnvironmentWindSpeedOverGround()) {
+void SKNMEA2000Converter::generateWindTrueNorth(const SKUpdate& update, SKNMEA2000Output& out) {
+  if (update.hasEnvironmentWindSpeedOverGround()) {
     generateWind(out, update.getEnvironmentWindDirectionTrue(), update.getEnvironmentWindSpeedOverGround(), N2kWind_True_North);
   }
 }
 
+SKSubscriptionFilter SKNMEA2000Converter::subscriptionFilter() {
+  SKSubscriptionFilter filter;
+  for (int p = 0; p < SKPathEnumCount; p++) {
+    if (_dispatchTable.hasHandlers((SKPathEnum)p)) {
+      filter.addPath((SKPathEnum)p);
+    }
+  }
+  return filter;
+}
+
 void SKNMEA2000Converter::visitSKElectricalBatteriesVoltage(const SKUpdate& u, const SKPath &p, const SKValue &v) {
   // PGN127508: Battery Status
   // FIXME: The mapping of Battery instance names to ids should be configurable
+  static const SKIndexId engineIndex = skIndexTable.intern("engine");
+  static const SKIndexId houseIndex = skIndexTable.intern("house");
+
   unsigned char instance = 255;
-  if (p.getIndex() == "engine") {
+  if (p.getIndexId() == engineIndex) {
     instance = 0;
   }
-  else if (p.getIndex() == "house") {
+  else if (p.getIndexId() == houseIndex) {
     instance = 1;
   }
 
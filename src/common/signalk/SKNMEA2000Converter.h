@@ -28,6 +28,8 @@
 #include "SKUpdate.h"
 #include "SKVisitor.generated.h"
 #include "SKNMEA2000Output.h"
+#include "SKPathDispatchTable.h"
+#include "SKSubscriptionFilter.h"
 
 /**
  * Converts one or multiple SignalK updates into a series of N2KMessages.
@@ -38,12 +40,43 @@ class SKNMEA2000Converter : private SKVisitor {
 
     void generateWind(SKNMEA2000Output &out, double windAngle, double windSpeed, tN2kWindReference windReference);
 
+    // Each generator outputs one PGN (or one per indexed value) and is
+    // triggered by the presence of one path in the update.
+    typedef void (SKNMEA2000Converter::*Generator)(const SKUpdate& update, SKNMEA2000Output& out);
+    struct GeneratorEntry {
+      SKPathEnum trigger;
+      Generator generate;
+    };
+    static const GeneratorEntry _generators[];
+    static const SKPathDispatchTable _dispatchTable;
+    static SKPathDispatchTable buildDispatchTable();
+
+    void generateBatteryStatus(const SKUpdate& update, SKNMEA2000Output& out);
+    void generatePressure(const SKUpdate& update, SKNMEA2000Output& out);
+    void generateTemperature(const SKUpdate& update, SKNMEA2000Output& out);
+    void generateAttitude(const SKUpdate& update, SKNMEA2000Output& out);
+    void generateCOGSOG(const SKUpdate& update, SKNMEA2000Output& out);
+    void generateHeading(const SKUpdate& update, SKNMEA2000Output& out);
+    void generateWindApparent(const SKUpdate& update, SKNMEA2000Output& out);
+    void generateWindTrueWater(const SKUpdate& update, SKNMEA2000Output& out);
+    void generateWindTrueGround(const SKUpdate& update, SKNMEA2000Output& out);
+    void generateWindMagnetic(const SKUpdate& update, SKNMEA2000Output& out);
+    void generateWindTrueNorth(const SKUpdate& update, SKNMEA2000Output& out);
+
   protected:
     void visitSKElectricalBatteriesVoltage(const SKUpdate& u, const SKPath &p, const SKValue &v) override;
 
   public:
     /**
      * Process a SKUpdate and add messages to the internal queue of messages.
+     *
+     * Only the generators depending on the paths present in the update are
+     * called, in the order of the _generators table.
      */
     void convert(const SKUpdate& update, SKNMEA2000Output& conversionOutput);
+
+    /**
+     * Returns a filter matching all the paths that can be converted.
+     */
+    static SKSubscriptionFilter subscriptionFilter();
 };
@@ -0,0 +1,149 @@
+// This file was automatically generated by sk-code-generator.py
+// DO NOT MODIFY! YOUR CHANGES WOULD BE OVERWRITTEN
+// Look at src/common/signalk/SKNMEA2000Descriptors.cpp.tmpl instead or modify the script
+// Generated on 2026-10-17 14:15:01.739539
+
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "SKNMEA2000Descriptors.h"
+
+bool skNMEA2000Decode126992(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode127245(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode127250(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode127251(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode127257(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode127258(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode127488(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode127505(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode127508(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode128259(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode128267(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode128275(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode129025(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode129026(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode129283(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode130306(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode130310(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode130314(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode130316(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode130577(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+bool skNMEA2000Decode130578(const SKSourceInput &input, const tN2kMsg &msg,
+                            const SKTime &timestamp, SKUpdate &update);
+
+const SKNMEA2000PGNDescriptor skNMEA2000PGNDescriptors[] = {
+  { 126992, skNMEA2000Decode126992 },
+  { 127245, skNMEA2000Decode127245 },
+  { 127250, skNMEA2000Decode127250 },
+  { 127251, skNMEA2000Decode127251 },
+  { 127257, skNMEA2000Decode127257 },
+  { 127258, skNMEA2000Decode127258 },
+  { 127488, skNMEA2000Decode127488 },
+  { 127505, skNMEA2000Decode127505 },
+  { 127508, skNMEA2000Decode127508 },
+  { 128259, skNMEA2000Decode128259 },
+  { 128267, skNMEA2000Decode128267 },
+  { 128275, skNMEA2000Decode128275 },
+  { 129025, skNMEA2000Decode129025 },
+  { 129026, skNMEA2000Decode129026 },
+  { 129283, skNMEA2000Decode129283 },
+  { 130306, skNMEA2000Decode130306 },
+  { 130310, skNMEA2000Decode130310 },
+  { 130314, skNMEA2000Decode130314 },
+  { 130316, skNMEA2000Decode130316 },
+  { 130577, skNMEA2000Decode130577 },
+  { 130578, skNMEA2000Decode130578 },
+};
+const size_t skNMEA2000PGNDescriptorsCount = sizeof(skNMEA2000PGNDescriptors) / sizeof(skNMEA2000PGNDescriptors[0]);
+
+// One bit per PGN, starting at firstPGN, set for the PGNs that are decoded.
+static const uint32_t firstPGN = 126992;
+static const uint32_t pgnBitmap[] = {
+  0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x20000000, 0x0000060c, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00010000, 0x00000012, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x08080000, 0x00000008, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00060000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00080000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x14440000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000006,
+};
+
+// Number of decoded PGNs before each word of pgnBitmap.
+static const uint8_t pgnRank[] = {
+  0, 1, 1, 1, 1, 1, 1, 1, 2, 6, 6, 6, 6, 6, 6, 6,
+  7, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+  9, 9, 9, 9, 9, 9, 9, 9, 11, 12, 12, 12, 12, 12, 12, 12,
+  12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+  14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, 15, 15, 15, 19, 19, 19, 19, 19, 19, 19, 19,
+  19,
+};
+
+const SKNMEA2000PGNDescriptor* skNMEA2000FindPGN(uint32_t pgn) {
+  // PGNs below firstPGN wrap around and are rejected too.
+  uint32_t bit = pgn - firstPGN;
+  if (bit >= sizeof(pgnBitmap) * 8) {
+    return nullptr;
+  }
+
+  uint32_t word = pgnBitmap[bit / 32];
+  uint32_t mask = (uint32_t)1 << (bit % 32);
+  if ((word & mask) == 0) {
+    return nullptr;
+  }
+  return &skNMEA2000PGNDescriptors[pgnRank[bit / 32] + __builtin_popcount(word & (mask - 1))];
+}
@@ -0,0 +1,66 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "SKSource.h"
+#include "SKTime.h"
+#include "SKUpdate.h"
+
+class tN2kMsg;
+
+/**
+ * Decodes a NMEA2000 message into the (cleared) update.
+ *
+ * @return true if the update contains values from the message.
+ */
+typedef bool (*SKNMEA2000Decoder)(const SKSourceInput &input, const tN2kMsg &msg,
+                                  const SKTime &timestamp, SKUpdate &update);
+
+/**
+ * A PGN decoded by SKNMEA2000Parser.
+ */
+struct SKNMEA2000PGNDescriptor {
+  uint32_t pgn;
+  SKNMEA2000Decoder decode;
+};
+
+/**
+ * Descriptors of all the decoded PGNs, sorted by PGN. Generated from the
+ * nmea2000 entries of signalk.json by sk-code-generator.py. The decoders are
+ * implemented in SKNMEA2000Parser.cpp.
+ */
+extern const SKNMEA2000PGNDescriptor skNMEA2000PGNDescriptors[];
+extern const size_t skNMEA2000PGNDescriptorsCount;
+
+/**
+ * Returns the descriptor of this PGN or a null pointer if it is not decoded.
+ *
+ * The lookup takes the same (constant) time for every PGN: a bitmap with one
+ * bit per PGN rejects the unknown ones and gives the position of the others
+ * in skNMEA2000PGNDescriptors.
+ */
+const SKNMEA2000PGNDescriptor* skNMEA2000FindPGN(uint32_t pgn);
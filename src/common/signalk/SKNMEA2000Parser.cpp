@@ -28,63 +28,41 @@
   THE SOFTWARE.
 */
 
+#include <stdio.h>
 #include <N2kMessages.h>
 #include <KBoxLogging.h>
+#include "common/stats/KBoxMetrics.h"
+#include "SKNMEA2000Descriptors.h"
 #include "SKNMEA2000Parser.h"
 #include "SKUnits.h"
 
-SKNMEA2000Parser::~SKNMEA2000Parser() {
-  if (_sku) {
-    delete(_sku);
-  }
+// Index of the SignalK paths of an instance (engine, battery...): its number.
+// Instances come from the bus so they are interned in the share of the index
+// table reserved for inputs.
+static SKIndexId instanceIndex(unsigned char instance) {
+  char index[4];
+  snprintf(index, sizeof(index), "%u", instance);
+  return skIndexTable.internInput(index);
 }
 
 const SKUpdate& SKNMEA2000Parser::parse(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
-  if (_sku) {
-    delete(_sku);
+  if (parse(input, msg, timestamp, _update)) {
+    return _update;
   }
+  return _invalidSku;
+}
+
+bool SKNMEA2000Parser::parse(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  update.clear();
 
-  switch (msg.PGN) {
-    case 126992L: // System Time / Date
-      return parse126992(input, msg, timestamp);
-    case 127245L: // Rudder
-      return parse127245(input, msg, timestamp);
-    case 127250L: // Vessel Heading
-      return parse127250(input, msg, timestamp);
-    //case 127251L: // Rate of Turn
-    case 127257L: // Attitude Yaw, Pitch, Roll
-      return parse127257(input, msg, timestamp);
-    //case 127258L:  // Magnetic Variation
-    //    return parse127258(input, msg, timestamp);
-    //  break;
-    case 128259L: // Boat speed
-      return parse128259(input, msg, timestamp);
-    case 128267L: // Water depth
-      return parse128267(input, msg, timestamp);
-    //case 128275L: // Distance Log
-    case 129025L: // Position, Rapid Update Lat/Lon
-      return parse129025(input, msg, timestamp);
-    case 129026L: // COG SOG rapid
-      return parse129026(input, msg, timestamp);
-    //case 129301L:  // Time to/from Mark
-    case 130306L: // Wind Speed
-      return parse130306(input, msg, timestamp);
-
-    //case 127488: // Engine parameters rapid
-    //case 127493: // Transmission parameters: dynamic
-    //case 127501: // Binary status report
-    //case 127505: // Fluid level
-    //case 127508: // Battery Status
-    //case 127513: // Battery Configuration Status
-    //case 129283: // Cross Track Error
-    //case 130314: // Actual Pressure
-    //case 130316: // Temperature extended range
-    //case 130577L: // Direction Data
-    //case 130578L: // Vessel Speed Components
-    default:
-      DEBUG("No known conversion for PGN %i", msg.PGN);
-      return _invalidSku;
-  } // end switch msg.PGN
+  const SKNMEA2000PGNDescriptor *descriptor = skNMEA2000FindPGN(msg.PGN);
+  if (descriptor == nullptr) {
+    // Busy buses carry many PGNs we do not use: count them instead of
+    // logging each one.
+    KBoxMetrics.event(KBoxEventNMEA2000UnknownPGN);
+    return false;
+  }
+  return descriptor->decode(input, msg, timestamp, update);
 }
 
 // *****************************************************************************
@@ -94,7 +72,7 @@ const SKUpdate& SKNMEA2000Parser::parse(const SKSourceInput& input, const tN2kMs
 //  - SystemTime    seconds since midnight
 //  - TimeSource    "GPS", "GLONASS", "radio station", "local cesium clock", "local rubidium clock", "local crystal clock"
 // *****************************************************************************
-const SKUpdate& SKNMEA2000Parser::parse126992(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
+bool skNMEA2000Decode126992(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
   unsigned char sid;          // Sequence ID
   uint16_t systemDate;        // Days since 1970-01-01
   double systemTime;          // seconds since midnight with 2 digits
@@ -103,17 +81,15 @@ const SKUpdate& SKNMEA2000Parser::parse126992(const SKSourceInput& input, const
   if (ParseN2kSystemTime(msg,sid,systemDate,systemTime,timeSource) ) {
     SKTime networkTime = SKTime::timeFromNMEA2000(systemDate, systemTime);
 
-    SKUpdateStatic<1> *update = new SKUpdateStatic<1>();
-    update->setTimestamp(timestamp);
+    update.setTimestamp(timestamp);
 
-    update->setNavigationDatetime(networkTime);
+    update.setNavigationDatetime(networkTime);
 
-    _sku = update;
-    return *_sku;
+    return true;
   }
 
   DEBUG("Unable to parse N2kMsg with PGN %i", msg.PGN);
-  return _invalidSku;
+  return false;
 }
 
 //  ***********************************************
@@ -121,7 +97,7 @@ const SKUpdate& SKNMEA2000Parser::parse126992(const SKSourceInput& input, const
 //        →  sid
 //        →  RudderPosition [rad]
 // *  ********************************************** */
-const SKUpdate& SKNMEA2000Parser::parse127245(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
+bool skNMEA2000Decode127245(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
   unsigned char instance;
   tN2kRudderDirectionOrder rudderDirectionOrder;
   double rudderPosition = N2kDoubleNA;
@@ -129,21 +105,19 @@ const SKUpdate& SKNMEA2000Parser::parse127245(const SKSourceInput& input, const
 
   if (ParseN2kRudder(msg,rudderPosition,instance,rudderDirectionOrder,angleOrder)) {
     if (!N2kIsNA(rudderPosition)) {
-      SKUpdateStatic<1> *update = new SKUpdateStatic<1>();
-      update->setTimestamp(timestamp);
+      update.setTimestamp(timestamp);
 
       SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
-      update->setSource(source);
+      update.setSource(source);
       // -> Current rudder angle, +ve is rudder to Starboard
-      update->setSteeringRudderAngle(rudderPosition);
+      update.setSteeringRudderAngle(rudderPosition);
 
-      _sku = update;
-      return *_sku;
+      return true;
     }
   }
 
   DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
-  return _invalidSku;
+  return false;
 }
 
 // *****************************************************************************
@@ -156,7 +130,7 @@ const SKUpdate& SKNMEA2000Parser::parse127245(const SKSourceInput& input, const
 //        N2khr_true=0,
 //        N2khr_magnetic=1
 // *****************************************************************************
-const SKUpdate& SKNMEA2000Parser::parse127250(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
+bool skNMEA2000Decode127250(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
   unsigned char sid;
   tN2kHeadingReference headingReference;
   double heading = N2kDoubleNA;
@@ -167,37 +141,55 @@ const SKUpdate& SKNMEA2000Parser::parse127250(const SKSourceInput& input, const
     if (!N2kIsNA(heading) && heading >= 0 && heading <= 2 * M_PI) {
       if (headingReference == N2khr_magnetic) {
         //TODO put 3 when updated to deviation
-        SKUpdateStatic<2> *update = new SKUpdateStatic<2>();
-        update->setTimestamp(timestamp);
+        update.setTimestamp(timestamp);
 
         SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
-        update->setSource(source);
-        update->setNavigationHeadingMagnetic(heading);
+        update.setSource(source);
+        update.setNavigationHeadingMagnetic(heading);
         if (!N2kIsNA(variation))
-          update->setNavigationMagneticVariation(variation);
+          update.setNavigationMagneticVariation(variation);
           /* coming when Signal K adds deviation
           if (!N2kIsNA(deviation))
-            update->setNavigationMagneticDeviation(deviation);
+            update.setNavigationMagneticDeviation(deviation);
           */
-        _sku = update;
-        return *_sku;
+        return true;
       }
 
       if (headingReference == N2khr_true) {
-        SKUpdateStatic<1> *update = new SKUpdateStatic<1>();
-        update->setTimestamp(timestamp);
+        update.setTimestamp(timestamp);
 
         SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
-        update->setSource(source);
-        update->setNavigationHeadingTrue(heading);
-        _sku = update;
-        return *_sku;
+        update.setSource(source);
+        update.setNavigationHeadingTrue(heading);
+        return true;
       }
     }
   }
 
   DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
-  return _invalidSku;
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 127251 Rate of Turn
+//  - RateOfTurn            Change in heading in radians per second, +ve to starboard
+// *****************************************************************************
+bool skNMEA2000Decode127251(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  unsigned char sid;
+  double rateOfTurn = N2kDoubleNA;
+
+  if (ParseN2kPGN127251(msg, sid, rateOfTurn) && !N2kIsNA(rateOfTurn)) {
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+    update.setNavigationRateOfTurn(rateOfTurn);
+
+    return true;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
 }
 
 // *****************************************************************************
@@ -206,26 +198,193 @@ const SKUpdate& SKNMEA2000Parser::parse127250(const SKSourceInput& input, const
 //  - Pitch                 Pitch in radians. Positive, when your bow rises.
 //  - Roll                  Roll in radians. Positive, when tilted right.
 // *****************************************************************************
-const SKUpdate& SKNMEA2000Parser::parse127257(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
+bool skNMEA2000Decode127257(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
   unsigned char sid;
   double yaw   = N2kDoubleNA;
   double pitch = N2kDoubleNA;
   double roll  = N2kDoubleNA;
 
   if (ParseN2kPGN127257(msg, sid, yaw, pitch, roll)) {
-    SKUpdateStatic<1> *update = new SKUpdateStatic<1>();
-    update->setTimestamp(timestamp);
+    update.setTimestamp(timestamp);
 
     SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
-    update->setSource(source);
-    update->setNavigationAttitude(SKTypeAttitude(roll, pitch, yaw));
+    update.setSource(source);
+    update.setNavigationAttitude(SKTypeAttitude(roll, pitch, yaw));
 
-    _sku = update;
-    return *_sku;
+    return true;
   }
 
   DEBUG("Unable to parse N2kMsg with PGN %i", msg.PGN);
-  return _invalidSku;
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 127258 Magnetic Variation
+//  - Variation             Radians, +ve to the East
+// *****************************************************************************
+bool skNMEA2000Decode127258(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  unsigned char sid;
+  tN2kMagneticVariation variationSource;
+  uint16_t daysSince1970;
+  double variation = N2kDoubleNA;
+
+  if (ParseN2kPGN127258(msg, sid, variationSource, daysSince1970, variation) && !N2kIsNA(variation)) {
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+    update.setNavigationMagneticVariation(variation);
+
+    return true;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 127488 Engine Parameters, Rapid Update
+//  - EngineSpeed           RPM, published in Hz as propulsion.<instance>.revolutions
+// *****************************************************************************
+bool skNMEA2000Decode127488(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  unsigned char engineInstance;
+  double engineSpeed = N2kDoubleNA;
+  double boostPressure = N2kDoubleNA;
+  int8_t tiltTrim;
+
+  if (ParseN2kPGN127488(msg, engineInstance, engineSpeed, boostPressure, tiltTrim) && !N2kIsNA(engineSpeed)) {
+    SKIndexId index = instanceIndex(engineInstance);
+    if (index == SKIndexInvalid) {
+      return false;
+    }
+
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+
+    update.setPropulsionRevolutions(index, engineSpeed / 60);
+
+    return true;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 127505 Fluid Level
+//  - Level                 Percent of the capacity
+//  - Capacity              Liters
+//  The tanks are indexed by SignalK type and instance: "fuel.0", "freshWater.1"
+// *****************************************************************************
+bool skNMEA2000Decode127505(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  unsigned char instance;
+  tN2kFluidType fluidType;
+  double level = N2kDoubleNA;
+  double capacity = N2kDoubleNA;
+
+  if (ParseN2kPGN127505(msg, instance, fluidType, level, capacity)) {
+    const char *type;
+    switch (fluidType) {
+      case N2kft_Fuel:
+        type = "fuel";
+        break;
+      case N2kft_Water:
+        type = "freshWater";
+        break;
+      case N2kft_GrayWater:
+        type = "wasteWater";
+        break;
+      case N2kft_LiveWell:
+        type = "liveWell";
+        break;
+      case N2kft_Oil:
+        type = "lubrication";
+        break;
+      case N2kft_BlackWater:
+        type = "blackWater";
+        break;
+      default:
+        return false;
+    }
+
+    char name[16];
+    snprintf(name, sizeof(name), "%s.%u", type, instance);
+    SKIndexId index = skIndexTable.internInput(name);
+    if (index == SKIndexInvalid) {
+      return false;
+    }
+
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+
+    if (!N2kIsNA(level)) {
+      update.setTanksCurrentLevel(index, level / 100);
+    }
+    if (!N2kIsNA(capacity)) {
+      update.setTanksCapacity(index, capacity / 1000);
+    }
+
+    return update.getSize() > 0;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 127508 Battery Status
+//  - BatteryVoltage        Volts
+//  - BatteryCurrent        Amperes
+//  - BatteryTemperature    Kelvin
+//  Instances 0 and 1 are the "engine" and "house" batteries, like in
+//  SKNMEA2000Converter. Other instances are indexed by their number.
+// *****************************************************************************
+bool skNMEA2000Decode127508(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  unsigned char batteryInstance;
+  unsigned char sid;
+  double voltage = N2kDoubleNA;
+  double current = N2kDoubleNA;
+  double temperature = N2kDoubleNA;
+
+  if (ParseN2kPGN127508(msg, batteryInstance, voltage, current, temperature, sid)) {
+    SKIndexId index;
+    if (batteryInstance == 0) {
+      index = skIndexTable.intern("engine");
+    }
+    else if (batteryInstance == 1) {
+      index = skIndexTable.intern("house");
+    }
+    else {
+      index = instanceIndex(batteryInstance);
+    }
+    if (index == SKIndexInvalid) {
+      return false;
+    }
+
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+
+    if (!N2kIsNA(voltage)) {
+      update.setElectricalBatteriesVoltage(index, voltage);
+    }
+    if (!N2kIsNA(current)) {
+      update.setElectricalBatteriesCurrent(index, current);
+    }
+    if (!N2kIsNA(temperature)) {
+      update.setElectricalBatteriesTemperature(index, temperature);
+    }
+
+    return update.getSize() > 0;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
 }
 
 // *****************************************************************************
@@ -237,29 +396,27 @@ const SKUpdate& SKNMEA2000Parser::parse127257(const SKSourceInput& input, const
 //                N2kSWRT_Ultra_Sound=3,
 //                N2kSWRT_Electro_magnetic=4
 // *****************************************************************************
-const SKUpdate& SKNMEA2000Parser::parse128259(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
+bool skNMEA2000Decode128259(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
   unsigned char sid;
   double waterSpeed = N2kDoubleNA;
   double groundSpeed = N2kDoubleNA;
   tN2kSpeedWaterReferenceType swrt;
 
   if (ParseN2kBoatSpeed(msg, sid, waterSpeed, groundSpeed, swrt)) {
-    SKUpdateStatic<2> *update = new SKUpdateStatic<2>();
-    update->setTimestamp(timestamp);
+    update.setTimestamp(timestamp);
 
     SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
-    update->setSource(source);
+    update.setSource(source);
 
     if (!N2kIsNA(waterSpeed)) {
-      update->setNavigationSpeedThroughWater(waterSpeed);
+      update.setNavigationSpeedThroughWater(waterSpeed);
     }
 
-    _sku = update;
-    return *_sku;
+    return true;
   }
 
   DEBUG("Unable to parse N2kMsg with PGN %i", msg.PGN);
-  return _invalidSku;
+  return false;
 }
 
 // ****************************************************************************
@@ -267,63 +424,90 @@ const SKUpdate& SKNMEA2000Parser::parse128259(const SKSourceInput& input, const
 //  Water depth relative to the transducer and offset of the measuring transducer.
 //  Water depth is either below water surface or below lowest point of vessel.
 // ****************************************************************************
-const SKUpdate& SKNMEA2000Parser::parse128267(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
+bool skNMEA2000Decode128267(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
   unsigned char sid;
   double depthBelowTransducer = N2kDoubleNA;
   double offset = N2kDoubleNA;
 
   if (ParseN2kWaterDepth(msg, sid, depthBelowTransducer, offset)) {
     if (!N2kIsNA(depthBelowTransducer)) {
-      SKUpdateStatic<3> *update = new SKUpdateStatic<3>();
-      update->setTimestamp(timestamp);
+      update.setTimestamp(timestamp);
 
       SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
-      update->setSource(source);
+      update.setSource(source);
 
-      update->setEnvironmentDepthBelowTransducer(depthBelowTransducer);
+      update.setEnvironmentDepthBelowTransducer(depthBelowTransducer);
 
       // When offset is negative, it's the distance between transducer and keel
       if (!N2kIsNA(offset)) {
         if (offset < 0) {
-          update->setEnvironmentDepthTransducerToKeel(offset * -1);
-          update->setEnvironmentDepthBelowKeel(depthBelowTransducer + offset);
+          update.setEnvironmentDepthTransducerToKeel(offset * -1);
+          update.setEnvironmentDepthBelowKeel(depthBelowTransducer + offset);
         }
         else if (offset > 0) {
-          update->setEnvironmentDepthSurfaceToTransducer(offset);
-          update->setEnvironmentDepthBelowSurface(depthBelowTransducer + offset);
+          update.setEnvironmentDepthSurfaceToTransducer(offset);
+          update.setEnvironmentDepthBelowSurface(depthBelowTransducer + offset);
         }
       }
 
-      _sku = update;
-      return *_sku;
+      return true;
     }
   }
 
   DEBUG("Unable to parse N2kMsg with PGN %i", msg.PGN);
-  return _invalidSku;
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 128275 Distance Log
+//  - Log                   Total distance in meters
+//  - TripLog               Distance since the last reset in meters
+// *****************************************************************************
+bool skNMEA2000Decode128275(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  uint16_t daysSince1970;
+  double secondsSinceMidnight;
+  uint32_t log = N2kUInt32NA;
+  uint32_t tripLog = N2kUInt32NA;
+
+  if (ParseN2kPGN128275(msg, daysSince1970, secondsSinceMidnight, log, tripLog)) {
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+
+    if (log != N2kUInt32NA) {
+      update.setNavigationLog(log);
+    }
+    if (tripLog != N2kUInt32NA) {
+      update.setNavigationTripLog(tripLog);
+    }
+
+    return update.getSize() > 0;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
 }
 
 // *****************************************************************************
 //    129025L: // Position, Rapid Update Lat/Lon
 // *****************************************************************************
-const SKUpdate& SKNMEA2000Parser::parse129025(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
+bool skNMEA2000Decode129025(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
   double latitude;
   double longitude;
 
   if (ParseN2kPositionRapid(msg, latitude, longitude)) {
-    SKUpdateStatic<2> *update = new SKUpdateStatic<2>();
-    update->setTimestamp(timestamp);
+    update.setTimestamp(timestamp);
 
     SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
-    update->setSource(source);
-    update->setNavigationPosition(SKTypePosition(latitude, longitude, 0));
+    update.setSource(source);
+    update.setNavigationPosition(SKTypePosition(latitude, longitude, 0));
 
-    _sku = update;
-    return *_sku;
+    return true;
   }
 
   DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
-  return _invalidSku;
+  return false;
 }
 
 // *****************************************************************************
@@ -334,27 +518,53 @@ const SKUpdate& SKNMEA2000Parser::parse129025(const SKSourceInput& input, const
 //    4 Course Over Ground
 //    5 Speed Over Ground
 // *****************************************************************************
-const SKUpdate& SKNMEA2000Parser::parse129026(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
+bool skNMEA2000Decode129026(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
   unsigned char sid;
   tN2kHeadingReference headingReference;
   double COG;
   double SOG;
 
   if (ParseN2kCOGSOGRapid(msg,sid,headingReference,COG,SOG)) {
-    SKUpdateStatic<2> *update = new SKUpdateStatic<2>();
-    update->setTimestamp(timestamp);
+    update.setTimestamp(timestamp);
 
     SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
-    update->setSource(source);
-    update->setNavigationCourseOverGroundTrue(COG);
-    update->setNavigationSpeedOverGround(SOG);
+    update.setSource(source);
+    update.setNavigationCourseOverGroundTrue(COG);
+    update.setNavigationSpeedOverGround(SOG);
 
-    _sku = update;
-    return *_sku;
+    return true;
   }
 
   DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
-  return _invalidSku;
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 129283 Cross Track Error
+//  - XTE                   Meters
+//  - NavigationTerminated  No XTE is published once the navigation is over.
+// *****************************************************************************
+bool skNMEA2000Decode129283(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  unsigned char sid;
+  tN2kXTEMode xteMode;
+  bool navigationTerminated;
+  double xte = N2kDoubleNA;
+
+  if (ParseN2kPGN129283(msg, sid, xteMode, navigationTerminated, xte)) {
+    if (navigationTerminated || N2kIsNA(xte)) {
+      return false;
+    }
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+    update.setNavigationCourseRhumblineCrossTrackError(xte);
+
+    return true;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
 }
 
 // *****************************************************************************
@@ -369,59 +579,254 @@ const SKUpdate& SKNMEA2000Parser::parse129026(const SKSourceInput& input, const
 //      N2kWind_True_boat=3     => Ground Wind, calculated using SOG/COG, relative to centerline
 //      N2kWind_True_water=4    => Theoretical Wind, calc using Heading/STW, relative to centerline vessel, referenced to water
 // *****************************************************************************
-const SKUpdate& SKNMEA2000Parser::parse130306(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp) {
+bool skNMEA2000Decode130306(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
   unsigned char sid;
   double windSpeed = N2kDoubleNA;
   double windAngle = N2kDoubleNA;
   tN2kWindReference windReference;
 
   if (ParseN2kPGN130306(msg,sid,windSpeed,windAngle,windReference)) {
-    SKUpdateStatic<2> *update = new SKUpdateStatic<2>();
-    update->setTimestamp(timestamp);
+    update.setTimestamp(timestamp);
 
     SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
-    update->setSource(source);
+    update.setSource(source);
 
     if (!N2kIsNA(windAngle) && !N2kIsNA(windSpeed)) {
       switch(windReference) {
         case N2kWind_True_North:
           // Ground Wind Speed
-          update->setEnvironmentWindSpeedOverGround(windSpeed);
+          update.setEnvironmentWindSpeedOverGround(windSpeed);
           // Ground Wind Direction
-          update->setEnvironmentWindDirectionTrue(windAngle);
+          update.setEnvironmentWindDirectionTrue(windAngle);
         break;
         case N2kWind_Magnetic:
           // Ground Wind Speed
-          update->setEnvironmentWindSpeedOverGround(windSpeed);
+          update.setEnvironmentWindSpeedOverGround(windSpeed);
           // Ground Wind Direction referred to magnetic north
-          update->setEnvironmentWindDirectionMagnetic(windAngle);
+          update.setEnvironmentWindDirectionMagnetic(windAngle);
         break;
         case  N2kWind_Apparent:
           // AWS Apparent Wind Speed
-          update->setEnvironmentWindSpeedApparent(windSpeed);
+          update.setEnvironmentWindSpeedApparent(windSpeed);
           // AWA pos coming from starboard, neg from port, relative to centerline vessel
-          update->setEnvironmentWindAngleApparent(SKNormalizeAngle(windAngle));
+          update.setEnvironmentWindAngleApparent(SKNormalizeAngle(windAngle));
         break;
         case N2kWind_True_boat:
           // Ground Wind
-          update->setEnvironmentWindSpeedOverGround(windSpeed);
+          update.setEnvironmentWindSpeedOverGround(windSpeed);
           // Ground Wind +/- starboard/port
-          update->setEnvironmentWindAngleTrueGround(SKNormalizeAngle(windAngle));
+          update.setEnvironmentWindAngleTrueGround(SKNormalizeAngle(windAngle));
         break;
         case N2kWind_True_water:
           // TWS (water referred) True "Sailing" Wind
-          update->setEnvironmentWindSpeedTrue(windSpeed);
-          update->setEnvironmentWindAngleTrueWater(SKNormalizeAngle(windAngle));
+          update.setEnvironmentWindSpeedTrue(windSpeed);
+          update.setEnvironmentWindAngleTrueWater(SKNormalizeAngle(windAngle));
         break;
       }
     }
 
-    _sku = update;
-    return *_sku;
+    return true;
   }
 
   DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
-  return _invalidSku;
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 130310 Environmental Parameters (outside)
+//  - WaterTemperature              Kelvin
+//  - OutsideAmbientAirTemperature  Kelvin
+//  - AtmosphericPressure           Pascal
+// *****************************************************************************
+bool skNMEA2000Decode130310(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  unsigned char sid;
+  double waterTemperature = N2kDoubleNA;
+  double airTemperature = N2kDoubleNA;
+  double pressure = N2kDoubleNA;
+
+  if (ParseN2kPGN130310(msg, sid, waterTemperature, airTemperature, pressure)) {
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+
+    if (!N2kIsNA(waterTemperature)) {
+      update.setEnvironmentWaterTemperature(waterTemperature);
+    }
+    if (!N2kIsNA(airTemperature)) {
+      update.setEnvironmentOutsideTemperature(airTemperature);
+    }
+    if (!N2kIsNA(pressure)) {
+      update.setEnvironmentOutsidePressure(pressure);
+    }
+
+    return update.getSize() > 0;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 130314 Actual Pressure
+//  - Pressure              Pascal. Only the atmospheric pressure is used.
+// *****************************************************************************
+bool skNMEA2000Decode130314(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  unsigned char sid;
+  unsigned char pressureInstance;
+  tN2kPressureSource pressureSource;
+  double pressure = N2kDoubleNA;
+
+  if (ParseN2kPGN130314(msg, sid, pressureInstance, pressureSource, pressure)) {
+    if (pressureSource != N2kps_Atmospheric || N2kIsNA(pressure)) {
+      return false;
+    }
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+    update.setEnvironmentOutsidePressure(pressure);
+
+    return true;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 130316 Temperature, Extended Range
+//  - ActualTemperature     Kelvin. Sea, outside and inside temperatures are used.
+// *****************************************************************************
+bool skNMEA2000Decode130316(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  unsigned char sid;
+  unsigned char temperatureInstance;
+  tN2kTempSource temperatureSource;
+  double temperature = N2kDoubleNA;
+  double setTemperature = N2kDoubleNA;
+
+  if (ParseN2kPGN130316(msg, sid, temperatureInstance, temperatureSource, temperature, setTemperature)) {
+    if (N2kIsNA(temperature)) {
+      return false;
+    }
+    update.setTimestamp(timestamp);
+
+    SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+    update.setSource(source);
+
+    switch (temperatureSource) {
+      case N2kts_SeaTemperature:
+        update.setEnvironmentWaterTemperature(temperature);
+        break;
+      case N2kts_OutsideTemperature:
+        update.setEnvironmentOutsideTemperature(temperature);
+        break;
+      case N2kts_InsideTemperature:
+        update.setEnvironmentInsideTemperature(temperature);
+        break;
+      default:
+        break;
+    }
+
+    return update.getSize() > 0;
+  }
+
+  DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+  return false;
+}
+
+// *****************************************************************************
+//  PGN 130577 Direction Data
+//    1 Data Mode (4 bits), COG Reference (2 bits)
+//    2 Sequence ID
+//    3 COG                 0.0001 rad
+//    4 SOG                 0.01 m/s
+//    5 Heading             0.0001 rad, same reference as COG
+//    6 Speed Through Water 0.01 m/s
+//    7 Set                 0.0001 rad, same reference as COG
+//    8 Drift               0.01 m/s
+//  Decoded here because not all versions of the NMEA2000 library parse it.
+// *****************************************************************************
+bool skNMEA2000Decode130577(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  if (msg.DataLen < 14) {
+    DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+    return false;
+  }
+
+  int index = 0;
+  tN2kHeadingReference reference = (tN2kHeadingReference)((msg.GetByte(index) >> 4) & 0x03);
+  msg.GetByte(index);
+  double cog = msg.Get2ByteUDouble(0.0001, index);
+  double sog = msg.Get2ByteUDouble(0.01, index);
+  double heading = msg.Get2ByteUDouble(0.0001, index);
+  double stw = msg.Get2ByteUDouble(0.01, index);
+  double set = msg.Get2ByteUDouble(0.0001, index);
+  double drift = msg.Get2ByteUDouble(0.01, index);
+
+  update.setTimestamp(timestamp);
+
+  SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+  update.setSource(source);
+
+  if (reference == N2khr_true) {
+    if (!N2kIsNA(cog)) {
+      update.setNavigationCourseOverGroundTrue(cog);
+    }
+    if (!N2kIsNA(heading)) {
+      update.setNavigationHeadingTrue(heading);
+    }
+    if (!N2kIsNA(set)) {
+      update.setEnvironmentCurrentSetTrue(set);
+    }
+  }
+  else if (reference == N2khr_magnetic && !N2kIsNA(heading)) {
+    update.setNavigationHeadingMagnetic(heading);
+  }
+  if (!N2kIsNA(sog)) {
+    update.setNavigationSpeedOverGround(sog);
+  }
+  if (!N2kIsNA(stw)) {
+    update.setNavigationSpeedThroughWater(stw);
+  }
+  if (!N2kIsNA(drift)) {
+    update.setEnvironmentCurrentDrift(drift);
+  }
+
+  return update.getSize() > 0;
+}
+
+// *****************************************************************************
+//  PGN 130578 Vessel Speed Components
+//    1 Longitudinal Speed, Water-referenced   0.001 m/s
+//    2 Transverse Speed, Water-referenced     0.001 m/s, +ve to starboard
+//    3 Longitudinal Speed, Ground-referenced  (not used)
+//    4 Transverse Speed, Ground-referenced    (not used)
+//    5 Stern Speed, Water-referenced          (not used)
+//    6 Stern Speed, Ground-referenced         (not used)
+// *****************************************************************************
+bool skNMEA2000Decode130578(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update) {
+  if (msg.DataLen < 4) {
+    DEBUG("Unable to parse NMEA2000 with PGN %i", msg.PGN);
+    return false;
+  }
+
+  int index = 0;
+  double longitudinal = msg.Get2ByteDouble(0.001, index);
+  double transverse = msg.Get2ByteDouble(0.001, index);
+
+  update.setTimestamp(timestamp);
+
+  SKSource source = SKSource::sourceForNMEA2000(input, msg.PGN, msg.Priority, msg.Source);
+  update.setSource(source);
+
+  if (!N2kIsNA(longitudinal)) {
+    update.setNavigationSpeedThroughWater(longitudinal);
+  }
+  if (!N2kIsNA(transverse)) {
+    update.setNavigationSpeedThroughWaterTransverse(transverse);
+  }
+
+  return update.getSize() > 0;
 }
 
 // *****************************************************************************
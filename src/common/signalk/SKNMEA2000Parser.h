@@ -34,14 +34,36 @@
 #include "SKUpdate.h"
 #include "SKUpdateStatic.h"
 
+/**
+ * Converts NMEA2000 messages into SignalK updates.
+ *
+ * The decoder of each PGN is found in the table generated from signalk.json
+ * (see SKNMEA2000Descriptors.h). Messages with other PGNs are rejected
+ * without any logging and counted with KBoxEventNMEA2000UnknownPGN.
+ */
 class SKNMEA2000Parser {
+  public:
+    /**
+     * Maximum number of values generated by one message. Updates passed to
+     * `parse()` should have at least this capacity.
+     */
+    static const uint16_t MaxValuesPerUpdate = 6;
+
   private:
-    SKUpdate *_sku = 0;
+    SKUpdateStatic<MaxValuesPerUpdate> _update;
     SKUpdateStatic<0> _invalidSku = SKUpdateStatic<0>();
 
   public:
     SKNMEA2000Parser() {};
-    ~SKNMEA2000Parser();
+
+    /**
+     * Parse a NMEA2000 @param msg received on @param input into @param update
+     * which is cleared first. The parser does not allocate any memory for the
+     * update so the same update object should be reused for every message.
+     *
+     * @return true if the message was recognized and converted.
+     */
+    bool parse(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp, SKUpdate& update);
 
     /**
      * Parse a NMEA2000 @param msg received on @param input and returns a
@@ -51,30 +73,4 @@ class SKNMEA2000Parser {
      * reference is no longer valid!
      */
     const SKUpdate& parse(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-
-  private:
-    //  PGN 126992  System Time Date
-    const SKUpdate& parse126992(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-    // PGN 127245 Rudder
-    const SKUpdate& parse127245(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-    // PGN 127250 VESSEL HEADING RAPID
-    const SKUpdate& parse127250(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-    // PGN 127257 Attitude Yaw, Pitch, Roll
-    const SKUpdate& parse127257(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-    // PGN 128259 Boat Speed
-    const SKUpdate& parse128259(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-    // PGN 128267 Water depth
-    const SKUpdate& parse128267(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-    // PGN 129025 Position
-    const SKUpdate& parse129025(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-    // PGN 129026 COG & SOG, Rapid Update
-    const SKUpdate& parse129026(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-    // PGN 130306 Wind Speed
-    const SKUpdate& parse130306(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-
-
-
-    // Magnetic variation
-    //const SKUpdate& parse127258(const SKSourceInput& input, const tN2kMsg& msg, const SKTime& timestamp);
-
 };
@@ -33,119 +33,168 @@
 
 #include "SKNMEAConverter.h"
 
-void SKNMEAConverter::convert(const SKUpdate& update, SKNMEAOutput& output) {
-  _currentOutput = &output;
+const SKNMEAConverter::GeneratorEntry SKNMEAConverter::_generators[] = {
+  { SKPathEnvironmentDepthBelowTransducer, &SKNMEAConverterConfig::dbt, &SKNMEAConverter::generateDBT },
+  { SKPathEnvironmentDepthBelowTransducer, &SKNMEAConverterConfig::dpt, &SKNMEAConverter::generateDPT },
+  { SKPathNavigationHeadingMagnetic, &SKNMEAConverterConfig::hdm, &SKNMEAConverter::generateHDM },
+  { SKPathEnvironmentWindAngleApparent, &SKNMEAConverterConfig::mwv, &SKNMEAConverter::generateMWVApparent },
+  { SKPathEnvironmentWindAngleTrueWater, &SKNMEAConverterConfig::mwv, &SKNMEAConverter::generateMWVTrue },
+  { SKPathSteeringRudderAngle, &SKNMEAConverterConfig::rsa, &SKNMEAConverter::generateRSA },
+  { SKPathNavigationAttitude, &SKNMEAConverterConfig::xdrAttitude, &SKNMEAConverter::generateXDRAttitude },
+  { SKPathElectricalBatteriesVoltage, &SKNMEAConverterConfig::xdrBattery, &SKNMEAConverter::generateXDRBattery },
+  { SKPathEnvironmentOutsidePressure, &SKNMEAConverterConfig::xdrPressure, &SKNMEAConverter::generateXDRPressure },
+};
+
+SKPathDispatchTable SKNMEAConverter::buildDispatchTable() {
+  static_assert(sizeof(_generators) / sizeof(_generators[0]) <= SKPathDispatchTable::MaxHandlers,
+                "Too many generators for one dispatch table");
+
+  SKPathDispatchTable table;
+  for (unsigned int i = 0; i < sizeof(_generators) / sizeof(_generators[0]); i++) {
+    table.add(_generators[i].trigger, i);
+  }
+  return table;
+}
 
-  if (_config.dbt && update.hasEnvironmentDepthBelowTransducer()) {
-    NMEASentenceBuilder sb("II", "DBT", 7);
-    sb.setField(1, SKMeterToFeet(update.getEnvironmentDepthBelowTransducer()), 2);
-    sb.setField(2, "f");
-    sb.setField(3, update.getEnvironmentDepthBelowTransducer(), 2);
-    sb.setField(4, "M");
-    sb.setField(5, SKMeterToFathom(update.getEnvironmentDepthBelowTransducer()), 2);
-    sb.setField(6, "F");
-    output.write(sb.toNMEA());
+const SKPathDispatchTable SKNMEAConverter::_dispatchTable = SKNMEAConverter::buildDispatchTable();
+
+void SKNMEAConverter::convert(const SKUpdate& update, SKNMEAOutput& output) {
+  // Updates about other vessels (AIS targets) must not be sent as our own
+  // data.
+  if (&update.getContext() != &SKContextSelf) {
+    return;
   }
 
-  if (_config.dpt && update.hasEnvironmentDepthBelowTransducer()) {
-    NMEASentenceBuilder sb("II", "DPT", 2);
-    sb.setField(1, update.getEnvironmentDepthBelowTransducer(), 1);
-    if (update.hasEnvironmentDepthSurfaceToTransducer()) {
-      sb.setField(2, update.getEnvironmentDepthSurfaceToTransducer(), 1);
-    }
-    else if (update.hasEnvironmentDepthTransducerToKeel()) {
-      sb.setField(2, -update.getEnvironmentDepthTransducerToKeel(), 1);
+  _currentOutput = &output;
+
+  uint32_t generators = _dispatchTable.handlersForUpdate(update);
+  for (int g = 0; generators != 0; g++, generators >>= 1) {
+    if ((generators & 1) && _config.*_generators[g].enabled) {
+      (this->*_generators[g].generate)(update, output);
     }
-    output.write(sb.toNMEA());
   }
 
-  if (_config.hdm && update.hasNavigationHeadingMagnetic()) {
-    NMEASentenceBuilder sb("II", "HDM", 2);
-    sb.setField(1, SKRadToDeg(update.getNavigationHeadingMagnetic()), 1);
-    sb.setField(2, "M");
-    output.write(sb.toNMEA());
+  //  ***********************************************
+  //  New NMEA 0183 sentence Leeway
+  //  https://www.nmea.org/Assets/20170303%20nautical%20leeway%20angle%20measurement%20sentence%20amendment.pdf
+  //         1  2
+  //         |  |
+  //  $--LWY,A,x.x*hh<CR><LF>
+  //      1) Valid or not A/V
+  //      2) leeway in degrees and decimal degrees, positiv slipping to starboard
+  //  ***********************************************
+  //  TODO!
+}
+
+void SKNMEAConverter::generateDBT(const SKUpdate& update, SKNMEAOutput& output) {
+  NMEASentenceBuilder sb("II", "DBT", 7);
+  sb.setField(1, SKMeterToFeet(update.getEnvironmentDepthBelowTransducer()), 2);
+  sb.setField(2, "f");
+  sb.setField(3, update.getEnvironmentDepthBelowTransducer(), 2);
+  sb.setField(4, "M");
+  sb.setField(5, SKMeterToFathom(update.getEnvironmentDepthBelowTransducer()), 2);
+  sb.setField(6, "F");
+  output.write(sb.toSentence());
+}
+
+void SKNMEAConverter::generateDPT(const SKUpdate& update, SKNMEAOutput& output) {
+  NMEASentenceBuilder sb("II", "DPT", 2);
+  sb.setField(1, update.getEnvironmentDepthBelowTransducer(), 1);
+  if (update.hasEnvironmentDepthSurfaceToTransducer()) {
+    sb.setField(2, update.getEnvironmentDepthSurfaceToTransducer(), 1);
   }
+  else if (update.hasEnvironmentDepthTransducerToKeel()) {
+    sb.setField(2, -update.getEnvironmentDepthTransducerToKeel(), 1);
+  }
+  output.write(sb.toSentence());
+}
 
-  if (_config.mwv && update.hasEnvironmentWindAngleApparent()
-      && update.hasEnvironmentWindSpeedApparent()) {
+void SKNMEAConverter::generateHDM(const SKUpdate& update, SKNMEAOutput& output) {
+  NMEASentenceBuilder sb("II", "HDM", 2);
+  sb.setField(1, SKRadToDeg(update.getNavigationHeadingMagnetic()), 1);
+  sb.setField(2, "M");
+  output.write(sb.toSentence());
+}
+
+void SKNMEAConverter::generateMWVApparent(const SKUpdate& update, SKNMEAOutput& output) {
+  if (update.hasEnvironmentWindSpeedApparent()) {
     generateMWV(output, update.getEnvironmentWindAngleApparent(), update.getEnvironmentWindSpeedApparent(), true);
   }
+}
 
-  if (_config.mwv && update.hasEnvironmentWindAngleTrueWater()
-      && update.hasEnvironmentWindSpeedTrue()) {
+void SKNMEAConverter::generateMWVTrue(const SKUpdate& update, SKNMEAOutput& output) {
+  if (update.hasEnvironmentWindSpeedTrue()) {
     generateMWV(output, update.getEnvironmentWindAngleTrueWater(), update.getEnvironmentWindSpeedTrue(), false);
   }
+}
 
-  //  ***********************************************
-  //    RSA Rudder Sensor Angle
-  //    Talker-ID: AG - Autopilot general
-  //    also seen: ERRSA
-  //    Expedition: IIXDR
-  //
-  //            1  2  3  4
-  //            |  |  |  |
-  //    $--RSA,x.x,A,x.x,A*hh
-  //      1) Starboard (or single) rudder sensor, "-" means Turn To Port
-  //      2) Status, A means data is valid
-  //      3) Port rudder sensor
-  //      4) Status, A means data is valid
-  // *********************************************** */
-  if (_config.rsa && update.hasSteeringRudderAngle()) {
-    NMEASentenceBuilder sb("II", "RSA", 4);
-    sb.setField(1, SKRadToDeg(SKNormalizeAngle(update.getSteeringRudderAngle())),1 );
-    sb.setField(2, "A");
-    sb.setField(3, "");
-    sb.setField(4, "");
-    output.write(sb.toNMEA());
-  }
+//  ***********************************************
+//    RSA Rudder Sensor Angle
+//    Talker-ID: AG - Autopilot general
+//    also seen: ERRSA
+//    Expedition: IIXDR
+//
+//            1  2  3  4
+//            |  |  |  |
+//    $--RSA,x.x,A,x.x,A*hh
+//      1) Starboard (or single) rudder sensor, "-" means Turn To Port
+//      2) Status, A means data is valid
+//      3) Port rudder sensor
+//      4) Status, A means data is valid
+// *********************************************** */
+void SKNMEAConverter::generateRSA(const SKUpdate& update, SKNMEAOutput& output) {
+  NMEASentenceBuilder sb("II", "RSA", 4);
+  sb.setField(1, SKRadToDeg(SKNormalizeAngle(update.getSteeringRudderAngle())),1 );
+  sb.setField(2, "A");
+  sb.setField(3, "");
+  sb.setField(4, "");
+  output.write(sb.toSentence());
+}
 
-  if (_config.xdrAttitude && update.hasNavigationAttitude()) {
-    NMEASentenceBuilder sb( "II", "XDR", 8);
-    sb.setField(1, "A");
-    if (update.getNavigationAttitude().pitch == SKDoubleNAN) {
-      sb.setField(2, "");
-    } else {
-      sb.setField(2, SKRadToDeg(update.getNavigationAttitude().pitch), 1);
-    }
-    sb.setField(3, "D");
-    sb.setField(4, "PTCH");
-    sb.setField(5, "A");
-    if (update.getNavigationAttitude().roll == SKDoubleNAN) {
-      sb.setField(6, "");
-    } else {
-      sb.setField(6, SKRadToDeg(update.getNavigationAttitude().roll), 1);
-    }
-    sb.setField(7, "D");
-    sb.setField(8, "ROLL");
-    output.write(sb.toNMEA());
+void SKNMEAConverter::generateXDRAttitude(const SKUpdate& update, SKNMEAOutput& output) {
+  NMEASentenceBuilder sb( "II", "XDR", 8);
+  sb.setField(1, "A");
+  if (update.getNavigationAttitude().pitch == SKDoubleNAN) {
+    sb.setField(2, "");
+  } else {
+    sb.setField(2, SKRadToDeg(update.getNavigationAttitude().pitch), 1);
   }
+  sb.setField(3, "D");
+  sb.setField(4, "PTCH");
+  sb.setField(5, "A");
+  if (update.getNavigationAttitude().roll == SKDoubleNAN) {
+    sb.setField(6, "");
+  } else {
+    sb.setField(6, SKRadToDeg(update.getNavigationAttitude().roll), 1);
+  }
+  sb.setField(7, "D");
+  sb.setField(8, "ROLL");
+  output.write(sb.toSentence());
+}
 
+void SKNMEAConverter::generateXDRBattery(const SKUpdate& update, SKNMEAOutput& output) {
   // Trigger a call of visitSKElectricalBatteriesVoltage for every key with that path
   // (there can be more than one and we do not know how they are called)
-  if (_config.xdrBattery) {
-    update.accept(*this, SKPathElectricalBatteriesVoltage);
-  }
-
-  if (_config.xdrPressure && update.hasEnvironmentOutsidePressure()) {
-    NMEASentenceBuilder sb("II", "XDR", 4);
-    sb.setField(1, "P");
-    sb.setField(2, SKPascalToBar(update.getEnvironmentOutsidePressure()), 5);
-    sb.setField(3, "B");
-    sb.setField(4, "Barometer");
-    output.write(sb.toNMEA());
-  }
+  update.accept(*this, SKPathElectricalBatteriesVoltage);
+}
 
+void SKNMEAConverter::generateXDRPressure(const SKUpdate& update, SKNMEAOutput& output) {
+  NMEASentenceBuilder sb("II", "XDR", 4);
+  sb.setField(1, "P");
+  sb.setField(2, SKPascalToBar(update.getEnvironmentOutsidePressure()), 5);
+  sb.setField(3, "B");
+  sb.setField(4, "Barometer");
+  output.write(sb.toSentence());
+}
 
-  //  ***********************************************
-  //  New NMEA 0183 sentence Leeway
-  //  https://www.nmea.org/Assets/20170303%20nautical%20leeway%20angle%20measurement%20sentence%20amendment.pdf
-  //         1  2
-  //         |  |
-  //  $--LWY,A,x.x*hh<CR><LF>
-  //      1) Valid or not A/V
-  //      2) leeway in degrees and decimal degrees, positiv slipping to starboard
-  //  ***********************************************
-  //  TODO!
+SKSubscriptionFilter SKNMEAConverter::subscriptionFilter(const SKNMEAConverterConfig &config) {
+  SKSubscriptionFilter filter;
+  for (unsigned int i = 0; i < sizeof(_generators) / sizeof(_generators[0]); i++) {
+    if (config.*_generators[i].enabled) {
+      filter.addPath(_generators[i].trigger);
+    }
+  }
+  return filter;
 }
 
 void SKNMEAConverter::visitSKElectricalBatteriesVoltage(const SKUpdate& u, const SKPath &p, const SKValue &v) {
@@ -155,7 +204,7 @@ void SKNMEAConverter::visitSKElectricalBatteriesVoltage(const SKUpdate& u, const
   sb.setField(3, "V");
   sb.setField(4, p.getIndex());
 
-  _currentOutput->write(sb.toNMEA());
+  _currentOutput->write(sb.toSentence());
 }
 
 // ***********************  Wind Speed and Angle  ************************
@@ -181,5 +230,5 @@ void SKNMEAConverter::generateMWV(SKNMEAOutput &output, double windAngle, double
   sb.setField(3, windSpeed, 2 );
   sb.setField(4, "M");
   sb.setField(5, "A");
-  output.write(sb.toNMEA());
+  output.write(sb.toSentence());
 }
@@ -34,6 +34,8 @@
 #include "SKVisitor.generated.h"
 #include "SKNMEAOutput.h"
 #include "SKNMEAConverterConfig.h"
+#include "SKPathDispatchTable.h"
+#include "SKSubscriptionFilter.h"
 
 class SKNMEAConverter : SKVisitor {
   private:
@@ -43,11 +45,43 @@ class SKNMEAConverter : SKVisitor {
 
     void generateMWV(SKNMEAOutput& out, double windAngle, double windSpeed, bool apparent);
 
+    // Each generator outputs one sentence (or one per indexed value) and is
+    // triggered by the presence of one path in the update, if it is enabled
+    // in the config. The subscription filter is built from the same table.
+    typedef void (SKNMEAConverter::*Generator)(const SKUpdate& update, SKNMEAOutput& output);
+    struct GeneratorEntry {
+      SKPathEnum trigger;
+      bool SKNMEAConverterConfig::*enabled;
+      Generator generate;
+    };
+    static const GeneratorEntry _generators[];
+    static const SKPathDispatchTable _dispatchTable;
+    static SKPathDispatchTable buildDispatchTable();
+
+    void generateDBT(const SKUpdate& update, SKNMEAOutput& output);
+    void generateDPT(const SKUpdate& update, SKNMEAOutput& output);
+    void generateHDM(const SKUpdate& update, SKNMEAOutput& output);
+    void generateMWVApparent(const SKUpdate& update, SKNMEAOutput& output);
+    void generateMWVTrue(const SKUpdate& update, SKNMEAOutput& output);
+    void generateRSA(const SKUpdate& update, SKNMEAOutput& output);
+    void generateXDRAttitude(const SKUpdate& update, SKNMEAOutput& output);
+    void generateXDRBattery(const SKUpdate& update, SKNMEAOutput& output);
+    void generateXDRPressure(const SKUpdate& update, SKNMEAOutput& output);
+
   public:
     SKNMEAConverter(const SKNMEAConverterConfig &config) : _config(config), _currentOutput(nullptr) {};
 
     /**
      * Process a SKUpdate and sends messages to the output.
+     *
+     * Only the generators depending on the paths present in the update are
+     * called, in the order of the _generators table.
      */
     void convert(const SKUpdate& update, SKNMEAOutput& output);
+
+    /**
+     * Returns a filter matching all the paths that can be converted with the
+     * given configuration.
+     */
+    static SKSubscriptionFilter subscriptionFilter(const SKNMEAConverterConfig &config);
 };
@@ -0,0 +1,88 @@
+// This file was automatically generated by sk-code-generator.py
+// DO NOT MODIFY! YOUR CHANGES WOULD BE OVERWRITTEN
+// Look at src/common/signalk/SKNMEADescriptors.cpp.tmpl instead or modify the script
+// Generated on 2026-10-17 13:51:32.244195
+
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common/nmea/NMEASentenceReader.h"
+#include "SKNMEADescriptors.h"
+
+const SKNMEAFieldDescriptor skNMEAFieldDescriptors[] = {
+  { NMEAPackCode("DBT"), 3, 0, SKNMEAConversionNone, 4, 'M', 0, 0, 0, 0, SKPathEnvironmentDepthBelowTransducer },
+  { NMEAPackCode("DPT"), 1, 0, SKNMEAConversionNone, 0, 0, 0, 0, 0, 0, SKPathEnvironmentDepthBelowTransducer },
+  { NMEAPackCode("DPT"), 2, 0, SKNMEAConversionNegativeOnly, 0, 0, 0, 0, 0, 0, SKPathEnvironmentDepthTransducerToKeel },
+  { NMEAPackCode("DPT"), 2, 0, SKNMEAConversionPositiveOnly, 0, 0, 0, 0, 0, 0, SKPathEnvironmentDepthSurfaceToTransducer },
+  { NMEAPackCode("GLL"), 1, 3, SKNMEAConversionPosition, 0, 0, 0, 0, 6, 'A', SKPathNavigationPosition },
+  { NMEAPackCode("HDG"), 1, 0, SKNMEAConversionDegToRad, 0, 0, 0, 0, 0, 0, SKPathNavigationHeadingMagnetic },
+  { NMEAPackCode("HDG"), 4, 5, SKNMEAConversionMagneticVariation, 0, 0, 0, 0, 0, 0, SKPathNavigationMagneticVariation },
+  { NMEAPackCode("HDM"), 1, 0, SKNMEAConversionDegToRad, 2, 'M', 0, 0, 0, 0, SKPathNavigationHeadingMagnetic },
+  { NMEAPackCode("HDT"), 1, 0, SKNMEAConversionDegToRad, 2, 'T', 0, 0, 0, 0, SKPathNavigationHeadingTrue },
+  { NMEAPackCode("MTA"), 1, 0, SKNMEAConversionCelsiusToKelvin, 2, 'C', 0, 0, 0, 0, SKPathEnvironmentOutsideTemperature },
+  { NMEAPackCode("MTW"), 1, 0, SKNMEAConversionCelsiusToKelvin, 2, 'C', 0, 0, 0, 0, SKPathEnvironmentWaterTemperature },
+  { NMEAPackCode("MWD"), 1, 0, SKNMEAConversionDegToRad, 2, 'T', 0, 0, 0, 0, SKPathEnvironmentWindDirectionTrue },
+  { NMEAPackCode("MWD"), 3, 0, SKNMEAConversionDegToRad, 4, 'M', 0, 0, 0, 0, SKPathEnvironmentWindDirectionMagnetic },
+  { NMEAPackCode("MWV"), 1, 0, SKNMEAConversionDegToAngle, 0, 0, 2, 'R', 5, 'A', SKPathEnvironmentWindAngleApparent },
+  { NMEAPackCode("MWV"), 1, 0, SKNMEAConversionDegToAngle, 0, 0, 2, 'T', 5, 'A', SKPathEnvironmentWindAngleTrueWater },
+  { NMEAPackCode("MWV"), 3, 0, SKNMEAConversionKnotToMs, 4, 'N', 2, 'T', 5, 'A', SKPathEnvironmentWindSpeedTrue },
+  { NMEAPackCode("MWV"), 3, 0, SKNMEAConversionNone, 4, 'M', 2, 'T', 5, 'A', SKPathEnvironmentWindSpeedTrue },
+  { NMEAPackCode("MWV"), 3, 0, SKNMEAConversionKmphToMs, 4, 'K', 2, 'T', 5, 'A', SKPathEnvironmentWindSpeedTrue },
+  { NMEAPackCode("MWV"), 3, 0, SKNMEAConversionStatuteMphToMs, 4, 'S', 2, 'T', 5, 'A', SKPathEnvironmentWindSpeedTrue },
+  { NMEAPackCode("MWV"), 3, 0, SKNMEAConversionKnotToMs, 4, 'N', 2, 'R', 5, 'A', SKPathEnvironmentWindSpeedApparent },
+  { NMEAPackCode("MWV"), 3, 0, SKNMEAConversionNone, 4, 'M', 2, 'R', 5, 'A', SKPathEnvironmentWindSpeedApparent },
+  { NMEAPackCode("MWV"), 3, 0, SKNMEAConversionKmphToMs, 4, 'K', 2, 'R', 5, 'A', SKPathEnvironmentWindSpeedApparent },
+  { NMEAPackCode("MWV"), 3, 0, SKNMEAConversionStatuteMphToMs, 4, 'S', 2, 'R', 5, 'A', SKPathEnvironmentWindSpeedApparent },
+  { NMEAPackCode("RMC"), 8, 0, SKNMEAConversionDegToRad, 0, 0, 0, 0, 2, 'A', SKPathNavigationCourseOverGroundTrue },
+  { NMEAPackCode("RMC"), 9, 1, SKNMEAConversionDateTime, 0, 0, 0, 0, 2, 'A', SKPathNavigationDatetime },
+  { NMEAPackCode("RMC"), 10, 11, SKNMEAConversionMagneticVariation, 0, 0, 0, 0, 2, 'A', SKPathNavigationMagneticVariation },
+  { NMEAPackCode("RMC"), 3, 5, SKNMEAConversionPosition, 0, 0, 0, 0, 2, 'A', SKPathNavigationPosition },
+  { NMEAPackCode("RMC"), 7, 0, SKNMEAConversionKnotToMs, 0, 0, 0, 0, 2, 'A', SKPathNavigationSpeedOverGround },
+  { NMEAPackCode("RSA"), 1, 0, SKNMEAConversionDegToRad, 0, 0, 0, 0, 2, 'A', SKPathSteeringRudderAngle },
+  { NMEAPackCode("VHW"), 3, 0, SKNMEAConversionDegToRad, 4, 'M', 0, 0, 0, 0, SKPathNavigationHeadingMagnetic },
+  { NMEAPackCode("VHW"), 1, 0, SKNMEAConversionDegToRad, 2, 'T', 0, 0, 0, 0, SKPathNavigationHeadingTrue },
+  { NMEAPackCode("VHW"), 5, 0, SKNMEAConversionKnotToMs, 6, 'N', 0, 0, 0, 0, SKPathNavigationSpeedThroughWater },
+  { NMEAPackCode("VHW"), 7, 0, SKNMEAConversionKmphToMs, 8, 'K', 0, 0, 0, 0, SKPathNavigationSpeedThroughWater },
+  { NMEAPackCode("VLW"), 1, 0, SKNMEAConversionNauticalMileToMeter, 2, 'N', 0, 0, 0, 0, SKPathNavigationLog },
+  { NMEAPackCode("VLW"), 3, 0, SKNMEAConversionNauticalMileToMeter, 4, 'N', 0, 0, 0, 0, SKPathNavigationTripLog },
+  { NMEAPackCode("VTG"), 1, 0, SKNMEAConversionDegToRad, 2, 'T', 0, 0, 0, 0, SKPathNavigationCourseOverGroundTrue },
+  { NMEAPackCode("VTG"), 5, 0, SKNMEAConversionKnotToMs, 6, 'N', 0, 0, 0, 0, SKPathNavigationSpeedOverGround },
+  { NMEAPackCode("VTG"), 7, 0, SKNMEAConversionKmphToMs, 8, 'K', 0, 0, 0, 0, SKPathNavigationSpeedOverGround },
+  { NMEAPackCode("VWR"), 1, 0, SKNMEAConversionDegToRad, 0, 0, 2, 'R', 0, 0, SKPathEnvironmentWindAngleApparent },
+  { NMEAPackCode("VWR"), 1, 0, SKNMEAConversionNegatedDegToRad, 0, 0, 2, 'L', 0, 0, SKPathEnvironmentWindAngleApparent },
+  { NMEAPackCode("VWR"), 3, 0, SKNMEAConversionKnotToMs, 4, 'N', 0, 0, 0, 0, SKPathEnvironmentWindSpeedApparent },
+  { NMEAPackCode("VWR"), 5, 0, SKNMEAConversionNone, 6, 'M', 0, 0, 0, 0, SKPathEnvironmentWindSpeedApparent },
+  { NMEAPackCode("VWR"), 7, 0, SKNMEAConversionKmphToMs, 8, 'K', 0, 0, 0, 0, SKPathEnvironmentWindSpeedApparent },
+};
+const size_t skNMEAFieldDescriptorsCount = sizeof(skNMEAFieldDescriptors) / sizeof(skNMEAFieldDescriptors[0]);
+
+const SKNMEAXDRDescriptor skNMEAXDRDescriptors[] = {
+  { 'P', 'B', "Barometer", SKNMEAConversionBarToPascal, SKPathEnvironmentOutsidePressure },
+  { 'P', 'P', "Barometer", SKNMEAConversionNone, SKPathEnvironmentOutsidePressure },
+  { 'A', 'D', "PTCH", SKNMEAConversionAttitudePitch, SKPathNavigationAttitude },
+  { 'A', 'D', "ROLL", SKNMEAConversionAttitudeRoll, SKPathNavigationAttitude },
+  { 'C', 'C', nullptr, SKNMEAConversionCelsiusToKelvin, SKPathEnvironmentOutsideTemperature },
+  { 'U', 'V', nullptr, SKNMEAConversionNone, SKPathElectricalBatteriesVoltage },
+};
+const size_t skNMEAXDRDescriptorsCount = sizeof(skNMEAXDRDescriptors) / sizeof(skNMEAXDRDescriptors[0]);
@@ -0,0 +1,112 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "SKPath.h"
+
+/**
+ * How the value of a NMEA field is converted into a SignalK value. The
+ * conversions use the functions of SKUnits.h.
+ */
+enum SKNMEAConversion : uint8_t {
+  SKNMEAConversionNone,
+  // Only keep the value if it is strictly positive.
+  SKNMEAConversionPositiveOnly,
+  // Only keep the value if it is strictly negative and negate it.
+  SKNMEAConversionNegativeOnly,
+  SKNMEAConversionKnotToMs,
+  SKNMEAConversionKmphToMs,
+  SKNMEAConversionStatuteMphToMs,
+  SKNMEAConversionNauticalMileToMeter,
+  SKNMEAConversionDegToRad,
+  // Degrees to radians, negated (for angles measured towards port)
+  SKNMEAConversionNegatedDegToRad,
+  // Degrees to an angle in radians between -PI and PI.
+  SKNMEAConversionDegToAngle,
+  SKNMEAConversionCelsiusToKelvin,
+  SKNMEAConversionBarToPascal,
+  // Latitude in field (and field + 1), longitude in auxField (and auxField + 1).
+  SKNMEAConversionPosition,
+  // Degrees in field, E or W in auxField.
+  SKNMEAConversionMagneticVariation,
+  // Date (ddmmyy) in field, time (hhmmss.ss) in auxField.
+  SKNMEAConversionDateTime,
+  // Degrees, stored in the pitch or roll of the navigation.attitude value.
+  SKNMEAConversionAttitudePitch,
+  SKNMEAConversionAttitudeRoll,
+};
+
+/**
+ * Describes how one field of a NMEA0183 sentence is decoded into a SignalK
+ * path.
+ *
+ * A field is only decoded if the unitField, referenceField and statusField
+ * (when they are not 0) contain the expected character. For example, MWV
+ * has one descriptor per reference (relative or true) and speed unit.
+ *
+ * If the update already has a value for the path (set by a previous
+ * descriptor of the same sentence), the descriptor is skipped.
+ */
+struct SKNMEAFieldDescriptor {
+  uint32_t sentence;
+  uint8_t field;
+  uint8_t auxField;
+  SKNMEAConversion conversion;
+  uint8_t unitField;
+  char unit;
+  uint8_t referenceField;
+  char reference;
+  uint8_t statusField;
+  char status;
+  SKPathEnum path;
+};
+
+/**
+ * Describes how one measurement (type, value, unit, name) of a XDR sentence
+ * is decoded. A null name matches every measurement with this type and unit.
+ * For indexed paths, the name of the measurement is used as the index.
+ */
+struct SKNMEAXDRDescriptor {
+  char type;
+  char unit;
+  const char *name;
+  SKNMEAConversion conversion;
+  SKPathEnum path;
+};
+
+/**
+ * Field descriptors of all the sentences, sorted by sentence code (see
+ * NMEAPackCode()). Generated from signalk.json by sk-code-generator.py.
+ */
+extern const SKNMEAFieldDescriptor skNMEAFieldDescriptors[];
+extern const size_t skNMEAFieldDescriptorsCount;
+
+/**
+ * XDR measurement descriptors. Descriptors with a name come first.
+ */
+extern const SKNMEAXDRDescriptor skNMEAXDRDescriptors[];
+extern const size_t skNMEAXDRDescriptorsCount;
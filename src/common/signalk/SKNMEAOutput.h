@@ -30,7 +30,7 @@
 
 #pragma once
 
-#include "SKNMEASentence.h"
+#include "common/nmea/NMEAFixedSentence.h"
 
 class SKNMEAOutput {
   public:
@@ -39,12 +39,12 @@ class SKNMEAOutput {
     /**
      * Writes one complete NMEA sentence to the output.
      *
-     * nmeaSentence must be terminated by "*XX\0" (where XX is the checksum). It
-     * should already include the "\r\n".
+     * nmeaSentence is terminated by "*XX" (where XX is the checksum), without
+     * the "\r\n".
      *
      * @return true if the sentence was completely written, or false if the
      * sentence could not be written.
      */
-    virtual bool write(const SKNMEASentence& nmeaSentence) = 0;
+    virtual bool write(const NMEAFixedSentence& nmeaSentence) = 0;
 };
 
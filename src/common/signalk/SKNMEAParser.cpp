@@ -25,245 +25,363 @@
 #include <math.h>
 #include <KBoxLogging.h>
 #include "common/nmea/NMEASentenceReader.h"
+#include "SKNMEADescriptors.h"
 #include "SKUnits.h"
 #include "SKNMEAParser.h"
 
-SKNMEAParser::~SKNMEAParser() {
-  if (_sku) {
-    delete(_sku);
-  }
+/*
+ * Build the source from the address field without allocating memory.
+ */
+static SKSource sourceForSentence(const SKSourceInput& input, const NMEASentenceReader& reader) {
+  char talker[3];
+  char sentence[4];
+  reader.getTalkerId().copyTo(talker, sizeof(talker));
+  reader.getSentenceCode().copyTo(sentence, sizeof(sentence));
+  return SKSource::sourceForNMEA0183(input, talker, sentence);
 }
 
-const SKUpdate& SKNMEAParser::parse(const SKSourceInput& input, const String& sentence, const SKTime& time) {
-  if (_sku) {
-    delete(_sku);
-    _sku = 0;
-  }
+struct SKNMEAParser::SentenceHandler {
+  uint32_t code;
+  bool SKNMEAParserConfig::*enabled;
+  // Optional: computes values that depend on several fields once the
+  // descriptors have been decoded.
+  void (*complete)(SKUpdate& update);
+};
 
-  NMEASentenceReader reader = NMEASentenceReader(sentence);
+template <typename Handler> static constexpr bool isSortedByCode(const Handler *handlers, size_t count) {
+  return count < 2 || (handlers[0].code < handlers[1].code && isSortedByCode(handlers + 1, count - 1));
+}
 
-  if (!reader.isValid()) {
-    DEBUG("%s: Invalid sentence %s", skSourceInputLabels[input].c_str(), sentence.c_str());
-    return _invalidSku;
+/*
+ * DPT gives the offset of the transducer. Depth below surface and depth below
+ * keel are computed from it.
+ */
+static void completeDPT(SKUpdate& update) {
+  if (!update.hasEnvironmentDepthBelowTransducer()) {
+    return;
   }
-
-  if (reader.getSentenceCode() == "DBT") {
-    return parseDBT(input, reader, time);
+  double depth = update.getEnvironmentDepthBelowTransducer();
+  if (update.hasEnvironmentDepthSurfaceToTransducer()) {
+    update.setEnvironmentDepthBelowSurface(depth + update.getEnvironmentDepthSurfaceToTransducer());
   }
-
-  if (reader.getSentenceCode() == "DPT") {
-    return parseDPT(input, reader, time);
+  if (update.hasEnvironmentDepthTransducerToKeel()) {
+    update.setEnvironmentDepthBelowKeel(depth - update.getEnvironmentDepthTransducerToKeel());
   }
+}
 
-  if (reader.getSentenceCode() == "MWV") {
-    return parseMWV(input, reader, time);
+const SKNMEAParser::SentenceHandler* SKNMEAParser::findHandler(uint32_t code) {
+  // Must be sorted by code. The fields of each sentence are described in
+  // signalk.json (see SKNMEADescriptors.h).
+  static constexpr SentenceHandler handlers[] = {
+    { NMEAPackCode("DBT"), &SKNMEAParserConfig::dbt, nullptr },
+    { NMEAPackCode("DPT"), &SKNMEAParserConfig::dpt, completeDPT },
+    { NMEAPackCode("GLL"), &SKNMEAParserConfig::gll, nullptr },
+    { NMEAPackCode("HDG"), &SKNMEAParserConfig::hdg, nullptr },
+    { NMEAPackCode("HDM"), &SKNMEAParserConfig::hdm, nullptr },
+    { NMEAPackCode("HDT"), &SKNMEAParserConfig::hdt, nullptr },
+    { NMEAPackCode("MTA"), &SKNMEAParserConfig::mta, nullptr },
+    { NMEAPackCode("MTW"), &SKNMEAParserConfig::mtw, nullptr },
+    { NMEAPackCode("MWD"), &SKNMEAParserConfig::mwd, nullptr },
+    { NMEAPackCode("MWV"), &SKNMEAParserConfig::mwv, nullptr },
+    { NMEAPackCode("RMC"), &SKNMEAParserConfig::rmc, nullptr },
+    { NMEAPackCode("RSA"), &SKNMEAParserConfig::rsa, nullptr },
+    { NMEAPackCode("VHW"), &SKNMEAParserConfig::vhw, nullptr },
+    { NMEAPackCode("VLW"), &SKNMEAParserConfig::vlw, nullptr },
+    { NMEAPackCode("VTG"), &SKNMEAParserConfig::vtg, nullptr },
+    { NMEAPackCode("VWR"), &SKNMEAParserConfig::vwr, nullptr },
+    { NMEAPackCode("XDR"), &SKNMEAParserConfig::xdr, nullptr },
+  };
+  static const size_t count = sizeof(handlers) / sizeof(handlers[0]);
+  static_assert(isSortedByCode(handlers, count), "handlers must be sorted by code");
+
+  size_t low = 0;
+  size_t high = count;
+  while (low < high) {
+    size_t middle = (low + high) / 2;
+    if (handlers[middle].code < code) {
+      low = middle + 1;
+    }
+    else {
+      high = middle;
+    }
   }
-
-  if (reader.getSentenceCode() == "RMC") {
-    return parseRMC(input, reader, time);
+  if (low < count && handlers[low].code == code) {
+    return &handlers[low];
   }
+  return nullptr;
+}
 
-  if (reader.getSentenceCode() == "XDR") {
-    return parseXDR(input, reader, time);
+const SKUpdate& SKNMEAParser::parse(const SKSourceInput& input, const String& sentence, const SKTime& time) {
+  if (parse(input, sentence, time, _update)) {
+    return _update;
   }
-
-  DEBUG("%s: %s%s - Unable to parse sentence", skSourceInputLabels[input].c_str(), reader.getTalkerId().c_str(), reader.getSentenceCode().c_str());
   return _invalidSku;
 }
 
-const SKUpdate& SKNMEAParser::parseDBT(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time) {
-  double depthBelowTransducer = reader.getFieldAsDouble(3);
-
-  if (reader.getFieldAsChar(4) == 'M' && !isnan(depthBelowTransducer)) {
-    auto *dbt = new SKUpdateStatic<1>();
-    dbt->setTimestamp(time);
-    SKSource source = SKSource::sourceForNMEA0183(input, reader.getTalkerId(), reader.getSentenceCode());
-    dbt->setSource(source);
+bool SKNMEAParser::parse(const SKSourceInput& input, const String& sentence, const SKTime& time, SKUpdate& update) {
+  update.clear();
 
-    dbt->setEnvironmentDepthBelowTransducer(depthBelowTransducer);
+  NMEASentenceReader reader(sentence);
 
-    _sku = dbt;
-    return *dbt;
+  if (!reader.isValid()) {
+    DEBUG("%s: Invalid sentence %s", skSourceInputLabels[input].c_str(), sentence.c_str());
+    return false;
   }
-  else {
-    return _invalidSku;
+
+  uint32_t code = reader.getSentenceCode().pack();
+  const SentenceHandler *handler = findHandler(code);
+  if (handler && !(_config.*(handler->enabled))) {
+    return false;
   }
-}
 
-const SKUpdate& SKNMEAParser::parseDPT(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time) {
-  double depthBelowTransducer = reader.getFieldAsDouble(1);
-  double transducerOffset = reader.getFieldAsDouble(2);
-
-  if (!isnan(depthBelowTransducer)) {
-    auto dpt = new SKUpdateStatic<3>();
-    dpt->setTimestamp(time);
-    SKSource source = SKSource::sourceForNMEA0183(input, reader.getTalkerId(), reader.getSentenceCode());
-    dpt->setSource(source);
-
-    dpt->setEnvironmentDepthBelowTransducer(depthBelowTransducer);
-
-    if (!isnan(transducerOffset)) {
-      if (transducerOffset > 0) {
-        dpt->setEnvironmentDepthSurfaceToTransducer(transducerOffset);
-        dpt->setEnvironmentDepthBelowSurface(depthBelowTransducer + transducerOffset);
-      } else if (transducerOffset < 0) {
-        dpt->setEnvironmentDepthTransducerToKeel(-transducerOffset);
-        dpt->setEnvironmentDepthBelowKeel(depthBelowTransducer + transducerOffset);
+  if (_talkerParsersCount > 0) {
+    uint32_t talker = reader.getTalkerId().pack();
+    for (int i = 0; i < _talkerParsersCount; i++) {
+      if (_talkerParsers[i].talker == talker && _talkerParsers[i].code == code) {
+        SKNMEASentenceParser parser = _talkerParsers[i].parser;
+        return parser && parser(input, reader, time, update);
       }
     }
-    _sku = dpt;
-    return *dpt;
   }
-  else {
-    return _invalidSku;
-  }
-}
-
-const SKUpdate& SKNMEAParser::parseMWV(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time) {
-  if (reader.getFieldAsChar(5) != 'A') {
-    return _invalidSku;
-  }
-
-  double windSpeed = reader.getFieldAsDouble(3);
-  double windAngle = reader.getFieldAsDouble(1);
-  bool isApparentWind;
 
-  if (isnan(windSpeed) || isnan(windAngle)) {
-    return _invalidSku;
+  if (handler) {
+    return decodeSentence(*handler, input, reader, time, update);
   }
 
-  switch (reader.getFieldAsChar(4)) {
-    case 'K':
-      windSpeed = SKKmphToMs(windSpeed);
-      break;
-    case 'M':
-      // do nothing. wind speed already in m/s.
-      break;
-    case 'N':
-      windSpeed = SKKnotToMs(windSpeed);
-      break;
-    case 'S':
-      windSpeed = SKStatuteMphToMs(windSpeed);
-      break;
-    default:
-      return _invalidSku;
-  }
-
-  if (reader.getFieldAsChar(2) == 'R') {
-    isApparentWind = true;
-  }
-  else if (reader.getFieldAsChar(2) == 'T') {
-    isApparentWind = false;
-  }
-  else {
-    return _invalidSku;
-  }
-
-  // Wind sensors return a number between 0 and 360 but we want an
-  // angle in radian with negative values when wind coming from port
-  windAngle = SKNormalizeAngle(SKDegToRad(windAngle));
-
-  SKUpdateStatic<2>* wmv = new SKUpdateStatic<2>();
-  wmv->setTimestamp(time);
+  NMEAField address = reader.getField(0);
+  DEBUG("%s: %.*s - Unable to parse sentence", skSourceInputLabels[input].c_str(), (int)address.getLength(), address.getData());
+  return false;
+}
 
-  SKSource source = SKSource::sourceForNMEA0183(input, reader.getTalkerId(), reader.getSentenceCode());
-  wmv->setSource(source);
+bool SKNMEAParser::setTalkerParser(const char *talker, const char *code, SKNMEASentenceParser parser) {
+  uint32_t packedTalker = NMEAPackCode(talker);
+  uint32_t packedCode = NMEAPackCode(code);
 
-  if (isApparentWind) {
-    wmv->setEnvironmentWindAngleApparent(windAngle);
-    wmv->setEnvironmentWindSpeedApparent(windSpeed);
+  for (int i = 0; i < _talkerParsersCount; i++) {
+    if (_talkerParsers[i].talker == packedTalker && _talkerParsers[i].code == packedCode) {
+      _talkerParsers[i].parser = parser;
+      return true;
+    }
   }
-  else {
-    // Here we are assuming that if we get a true wind, it is true relative to
-    // boat speed in water.  This might be incorrect for some elaborate
-    // computers that would take GPS data and provide a true wind over ground.
-    // TODO: make this a configuration option
-    wmv->setEnvironmentWindAngleTrueWater(windAngle);
-    wmv->setEnvironmentWindSpeedTrue(windSpeed);
+  if (_talkerParsersCount >= MaxTalkerParsers) {
+    return false;
   }
+  _talkerParsers[_talkerParsersCount++] = TalkerParser { packedTalker, packedCode, parser };
+  return true;
+}
 
-  // _sku is deleted every time a new sentence is parsed
-  _sku = wmv;
-  return *_sku;
+bool SKNMEAParser::parseDBT(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time, SKUpdate& update) {
+  return decodeSentence(*findHandler(NMEAPackCode("DBT")), input, reader, time, update);
 }
 
-const SKUpdate& SKNMEAParser::parseRMC(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time) {
-  // We first need to make sure the data is valid.
-  if (reader.getFieldAsChar(2) != 'A') {
-    return _invalidSku;
-  }
+bool SKNMEAParser::parseDPT(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time, SKUpdate& update) {
+  return decodeSentence(*findHandler(NMEAPackCode("DPT")), input, reader, time, update);
+}
 
-  auto rmc = new SKUpdateStatic<5>();
-  rmc->setTimestamp(time);
+bool SKNMEAParser::parseMWV(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time, SKUpdate& update) {
+  return decodeSentence(*findHandler(NMEAPackCode("MWV")), input, reader, time, update);
+}
 
-  SKSource source = SKSource::sourceForNMEA0183(input, reader.getTalkerId(), reader.getSentenceCode());
-  rmc->setSource(source);
+bool SKNMEAParser::parseRMC(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time, SKUpdate& update) {
+  return decodeSentence(*findHandler(NMEAPackCode("RMC")), input, reader, time, update);
+}
 
-  String utcTime = reader.getFieldAsString(1);
-  double latitude = reader.getFieldAsLatLon(3);
-  double longitude = reader.getFieldAsLatLon(5);
-  double sog = SKKnotToMs(reader.getFieldAsDouble(7));
-  double cog = SKDegToRad(reader.getFieldAsDouble(8));
-  String date = reader.getFieldAsString(9);
+bool SKNMEAParser::parseXDR(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time, SKUpdate& update) {
+  return decodeSentence(*findHandler(NMEAPackCode("XDR")), input, reader, time, update);
+}
 
-  if (!isnan(latitude) && !isnan(longitude)) {
-    rmc->setValue(SKPathNavigationPosition, SKTypePosition(latitude,
-                                                           longitude,
-                                                           SKDoubleNAN));
+bool SKNMEAParser::decodeSentence(const SentenceHandler& handler, const SKSourceInput& input,
+                                  NMEASentenceReader& reader, const SKTime& time, SKUpdate& update) {
+  if (handler.code == NMEAPackCode("XDR")) {
+    decodeXDR(reader, update);
   }
-  if (!isnan(sog)) {
-    rmc->setValue(SKPathNavigationSpeedOverGround, sog);
+  else {
+    decodeFields(handler.code, reader, update);
   }
-  if (!isnan(cog)) {
-    rmc->setValue(SKPathNavigationCourseOverGroundTrue, cog);
+  if (handler.complete) {
+    handler.complete(update);
   }
 
-  double magVar = reader.getFieldAsDouble(10);
-  char magVarSign = reader.getFieldAsChar(11);
-  if (!isnan(magVar) && (magVarSign == 'E' || magVarSign == 'W')) {
-    if (magVarSign == 'W') {
-      magVar *= -1;
-    }
-    rmc->setValue(SKPathNavigationMagneticVariation, SKDegToRad(magVar));
+  if (update.getSize() == 0) {
+    return false;
   }
+  update.setTimestamp(time);
+  SKSource source = sourceForSentence(input, reader);
+  update.setSource(source);
+  return true;
+}
 
-  if (date.length() >= 6 && utcTime.length() >= 6) {
-    SKTime timestamp = SKTime::timeFromNMEAStrings(date, utcTime);
-    rmc->setNavigationDatetime(timestamp);
+/*
+ * Returns true and the converted value of the field in value, or false if
+ * the field is empty or the value should be ignored.
+ */
+static bool convertNumber(SKNMEAConversion conversion, double v, double &value) {
+  if (isnan(v)) {
+    return false;
   }
+  switch (conversion) {
+    case SKNMEAConversionPositiveOnly:
+      value = v;
+      return v > 0;
+    case SKNMEAConversionNegativeOnly:
+      value = -v;
+      return v < 0;
+    case SKNMEAConversionKnotToMs:
+      value = SKKnotToMs(v);
+      break;
+    case SKNMEAConversionKmphToMs:
+      value = SKKmphToMs(v);
+      break;
+    case SKNMEAConversionStatuteMphToMs:
+      value = SKStatuteMphToMs(v);
+      break;
+    case SKNMEAConversionNauticalMileToMeter:
+      value = SKNauticalMileToMeter(v);
+      break;
+    case SKNMEAConversionDegToRad:
+      value = SKDegToRad(v);
+      break;
+    case SKNMEAConversionNegatedDegToRad:
+      value = SKDegToRad(-v);
+      break;
+    case SKNMEAConversionDegToAngle:
+      // Sensors return a number between 0 and 360 but we want an angle in
+      // radian with negative values to port.
+      value = SKNormalizeAngle(SKDegToRad(v));
+      break;
+    case SKNMEAConversionCelsiusToKelvin:
+      value = SKCelsiusToKelvin(v);
+      break;
+    case SKNMEAConversionBarToPascal:
+      value = SKBarToPascal(v);
+      break;
+    default:
+      value = v;
+      break;
+  }
+  return true;
+}
 
-  // _sku is deleted every time a new sentence is parsed
-  _sku = rmc;
-  return *_sku;
+static bool fieldMatches(const NMEASentenceReader& reader, uint8_t field, char expected) {
+  return field == 0 || reader.getFieldAsChar(field) == expected;
 }
 
-const SKUpdate& SKNMEAParser::parseXDR(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& time) {
-  // FIXME: XDR contains group of 4 variables that describe one transducer measurement
-  // We will want to handle all sorts of measurements here.
-  if (reader.getFieldAsChar(1) == 'C') {
-    return parseXDRtemp(input, reader, time);
+void SKNMEAParser::decodeFields(uint32_t code, const NMEASentenceReader& reader, SKUpdate& update) {
+  // Descriptors are sorted by sentence code: find the first one for this code.
+  size_t low = 0;
+  size_t high = skNMEAFieldDescriptorsCount;
+  while (low < high) {
+    size_t middle = (low + high) / 2;
+    if (skNMEAFieldDescriptors[middle].sentence < code) {
+      low = middle + 1;
+    }
+    else {
+      high = middle;
+    }
   }
-  else {
-    return _invalidSku;
+
+  for (size_t i = low; i < skNMEAFieldDescriptorsCount && skNMEAFieldDescriptors[i].sentence == code; i++) {
+    const SKNMEAFieldDescriptor &d = skNMEAFieldDescriptors[i];
+
+    if (!fieldMatches(reader, d.statusField, d.status)
+        || !fieldMatches(reader, d.referenceField, d.reference)
+        || !fieldMatches(reader, d.unitField, d.unit)
+        || update.hasPath(d.path)) {
+      continue;
+    }
+
+    switch (d.conversion) {
+      case SKNMEAConversionPosition: {
+        double latitude = reader.getFieldAsLatLon(d.field);
+        double longitude = reader.getFieldAsLatLon(d.auxField);
+        if (!isnan(latitude) && !isnan(longitude)) {
+          update.setValue(d.path, SKTypePosition(latitude, longitude, SKDoubleNAN));
+        }
+        break;
+      }
+      case SKNMEAConversionMagneticVariation: {
+        double variation = reader.getFieldAsDouble(d.field);
+        char direction = reader.getFieldAsChar(d.auxField);
+        if (!isnan(variation) && (direction == 'E' || direction == 'W')) {
+          update.setValue(d.path, SKDegToRad(direction == 'W' ? -variation : variation));
+        }
+        break;
+      }
+      case SKNMEAConversionDateTime: {
+        NMEAField date = reader.getField(d.field);
+        NMEAField time = reader.getField(d.auxField);
+        if (date.getLength() >= 6 && time.getLength() >= 6) {
+          update.setValue(d.path, SKTime::timeFromNMEAStrings(date.getData(), date.getLength(),
+                                                              time.getData(), time.getLength()));
+        }
+        break;
+      }
+      default: {
+        double value;
+        if (convertNumber(d.conversion, reader.getFieldAsDouble(d.field), value)) {
+          update.setValue(d.path, value);
+        }
+      }
+    }
   }
 }
 
-const SKUpdate& SKNMEAParser::parseXDRtemp(const SKSourceInput &input, NMEASentenceReader &reader,
-                                           const SKTime time){
-  double temperature = reader.getFieldAsDouble(2);
+void SKNMEAParser::decodeXDR(const NMEASentenceReader& reader, SKUpdate& update) {
+  // XDR is a list of measurements of four fields: type, value, unit, name.
+  for (int group = 1; group + 2 <= reader.countFields(); group += 4) {
+    char type = reader.getFieldAsChar(group);
+    char unit = reader.getFieldAsChar(group + 2);
+    NMEAField name = reader.getField(group + 3);
+
+    for (size_t i = 0; i < skNMEAXDRDescriptorsCount; i++) {
+      const SKNMEAXDRDescriptor &d = skNMEAXDRDescriptors[i];
+      if (d.type != type || d.unit != unit || (d.name && name != d.name)) {
+        continue;
+      }
 
-  if (!isnan(temperature) && reader.getFieldAsChar(3) == 'C') {
-    auto *dbt = new SKUpdateStatic<1>();
-    dbt->setTimestamp(time);
-    SKSource source = SKSource::sourceForNMEA0183(input, reader.getTalkerId(), reader.getSentenceCode());
-    dbt->setSource(source);
+      double v = reader.getFieldAsDouble(group + 1);
+      if (isnan(v)) {
+        break;
+      }
 
-    dbt->setEnvironmentOutsideTemperature(SKCelsiusToKelvin(temperature));
+      if (d.conversion == SKNMEAConversionAttitudePitch || d.conversion == SKNMEAConversionAttitudeRoll) {
+        SKTypeAttitude attitude(SKDoubleNAN, SKDoubleNAN, SKDoubleNAN);
+        if (update.hasNavigationAttitude()) {
+          attitude = update.getNavigationAttitude();
+        }
+        if (d.conversion == SKNMEAConversionAttitudePitch) {
+          attitude.pitch = SKDegToRad(v);
+        }
+        else {
+          attitude.roll = SKDegToRad(v);
+        }
+        update.setNavigationAttitude(attitude);
+        break;
+      }
 
-    _sku = dbt;
-    return *dbt;
-  }
-  else {
-    return _invalidSku;
+      double value;
+      if (!convertNumber(d.conversion, v, value)) {
+        break;
+      }
+      if (d.path > SKPathEnumIndexedPaths) {
+        // The name of the measurement is the index (a battery bank, ...)
+        char index[SKIndexTable::MaxIndexLength + 1];
+        if (name.isEmpty() || name.getLength() >= sizeof(index)) {
+          break;
+        }
+        name.copyTo(index, sizeof(index));
+        // Names from the wire are interned in the share of the index
+        // table reserved for inputs.
+        SKIndexId id = skIndexTable.internInput(index);
+        if (id == SKIndexInvalid) {
+          break;
+        }
+        update.setValue(SKPath(d.path, id), value);
+      }
+      else {
+        update.setValue(d.path, value);
+      }
+      break;
+    }
   }
-}
\ No newline at end of file
+}
@@ -26,20 +26,80 @@
 
 #include "SKUpdate.h"
 #include "SKUpdateStatic.h"
+#include "SKNMEAParserConfig.h"
 
 class NMEASentenceReader;
 
+/**
+ * A function converting one type of NMEA sentence into an update.
+ */
+typedef bool (*SKNMEASentenceParser)(const SKSourceInput& input, NMEASentenceReader& reader,
+                                     const SKTime& timestamp, SKUpdate& update);
+
 /**
  * Parse NMEA sentences into SignalK updates.
+ *
+ * Sentences are dispatched on their code (packed in an integer) with a binary
+ * search in a sorted table of handlers so adding sentences does not slow down
+ * the others.
+ *
+ * The fields of each sentence are decoded by walking their descriptors (see
+ * SKNMEADescriptors.h) which are generated from signalk.json. XDR sentences
+ * are decoded one measurement at a time.
  */
 class SKNMEAParser {
+  public:
+    /**
+     * Maximum number of values generated by one sentence. Updates passed to
+     * `parse()` should have at least this capacity.
+     */
+    static const uint16_t MaxValuesPerUpdate = 8;
+
+    /**
+     * Maximum number of talker specific parsers (see setTalkerParser()).
+     */
+    static const int MaxTalkerParsers = 4;
+
   private:
-    SKUpdate *_sku = 0;
+    struct SentenceHandler;
+    struct TalkerParser {
+      uint32_t talker;
+      uint32_t code;
+      SKNMEASentenceParser parser;
+    };
+
+    SKNMEAParserConfig _config;
+    TalkerParser _talkerParsers[MaxTalkerParsers];
+    int _talkerParsersCount = 0;
+
+    SKUpdateStatic<MaxValuesPerUpdate> _update;
     SKUpdateStatic<0> _invalidSku = SKUpdateStatic<0>();
 
+    static const SentenceHandler* findHandler(uint32_t code);
+
   public:
-    SKNMEAParser() {};
-    ~SKNMEAParser();
+    SKNMEAParser(const SKNMEAParserConfig &config = SKNMEAParserConfig()) : _config(config) {};
+
+    /**
+     * Use parser for the sentences with this code sent by this talker,
+     * instead of the default parser for this code. A null parser ignores
+     * them.
+     *
+     * Sentences disabled in the configuration are never parsed.
+     *
+     * @return false if there are already MaxTalkerParsers talker parsers.
+     */
+    bool setTalkerParser(const char *talker, const char *code, SKNMEASentenceParser parser);
+
+    /**
+     * Parses a NMEA0183 @param sentence received on @param input into
+     * @param update which is cleared first. The parser does not allocate any
+     * memory for the update so the same update object should be reused
+     * for every sentence.
+     *
+     * @return true if the sentence was recognized and converted.
+     */
+    bool parse(const SKSourceInput& input, const String& sentence, const SKTime& timestamp, SKUpdate& update);
 
     /**
      * Parses a NMEA0183 @param sentence received on @param input and returns a
@@ -50,12 +110,19 @@ class SKNMEAParser {
      */
     const SKUpdate& parse(const SKSourceInput& input, const String& sentence, const SKTime& timestamp);
 
+    /*
+     * Parsers for some of the supported sentences. They can be used with
+     * setTalkerParser() to decode a sentence as another one.
+     */
+    static bool parseDBT(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp, SKUpdate& update);
+    static bool parseDPT(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp, SKUpdate& update);
+    static bool parseMWV(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp, SKUpdate& update);
+    static bool parseRMC(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp, SKUpdate& update);
+    static bool parseXDR(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp, SKUpdate& update);
+
   private:
-    const SKUpdate& parseDBT(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp);
-    const SKUpdate& parseDPT(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp);
-    const SKUpdate& parseMWV(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp);
-    const SKUpdate& parseRMC(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp);
-    const SKUpdate& parseXDR(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime& timestamp);
-    const SKUpdate& parseXDRtemp(const SKSourceInput& input, NMEASentenceReader& reader, const SKTime timestamp);
+    static bool decodeSentence(const SentenceHandler& handler, const SKSourceInput& input,
+                               NMEASentenceReader& reader, const SKTime& timestamp, SKUpdate& update);
+    static void decodeFields(uint32_t code, const NMEASentenceReader& reader, SKUpdate& update);
+    static void decodeXDR(const NMEASentenceReader& reader, SKUpdate& update);
 };
-
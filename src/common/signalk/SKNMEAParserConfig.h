@@ -0,0 +1,52 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+/**
+ * Configuration for an instance of SKNMEAParser: the sentences that should be
+ * parsed. Sentences that are disabled are still repeated to the other
+ * outputs.
+ */
+struct SKNMEAParserConfig {
+  // AIS messages (!AIVDM), decoded by SKAISParser
+  bool ais = true;
+  bool dbt = true;
+  bool dpt = true;
+  bool gll = true;
+  bool hdg = true;
+  bool hdm = true;
+  bool hdt = true;
+  bool mta = true;
+  bool mtw = true;
+  bool mwd = true;
+  bool mwv = true;
+  bool rmc = true;
+  bool rsa = true;
+  bool vhw = true;
+  bool vlw = true;
+  bool vtg = true;
+  bool vwr = true;
+  bool xdr = true;
+};
@@ -37,7 +37,11 @@
 // not depend on dynamic memory or Arduino strings.
 class SKNMEASentence : public String {
   public:
+    SKNMEASentence() {};
     SKNMEASentence(const String &s) : String(s) {};
+    SKNMEASentence(const char *s) : String(s) {};
+
+    using String::operator=;
 
     bool isValid() const {
       return nmea_is_valid(this->c_str());
@@ -32,22 +32,3 @@
 
 // Shared global instance
 const SKPath SKPathInvalid;
-
-bool SKPath::operator==(const SKPath &other) const {
-  if (_p < SKPathEnumIndexedPaths) {
-    return _p == other._p;
-  }
-  else {
-    // If it is an indexed path, compare the indexes too
-    if (_p == other._p && _index == other._index) {
-      return true;
-    }
-    else {
-      return false;
-    }
-  }
-}
-
-bool SKPath::operator!=(const SKPath &other) const {
-  return ! (*this == other);
-}
@@ -34,32 +34,52 @@
 
 // This file includes an enum with all the SKPath values. It is generated.
 #include "SKPathEnum.generated.h"
-
-class SKPath;
-extern const SKPath SKPathInvalid;
-
+#include "SKIndexTable.h"
+
+/**
+ * A SignalK path.
+ *
+ * Indexed paths keep the id of their index in the global skIndexTable so a
+ * SKPath is just two integers: it can be copied and compared without any
+ * memory allocation. The index string is only materialized by toString().
+ */
 class SKPath {
   private:
     SKPathEnum _p;
-    String _index;
+    SKIndexId _index;
 
   public:
-    SKPath() : _p(SKPathInvalidPath) {};
-    SKPath(SKPathEnum p) : _p(p) {
+    SKPath() : _p(SKPathInvalidPath), _index(SKIndexInvalid) {};
+    SKPath(SKPathEnum p) : _p(p), _index(SKIndexInvalid) {
       if (p >= SKPathEnumIndexedPaths) {
         _p = SKPathInvalidPath;
       }
     };
 
-    SKPath(SKPathEnum p, String index) : _p(p), _index(index) {
-      if (p <= SKPathEnumIndexedPaths) {
+    SKPath(SKPathEnum p, SKIndexId index) : _p(p), _index(index) {
+      if (p <= SKPathEnumIndexedPaths || index == SKIndexInvalid) {
         _p = SKPathInvalidPath;
-        _index = String();
+        _index = SKIndexInvalid;
       }
     };
 
-    bool operator==(const SKPath &other) const;
-    bool operator!=(const SKPath &other) const;
+    /**
+     * Interns the index in skIndexTable. If the index can not be interned
+     * (table full or name too long), the path is invalid.
+     *
+     * To look for a path without adding its index to the table, use
+     * SKPath(p, skIndexTable.find(index)).
+     */
+    SKPath(SKPathEnum p, const char *index) : SKPath(p, skIndexTable.intern(index)) {};
+    SKPath(SKPathEnum p, const String &index) : SKPath(p, index.c_str()) {};
+
+    bool operator==(const SKPath &other) const {
+      return _p == other._p && _index == other._index;
+    };
+
+    bool operator!=(const SKPath &other) const {
+      return ! (*this == other);
+    };
 
     /**
      * Static path is the path without the index.
@@ -78,20 +98,35 @@ class SKPath {
     };
 
     /**
-     * Returns the index associated with the path.
+     * Returns the id of the index associated with the path, SKIndexInvalid
+     * if the path is not indexed.
      */
-    const String& getIndex() const {
-      if (isIndexed()) {
-        return _index;
-      }
-      else {
-        return SKPathInvalid._index;
-      }
+    SKIndexId getIndexId() const {
+      return _index;
     };
 
+    /**
+     * Returns the index associated with the path, or an empty string.
+     */
+    const char* getIndex() const {
+      return skIndexTable.name(_index);
+    };
+
+    /**
+     * Returns the static string of the path. For indexed paths, this is the
+     * part before the index.
+     */
+    const char* getPathPrefix() const;
+
+    /**
+     * Returns the part of an indexed path after the index, or an empty string.
+     */
+    const char* getPathSuffix() const;
+
     /**
      * Return the full path, with index if required.
      */
     String toString() const;
 };
 
+extern const SKPath SKPathInvalid;
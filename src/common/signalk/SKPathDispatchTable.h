@@ -0,0 +1,76 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "SKPath.h"
+#include "SKUpdate.h"
+
+/**
+ * Associates each SKPathEnum value with a set of handlers (identified by
+ * their index, 0 to 31).
+ *
+ * Converters use it to find which of their generators depend on the paths
+ * of an update without probing the update for every path they support.
+ */
+class SKPathDispatchTable {
+  private:
+    uint32_t _handlers[SKPathEnumCount];
+
+  public:
+    static const int MaxHandlers = 32;
+
+    SKPathDispatchTable() {
+      for (int p = 0; p < SKPathEnumCount; p++) {
+        _handlers[p] = 0;
+      }
+    };
+
+    /**
+     * Registers handler as depending on path.
+     */
+    void add(SKPathEnum path, int handler) {
+      _handlers[path] |= (uint32_t)1 << handler;
+    };
+
+    /**
+     * Returns true if at least one handler depends on this path.
+     */
+    bool hasHandlers(SKPathEnum path) const {
+      return _handlers[path] != 0;
+    };
+
+    /**
+     * Returns a bitmask of the handlers that depend on at least one of the
+     * paths of this update. The cost only depends on the size of the update.
+     */
+    uint32_t handlersForUpdate(const SKUpdate &update) const {
+      uint32_t handlers = 0;
+      for (int i = 0; i < update.getSize(); i++) {
+        handlers |= _handlers[update.getPath(i).getStaticPath()];
+      }
+      return handlers;
+    };
+};
@@ -1,7 +1,7 @@
 // This file was automatically generated by sk-code-generator.py
 // DO NOT MODIFY! YOUR CHANGES WOULD BE OVERWRITTEN
 // Look at src/common/signalk/SKPathEnum.h.tmpl instead or modify the script
-// Generated on 2018-07-26 18:30:17.964584
+// Generated on 2026-10-17 14:15:01.735286
 
 typedef enum {
   SKPathInvalidPath,
@@ -11,8 +11,12 @@ typedef enum {
   SKPathEnvironmentDepthBelowSurface,
   SKPathEnvironmentDepthTransducerToKeel,
   SKPathEnvironmentDepthSurfaceToTransducer,
+  SKPathEnvironmentCurrentDrift,
+  SKPathEnvironmentCurrentSetTrue,
+  SKPathEnvironmentInsideTemperature,
   SKPathEnvironmentOutsidePressure,
   SKPathEnvironmentOutsideTemperature,
+  SKPathEnvironmentWaterTemperature,
   SKPathEnvironmentWindAngleApparent,
   SKPathEnvironmentWindAngleTrueGround,
   SKPathEnvironmentWindAngleTrueWater,
@@ -23,14 +27,17 @@ typedef enum {
   SKPathEnvironmentWindSpeedApparent,
   SKPathNavigationAttitude,
   SKPathNavigationCourseOverGroundTrue,
+  SKPathNavigationCourseRhumblineCrossTrackError,
   SKPathNavigationDatetime,
   SKPathNavigationHeadingMagnetic,
   SKPathNavigationHeadingTrue,
   SKPathNavigationLog,
   SKPathNavigationMagneticVariation,
   SKPathNavigationPosition,
+  SKPathNavigationRateOfTurn,
   SKPathNavigationSpeedOverGround,
   SKPathNavigationSpeedThroughWater,
+  SKPathNavigationSpeedThroughWaterTransverse,
   SKPathNavigationTripLog,
   SKPathSteeringRudderAngle,
   SKPathSteeringRudderAngleTarget,
@@ -40,5 +47,15 @@ typedef enum {
   SKPathEnumIndexedPaths,
 
   SKPathElectricalBatteriesVoltage,
+  SKPathElectricalBatteriesCurrent,
+  SKPathElectricalBatteriesTemperature,
+  SKPathPropulsionRevolutions,
+  SKPathTanksCurrentLevel,
+  SKPathTanksCapacity,
 
+  // Marker value - Number of values in this enum.
+  SKPathEnumCount
 } SKPathEnum;
+
+// Number of 32 bits words needed to hold one bit per SKPathEnum value.
+static const int SKPathEnumBitmapWords = 2;
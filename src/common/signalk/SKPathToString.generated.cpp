@@ -1,111 +1,123 @@
 // This file was automatically generated by sk-code-generator.py
 // DO NOT MODIFY! YOUR CHANGES WOULD BE OVERWRITTEN
 // Look at src/common/signalk/SKPathToString.cpp.tmpl instead or modify the script
-// Generated on 2018-07-26 18:30:17.966879
+// Generated on 2026-10-17 14:15:01.735813
 
 #include "SKPath.h"
 
-String SKPath::toString() const {
-  String path;
+/*
+ * Static strings of all the paths, in the order of SKPathEnum. Indexed paths
+ * are split in a prefix and a suffix around the index.
+ */
+static const char *const pathPrefixes[SKPathEnumCount] = {
+  "invalid",
+  "environment.depth.belowKeel",
+  "environment.depth.belowTransducer",
+  "environment.depth.belowSurface",
+  "environment.depth.transducerToKeel",
+  "environment.depth.surfaceToTransducer",
+  "environment.current.drift",
+  "environment.current.setTrue",
+  "environment.inside.temperature",
+  "environment.outside.pressure",
+  "environment.outside.temperature",
+  "environment.water.temperature",
+  "environment.wind.angleApparent",
+  "environment.wind.angleTrueGround",
+  "environment.wind.angleTrueWater",
+  "environment.wind.directionTrue",
+  "environment.wind.directionMagnetic",
+  "environment.wind.speedTrue",
+  "environment.wind.speedOverGround",
+  "environment.wind.speedApparent",
+  "navigation.attitude",
+  "navigation.courseOverGroundTrue",
+  "navigation.courseRhumbline.crossTrackError",
+  "navigation.datetime",
+  "navigation.headingMagnetic",
+  "navigation.headingTrue",
+  "navigation.log",
+  "navigation.magneticVariation",
+  "navigation.position",
+  "navigation.rateOfTurn",
+  "navigation.speedOverGround",
+  "navigation.speedThroughWater",
+  "navigation.speedThroughWaterTransverse",
+  "navigation.trip.log",
+  "steering.rudderAngle",
+  "steering.rudderAngleTarget",
+  "performance.leeway",
+  "invalid",
+  "electrical.batteries.",
+  "electrical.batteries.",
+  "electrical.batteries.",
+  "propulsion.",
+  "tanks.",
+  "tanks.",
+};
+
+static const char *const pathSuffixes[SKPathEnumCount] = {
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  "",
+  ".voltage",
+  ".current",
+  ".temperature",
+  ".revolutions",
+  ".currentLevel",
+  ".capacity",
+};
+
+const char* SKPath::getPathPrefix() const {
+  return pathPrefixes[_p];
+};
 
-  switch (_p) {
-    case SKPathEnvironmentDepthBelowKeel:
-      path = "environment.depth.belowKeel";
-      break;
-    case SKPathEnvironmentDepthBelowTransducer:
-      path = "environment.depth.belowTransducer";
-      break;
-    case SKPathEnvironmentDepthBelowSurface:
-      path = "environment.depth.belowSurface";
-      break;
-    case SKPathEnvironmentDepthTransducerToKeel:
-      path = "environment.depth.transducerToKeel";
-      break;
-    case SKPathEnvironmentDepthSurfaceToTransducer:
-      path = "environment.depth.surfaceToTransducer";
-      break;
-    case SKPathEnvironmentOutsidePressure:
-      path = "environment.outside.pressure";
-      break;
-    case SKPathEnvironmentOutsideTemperature:
-      path = "environment.outside.temperature";
-      break;
-    case SKPathEnvironmentWindAngleApparent:
-      path = "environment.wind.angleApparent";
-      break;
-    case SKPathEnvironmentWindAngleTrueGround:
-      path = "environment.wind.angleTrueGround";
-      break;
-    case SKPathEnvironmentWindAngleTrueWater:
-      path = "environment.wind.angleTrueWater";
-      break;
-    case SKPathEnvironmentWindDirectionTrue:
-      path = "environment.wind.directionTrue";
-      break;
-    case SKPathEnvironmentWindDirectionMagnetic:
-      path = "environment.wind.directionMagnetic";
-      break;
-    case SKPathEnvironmentWindSpeedTrue:
-      path = "environment.wind.speedTrue";
-      break;
-    case SKPathEnvironmentWindSpeedOverGround:
-      path = "environment.wind.speedOverGround";
-      break;
-    case SKPathEnvironmentWindSpeedApparent:
-      path = "environment.wind.speedApparent";
-      break;
-    case SKPathElectricalBatteriesVoltage:
-      path = "electrical.batteries." + _index + ".voltage";
-      break;
-    case SKPathNavigationAttitude:
-      path = "navigation.attitude";
-      break;
-    case SKPathNavigationCourseOverGroundTrue:
-      path = "navigation.courseOverGroundTrue";
-      break;
-    case SKPathNavigationDatetime:
-      path = "navigation.datetime";
-      break;
-    case SKPathNavigationHeadingMagnetic:
-      path = "navigation.headingMagnetic";
-      break;
-    case SKPathNavigationHeadingTrue:
-      path = "navigation.headingTrue";
-      break;
-    case SKPathNavigationLog:
-      path = "navigation.log";
-      break;
-    case SKPathNavigationMagneticVariation:
-      path = "navigation.magneticVariation";
-      break;
-    case SKPathNavigationPosition:
-      path = "navigation.position";
-      break;
-    case SKPathNavigationSpeedOverGround:
-      path = "navigation.speedOverGround";
-      break;
-    case SKPathNavigationSpeedThroughWater:
-      path = "navigation.speedThroughWater";
-      break;
-    case SKPathNavigationTripLog:
-      path = "navigation.trip.log";
-      break;
-    case SKPathSteeringRudderAngle:
-      path = "steering.rudderAngle";
-      break;
-    case SKPathSteeringRudderAngleTarget:
-      path = "steering.rudderAngleTarget";
-      break;
-    case SKPathPerformanceLeeway:
-      path = "performance.leeway";
-      break;
+const char* SKPath::getPathSuffix() const {
+  return pathSuffixes[_p];
+};
 
-    case SKPathInvalidPath:
-    case SKPathEnumIndexedPaths:
-      path = "invalid";
-      break;
+String SKPath::toString() const {
+  String path = getPathPrefix();
+
+  if (isIndexed()) {
+    path += getIndex();
+    path += getPathSuffix();
   }
 
   return path;
 };
-
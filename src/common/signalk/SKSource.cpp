@@ -43,6 +43,10 @@ SKSource SKSource::unknownSource() {
 }
 
 SKSource SKSource::sourceForNMEA0183(const SKSourceInput input, const String& talker, const String& sentence) {
+  return sourceForNMEA0183(input, talker.c_str(), sentence.c_str());
+}
+
+SKSource SKSource::sourceForNMEA0183(const SKSourceInput input, const char *talker, const char *sentence) {
   SKSource s;
   if (input == SKSourceInputNMEA0183_1 || input == SKSourceInputNMEA0183_2) {
     s._input = input;
@@ -50,8 +54,8 @@ SKSource SKSource::sourceForNMEA0183(const SKSourceInput input, const String& ta
   else {
     s._input = SKSourceInputUnknown;
   }
-  strlcpy(s._info.nmea.talker, talker.c_str(), sizeof(s._info.nmea.talker));
-  strlcpy(s._info.nmea.sentence, sentence.c_str(), sizeof(s._info.nmea.sentence));
+  strlcpy(s._info.nmea.talker, talker, sizeof(s._info.nmea.talker));
+  strlcpy(s._info.nmea.sentence, sentence, sizeof(s._info.nmea.sentence));
   return s;
 }
 
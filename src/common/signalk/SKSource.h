@@ -36,6 +36,11 @@ enum SKSourceInput {
   SKSourceInputKBoxBarometer
 };
 
+/**
+ * Number of values in the SKSourceInput enum.
+ */
+static const int SKSourceInputCount = SKSourceInputKBoxBarometer + 1;
+
 const String skSourceInputLabels[] = {
   "InputUnknown",
   "InputNMEA1",
@@ -73,6 +78,7 @@ class SKSource {
      * Returns a source instance for the given NMEA0183 source info.
      */
     static SKSource sourceForNMEA0183(const SKSourceInput input, const String& _talker, const String& _sentence);
+    static SKSource sourceForNMEA0183(const SKSourceInput input, const char *talker, const char *sentence);
 
     /**
      * Returns a source instance for the given NMEA2000 source info.
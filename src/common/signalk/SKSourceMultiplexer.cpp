@@ -0,0 +1,128 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common/stats/KBoxMetrics.h"
+#include "SKContext.h"
+#include "SKSourceMultiplexer.h"
+
+SKSourceMultiplexer::SKSourceMultiplexer(const SKSourceMultiplexerConfig &config) :
+  _config(config), _indexedPathsCount(0), _suppressed(0), _failovers(0) {
+  for (int p = 0; p < SKPathEnumIndexedPaths; p++) {
+    _paths[p].lastSeen = 0;
+    _paths[p].input = SKSourceInputUnknown;
+  }
+}
+
+uint8_t SKSourceMultiplexer::priority(SKSourceInput input) const {
+  switch (input) {
+    case SKSourceInputNMEA0183_1:
+      return _config.nmea1Priority;
+    case SKSourceInputNMEA0183_2:
+      return _config.nmea2Priority;
+    case SKSourceInputNMEA2000:
+      return _config.nmea2000Priority;
+    case SKSourceInputKBoxIMU:
+    case SKSourceInputKBoxADC:
+    case SKSourceInputKBoxBarometer:
+      return _config.kboxPriority;
+    default:
+      return 0;
+  }
+}
+
+const SKSourceMultiplexer::Selection* SKSourceMultiplexer::find(const SKPath &path) const {
+  if (!path.isIndexed()) {
+    return &_paths[path.getStaticPath()];
+  }
+  for (int i = 0; i < _indexedPathsCount; i++) {
+    if (_indexedPaths[i].path == path) {
+      return &_indexedPaths[i].selection;
+    }
+  }
+  return nullptr;
+}
+
+SKSourceMultiplexer::Selection& SKSourceMultiplexer::findOrAdd(const SKPath &path) {
+  Selection *selection = const_cast<Selection*>(find(path));
+  if (selection) {
+    return *selection;
+  }
+
+  int slot = _indexedPathsCount;
+  if (_indexedPathsCount < MaxIndexedPaths) {
+    _indexedPathsCount++;
+  }
+  else {
+    slot = 0;
+    for (int i = 1; i < MaxIndexedPaths; i++) {
+      if (_indexedPaths[i].selection.lastSeen < _indexedPaths[slot].selection.lastSeen) {
+        slot = i;
+      }
+    }
+  }
+  _indexedPaths[slot].path = path;
+  _indexedPaths[slot].selection.lastSeen = 0;
+  _indexedPaths[slot].selection.input = SKSourceInputUnknown;
+  return _indexedPaths[slot].selection;
+}
+
+bool SKSourceMultiplexer::accept(Selection &selection, SKSourceInput input, uint32_t now) {
+  if (selection.input != input && selection.input != SKSourceInputUnknown
+      && priority(input) <= priority(selection.input)) {
+    if (now - selection.lastSeen < _config.sourceTimeout) {
+      return false;
+    }
+    _failovers++;
+    KBoxMetrics.event(KBoxEventSKSourceFailover);
+  }
+  selection.input = input;
+  selection.lastSeen = now;
+  return true;
+}
+
+uint32_t SKSourceMultiplexer::suppressedValues(const SKUpdate &update, uint32_t now) {
+  SKSourceInput input = update.getSource().getInput();
+  if (input == SKSourceInputUnknown || &update.getContext() != &SKContextSelf) {
+    return 0;
+  }
+
+  uint32_t suppressed = 0;
+  for (int i = 0; i < update.getSize() && i < 32; i++) {
+    const SKPath &path = update.getPath(i);
+    if (path.getStaticPath() == SKPathInvalidPath) {
+      continue;
+    }
+    if (!accept(findOrAdd(path), input, now)) {
+      suppressed |= (uint32_t)1 << i;
+      _suppressed++;
+      KBoxMetrics.event(KBoxEventSKSourceSuppressed);
+    }
+  }
+  return suppressed;
+}
+
+SKSourceInput SKSourceMultiplexer::preferredInput(const SKPath &path) const {
+  const Selection *selection = find(path);
+  return selection ? selection->input : SKSourceInputUnknown;
+}
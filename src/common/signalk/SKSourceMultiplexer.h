@@ -0,0 +1,112 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "SKPath.h"
+#include "SKSource.h"
+#include "SKSourceMultiplexerConfig.h"
+#include "SKUpdate.h"
+
+/**
+ * Chooses, for each path, the input its values are taken from.
+ *
+ * The same data often reaches the KBox more than once: a GPS wired to NMEA1
+ * and also visible on the NMEA2000 bus, or a heading computed by the IMU and
+ * received from a compass. For each path, the input with the highest
+ * priority is preferred and the values of the other inputs are dropped. When
+ * the preferred input has not sent the path for `sourceTimeout`, the next
+ * input which sends it takes over.
+ */
+class SKSourceMultiplexer {
+  public:
+    /**
+     * Number of indexed paths (batteries, temperatures...) tracked. When the
+     * table is full, the path seen least recently is forgotten.
+     */
+    static const int MaxIndexedPaths = 16;
+
+  private:
+    struct Selection {
+      // millis() when the preferred input last sent this path
+      uint32_t lastSeen;
+      // SKSourceInputUnknown if the path was never received
+      SKSourceInput input;
+    };
+
+    struct IndexedSelection {
+      SKPath path;
+      Selection selection;
+    };
+
+    const SKSourceMultiplexerConfig &_config;
+    Selection _paths[SKPathEnumIndexedPaths];
+    IndexedSelection _indexedPaths[MaxIndexedPaths];
+    int _indexedPathsCount;
+    uint32_t _suppressed;
+    uint32_t _failovers;
+
+    uint8_t priority(SKSourceInput input) const;
+    const Selection* find(const SKPath &path) const;
+    Selection& findOrAdd(const SKPath &path);
+    bool accept(Selection &selection, SKSourceInput input, uint32_t now);
+
+  public:
+    SKSourceMultiplexer(const SKSourceMultiplexerConfig &config);
+
+    /**
+     * Records the values of this update received at time now (in
+     * milliseconds) and returns the values that should be dropped because
+     * another input is preferred for their path.
+     *
+     * Updates about other vessels and from an unknown input are never
+     * filtered.
+     *
+     * @return a bitmask of the values to drop (bit i for value i). Values
+     * after the 32nd are always kept.
+     */
+    uint32_t suppressedValues(const SKUpdate &update, uint32_t now);
+
+    /**
+     * The input currently used for this path, SKSourceInputUnknown if it was
+     * never received.
+     */
+    SKSourceInput preferredInput(const SKPath &path) const;
+
+    /**
+     * Number of values dropped so far.
+     */
+    uint32_t suppressed() const {
+      return _suppressed;
+    };
+
+    /**
+     * Number of times a path switched to another input because its
+     * preferred input went quiet.
+     */
+    uint32_t failovers() const {
+      return _failovers;
+    };
+};
@@ -0,0 +1,47 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Configuration of the SKSourceMultiplexer: when the same path is received
+ * from more than one input, the input with the highest priority is used and
+ * the others are dropped until it goes quiet.
+ *
+ * Disabled by default: all the inputs are published, like before.
+ */
+struct SKSourceMultiplexerConfig {
+  bool enabled = false;
+  // Time after which a path falls back to another input when its preferred
+  // input stopped sending it (milliseconds)
+  uint16_t sourceTimeout = 3000;
+  // Priority of each input, from 0 to 9. Higher is preferred.
+  uint8_t nmea1Priority = 2;
+  uint8_t nmea2Priority = 2;
+  uint8_t nmea2000Priority = 3;
+  // IMU, barometer and ADC of the KBox
+  uint8_t kboxPriority = 1;
+};
@@ -0,0 +1,98 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "SKSubscriptionFilter.h"
+#include "SKUpdate.h"
+
+SKSubscriptionFilter::SKSubscriptionFilter() : _sourceInputs(0), _sourceInputsRestricted(false) {
+  for (int i = 0; i < SKPathEnumBitmapWords; i++) {
+    _paths[i] = 0;
+  }
+}
+
+SKSubscriptionFilter SKSubscriptionFilter::allPaths() {
+  SKSubscriptionFilter filter;
+  for (int p = 0; p < SKPathEnumCount; p++) {
+    filter.addPath((SKPathEnum)p);
+  }
+  return filter;
+}
+
+SKSubscriptionFilter& SKSubscriptionFilter::addPath(SKPathEnum path) {
+  if (path >= 0 && path < SKPathEnumCount) {
+    _paths[path / 32] |= (uint32_t)1 << (path % 32);
+  }
+  return *this;
+}
+
+SKSubscriptionFilter& SKSubscriptionFilter::addPaths(const SKSubscriptionFilter &other) {
+  for (int i = 0; i < SKPathEnumBitmapWords; i++) {
+    _paths[i] |= other._paths[i];
+  }
+  return *this;
+}
+
+SKSubscriptionFilter& SKSubscriptionFilter::addSourceInput(SKSourceInput input) {
+  if (!_sourceInputsRestricted) {
+    _sourceInputs = 0;
+    _sourceInputsRestricted = true;
+  }
+  _sourceInputs |= (uint32_t)1 << input;
+  return *this;
+}
+
+SKSubscriptionFilter& SKSubscriptionFilter::excludeSourceInput(SKSourceInput input) {
+  if (!_sourceInputsRestricted) {
+    _sourceInputs = ((uint32_t)1 << SKSourceInputCount) - 1;
+    _sourceInputsRestricted = true;
+  }
+  _sourceInputs &= ~((uint32_t)1 << input);
+  return *this;
+}
+
+bool SKSubscriptionFilter::matchesPath(SKPathEnum path) const {
+  if (path < 0 || path >= SKPathEnumCount) {
+    return false;
+  }
+  return (_paths[path / 32] & ((uint32_t)1 << (path % 32))) != 0;
+}
+
+bool SKSubscriptionFilter::matchesSourceInput(SKSourceInput input) const {
+  if (!_sourceInputsRestricted) {
+    return true;
+  }
+  return (_sourceInputs & ((uint32_t)1 << input)) != 0;
+}
+
+bool SKSubscriptionFilter::matches(const SKUpdate &update) const {
+  if (!matchesSourceInput(update.getSource().getInput())) {
+    return false;
+  }
+  for (int i = 0; i < update.getSize(); i++) {
+    if (matchesPath(update.getPath(i).getStaticPath())) {
+      return true;
+    }
+  }
+  return false;
+}
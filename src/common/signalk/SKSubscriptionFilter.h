@@ -0,0 +1,86 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "SKPath.h"
+#include "SKSource.h"
+
+class SKUpdate;
+
+/**
+ * Describes which updates a SKSubscriber is interested in.
+ *
+ * A filter is a set of static paths (SKPathEnum) and optionally a set of
+ * source inputs. An update matches the filter if it comes from one of the
+ * accepted inputs and contains at least one of the paths.
+ *
+ * A new filter matches no path and accepts updates from all inputs.
+ */
+class SKSubscriptionFilter {
+  private:
+    uint32_t _paths[SKPathEnumBitmapWords];
+    uint32_t _sourceInputs;
+    bool _sourceInputsRestricted;
+
+  public:
+    SKSubscriptionFilter();
+
+    /**
+     * Returns a filter that matches all paths from all inputs.
+     */
+    static SKSubscriptionFilter allPaths();
+
+    /**
+     * Add a path to the filter. For indexed paths, all the indexes are
+     * matched.
+     */
+    SKSubscriptionFilter& addPath(SKPathEnum path);
+
+    /**
+     * Add all the paths of another filter to this one.
+     */
+    SKSubscriptionFilter& addPaths(const SKSubscriptionFilter &other);
+
+    /**
+     * Only accept updates coming from this input (can be called multiple
+     * times to accept multiple inputs).
+     */
+    SKSubscriptionFilter& addSourceInput(SKSourceInput input);
+
+    /**
+     * Reject updates coming from this input.
+     */
+    SKSubscriptionFilter& excludeSourceInput(SKSourceInput input);
+
+    bool matchesPath(SKPathEnum path) const;
+    bool matchesSourceInput(SKSourceInput input) const;
+
+    /**
+     * Return true if the update comes from an accepted input and contains
+     * at least one of the paths of the filter.
+     */
+    bool matches(const SKUpdate &update) const;
+};
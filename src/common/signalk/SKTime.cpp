@@ -31,6 +31,9 @@
 #include "SKTime.h"
 
 #include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 /*
  * Time math copied from Teensy/Time.cpp - Original copyright follows.
@@ -171,14 +174,32 @@ uint32_t makeTime(const tmElements_t &tm){
   return seconds;
 }
 
+/*
+ * Parse length characters with atol() like String::toInt() would do on a
+ * substring.
+ */
+static long parseInt(const char *s, size_t length) {
+  char buffer[4];
+  if (length >= sizeof(buffer)) {
+    length = sizeof(buffer) - 1;
+  }
+  memcpy(buffer, s, length);
+  buffer[length] = '\0';
+  return atol(buffer);
+}
+
 SKTime SKTime::timeFromNMEAStrings(String dateString, String timeString) {
+  return timeFromNMEAStrings(dateString.c_str(), dateString.length(), timeString.c_str(), timeString.length());
+}
+
+SKTime SKTime::timeFromNMEAStrings(const char *date, size_t dateLength, const char *time, size_t timeLength) {
   tmElements_t tm;
 
-  if (dateString.length() == 6) {
-    tm.Day = dateString.substring(0, 2).toInt();
-    tm.Month = dateString.substring(2, 4).toInt();
+  if (dateLength == 6) {
+    tm.Day = parseInt(date, 2);
+    tm.Month = parseInt(date + 2, 2);
     // Year 2070 bug incoming ...
-    int year = dateString.substring(4, 6).toInt();
+    int year = parseInt(date + 4, 2);
     if (year < 70) {
       tm.Year = year + 30;
     }
@@ -192,10 +213,10 @@ SKTime SKTime::timeFromNMEAStrings(String dateString, String timeString) {
     tm.Day = 1;
   }
 
-  if (timeString.length() >= 6) {
-    tm.Hour = timeString.substring(0, 2).toInt();
-    tm.Minute = timeString.substring(2, 4).toInt();
-    tm.Second = timeString.substring(4, 6).toInt();
+  if (timeLength >= 6) {
+    tm.Hour = parseInt(time, 2);
+    tm.Minute = parseInt(time + 2, 2);
+    tm.Second = parseInt(time + 4, 2);
   }
   else {
     tm.Hour = tm.Minute = tm.Second = 0;
@@ -204,14 +225,14 @@ SKTime SKTime::timeFromNMEAStrings(String dateString, String timeString) {
   uint32_t timestamp = makeTime(tm);
   uint32_t milliseconds = unknownMilliseconds;
 
-  if (timeString.length() > 7) {
-    String ms = timeString.substring(7, 10);
-    int millis = ms.toInt();
+  if (timeLength > 7) {
+    size_t msLength = timeLength - 7 < 3 ? timeLength - 7 : 3;
+    int millis = parseInt(time + 7, msLength);
 
-    if (ms.length() == 1) {
+    if (msLength == 1) {
       millis *= 100;
     }
-    if (ms.length() == 2) {
+    if (msLength == 2) {
       millis *= 10;
     }
 
@@ -258,43 +279,26 @@ SKTime& SKTime::operator+=(uint32_t ms) {
   return *this; // return the result by reference
 }
 
-String SKTime::toString() const {
+void SKTime::toString(char *buffer, size_t size) const {
   tmElements_t tm;
   breakTime(_timestamp, tm);
 
-  String s;
   if (!hasMilliseconds()) {
-    // 2014-04-10T08:33:53Z => 20
-    s.reserve(21);
+    // 2014-04-10T08:33:53Z
+    snprintf(buffer, size, "%i-%02i-%02iT%02i:%02i:%02iZ", 1970 + tm.Year,
+             tm.Month, tm.Day, tm.Hour, tm.Minute, tm.Second);
   }
   else {
-    // "2014-04-10T08:33:53.010Z" => 24
-    s.reserve(25);
+    // 2014-04-10T08:33:53.010Z
+    snprintf(buffer, size, "%i-%02i-%02iT%02i:%02i:%02i.%03iZ", 1970 + tm.Year,
+             tm.Month, tm.Day, tm.Hour, tm.Minute, tm.Second, _milliseconds);
   }
-  s += (1970 + tm.Year); s += "-";
-  if (tm.Month < 10) { s += "0"; }
-  s += tm.Month; s += "-";
-  if (tm.Day < 10) { s += "0"; }
-  s += tm.Day; s += "T";
-  if (tm.Hour < 10) { s += "0"; }
-  s += tm.Hour; s += ":";
-  if (tm.Minute < 10) { s += "0"; }
-  s += tm.Minute; s += ":";
-  if (tm.Second < 10) { s += "0"; }
-  s += tm.Second;
+}
 
-  if (hasMilliseconds()) {
-    s += ".";
-    if (_milliseconds < 100) {
-      s += "0";
-    }
-    if (_milliseconds < 10) {
-      s += "0";
-    }
-    s += _milliseconds;
-  }
-  s += "Z";
-  return s;
+String SKTime::toString() const {
+  char buffer[MaxStringLength + 1];
+  toString(buffer, sizeof(buffer));
+  return String(buffer);
 }
 
 String SKTime::iso8601date() const {
@@ -65,6 +65,11 @@ class SKTime {
      */
     static SKTime timeFromNMEAStrings(String date, String time);
 
+    /**
+     * Same as above with strings that are not null-terminated.
+     */
+    static SKTime timeFromNMEAStrings(const char *date, size_t dateLength, const char *time, size_t timeLength);
+
     /**
      * SKTime object from number of days and number of seconds (NMEA2000).
      * @param daysSince1970 number of days since 1970
@@ -115,6 +120,18 @@ class SKTime {
      */
     String toString() const;
 
+    /**
+     * Maximum length of the string returned by toString().
+     */
+    static const size_t MaxStringLength = 24;
+
+    /**
+     * Writes the same representation as toString() in buffer, without
+     * allocating memory. The buffer should be at least MaxStringLength + 1
+     * bytes.
+     */
+    void toString(char *buffer, size_t size) const;
+
     /**
      * Returns the date written in ISO8601 format: YYYY-MM-DD.
      *
@@ -42,6 +42,7 @@
 #define SKMeterToFeet(x)   ((x) / 0.3048)
 #define SKFathomToMeter(x) ((x) * 1.8288)
 #define SKFeetToMeter(x)   ((x) * 0.3048)
+#define SKNauticalMileToMeter(x) ((x) * 1852)
 
 #define SKCelsiusToKelvin(x) ((x) + 273.15)
 #define SKKelvinToCelsius(x) ((x) - 273.15)
@@ -50,6 +51,10 @@ inline double SKPascalToBar(double x) {
   return x / 1e5;
 }
 
+inline double SKBarToPascal(double x) {
+  return x * 1e5;
+}
+
 /**
  * Normalizes any angle in radians to the range [0,2*M_PI)
  */
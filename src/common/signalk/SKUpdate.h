@@ -100,6 +100,22 @@ class SKUpdate {
      */
     virtual bool setValue(const SKPath path, const SKValue v) = 0;
 
+    /**
+     * Set the source of the values in this update.
+     */
+    virtual void setSource(const SKSource& source) = 0;
+
+    /**
+     * Set the timestamp of this update.
+     */
+    virtual void setTimestamp(const SKTime& timestamp) = 0;
+
+    /**
+     * Remove all the values and reset the source and timestamp so that the
+     * update can be reused. This does not release any memory.
+     */
+    virtual void clear() = 0;
+
     /**
      * Visit this SKValue calling appropriate callback on the visitor for each
      * path/value encountered.
@@ -38,11 +38,41 @@ template <uint16_t capacity> class SKUpdateStatic : public SKUpdate {
     SKTime _timestamp;
     const SKContext& _context;
 
-    // Very simple hash-type data structure
+    static_assert(capacity < 256, "SKUpdateStatic slots are indexed with uint8_t");
+
     SKPath _paths[capacity];
     SKValue _values[capacity];
     uint16_t _size = 0;
 
+    // One bit per static path present in this update and, for each of them,
+    // the slot of its first value. Indexed paths can have more than one
+    // value, they are stored in later slots.
+    uint32_t _present[SKPathEnumBitmapWords] = {};
+    uint8_t _firstSlot[SKPathEnumCount];
+
+    bool isPresent(SKPathEnum p) const {
+      return _present[p / 32] & (1u << (p % 32));
+    };
+
+    /**
+     * Returns the slot where this path is stored or -1.
+     */
+    int findSlot(const SKPath &p) const {
+      SKPathEnum staticPath = p.getStaticPath();
+      if (capacity == 0 || !isPresent(staticPath)) {
+        return -1;
+      }
+      if (!p.isIndexed()) {
+        return _firstSlot[staticPath];
+      }
+      for (uint16_t i = _firstSlot[staticPath]; i < _size; i++) {
+        if (_paths[i] == p) {
+          return i;
+        }
+      }
+      return -1;
+    };
+
   public:
     /**
      * Create a new SKUpdate object, with the context 'self' and  with an empty
@@ -59,24 +89,27 @@ template <uint16_t capacity> class SKUpdateStatic : public SKUpdate {
     ~SKUpdateStatic() {};
 
     virtual bool hasPath(const SKPath &p) const override {
-      for (uint16_t i = 0; i < _size; i++) {
-        if (_paths[i] == p) {
-          return true;
-        }
-      }
-      return false;
+      return findSlot(p) >= 0;
     };
 
     virtual bool setValue(const SKPath p, const SKValue v) override {
+      // An index that could not be interned gives an invalid path.
+      if (p.getStaticPath() == SKPathInvalidPath) {
+        return false;
+      }
       // Update?
-      for (uint16_t i = 0; i < _size && i < capacity; i++) {
-        if (_paths[i] == p) {
-          _values[i] = v;
-          return true;
-        }
+      int slot = findSlot(p);
+      if (slot >= 0) {
+        _values[slot] = v;
+        return true;
       }
       // Add?
       if (_size < capacity) {
+        SKPathEnum staticPath = p.getStaticPath();
+        if (!isPresent(staticPath)) {
+          _present[staticPath / 32] |= 1u << (staticPath % 32);
+          _firstSlot[staticPath] = _size;
+        }
         _paths[_size] = p;
         _values[_size] = v;
         _size++;
@@ -88,7 +121,7 @@ template <uint16_t capacity> class SKUpdateStatic : public SKUpdate {
     /**
      * Returns the source of the values in this update.
      */
-    void setSource(const SKSource& source) {
+    void setSource(const SKSource& source) override {
       _source = source;
     };
 
@@ -96,10 +129,19 @@ template <uint16_t capacity> class SKUpdateStatic : public SKUpdate {
       return _timestamp;
     };
 
-    void setTimestamp(const SKTime& timestamp) {
+    void setTimestamp(const SKTime& timestamp) override {
       _timestamp = timestamp;
     };
 
+    void clear() override {
+      _source = SKSourceUnknown;
+      _timestamp = SKTime();
+      _size = 0;
+      for (int i = 0; i < SKPathEnumBitmapWords; i++) {
+        _present[i] = 0;
+      }
+    };
+
     uint16_t getSize() const override {
       return _size;
     };
@@ -118,16 +160,15 @@ template <uint16_t capacity> class SKUpdateStatic : public SKUpdate {
     };
 
     const SKValue& operator[] (const SKPath& path) const override {
-      for (int i = 0; i < _size; i++) {
-        if (_paths[i] == path) {
-          return _values[i];
-        }
+      int slot = findSlot(path);
+      if (slot >= 0) {
+        return _values[slot];
       }
       return SKValueNone;
     }
 
     virtual const SKPath& getPath(int index) const override {
-      if (index < _size) {
+      if (index >= 0 && index < _size && index < capacity) {
         return _paths[index];
       }
       else {
@@ -136,7 +177,7 @@ template <uint16_t capacity> class SKUpdateStatic : public SKUpdate {
     };
 
     virtual const SKValue& getValue(int index) const override {
-      if (index < _size) {
+      if (index >= 0 && index < _size && index < capacity) {
         return _values[index];
       }
       else {
@@ -151,7 +192,10 @@ template <uint16_t capacity> class SKUpdateStatic : public SKUpdate {
     }
 
     virtual void accept(SKVisitor& visitor, SKPathEnum staticPath) const override {
-      for (int i = 0; i < getSize(); i++) {
+      if (staticPath < 0 || staticPath >= SKPathEnumCount || !isPresent(staticPath)) {
+        return;
+      }
+      for (int i = _firstSlot[staticPath]; i < getSize(); i++) {
         if (getPath(i).getStaticPath() == staticPath) {
           visitor.visit(*this, getPath(i), getValue(i));
         }
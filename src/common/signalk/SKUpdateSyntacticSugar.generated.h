@@ -1,7 +1,7 @@
 // This file was automatically generated by sk-code-generator.py
 // DO NOT MODIFY! YOUR CHANGES WOULD BE OVERWRITTEN
 // Look at src/common/signalk/SKUpdateSyntacticSugar.h.tmpl instead or modify the script
-// Generated on 2018-07-26 18:30:17.968282
+// Generated on 2026-10-17 14:57:21.689304
 
 bool hasEnvironmentDepthBelowKeel() const {
   return hasPath(SKPathEnvironmentDepthBelowKeel);
@@ -48,6 +48,33 @@ double getEnvironmentDepthSurfaceToTransducer() const {
 bool setEnvironmentDepthSurfaceToTransducer(double newValue) {
   return setValue(SKPathEnvironmentDepthSurfaceToTransducer, newValue);
 };
+bool hasEnvironmentCurrentDrift() const {
+  return hasPath(SKPathEnvironmentCurrentDrift);
+};
+double getEnvironmentCurrentDrift() const {
+  return this->operator[](SKPathEnvironmentCurrentDrift).getNumberValue();
+};
+bool setEnvironmentCurrentDrift(double newValue) {
+  return setValue(SKPathEnvironmentCurrentDrift, newValue);
+};
+bool hasEnvironmentCurrentSetTrue() const {
+  return hasPath(SKPathEnvironmentCurrentSetTrue);
+};
+double getEnvironmentCurrentSetTrue() const {
+  return this->operator[](SKPathEnvironmentCurrentSetTrue).getNumberValue();
+};
+bool setEnvironmentCurrentSetTrue(double newValue) {
+  return setValue(SKPathEnvironmentCurrentSetTrue, newValue);
+};
+bool hasEnvironmentInsideTemperature() const {
+  return hasPath(SKPathEnvironmentInsideTemperature);
+};
+double getEnvironmentInsideTemperature() const {
+  return this->operator[](SKPathEnvironmentInsideTemperature).getNumberValue();
+};
+bool setEnvironmentInsideTemperature(double newValue) {
+  return setValue(SKPathEnvironmentInsideTemperature, newValue);
+};
 bool hasEnvironmentOutsidePressure() const {
   return hasPath(SKPathEnvironmentOutsidePressure);
 };
@@ -66,6 +93,15 @@ double getEnvironmentOutsideTemperature() const {
 bool setEnvironmentOutsideTemperature(double newValue) {
   return setValue(SKPathEnvironmentOutsideTemperature, newValue);
 };
+bool hasEnvironmentWaterTemperature() const {
+  return hasPath(SKPathEnvironmentWaterTemperature);
+};
+double getEnvironmentWaterTemperature() const {
+  return this->operator[](SKPathEnvironmentWaterTemperature).getNumberValue();
+};
+bool setEnvironmentWaterTemperature(double newValue) {
+  return setValue(SKPathEnvironmentWaterTemperature, newValue);
+};
 bool hasEnvironmentWindAngleApparent() const {
   return hasPath(SKPathEnvironmentWindAngleApparent);
 };
@@ -138,15 +174,114 @@ double getEnvironmentWindSpeedApparent() const {
 bool setEnvironmentWindSpeedApparent(double newValue) {
   return setValue(SKPathEnvironmentWindSpeedApparent, newValue);
 };
-bool hasElectricalBatteriesVoltage(String index) const {
+bool hasElectricalBatteriesVoltage(const char *index) const {
+  return hasPath(SKPath(SKPathElectricalBatteriesVoltage, skIndexTable.find(index)));
+};
+double getElectricalBatteriesVoltage(const char *index) const {
+  return this->operator[](SKPath(SKPathElectricalBatteriesVoltage, skIndexTable.find(index))).getNumberValue();
+};
+bool setElectricalBatteriesVoltage(const char *index, double newValue) {
+  return setValue(SKPath(SKPathElectricalBatteriesVoltage, index), newValue);
+};
+bool hasElectricalBatteriesVoltage(SKIndexId index) const {
   return hasPath(SKPath(SKPathElectricalBatteriesVoltage, index));
 };
-double getElectricalBatteriesVoltage(String index) const {
+double getElectricalBatteriesVoltage(SKIndexId index) const {
   return this->operator[](SKPath(SKPathElectricalBatteriesVoltage, index)).getNumberValue();
 };
-bool setElectricalBatteriesVoltage(String index, double newValue) {
+bool setElectricalBatteriesVoltage(SKIndexId index, double newValue) {
   return setValue(SKPath(SKPathElectricalBatteriesVoltage, index), newValue);
 };
+bool hasElectricalBatteriesCurrent(const char *index) const {
+  return hasPath(SKPath(SKPathElectricalBatteriesCurrent, skIndexTable.find(index)));
+};
+double getElectricalBatteriesCurrent(const char *index) const {
+  return this->operator[](SKPath(SKPathElectricalBatteriesCurrent, skIndexTable.find(index))).getNumberValue();
+};
+bool setElectricalBatteriesCurrent(const char *index, double newValue) {
+  return setValue(SKPath(SKPathElectricalBatteriesCurrent, index), newValue);
+};
+bool hasElectricalBatteriesCurrent(SKIndexId index) const {
+  return hasPath(SKPath(SKPathElectricalBatteriesCurrent, index));
+};
+double getElectricalBatteriesCurrent(SKIndexId index) const {
+  return this->operator[](SKPath(SKPathElectricalBatteriesCurrent, index)).getNumberValue();
+};
+bool setElectricalBatteriesCurrent(SKIndexId index, double newValue) {
+  return setValue(SKPath(SKPathElectricalBatteriesCurrent, index), newValue);
+};
+bool hasElectricalBatteriesTemperature(const char *index) const {
+  return hasPath(SKPath(SKPathElectricalBatteriesTemperature, skIndexTable.find(index)));
+};
+double getElectricalBatteriesTemperature(const char *index) const {
+  return this->operator[](SKPath(SKPathElectricalBatteriesTemperature, skIndexTable.find(index))).getNumberValue();
+};
+bool setElectricalBatteriesTemperature(const char *index, double newValue) {
+  return setValue(SKPath(SKPathElectricalBatteriesTemperature, index), newValue);
+};
+bool hasElectricalBatteriesTemperature(SKIndexId index) const {
+  return hasPath(SKPath(SKPathElectricalBatteriesTemperature, index));
+};
+double getElectricalBatteriesTemperature(SKIndexId index) const {
+  return this->operator[](SKPath(SKPathElectricalBatteriesTemperature, index)).getNumberValue();
+};
+bool setElectricalBatteriesTemperature(SKIndexId index, double newValue) {
+  return setValue(SKPath(SKPathElectricalBatteriesTemperature, index), newValue);
+};
+bool hasPropulsionRevolutions(const char *index) const {
+  return hasPath(SKPath(SKPathPropulsionRevolutions, skIndexTable.find(index)));
+};
+double getPropulsionRevolutions(const char *index) const {
+  return this->operator[](SKPath(SKPathPropulsionRevolutions, skIndexTable.find(index))).getNumberValue();
+};
+bool setPropulsionRevolutions(const char *index, double newValue) {
+  return setValue(SKPath(SKPathPropulsionRevolutions, index), newValue);
+};
+bool hasPropulsionRevolutions(SKIndexId index) const {
+  return hasPath(SKPath(SKPathPropulsionRevolutions, index));
+};
+double getPropulsionRevolutions(SKIndexId index) const {
+  return this->operator[](SKPath(SKPathPropulsionRevolutions, index)).getNumberValue();
+};
+bool setPropulsionRevolutions(SKIndexId index, double newValue) {
+  return setValue(SKPath(SKPathPropulsionRevolutions, index), newValue);
+};
+bool hasTanksCurrentLevel(const char *index) const {
+  return hasPath(SKPath(SKPathTanksCurrentLevel, skIndexTable.find(index)));
+};
+double getTanksCurrentLevel(const char *index) const {
+  return this->operator[](SKPath(SKPathTanksCurrentLevel, skIndexTable.find(index))).getNumberValue();
+};
+bool setTanksCurrentLevel(const char *index, double newValue) {
+  return setValue(SKPath(SKPathTanksCurrentLevel, index), newValue);
+};
+bool hasTanksCurrentLevel(SKIndexId index) const {
+  return hasPath(SKPath(SKPathTanksCurrentLevel, index));
+};
+double getTanksCurrentLevel(SKIndexId index) const {
+  return this->operator[](SKPath(SKPathTanksCurrentLevel, index)).getNumberValue();
+};
+bool setTanksCurrentLevel(SKIndexId index, double newValue) {
+  return setValue(SKPath(SKPathTanksCurrentLevel, index), newValue);
+};
+bool hasTanksCapacity(const char *index) const {
+  return hasPath(SKPath(SKPathTanksCapacity, skIndexTable.find(index)));
+};
+double getTanksCapacity(const char *index) const {
+  return this->operator[](SKPath(SKPathTanksCapacity, skIndexTable.find(index))).getNumberValue();
+};
+bool setTanksCapacity(const char *index, double newValue) {
+  return setValue(SKPath(SKPathTanksCapacity, index), newValue);
+};
+bool hasTanksCapacity(SKIndexId index) const {
+  return hasPath(SKPath(SKPathTanksCapacity, index));
+};
+double getTanksCapacity(SKIndexId index) const {
+  return this->operator[](SKPath(SKPathTanksCapacity, index)).getNumberValue();
+};
+bool setTanksCapacity(SKIndexId index, double newValue) {
+  return setValue(SKPath(SKPathTanksCapacity, index), newValue);
+};
 bool hasNavigationAttitude() const {
   return hasPath(SKPathNavigationAttitude);
 };
@@ -165,6 +300,15 @@ double getNavigationCourseOverGroundTrue() const {
 bool setNavigationCourseOverGroundTrue(double newValue) {
   return setValue(SKPathNavigationCourseOverGroundTrue, newValue);
 };
+bool hasNavigationCourseRhumblineCrossTrackError() const {
+  return hasPath(SKPathNavigationCourseRhumblineCrossTrackError);
+};
+double getNavigationCourseRhumblineCrossTrackError() const {
+  return this->operator[](SKPathNavigationCourseRhumblineCrossTrackError).getNumberValue();
+};
+bool setNavigationCourseRhumblineCrossTrackError(double newValue) {
+  return setValue(SKPathNavigationCourseRhumblineCrossTrackError, newValue);
+};
 bool hasNavigationDatetime() const {
   return hasPath(SKPathNavigationDatetime);
 };
@@ -219,6 +363,15 @@ SKTypePosition getNavigationPosition() const {
 bool setNavigationPosition(SKTypePosition newValue) {
   return setValue(SKPathNavigationPosition, newValue);
 };
+bool hasNavigationRateOfTurn() const {
+  return hasPath(SKPathNavigationRateOfTurn);
+};
+double getNavigationRateOfTurn() const {
+  return this->operator[](SKPathNavigationRateOfTurn).getNumberValue();
+};
+bool setNavigationRateOfTurn(double newValue) {
+  return setValue(SKPathNavigationRateOfTurn, newValue);
+};
 bool hasNavigationSpeedOverGround() const {
   return hasPath(SKPathNavigationSpeedOverGround);
 };
@@ -237,6 +390,15 @@ double getNavigationSpeedThroughWater() const {
 bool setNavigationSpeedThroughWater(double newValue) {
   return setValue(SKPathNavigationSpeedThroughWater, newValue);
 };
+bool hasNavigationSpeedThroughWaterTransverse() const {
+  return hasPath(SKPathNavigationSpeedThroughWaterTransverse);
+};
+double getNavigationSpeedThroughWaterTransverse() const {
+  return this->operator[](SKPathNavigationSpeedThroughWaterTransverse).getNumberValue();
+};
+bool setNavigationSpeedThroughWaterTransverse(double newValue) {
+  return setValue(SKPathNavigationSpeedThroughWaterTransverse, newValue);
+};
 bool hasNavigationTripLog() const {
   return hasPath(SKPathNavigationTripLog);
 };
@@ -1,7 +1,7 @@
 // This file was automatically generated by sk-code-generator.py
 // DO NOT MODIFY! YOUR CHANGES WOULD BE OVERWRITTEN
 // Look at src/common/signalk/SKVisitor.cpp.tmpl instead or modify the script
-// Generated on 2018-07-26 18:30:17.969656
+// Generated on 2026-10-17 14:15:01.738357
 
 /*
      __  __     ______     ______     __  __
@@ -37,95 +37,135 @@
 
 
 void SKVisitor::visit(const SKUpdate& u, const SKPath &p, const SKValue &v) {
-  if (p.getStaticPath() == SKPathEnvironmentDepthBelowKeel) {
-    visitSKEnvironmentDepthBelowKeel(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentDepthBelowTransducer) {
-    visitSKEnvironmentDepthBelowTransducer(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentDepthBelowSurface) {
-    visitSKEnvironmentDepthBelowSurface(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentDepthTransducerToKeel) {
-    visitSKEnvironmentDepthTransducerToKeel(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentDepthSurfaceToTransducer) {
-    visitSKEnvironmentDepthSurfaceToTransducer(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentOutsidePressure) {
-    visitSKEnvironmentOutsidePressure(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentOutsideTemperature) {
-    visitSKEnvironmentOutsideTemperature(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentWindAngleApparent) {
-    visitSKEnvironmentWindAngleApparent(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentWindAngleTrueGround) {
-    visitSKEnvironmentWindAngleTrueGround(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentWindAngleTrueWater) {
-    visitSKEnvironmentWindAngleTrueWater(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentWindDirectionTrue) {
-    visitSKEnvironmentWindDirectionTrue(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentWindDirectionMagnetic) {
-    visitSKEnvironmentWindDirectionMagnetic(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentWindSpeedTrue) {
-    visitSKEnvironmentWindSpeedTrue(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentWindSpeedOverGround) {
-    visitSKEnvironmentWindSpeedOverGround(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathEnvironmentWindSpeedApparent) {
-    visitSKEnvironmentWindSpeedApparent(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathElectricalBatteriesVoltage) {
-    visitSKElectricalBatteriesVoltage(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationAttitude) {
-    visitSKNavigationAttitude(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationCourseOverGroundTrue) {
-    visitSKNavigationCourseOverGroundTrue(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationDatetime) {
-    visitSKNavigationDatetime(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationHeadingMagnetic) {
-    visitSKNavigationHeadingMagnetic(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationHeadingTrue) {
-    visitSKNavigationHeadingTrue(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationLog) {
-    visitSKNavigationLog(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationMagneticVariation) {
-    visitSKNavigationMagneticVariation(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationPosition) {
-    visitSKNavigationPosition(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationSpeedOverGround) {
-    visitSKNavigationSpeedOverGround(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationSpeedThroughWater) {
-    visitSKNavigationSpeedThroughWater(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathNavigationTripLog) {
-    visitSKNavigationTripLog(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathSteeringRudderAngle) {
-    visitSKSteeringRudderAngle(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathSteeringRudderAngleTarget) {
-    visitSKSteeringRudderAngleTarget(u, p, v);
-  }
-  if (p.getStaticPath() == SKPathPerformanceLeeway) {
-    visitSKPerformanceLeeway(u, p, v);
+  switch (p.getStaticPath()) {
+    case SKPathEnvironmentDepthBelowKeel:
+      visitSKEnvironmentDepthBelowKeel(u, p, v);
+      break;
+    case SKPathEnvironmentDepthBelowTransducer:
+      visitSKEnvironmentDepthBelowTransducer(u, p, v);
+      break;
+    case SKPathEnvironmentDepthBelowSurface:
+      visitSKEnvironmentDepthBelowSurface(u, p, v);
+      break;
+    case SKPathEnvironmentDepthTransducerToKeel:
+      visitSKEnvironmentDepthTransducerToKeel(u, p, v);
+      break;
+    case SKPathEnvironmentDepthSurfaceToTransducer:
+      visitSKEnvironmentDepthSurfaceToTransducer(u, p, v);
+      break;
+    case SKPathEnvironmentCurrentDrift:
+      visitSKEnvironmentCurrentDrift(u, p, v);
+      break;
+    case SKPathEnvironmentCurrentSetTrue:
+      visitSKEnvironmentCurrentSetTrue(u, p, v);
+      break;
+    case SKPathEnvironmentInsideTemperature:
+      visitSKEnvironmentInsideTemperature(u, p, v);
+      break;
+    case SKPathEnvironmentOutsidePressure:
+      visitSKEnvironmentOutsidePressure(u, p, v);
+      break;
+    case SKPathEnvironmentOutsideTemperature:
+      visitSKEnvironmentOutsideTemperature(u, p, v);
+      break;
+    case SKPathEnvironmentWaterTemperature:
+      visitSKEnvironmentWaterTemperature(u, p, v);
+      break;
+    case SKPathEnvironmentWindAngleApparent:
+      visitSKEnvironmentWindAngleApparent(u, p, v);
+      break;
+    case SKPathEnvironmentWindAngleTrueGround:
+      visitSKEnvironmentWindAngleTrueGround(u, p, v);
+      break;
+    case SKPathEnvironmentWindAngleTrueWater:
+      visitSKEnvironmentWindAngleTrueWater(u, p, v);
+      break;
+    case SKPathEnvironmentWindDirectionTrue:
+      visitSKEnvironmentWindDirectionTrue(u, p, v);
+      break;
+    case SKPathEnvironmentWindDirectionMagnetic:
+      visitSKEnvironmentWindDirectionMagnetic(u, p, v);
+      break;
+    case SKPathEnvironmentWindSpeedTrue:
+      visitSKEnvironmentWindSpeedTrue(u, p, v);
+      break;
+    case SKPathEnvironmentWindSpeedOverGround:
+      visitSKEnvironmentWindSpeedOverGround(u, p, v);
+      break;
+    case SKPathEnvironmentWindSpeedApparent:
+      visitSKEnvironmentWindSpeedApparent(u, p, v);
+      break;
+    case SKPathElectricalBatteriesVoltage:
+      visitSKElectricalBatteriesVoltage(u, p, v);
+      break;
+    case SKPathElectricalBatteriesCurrent:
+      visitSKElectricalBatteriesCurrent(u, p, v);
+      break;
+    case SKPathElectricalBatteriesTemperature:
+      visitSKElectricalBatteriesTemperature(u, p, v);
+      break;
+    case SKPathPropulsionRevolutions:
+      visitSKPropulsionRevolutions(u, p, v);
+      break;
+    case SKPathTanksCurrentLevel:
+      visitSKTanksCurrentLevel(u, p, v);
+      break;
+    case SKPathTanksCapacity:
+      visitSKTanksCapacity(u, p, v);
+      break;
+    case SKPathNavigationAttitude:
+      visitSKNavigationAttitude(u, p, v);
+      break;
+    case SKPathNavigationCourseOverGroundTrue:
+      visitSKNavigationCourseOverGroundTrue(u, p, v);
+      break;
+    case SKPathNavigationCourseRhumblineCrossTrackError:
+      visitSKNavigationCourseRhumblineCrossTrackError(u, p, v);
+      break;
+    case SKPathNavigationDatetime:
+      visitSKNavigationDatetime(u, p, v);
+      break;
+    case SKPathNavigationHeadingMagnetic:
+      visitSKNavigationHeadingMagnetic(u, p, v);
+      break;
+    case SKPathNavigationHeadingTrue:
+      visitSKNavigationHeadingTrue(u, p, v);
+      break;
+    case SKPathNavigationLog:
+      visitSKNavigationLog(u, p, v);
+      break;
+    case SKPathNavigationMagneticVariation:
+      visitSKNavigationMagneticVariation(u, p, v);
+      break;
+    case SKPathNavigationPosition:
+      visitSKNavigationPosition(u, p, v);
+      break;
+    case SKPathNavigationRateOfTurn:
+      visitSKNavigationRateOfTurn(u, p, v);
+      break;
+    case SKPathNavigationSpeedOverGround:
+      visitSKNavigationSpeedOverGround(u, p, v);
+      break;
+    case SKPathNavigationSpeedThroughWater:
+      visitSKNavigationSpeedThroughWater(u, p, v);
+      break;
+    case SKPathNavigationSpeedThroughWaterTransverse:
+      visitSKNavigationSpeedThroughWaterTransverse(u, p, v);
+      break;
+    case SKPathNavigationTripLog:
+      visitSKNavigationTripLog(u, p, v);
+      break;
+    case SKPathSteeringRudderAngle:
+      visitSKSteeringRudderAngle(u, p, v);
+      break;
+    case SKPathSteeringRudderAngleTarget:
+      visitSKSteeringRudderAngleTarget(u, p, v);
+      break;
+    case SKPathPerformanceLeeway:
+      visitSKPerformanceLeeway(u, p, v);
+      break;
+    default:
+      break;
   }
 }
 
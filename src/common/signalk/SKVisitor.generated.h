@@ -1,7 +1,7 @@
 // This file was automatically generated by sk-code-generator.py
 // DO NOT MODIFY! YOUR CHANGES WOULD BE OVERWRITTEN
 // Look at src/common/signalk/SKVisitor.h.tmpl instead or modify the script
-// Generated on 2018-07-26 18:30:17.969000
+// Generated on 2026-10-17 14:15:01.737772
 
 /*
      __  __     ______     ______     __  __
@@ -53,8 +53,12 @@ class SKVisitor {
   virtual void visitSKEnvironmentDepthBelowSurface(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKEnvironmentDepthTransducerToKeel(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKEnvironmentDepthSurfaceToTransducer(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKEnvironmentCurrentDrift(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKEnvironmentCurrentSetTrue(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKEnvironmentInsideTemperature(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKEnvironmentOutsidePressure(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKEnvironmentOutsideTemperature(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKEnvironmentWaterTemperature(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKEnvironmentWindAngleApparent(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKEnvironmentWindAngleTrueGround(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKEnvironmentWindAngleTrueWater(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
@@ -64,16 +68,24 @@ class SKVisitor {
   virtual void visitSKEnvironmentWindSpeedOverGround(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKEnvironmentWindSpeedApparent(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKElectricalBatteriesVoltage(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKElectricalBatteriesCurrent(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKElectricalBatteriesTemperature(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKPropulsionRevolutions(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKTanksCurrentLevel(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKTanksCapacity(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationAttitude(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationCourseOverGroundTrue(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKNavigationCourseRhumblineCrossTrackError(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationDatetime(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationHeadingMagnetic(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationHeadingTrue(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationLog(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationMagneticVariation(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationPosition(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKNavigationRateOfTurn(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationSpeedOverGround(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationSpeedThroughWater(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
+  virtual void visitSKNavigationSpeedThroughWaterTransverse(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKNavigationTripLog(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKSteeringRudderAngle(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
   virtual void visitSKSteeringRudderAngleTarget(const SKUpdate &u, const SKPath &p, const SKValue &v) {};
@@ -44,6 +44,9 @@ class SKModel(object):
             if 'unit' in keyJson:
                 unit = keyJson['unit']
             key = SKKey(keyJson['path'], keyJson['type'], unit, keyJson['description'])
+            key.nmea0183 = keyJson.get('nmea0183', [])
+            key.xdr = keyJson.get('xdr', [])
+            key.nmea2000 = keyJson.get('nmea2000', [])
             model.keys.append(key)
 
         return model
@@ -148,9 +151,11 @@ class SKPathEnumGenerator(TemplateGenerator):
     def beginTemplate(self, data):
         self.nonIndexedKeys = ""
         self.indexedKeys = ""
+        self.keysCount = 0
         return data
 
     def generateForKey(self, k):
+        self.keysCount += 1
         if k.isIndexed():
             self.indexedKeys += "  " + k.enumKey() + ",\n"
         else:
@@ -159,19 +164,32 @@ class SKPathEnumGenerator(TemplateGenerator):
     def finalizeTemplate(self, data):
         data = data.replace("  // Insert Non-Indexed Keys Here\n", self.nonIndexedKeys)
         data = data.replace("  // Insert Indexed Keys Here\n", self.indexedKeys)
+        # SKPathInvalidPath and SKPathEnumIndexedPaths are also in the enum
+        enumCount = self.keysCount + 2
+        data = data.replace("/* Insert Bitmap Words Here */", str((enumCount + 31) // 32))
         return data
 
 
 class SKPathToStringGenerator(TemplateGenerator):
+    def beginTemplate(self, data):
+        self.prefixes = { True: "", False: "" }
+        self.suffixes = { True: "", False: "" }
+        return data
+
     def generateForKey(self, k):
-        self.indentLevel = 4;
-        self.p("case " + k.enumKey() + ":")
         if not k.isIndexed():
-            self.p("  path = \"" + k.getPath() + "\";")
+            (prefix, suffix) = (k.getPath(), "")
         else:
             (prefix, suffix) = k.getPath().split('%%')
-            self.p("  path = \"" + prefix + "\" + _index + \"" + suffix + "\";")
-        self.p("  break;")
+        self.prefixes[k.isIndexed()] += "  \"" + prefix + "\",\n"
+        self.suffixes[k.isIndexed()] += "  \"" + suffix + "\",\n"
+
+    def finalizeTemplate(self, data):
+        data = data.replace("  // Insert Non-Indexed Prefixes Here\n", self.prefixes[False])
+        data = data.replace("  // Insert Indexed Prefixes Here\n", self.prefixes[True])
+        data = data.replace("  // Insert Non-Indexed Suffixes Here\n", self.suffixes[False])
+        data = data.replace("  // Insert Indexed Suffixes Here\n", self.suffixes[True])
+        return data
 
 
 class SKUpdateSyntacticSugarGenerator(TemplateGenerator):
@@ -189,17 +207,20 @@ class SKUpdateSyntacticSugarGenerator(TemplateGenerator):
             self.p("  return setValue({}, newValue);".format(k.enumKey()))
             self.p("};")
         else:
-            self.p("bool has{}(String index) const {{".format(k.camelCasedPath()))
-            self.p("  return hasPath(SKPath(" + k.enumKey() + ", index));")
-            self.p("};")
+            for indexType in ["const char *", "SKIndexId "]:
+                self.p("bool has{}({}index) const {{".format(k.camelCasedPath(), indexType))
+                # Looking for a value must not intern its index.
+                lookupIndex = "skIndexTable.find(index)" if indexType == "const char *" else "index"
+                self.p("  return hasPath(SKPath({}, {}));".format(k.enumKey(), lookupIndex))
+                self.p("};")
 
-            self.p("{} get{}(String index) const {{".format(k.cType(), k.camelCasedPath()))
-            self.p("  return this->operator[](SKPath({}, index)).{}();".format(k.enumKey(), k.cTypeAccessor()))
-            self.p("};")
+                self.p("{} get{}({}index) const {{".format(k.cType(), k.camelCasedPath(), indexType))
+                self.p("  return this->operator[](SKPath({}, {})).{}();".format(k.enumKey(), lookupIndex, k.cTypeAccessor()))
+                self.p("};")
 
-            self.p("bool set{}(String index, {} newValue) {{".format(k.camelCasedPath(), k.cType()))
-            self.p("  return setValue(SKPath({}, index), newValue);".format(k.enumKey()))
-            self.p("};")
+                self.p("bool set{}({}index, {} newValue) {{".format(k.camelCasedPath(), indexType, k.cType()))
+                self.p("  return setValue(SKPath({}, index), newValue);".format(k.enumKey()))
+                self.p("};")
 
 
 class SKVisitorHeaderGenerator(TemplateGenerator):
@@ -210,10 +231,92 @@ class SKVisitorHeaderGenerator(TemplateGenerator):
 
 class SKVisitorImplGenerator(TemplateGenerator):
     def generateForKey(self, k):
-        self.indentLevel = 2;
-        self.p("if (p.getStaticPath() == {}) {{".format(k.enumKey()))
+        self.indentLevel = 4;
+        self.p("case {}:".format(k.enumKey()))
         self.p("  {}(u, p, v);".format(k.visitorName()));
-        self.p("}");
+        self.p("  break;");
+
+
+class SKNMEADescriptorsGenerator(TemplateGenerator):
+    def beginTemplate(self, data):
+        self.fieldDescriptors = []
+        self.xdrDescriptors = []
+        return data
+
+    @staticmethod
+    def packCode(code):
+        # Same as NMEAPackCode()
+        packed = 0
+        for c in code[:4]:
+            packed = (packed << 8) | ord(c)
+        return packed
+
+    @staticmethod
+    def condition(d, name):
+        if name in d:
+            return "{}, '{}'".format(d[name][0], d[name][1])
+        return "0, 0"
+
+    def generateForKey(self, k):
+        for d in k.nmea0183:
+            line = "  {{ NMEAPackCode(\"{}\"), {}, {}, SKNMEAConversion{}, {}, {}, {}, {} }},".format(
+                d['sentence'], d['field'], d.get('aux', 0), d.get('conversion', 'None'),
+                self.condition(d, 'unit'), self.condition(d, 'reference'), self.condition(d, 'status'),
+                k.enumKey())
+            self.fieldDescriptors.append((self.packCode(d['sentence']), line))
+
+        for d in k.xdr:
+            name = "\"{}\"".format(d['name']) if 'name' in d else "nullptr"
+            line = "  {{ '{}', '{}', {}, SKNMEAConversion{}, {} }},".format(
+                d['type'], d['unit'], name, d.get('conversion', 'None'), k.enumKey())
+            self.xdrDescriptors.append(('name' not in d, line))
+
+    def finalizeTemplate(self, data):
+        # Sorted by sentence code for the parser binary search. The sort is
+        # stable so descriptors of one sentence keep the order of signalk.json.
+        self.fieldDescriptors.sort(key=lambda d: d[0])
+        self.xdrDescriptors.sort(key=lambda d: d[0])
+        data = data.replace("  // Insert Field Descriptors Here\n", "".join(l + "\n" for (_, l) in self.fieldDescriptors))
+        data = data.replace("  // Insert XDR Descriptors Here\n", "".join(l + "\n" for (_, l) in self.xdrDescriptors))
+        return data
+
+
+class SKNMEA2000DescriptorsGenerator(TemplateGenerator):
+    def beginTemplate(self, data):
+        self.pgns = set()
+        return data
+
+    def generateForKey(self, k):
+        self.pgns.update(k.nmea2000)
+
+    def finalizeTemplate(self, data):
+        pgns = sorted(self.pgns)
+        declarations = "".join(
+            "bool skNMEA2000Decode{}(const SKSourceInput &input, const tN2kMsg &msg,\n"
+            "                            const SKTime &timestamp, SKUpdate &update);\n".format(pgn) for pgn in pgns)
+        descriptors = "".join("  {{ {}, skNMEA2000Decode{} }},\n".format(pgn, pgn) for pgn in pgns)
+
+        first = pgns[0]
+        words = [0] * ((pgns[-1] - first) // 32 + 1)
+        for pgn in pgns:
+            words[(pgn - first) // 32] |= 1 << ((pgn - first) % 32)
+        ranks = []
+        count = 0
+        for w in words:
+            ranks.append(count)
+            count += bin(w).count("1")
+
+        bitmap = "".join("  {},\n".format(", ".join("0x{:08x}".format(w) for w in words[i:i + 6]))
+                         for i in range(0, len(words), 6))
+        rank = "".join("  {},\n".format(", ".join(str(r) for r in ranks[i:i + 16]))
+                       for i in range(0, len(ranks), 16))
+
+        data = data.replace("// Insert Decoder Declarations Here\n", declarations)
+        data = data.replace("  // Insert PGN Descriptors Here\n", descriptors)
+        data = data.replace("/* Insert First PGN Here */", str(first))
+        data = data.replace("  // Insert PGN Bitmap Here\n", bitmap)
+        data = data.replace("  // Insert PGN Rank Here\n", rank)
+        return data
 
 
 def main():
@@ -237,6 +340,8 @@ def main():
     SKUpdateSyntacticSugarGenerator(os.path.join(templatePath, 'SKUpdateSyntacticSugar.h.tmpl')).generate(model, open(os.path.join(outputPath, 'SKUpdateSyntacticSugar.generated.h'), 'w'))
     SKVisitorHeaderGenerator(os.path.join(templatePath, 'SKVisitor.h.tmpl')).generate(model, open(os.path.join(outputPath, 'SKVisitor.generated.h'), 'w'))
     SKVisitorImplGenerator(os.path.join(templatePath, 'SKVisitor.cpp.tmpl')).generate(model, open(os.path.join(outputPath, 'SKVisitor.generated.cpp'), 'w'))
+    SKNMEADescriptorsGenerator(os.path.join(templatePath, 'SKNMEADescriptors.cpp.tmpl')).generate(model, open(os.path.join(outputPath, 'SKNMEADescriptors.generated.cpp'), 'w'))
+    SKNMEA2000DescriptorsGenerator(os.path.join(templatePath, 'SKNMEA2000Descriptors.cpp.tmpl')).generate(model, open(os.path.join(outputPath, 'SKNMEA2000Descriptors.generated.cpp'), 'w'))
 
 if __name__ == '__main__':
     main()
@@ -30,23 +30,45 @@ enum KBoxEvent {
   KBoxEventNMEA1RX,
   // Happens when the serial buffer is overflowed
   KBoxEventNMEA1RXBufferOverflow,
-  // Happens when sentences are received too fast and exceed the max queue length
-  // FIXME: Not implemented yet.
+  // Happens when sentences are received too fast and the receive ring is full
   KBoxEventNMEA1RXOverflow,
   KBoxEventNMEA1RXError,
+  // Happens when a sentence was just received identically on the other port
+  KBoxEventNMEA1RXDuplicate,
   KBoxEventNMEA1TX,
+  // Happens when a sentence is dropped because too many are waiting
   KBoxEventNMEA1TXOverflow,
+  // Happens when a waiting sentence is replaced by a newer one of the same type
+  KBoxEventNMEA1TXCoalesced,
 
   KBoxEventNMEA2RX,
   KBoxEventNMEA2RXBufferOverflow,
   KBoxEventNMEA2RXOverflow,
   KBoxEventNMEA2RXError,
+  // Happens when a sentence was just received identically on the other port
+  KBoxEventNMEA2RXDuplicate,
   KBoxEventNMEA2TX,
+  // Happens when a sentence is dropped because too many are waiting
   KBoxEventNMEA2TXOverflow,
+  // Happens when a waiting sentence is replaced by a newer one of the same type
+  KBoxEventNMEA2TXCoalesced,
 
   KBoxEventNMEA2000MessageReceived,
   KBoxEventNMEA2000MessageSent,
   KBoxEventNMEA2000MessageSendError,
+  // Happens when a message with a PGN that is not decoded is received
+  KBoxEventNMEA2000UnknownPGN,
+  // Happens when a received message is dropped because too many are waiting
+  // to be processed (navigation PGNs and other PGNs are queued separately)
+  KBoxEventNMEA2000IngressNavigationOverflow,
+  KBoxEventNMEA2000IngressOtherOverflow,
+  // Happens when a message to send is dropped because too many are waiting
+  KBoxEventNMEA2000TXDropped,
+  // Happens when a waiting message is replaced by a newer one of the same value
+  KBoxEventNMEA2000TXCoalesced,
+  // Happens when the bus statistics of a PGN and source are dropped to make
+  // room for a new one
+  KBoxEventNMEA2000BusStatsEvicted,
 
   KBoxEventUSBValidKommand,
   KBoxEventUSBInvalidKommand,
@@ -55,6 +77,25 @@ enum KBoxEvent {
   KBoxEventWiFiRxInvalidKommand,
   KBoxEventWiFiTxFrame,
   KBoxEventWiFiRxErrorFrame,
+  // Happens when the ESP asks for the SignalK source and index definitions
+  // again because it lost one
+  KBoxEventWiFiSKDefinitionsRequested,
+
+  // Happens when an update is published while the SKHub queue is full
+  KBoxEventSKHubQueueDropped,
+  // Happens when an update has too many values to be filtered by the
+  // multiplexer and is delivered unchanged
+  KBoxEventSKHubUpdateNotFiltered,
+  // Happens when a value is dropped because another input is preferred for
+  // its path
+  KBoxEventSKSourceSuppressed,
+  // Happens when a path switches to another input because the preferred one
+  // went quiet
+  KBoxEventSKSourceFailover,
+  // Happens when an index (battery or tank name, ...) is not published because
+  // the table of indexes (or its share for the names received from the
+  // inputs) is full
+  KBoxEventSKIndexTableFull,
 
 
   // Events used by the ESP module
@@ -74,6 +115,24 @@ enum KBoxMetric {
   // Average time in us it takes to run through all the system tasks.
   KBoxMetricTaskManagerLoopUS,
 
+  // Number of updates waiting in the SKHub queue, sampled by SKHubService.
+  KBoxMetricSKHubQueueDepthCount,
+
+  // Maximum number of updates that were waiting in the SKHub queue.
+  KBoxMetricSKHubQueueHighWaterCount,
+
+  // Number of NMEA2000 messages waiting to be processed, sampled by
+  // NMEA2000Service.
+  KBoxMetricNMEA2000IngressDepthCount,
+
+  // Estimated share of the NMEA2000 bus used by the messages sent by KBox
+  // during the last second.
+  KBoxMetricNMEA2000TXBusLoadPercent,
+
+  // Estimated share of the NMEA2000 bus used by all the messages (received
+  // and sent) during the last second.
+  KBoxMetricNMEA2000BusLoadPercent,
+
   // Used to get a count of the number of metrics
   KBoxMetricCountDistinctMetrics
 };
@@ -28,12 +28,25 @@
   THE SOFTWARE.
 */
 
+#include <Arduino.h>
 #include <KBoxLogging.h>
 #include "KommandHandlerSKData.h"
 
 bool KommandHandlerSKData::handleKommand(KommandReader &kreader, SlipStream &replyStream) {
-  if (kreader.getKommandIdentifier() != KommandSKData) {
-    return false;
+  switch (kreader.getKommandIdentifier()) {
+    case KommandSKSource:
+    case KommandSKIndex:
+      if (!_decoder.decodeDefinition(kreader)) {
+        DEBUG("Received invalid SignalK source or index definition");
+      }
+      return true;
+    case KommandSKDelta:
+      publishDelta(kreader, replyStream);
+      return true;
+    case KommandSKData:
+      break;
+    default:
+      return false;
   }
 
   const char *jsonData = kreader.readNullTerminatedString();
@@ -46,3 +59,28 @@ bool KommandHandlerSKData::handleKommand(KommandReader &kreader, SlipStream &rep
   }
   return true;
 }
+
+void KommandHandlerSKData::publishDelta(KommandReader &kreader, SlipStream &replyStream) {
+  if (_webServer.countClients() == 0) {
+    return;
+  }
+
+  if (!_decoder.decodeDelta(kreader, _update)) {
+    if (!_decoder.missingDefinition()) {
+      DEBUG("Received invalid KommandSKDelta");
+    }
+    else if (!_definitionsRequested || millis() - _lastDefinitionsRequest > DefinitionsRequestInterval) {
+      // A definition was lost on the way: ask KBox to send them again.
+      DEBUG("KommandSKDelta references an unknown source or index");
+      FixedSizeKommand<0> request(KommandSKUnknownReference);
+      replyStream.writeFrame(request.getBytes(), request.getSize());
+      _lastDefinitionsRequest = millis();
+      _definitionsRequested = true;
+    }
+    return;
+  }
+
+  static char json[1024];
+  _jsonWriter.write(_update, json, sizeof(json));
+  _webServer.publishSKUpdate(json);
+}
@@ -31,13 +31,40 @@
 #pragma once
 
 #include "common/comms/KommandHandler.h"
+#include "common/comms/SKBinaryDelta.h"
+#include "common/signalk/SKJSONWriter.h"
+#include "common/signalk/SKUpdateStatic.h"
 #include "net/KBoxWebServer.h"
 
+/**
+ * Publishes SignalK data received from KBox to the WebSocket clients.
+ *
+ * Handles KommandSKData (already in JSON) and KommandSKDelta with its source
+ * and index definitions. Binary deltas are only converted to JSON when a
+ * client is connected.
+ */
 class KommandHandlerSKData : public KommandHandler {
   private:
     KBoxWebServer &_webServer;
+    SKBinaryDeltaDecoder _decoder;
+    SKUpdateStatic<SKBinaryDeltaEncoder::MaxValues> _update;
+    SKJSONWriter _jsonWriter;
+
+    // Definitions are requested again at most once per second: the deltas
+    // already in flight would otherwise each trigger a request.
+    static const uint32_t DefinitionsRequestInterval = 1000;
+    uint32_t _lastDefinitionsRequest;
+    bool _definitionsRequested;
+
+    void publishDelta(KommandReader &kreader, SlipStream &replyStream);
 
   public:
-    KommandHandlerSKData(KBoxWebServer &webServer) : _webServer(webServer) {};
+    KommandHandlerSKData(KBoxWebServer &webServer) : _webServer(webServer), _jsonWriter(""),
+      _lastDefinitionsRequest(0), _definitionsRequested(false) {};
+
+    void setVesselURN(const String &vesselURN) {
+      _jsonWriter.setVesselURN(vesselURN);
+    };
+
     bool handleKommand(KommandReader &kreader, SlipStream &replyStream) override;
 };
@@ -225,6 +225,7 @@ static void configurationCallback(const WiFiConfiguration& config) {
   }
 
   webServer.setVesselURN(config.vesselURN);
+  skDataHandler.setVesselURN(config.vesselURN);
 
   espState = ESPState::ESPConfigured;
 }
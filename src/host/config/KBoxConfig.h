@@ -36,6 +36,7 @@
 #include "BarometerConfig.h"
 #include "WiFiConfig.h"
 #include "SDLoggingConfig.h"
+#include "SKHubConfig.h"
 
 /**
  * A KBox configuration in memory
@@ -48,4 +49,5 @@ struct KBoxConfig {
   BarometerConfig barometerConfig;
   WiFiConfig wifiConfig;
   SDLoggingConfig sdLoggingConfig;
+  SKHubConfig skHubConfig;
 };
@@ -28,6 +28,7 @@
   THE SOFTWARE.
 */
 
+#include <stdlib.h>
 #include "KBoxConfigParser.h"
 
 #define READ_VALUE_WITH_TYPE(name, type) if (json[#name].is<type>()) { \
@@ -66,6 +67,8 @@ void KBoxConfigParser::defaultConfig(KBoxConfig &config) {
   config.serial2Config.nmeaConverter.xdrAttitude = false;
   config.serial2Config.nmeaConverter.xdrBattery = false;
   config.serial2Config.nmeaConverter.xdrPressure = false;
+  // At 4800 baud, heading at the IMU frequency would use most of the port.
+  config.serial2Config.nmeaOutput.hdm.maxRate = 10;
 
   config.nmea2000Config.txEnabled = true;
   config.nmea2000Config.rxEnabled = true;
@@ -94,12 +97,18 @@ void KBoxConfigParser::defaultConfig(KBoxConfig &config) {
   config.sdLoggingConfig.enabled = true;
   config.sdLoggingConfig.logWithoutTime = false;
   config.sdLoggingConfig.logNMEA2000 = true;
+  config.sdLoggingConfig.logNMEA2000Binary = false;
   config.sdLoggingConfig.logNMEA = true;
   config.sdLoggingConfig.logSignalK = true;
   config.sdLoggingConfig.logSystemMessages = true;
   config.sdLoggingConfig.logSignalKGeneratedFromNMEA = false;
   config.sdLoggingConfig.logSignalKGeneratedFromNMEA2000 = false;
   config.sdLoggingConfig.logSignalKGeneratedByKBoxSensors = true;
+
+  config.skHubConfig.queueEnabled = false;
+  config.skHubConfig.queueSize = 32;
+  config.skHubConfig.dispatchBudget = 2000;
+  config.skHubConfig.multiplexer.enabled = false;
 }
 
 void KBoxConfigParser::parseKBoxConfig(const JsonObject &json, KBoxConfig &config) {
@@ -112,6 +121,7 @@ void KBoxConfigParser::parseKBoxConfig(const JsonObject &json, KBoxConfig &confi
   parseWiFiConfig(json["wifi"], config.wifiConfig);
   parseNMEA2000Config(json["nmea2000"], config.nmea2000Config);
   parseSDLoggingConfig(json["logging"], config.sdLoggingConfig);
+  parseSKHubConfig(json["skhub"], config.skHubConfig);
 }
 
 void KBoxConfigParser::parseIMUConfig(const JsonObject &json, IMUConfig &config) {
@@ -135,14 +145,47 @@ void KBoxConfigParser::parseSerialConfig(const JsonObject &json, SerialConfig &c
   READ_INT_VALUE(baudRate);
   READ_ENUM_VALUE(inputMode, convertSerialMode);
   READ_ENUM_VALUE(outputMode, convertSerialMode);
+  READ_BOOL_VALUE(suppressDuplicates);
 
   parseNMEAConverterConfig(json["nmeaConverter"], config.nmeaConverter);
+  parseNMEAParserConfig(json["nmeaParser"], config.nmeaParser);
+  parseNMEAOutputSchedulerConfig(json["nmeaOutput"], config.nmeaOutput);
 }
 
 void KBoxConfigParser::parseNMEA2000Config(const JsonObject &json,
                                            NMEA2000Config &config) {
   READ_BOOL_VALUE(rxEnabled);
   READ_BOOL_VALUE(txEnabled);
+
+  parseNMEA2000OutputSchedulerConfig(json["output"], config.output);
+}
+
+void KBoxConfigParser::parseNMEA2000OutputSchedulerConfig(const JsonObject &json,
+                                                          NMEA2000OutputSchedulerConfig &config) {
+  if (json == JsonObject::invalid()) {
+    return;
+  }
+
+  READ_INT_VALUE_WRANGE(maxBusLoad, 0, 100);
+
+  // Maximum rates by PGN, for example: { "127257": 2 }
+  const JsonObject &maxRates = json["maxRate"];
+  if (maxRates == JsonObject::invalid()) {
+    return;
+  }
+  int index = 0;
+  for (auto kv : maxRates) {
+    long pgn = atol(kv.key);
+    if (index >= NMEA2000OutputSchedulerConfig::MaxPGNs) {
+      break;
+    }
+    if (pgn <= 0 || !kv.value.is<int>() || kv.value.as<int>() < 0 || kv.value.as<int>() > 50) {
+      continue;
+    }
+    config.pgns[index].pgn = pgn;
+    config.pgns[index].maxRate = kv.value.as<int>();
+    index++;
+  }
 }
 
 void KBoxConfigParser::parseWiFiConfig(const JsonObject &json, WiFiConfig &config) {
@@ -168,6 +211,7 @@ void KBoxConfigParser::parseSDLoggingConfig(const JsonObject &json, SDLoggingCon
   READ_BOOL_VALUE(enabled);
   READ_BOOL_VALUE(logWithoutTime);
   READ_BOOL_VALUE(logNMEA2000);
+  READ_BOOL_VALUE(logNMEA2000Binary);
   READ_BOOL_VALUE(logNMEA);
   READ_BOOL_VALUE(logSignalK);
   READ_BOOL_VALUE(logSystemMessages);
@@ -176,6 +220,32 @@ void KBoxConfigParser::parseSDLoggingConfig(const JsonObject &json, SDLoggingCon
   READ_BOOL_VALUE(logSignalKGeneratedByKBoxSensors);
 }
 
+void KBoxConfigParser::parseSKHubConfig(const JsonObject &json, SKHubConfig &config) {
+  if (json == JsonObject::invalid()) {
+    return;
+  }
+
+  READ_BOOL_VALUE(queueEnabled);
+  READ_INT_VALUE_WRANGE(queueSize, 1, 256);
+  READ_INT_VALUE_WRANGE(dispatchBudget, 100, 10000);
+
+  parseSKSourceMultiplexerConfig(json["multiplexer"], config.multiplexer);
+}
+
+void KBoxConfigParser::parseSKSourceMultiplexerConfig(const JsonObject &json,
+                                                      SKSourceMultiplexerConfig &config) {
+  if (json == JsonObject::invalid()) {
+    return;
+  }
+
+  READ_BOOL_VALUE(enabled);
+  READ_INT_VALUE_WRANGE(sourceTimeout, 0, 60000);
+  READ_INT_VALUE_WRANGE(nmea1Priority, 0, 9);
+  READ_INT_VALUE_WRANGE(nmea2Priority, 0, 9);
+  READ_INT_VALUE_WRANGE(nmea2000Priority, 0, 9);
+  READ_INT_VALUE_WRANGE(kboxPriority, 0, 9);
+}
+
 void KBoxConfigParser::parseNMEAConverterConfig(const JsonObject &json, SKNMEAConverterConfig &config) {
   if (json == JsonObject::invalid()) {
     return;
@@ -191,6 +261,56 @@ void KBoxConfigParser::parseNMEAConverterConfig(const JsonObject &json, SKNMEACo
   READ_BOOL_VALUE(xdrPressure);
 }
 
+void KBoxConfigParser::parseNMEAParserConfig(const JsonObject &json, SKNMEAParserConfig &config) {
+  if (json == JsonObject::invalid()) {
+    return;
+  }
+
+  READ_BOOL_VALUE(ais);
+  READ_BOOL_VALUE(dbt);
+  READ_BOOL_VALUE(dpt);
+  READ_BOOL_VALUE(gll);
+  READ_BOOL_VALUE(hdg);
+  READ_BOOL_VALUE(hdm);
+  READ_BOOL_VALUE(hdt);
+  READ_BOOL_VALUE(mta);
+  READ_BOOL_VALUE(mtw);
+  READ_BOOL_VALUE(mwd);
+  READ_BOOL_VALUE(mwv);
+  READ_BOOL_VALUE(rmc);
+  READ_BOOL_VALUE(rsa);
+  READ_BOOL_VALUE(vhw);
+  READ_BOOL_VALUE(vlw);
+  READ_BOOL_VALUE(vtg);
+  READ_BOOL_VALUE(vwr);
+  READ_BOOL_VALUE(xdr);
+}
+
+void KBoxConfigParser::parseNMEAOutputSchedulerConfig(const JsonObject &json,
+                                                      NMEAOutputSchedulerConfig &config) {
+  if (json == JsonObject::invalid()) {
+    return;
+  }
+
+  parseNMEAOutputSentenceConfig(json["dbt"], config.dbt);
+  parseNMEAOutputSentenceConfig(json["dpt"], config.dpt);
+  parseNMEAOutputSentenceConfig(json["hdm"], config.hdm);
+  parseNMEAOutputSentenceConfig(json["mwv"], config.mwv);
+  parseNMEAOutputSentenceConfig(json["rsa"], config.rsa);
+  parseNMEAOutputSentenceConfig(json["xdr"], config.xdr);
+  parseNMEAOutputSentenceConfig(json["other"], config.other);
+}
+
+void KBoxConfigParser::parseNMEAOutputSentenceConfig(const JsonObject &json,
+                                                     NMEAOutputSentenceConfig &config) {
+  if (json == JsonObject::invalid()) {
+    return;
+  }
+
+  READ_INT_VALUE_WRANGE(priority, 0, 3);
+  READ_INT_VALUE_WRANGE(maxRate, 0, 50);
+}
+
 void KBoxConfigParser::parseWiFiNetworkConfig(const JsonObject &json,
                                               WiFiNetworkConfig &config) {
   READ_BOOL_VALUE(enabled);
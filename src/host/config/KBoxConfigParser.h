@@ -66,8 +66,19 @@ class KBoxConfigParser {
     void parseNMEA2000Config(const JsonObject &object, NMEA2000Config &config);
     void parseWiFiConfig(const JsonObject &json, WiFiConfig &config);
     void parseSDLoggingConfig(const JsonObject &json, SDLoggingConfig &config);
+    void parseSKHubConfig(const JsonObject &json, SKHubConfig &config);
     void parseWiFiNetworkConfig(const JsonObject &json,
                                 WiFiNetworkConfig &config);
     void parseNMEAConverterConfig(const JsonObject &json,
                                   SKNMEAConverterConfig &config);
+    void parseNMEAParserConfig(const JsonObject &json,
+                               SKNMEAParserConfig &config);
+    void parseNMEAOutputSchedulerConfig(const JsonObject &json,
+                                        NMEAOutputSchedulerConfig &config);
+    void parseNMEAOutputSentenceConfig(const JsonObject &json,
+                                       NMEAOutputSentenceConfig &config);
+    void parseSKSourceMultiplexerConfig(const JsonObject &json,
+                                        SKSourceMultiplexerConfig &config);
+    void parseNMEA2000OutputSchedulerConfig(const JsonObject &json,
+                                            NMEA2000OutputSchedulerConfig &config);
 };
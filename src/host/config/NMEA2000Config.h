@@ -30,7 +30,10 @@
 
 #pragma once
 
+#include "common/nmea/NMEA2000OutputSchedulerConfig.h"
+
 struct  NMEA2000Config {
   bool rxEnabled;
   bool txEnabled;
+  NMEA2000OutputSchedulerConfig output;
 };
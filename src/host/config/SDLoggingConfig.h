@@ -34,6 +34,8 @@ struct SDLoggingConfig {
   bool enabled;
   bool logWithoutTime;
   bool logNMEA2000;
+  // Log NMEA2000 messages as binary records instead of $PCDIN sentences.
+  bool logNMEA2000Binary;
   bool logNMEA;
   bool logSignalK;
   bool logSignalKGeneratedFromNMEA;
@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include "common/nmea/NMEAOutputSchedulerConfig.h"
 #include "common/signalk/SKNMEAConverterConfig.h"
+#include "common/signalk/SKNMEAParserConfig.h"
 
 enum SerialMode {
   SerialModeDisabled,
@@ -41,5 +43,9 @@ struct  SerialConfig {
   int baudRate = 0;
   enum SerialMode inputMode = SerialModeDisabled;
   enum SerialMode outputMode = SerialModeDisabled;
+  // Ignore sentences just received identically on the other port
+  bool suppressDuplicates = true;
   SKNMEAConverterConfig nmeaConverter;
+  SKNMEAParserConfig nmeaParser;
+  NMEAOutputSchedulerConfig nmeaOutput;
 };
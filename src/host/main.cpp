@@ -31,6 +31,7 @@
 #include "host/os/TaskManager.h"
 #include "host/drivers/ILI9341GC.h"
 #include "host/pages/BatteryMonitorPage.h"
+#include "host/pages/NMEA2000BusPage.h"
 #include "host/pages/StatsPage.h"
 #include "host/services/MFD.h"
 #include "host/services/ADCService.h"
@@ -39,6 +40,7 @@
 #include "host/pages/IMUMonitorPage.h"
 #include "host/services/NMEA2000Service.h"
 #include "host/services/SerialService.h"
+#include "host/services/SKHubService.h"
 #include "host/services/RunningLightService.h"
 #include "host/services/SDLoggingService.h"
 #include "host/services/TimeService.h"
@@ -90,9 +92,10 @@ void setup() {
   configParser.defaultConfig(config);
   if (KBox.getSdFat().exists(configFilename)) {
     File configFile = KBox.getSdFat().open(configFilename);
-    // We can afford to allocate a lot of memory on the stack for this because we have not started doing
-    // anything real yet.
-    StaticJsonBuffer<4096> jsonBuffer;
+    // The complete default config needs a bit more than 4kB. This memory is
+    // taken from the heap, only as much as the file needs, and released
+    // before the services are created.
+    DynamicJsonBuffer jsonBuffer(1024);
     JsonObject &root =jsonBuffer.parseObject(configFile);
 
     if (root.success()) {
@@ -130,6 +133,8 @@ void setup() {
   reader1->addRepeater(sdLoggingService);
   reader2->addRepeater(sdLoggingService);
   n2kService->addSentenceRepeater(sdLoggingService);
+  n2kService->addMessageRepeater(sdLoggingService);
+  usbService.setNMEA2000BusStats(n2kService->getBusStats());
 
   // Tell the wallClock how to get the number of ms elapsed since boot.
   wallClock.setMillisecondsProvider(millis);
@@ -139,6 +144,8 @@ void setup() {
   new TimeService(skHub);
 
   // Add all the tasks
+  // In queued mode, the hub delivers the updates from its own task.
+  taskManager.addTask(new SKHubService(config.skHubConfig, skHub));
   taskManager.addTask(&mfd);
   taskManager.addTask(new IntervalTask(new RunningLightService(), 250));
   taskManager.addTask(new IntervalTask(adcService, 1000));
@@ -160,6 +167,8 @@ void setup() {
   statsPage->setWiFiService(wifi);
   mfd.addPage(statsPage);
 
+  mfd.addPage(new NMEA2000BusPage(n2kService->getBusStats()));
+
   if (config.imuConfig.enabled) {
     // At the moment the IMUMonitorPage is working with built-in sensor only
     IMUMonitorPage *imuPage = new IMUMonitorPage(config.imuConfig, skHub, *imuService);
@@ -53,7 +53,7 @@ BatteryMonitorPage::BatteryMonitorPage(SKHub& hub) {
   addLayer(engineVoltage);
   addLayer(supplyVoltage);
 
-  hub.subscribe(this);
+  hub.subscribe(this, SKSubscriptionFilter().addPath(SKPathElectricalBatteriesVoltage));
 }
 
 Color BatteryMonitorPage::colorForVoltage(float v) {
@@ -58,7 +58,8 @@ IMUMonitorPage::IMUMonitorPage(IMUConfig &config, SKHub& hub, IMUService &imuSer
   addLayer(_rollTL);
   addLayer(_pitchTL);
 
-  hub.subscribe(this);
+  // Values are read directly from the IMUService. Nothing needed from the hub yet.
+  hub.subscribe(this, SKSubscriptionFilter());
 }
 
 bool IMUMonitorPage::processEvent(const ButtonEvent &be){
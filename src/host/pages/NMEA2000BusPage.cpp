@@ -0,0 +1,107 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "NMEA2000BusPage.h"
+
+NMEA2000BusPage::NMEA2000BusPage(const NMEA2000BusStats &stats) : _stats(stats) {
+  static const int colPGN = 5;
+  static const int colSource = 90;
+  static const int colRate = 150;
+  static const int colCount = 230;
+  static const int rowHeight = 20;
+  static const int rowHeader = 30;
+  static const int row1 = rowHeader + rowHeight;
+
+  addLayer(new TextLayer(Point(colPGN, 0), Size(80, rowHeight), "N2k Bus:"));
+  busLoad = new TextLayer(Point(colSource, 0), Size(60, rowHeight), "--");
+  messages = new TextLayer(Point(colRate, 0), Size(170, rowHeight), "");
+  addLayer(busLoad);
+  addLayer(messages);
+
+  addLayer(new TextLayer(Point(colPGN, rowHeader), Size(80, rowHeight), "PGN"));
+  addLayer(new TextLayer(Point(colSource, rowHeader), Size(60, rowHeight), "Src"));
+  addLayer(new TextLayer(Point(colRate, rowHeader), Size(80, rowHeight), "Msg/s"));
+  addLayer(new TextLayer(Point(colCount, rowHeader), Size(90, rowHeight), "Count"));
+
+  for (int i = 0; i < Rows; i++) {
+    int y = row1 + i * rowHeight;
+    pgn[i] = new TextLayer(Point(colPGN, y), Size(80, rowHeight), "");
+    source[i] = new TextLayer(Point(colSource, y), Size(60, rowHeight), "");
+    rate[i] = new TextLayer(Point(colRate, y), Size(80, rowHeight), "");
+    count[i] = new TextLayer(Point(colCount, y), Size(90, rowHeight), "");
+    addLayer(pgn[i]);
+    addLayer(source[i]);
+    addLayer(rate[i]);
+    addLayer(count[i]);
+  }
+}
+
+bool NMEA2000BusPage::processEvent(const TickEvent &e) {
+  uint32_t now = millis();
+
+  // extra spaces at the end needed to clear previous value completely
+  // (we use a non-fixed width font)
+  char s[24];
+
+  uint8_t load = _stats.busLoad(now);
+  snprintf(s, sizeof(s), "%i%%   ", load);
+  busLoad->setText(s);
+  if (load >= 70) {
+    busLoad->setColor(ColorRed);
+  }
+  else if (load >= 40) {
+    busLoad->setColor(ColorOrange);
+  }
+  else {
+    busLoad->setColor(ColorWhite);
+  }
+
+  snprintf(s, sizeof(s), "%lu msgs   ", (unsigned long)_stats.messages());
+  messages->setText(s);
+
+  const NMEA2000BusStatsEntry *entries[Rows];
+  int found = _stats.busiest(entries, Rows, now);
+  for (int i = 0; i < Rows; i++) {
+    if (i >= found) {
+      // Spaces to erase the entry that was there before
+      pgn[i]->setText("            ");
+      source[i]->setText("        ");
+      rate[i]->setText("            ");
+      count[i]->setText("              ");
+      continue;
+    }
+    snprintf(s, sizeof(s), "%lu   ", (unsigned long)entries[i]->pgn);
+    pgn[i]->setText(s);
+    snprintf(s, sizeof(s), "%i   ", entries[i]->source);
+    source[i]->setText(s);
+    snprintf(s, sizeof(s), "%.1f   ", entries[i]->rate(now));
+    rate[i]->setText(s);
+    snprintf(s, sizeof(s), "%lu   ", (unsigned long)entries[i]->messages);
+    count[i]->setText(s);
+  }
+
+  return true;
+}
@@ -0,0 +1,47 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "common/nmea/NMEA2000BusStats.h"
+#include "common/ui/Page.h"
+#include "common/ui/TextLayer.h"
+
+/**
+ * Shows the load of the NMEA2000 bus and the busiest PGNs with the device
+ * that sends them.
+ */
+class NMEA2000BusPage : public Page {
+  private:
+    static const int Rows = 9;
+
+    const NMEA2000BusStats &_stats;
+    TextLayer *busLoad, *messages;
+    TextLayer *pgn[Rows], *source[Rows], *rate[Rows], *count[Rows];
+
+  public:
+    NMEA2000BusPage(const NMEA2000BusStats &stats);
+
+    bool processEvent(const TickEvent &e) override;
+};
@@ -29,6 +29,15 @@
 
 #include "ADCService.h"
 
+ADCService::ADCService(SKHub &skHub, ADC& adc) : Task("ADC"), _skHub(skHub), _adc(adc) {
+  // FIXME: We should have configuration options to describe what each input is
+  // connected to instead of hard-coding names.
+  _adc1Index = skIndexTable.intern("engine");
+  _adc2Index = skIndexTable.intern("house");
+  _adc3Index = skIndexTable.intern("dc3");
+  _supplyIndex = skIndexTable.intern("kbox-supply");
+}
+
 void ADCService::loop() {
   int supply_adc = _adc.analogRead(supply_analog, ADC_0);
   int adc1_adc = _adc.analogRead(adc1_analog, ADC_0);
@@ -40,14 +49,12 @@ void ADCService::loop() {
   _adc2 = adc2_adc * analog_max_voltage / _adc.getMaxValue();
   _adc3 = adc3_adc * analog_max_voltage / _adc.getMaxValue();
 
-  // FIXME: We should have configuration options to describe what each input is
-  // connected to instead of hard-coding names.
   SKUpdateStatic<4> sk;
   sk.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxADC));
-  sk.setElectricalBatteriesVoltage("engine", _adc1);
-  sk.setElectricalBatteriesVoltage("house", _adc2);
-  sk.setElectricalBatteriesVoltage("dc3", _adc3);
-  sk.setElectricalBatteriesVoltage("kbox-supply", _supply);
+  sk.setElectricalBatteriesVoltage(_adc1Index, _adc1);
+  sk.setElectricalBatteriesVoltage(_adc2Index, _adc2);
+  sk.setElectricalBatteriesVoltage(_adc3Index, _adc3);
+  sk.setElectricalBatteriesVoltage(_supplyIndex, _supply);
 
   _skHub.publish(sk);
 }
@@ -27,15 +27,17 @@
 #include <ADC.h>
 #include "host/os/Task.h"
 #include "common/signalk/SKHub.h"
+#include "common/signalk/SKIndexTable.h"
 
 class ADCService : public Task {
   private:
     SKHub &_skHub;
     ADC& _adc;
     float _adc1, _adc2, _adc3, _supply;
+    SKIndexId _adc1Index, _adc2Index, _adc3Index, _supplyIndex;
 
   public:
-    ADCService(SKHub &skHub, ADC& adc) : Task("ADC"), _skHub(skHub), _adc(adc) {};
+    ADCService(SKHub &skHub, ADC& adc);
 
     virtual void loop() override;
 };
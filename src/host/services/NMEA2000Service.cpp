@@ -27,6 +27,7 @@
 #include <KBoxLogging.h>
 #include <KBoxHardware.h>
 #include <TimeLib.h>
+#include <Seasmart.h>
 #include "common/stats/KBoxMetrics.h"
 #include "common/algo/crc.h"
 #include "common/version/KBoxVersion.h"
@@ -34,26 +35,62 @@
 #include "common/time/WallClock.h"
 #include "host/util/PersistentStorage.h"
 
+// Maximum time spent processing received messages in one loop(). Messages
+// that do not fit wait in the ingress for the next loop.
+#ifndef KBOX_N2K_INGRESS_BUDGET_US
+#define KBOX_N2K_INGRESS_BUDGET_US 2000
+#endif
+
 static NMEA2000Service *handlerContext;
 
 static void handler(const tN2kMsg &msg) {
-  handlerContext->publishN2kMessage(msg);
+  handlerContext->receiveN2kMessage(msg);
 }
 
-void NMEA2000Service::publishN2kMessage(const tN2kMsg& msg) {
+void NMEA2000Service::receiveN2kMessage(const tN2kMsg& msg) {
+  // The statistics describe the bus, even when KBox ignores the messages.
+  _busStats.record(msg.PGN, msg.Source, msg.DataLen > 0 ? msg.DataLen : 0, msg.MsgTime);
+
   if (_config.rxEnabled) {
     KBoxMetrics.event(KBoxEventNMEA2000MessageReceived);
 
-    DEBUG("Received N2K Message with pgn: %i", msg.PGN);
+    if (msg.DataLen < 0 || (size_t)msg.DataLen > NMEA2000Frame::MaxDataLength) {
+      return;
+    }
+    NMEA2000Frame frame;
+    frame.pgn = msg.PGN;
+    frame.timestamp = msg.MsgTime;
+    frame.priority = msg.Priority;
+    frame.source = msg.Source;
+    frame.destination = msg.Destination;
+    frame.length = msg.DataLen;
+    memcpy(frame.data, msg.Data, msg.DataLen);
+    _ingress.push(frame);
+  }
+}
+
+void NMEA2000Service::publishN2kMessage(const tN2kMsg& msg) {
+  if (_config.rxEnabled) {
+    if (_sentenceRepeaters.size() > 0) {
+      // Encode the message once for all the repeaters.
+      NMEAEncodedMessage pcdin = NMEAEncodedMessage::allocate(NMEAEncodedMessage::NMEA2000, 30 + msg.DataLen * 2);
+      if (pcdin.isValid()) {
+        size_t length = N2kToSeasmart(msg, millis(), pcdin.getBuffer(), pcdin.capacity() + 1);
+        if (length > 0 && length <= pcdin.capacity()) {
+          pcdin.setLength(length);
+          for (auto it = _sentenceRepeaters.begin(); it != _sentenceRepeaters.end(); it++) {
+            (*it)->repeat(pcdin);
+          }
+        }
+      }
+    }
 
-    for (auto it = _sentenceRepeaters.begin(); it != _sentenceRepeaters.end(); it++) {
+    for (auto it = _messageRepeaters.begin(); it != _messageRepeaters.end(); it++) {
       (*it)->write(msg);
     }
 
-    SKNMEA2000Parser p;
-    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, wallClock.now());
-    if (update.getSize() > 0) {
-      _hub.publish(update);
+    if (_parser.parse(SKSourceInputNMEA2000, msg, wallClock.now(), _update) && _update.getSize() > 0) {
+      _hub.publish(_update);
     }
 
   }
@@ -64,6 +101,10 @@ void NMEA2000Service::setup() {
     // Make sure the CAN transceiver is enabled.
     digitalWrite(can_standby, 0);
 
+    // Must be set before Open(). The library default (32 frames) only
+    // covers ~10ms of a busy bus.
+    NMEA2000.SetN2kCANReceiveFrameBufSize(KBOX_N2K_INGRESS_CAN_FRAMES);
+
 
     if (_config.txEnabled) {
       initializeNMEA2000forReceiveAndTransmit();
@@ -72,7 +113,8 @@ void NMEA2000Service::setup() {
       initializeNMEA2000forReceiveOnly();
     }
   }
-  _hub.subscribe(this);
+  // Never send back on the bus what we received from it.
+  _hub.subscribe(this, SKNMEA2000Converter::subscriptionFilter().excludeSourceInput(SKSourceInputNMEA2000));
 }
 
 bool NMEA2000Service::write(const tN2kMsg& msg) {
@@ -84,6 +126,7 @@ bool NMEA2000Service::write(const tN2kMsg& msg) {
   */
   if (result) {
     KBoxMetrics.event(KBoxEventNMEA2000MessageSent);
+    _busStats.record(msg.PGN, NMEA2000.GetN2kSource(), msg.DataLen, millis());
     return true;
   }
   else {
@@ -95,15 +138,43 @@ bool NMEA2000Service::write(const tN2kMsg& msg) {
 void NMEA2000Service::loop() {
   // Both incoming and outgoing messages are handled by interrupts.
 
-  // Incoming messages are stored in a circular buffer by the NMEA2000 library
-  // Right now this buffer is set to 32 messages. At 100% NMEA2000 bus
-  // capacity, that would mean the buffer would fill in about 10ms so we should
-  // call ParseMessages() at least every 10ms.
+  // Incoming frames are stored under interrupt in a circular buffer of
+  // KBOX_N2K_INGRESS_CAN_FRAMES frames by the NMEA2000 library, which must be
+  // emptied before it overflows.
+  // ParseMessages() only copies the messages in our ingress: it empties the
+  // library buffer quickly whatever the number of messages received.
   NMEA2000.ParseMessages();
+  KBoxMetrics.metric(KBoxMetricNMEA2000IngressDepthCount, _ingress.size());
+
+  // Repeating and decoding takes much longer. Do it for as long as the
+  // budget allows, navigation messages first, and leave the rest for the
+  // next loop.
+  uint32_t start = micros();
+  while (micros() - start < KBOX_N2K_INGRESS_BUDGET_US && _ingress.pop(_rxFrame)) {
+    _rxMessage.Clear();
+    _rxMessage.SetPGN(_rxFrame.pgn);
+    _rxMessage.Priority = _rxFrame.priority;
+    _rxMessage.Source = _rxFrame.source;
+    _rxMessage.Destination = _rxFrame.destination;
+    _rxMessage.MsgTime = _rxFrame.timestamp;
+    _rxMessage.DataLen = _rxFrame.length;
+    memcpy(_rxMessage.Data, _rxFrame.data, _rxFrame.length);
+
+    publishN2kMessage(_rxMessage);
+  }
+
+  // Messages held back by their maximum rate or by the bus budget.
+  if (_config.txEnabled) {
+    _txScheduler.flush(millis());
+  }
 
   if (timeSinceLastParametersSave > 1000) {
     saveNMEA2000Parameters();
     timeSinceLastParametersSave = 0;
+    KBoxMetrics.metric(KBoxMetricNMEA2000TXBusLoadPercent, _txScheduler.busLoad());
+
+    _busStats.expire(millis());
+    KBoxMetrics.metric(KBoxMetricNMEA2000BusLoadPercent, _busStats.busLoad(millis()));
   }
 }
 
@@ -111,7 +182,8 @@ void NMEA2000Service::updateReceived(const SKUpdate& update) {
   if (_config.txEnabled) {
     if (update.getSource().getInput() != SKSourceInputNMEA2000) {
       SKNMEA2000Converter converter;
-      converter.convert(update, *this);
+      converter.convert(update, _txScheduler);
+      _txScheduler.flush(millis());
     }
   }
 }
@@ -189,6 +261,10 @@ void NMEA2000Service::saveNMEA2000Parameters() {
   }
 }
 
-void NMEA2000Service::addSentenceRepeater(SKNMEA2000Output &repeater) {
+void NMEA2000Service::addSentenceRepeater(NMEARepeater &repeater) {
   _sentenceRepeaters.add(&repeater);
+}
+
+void NMEA2000Service::addMessageRepeater(SKNMEA2000Output &repeater) {
+  _messageRepeaters.add(&repeater);
 }
\ No newline at end of file
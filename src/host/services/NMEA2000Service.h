@@ -26,10 +26,15 @@
 
 #include <N2kMsg.h>
 #include <NMEA2000_teensy.h>
+#include "common/nmea/NMEA2000BusStats.h"
+#include "common/nmea/NMEA2000Ingress.h"
+#include "common/nmea/NMEA2000OutputScheduler.h"
+#include "common/nmea/NMEAEncodedMessage.h"
 #include "host/os/Task.h"
 #include "common/signalk/SKHub.h"
 #include "common/signalk/SKSubscriber.h"
 #include "common/signalk/SKNMEA2000Converter.h"
+#include "common/signalk/SKNMEA2000Parser.h"
 #include "host/config/NMEA2000Config.h"
 
 class NMEA2000Service : public Task, public SKSubscriber,
@@ -39,10 +44,23 @@ class NMEA2000Service : public Task, public SKSubscriber,
     SKHub &_hub;
     tNMEA2000_teensy NMEA2000;
     unsigned int _imuSequence;
-    LinkedList<SKNMEA2000Output*> _sentenceRepeaters;
+    LinkedList<NMEARepeater*> _sentenceRepeaters;
+    LinkedList<SKNMEA2000Output*> _messageRepeaters;
+    SKNMEA2000Parser _parser;
+    SKUpdateStatic<SKNMEA2000Parser::MaxValuesPerUpdate> _update;
+    NMEA2000Ingress _ingress;
+    NMEA2000OutputScheduler _txScheduler;
+    NMEA2000BusStats _busStats;
+    NMEA2000Frame _rxFrame;
+    tN2kMsg _rxMessage;
 
     void sendN2kMessage(const tN2kMsg& msg);
 
+    /**
+     * Repeats and decodes one message received from the bus.
+     */
+    void publishN2kMessage(const tN2kMsg& msg);
+
     /**
      * Will initialize NMEA2000 and restore NMEA2000 parameters from persistent
      * storage if available.
@@ -65,13 +83,15 @@ class NMEA2000Service : public Task, public SKSubscriber,
 
   public:
     NMEA2000Service(NMEA2000Config &config, SKHub &hub) :
-      Task("NMEA2000"), _config(config), _hub(hub), _imuSequence(0) {};
+      Task("NMEA2000"), _config(config), _hub(hub), _imuSequence(0),
+      _txScheduler(config.output, *this) {};
 
     void setup();
     void loop();
 
-    // Helper for the handler who is not a part of this class
-    void publishN2kMessage(const tN2kMsg& msg);
+    // Helper for the handler who is not a part of this class. The message
+    // is queued and processed in loop().
+    void receiveN2kMessage(const tN2kMsg& msg);
 
     // SKNMEA2000Output
     bool write(const tN2kMsg&) override;
@@ -79,9 +99,21 @@ class NMEA2000Service : public Task, public SKSubscriber,
     void updateReceived(const SKUpdate& update);
 
     /**
-     * All incoming NMEA2000 messages will be repeated to repeaters.
-     *
-     * @param repeater A reference to an object that implements SKNMEA2000Output.
+     * All incoming NMEA2000 messages will be repeated to repeaters, as
+     * PCDIN sentences encoded once for all of them.
+     */
+    void addSentenceRepeater(NMEARepeater &repeater);
+
+    /**
+     * All incoming NMEA2000 messages will also be written, as they are, to
+     * these outputs.
+     */
+    void addMessageRepeater(SKNMEA2000Output &repeater);
+
+    /**
+     * Traffic seen on the bus (received and sent) by PGN and source.
      */
-    void addSentenceRepeater(SKNMEA2000Output &repeater);
+    const NMEA2000BusStats& getBusStats() const {
+      return _busStats;
+    };
 };
@@ -27,14 +27,15 @@
 
 #include <KBoxLogging.h>
 #include <KBoxHardware.h>
-#include <Seasmart.h>
-#include <ArduinoJson.h>
+#include <N2kMsg.h>
 #include "common/time/WallClock.h"
-#include "common/time/WallClock.h"
-#include "common/signalk/SKJSONVisitor.h"
+
+// A clock record is added at least every minute so that the wall clock time
+// of the binary NMEA2000 records follows the corrections of the wall clock.
+static const uint32_t ClockRecordInterval = 60000;
 
 SDLoggingService::SDLoggingService(const SDLoggingConfig &config, SKHub &hub) :
-  Task("SDCard"), _config(config), _hub(hub) {
+  Task("SDCard"), _config(config), _hub(hub), _jsonWriter("self") {
 }
 
 static void dateTime(uint16_t* date, uint16_t* time) {
@@ -108,6 +109,10 @@ void SDLoggingService::loop() {
     }
   }
 
+  // Binary records are only written when a sector is full or has waited a
+  // second, so they can follow text lines received after them.
+  _n2kSector.poll(logFile, millis());
+
   for (LinkedList<Loggable>::iterator it = receivedMessages.begin(); it != receivedMessages.end(); it++) {
     logFile.print(it->_timestamp.getTime());
     if (it->_timestamp.hasMilliseconds() && it->_timestamp.getMilliseconds() != 0) {
@@ -125,7 +130,12 @@ void SDLoggingService::loop() {
     logFile.print(";");
     logFile.print(it->_source);
     logFile.print(";");
-    logFile.print(it->_message);
+    if (it->_encodedMessage.isValid()) {
+      logFile.write(it->_encodedMessage.c_str(), it->_encodedMessage.length());
+    }
+    else {
+      logFile.print(it->_message);
+    }
     logFile.println();
   }
   // Force data to SD and update the directory entry to avoid data loss.
@@ -156,6 +166,8 @@ void SDLoggingService::createLogFile(const String& fileName) {
   }
 
   logFile = KBox.getSdFat().open(fileName, O_CREAT | O_WRITE | O_EXCL);
+  _n2kSector.reset(millis());
+  _clockWritten = false;
   if (!logFile) {
     DEBUG("Error while opening file '%s'", fileName.c_str());
   }
@@ -185,31 +197,48 @@ String SDLoggingService::getLogFileName() {
   return String(name);
 }
 
-bool SDLoggingService::write(const SKNMEASentence &nmeaSentence) {
-  if (!isLogging() || !_config.logNMEA) {
-    return true;
+void SDLoggingService::repeat(const NMEAEncodedMessage &message) {
+  if (!isLogging()) {
+    return;
   }
 
-  receivedMessages.add(Loggable("N", nmeaSentence, wallClock.now()));
-  return true;
+  if (message.getType() == NMEAEncodedMessage::NMEA0183 && _config.logNMEA) {
+    receivedMessages.add(Loggable("N", message, wallClock.now()));
+  }
+  if (message.getType() == NMEAEncodedMessage::NMEA2000 && _config.logNMEA2000 && !_config.logNMEA2000Binary) {
+    receivedMessages.add(Loggable("P", message, wallClock.now()));
+  }
 }
 
 bool SDLoggingService::write(const tN2kMsg &msg) {
-  if (!isLogging() || !_config.logNMEA2000) {
-    return true;
+  if (!isLogging() || !_config.logNMEA2000 || !_config.logNMEA2000Binary) {
+    return false;
   }
-
-  if (msg.DataLen > 500) {
+  if (msg.DataLen < 0 || (size_t)msg.DataLen > NMEA2000Frame::MaxDataLength) {
     return false;
   }
 
-  char pcdin[30 + msg.DataLen * 2];
-  if (N2kToSeasmart(msg, wallClock.now().getTime(), pcdin, sizeof(pcdin)) < sizeof(pcdin)) {
-    receivedMessages.add(Loggable("P", pcdin, wallClock.now()));
-    return true;
-  } else {
-    return false;
+  uint32_t now = millis();
+  if (!_clockWritten || now - _lastClockTime > ClockRecordInterval) {
+    SKTime time = wallClock.now();
+    uint64_t wallClockMs = (uint64_t)time.getTime() * 1000
+                           + (time.hasMilliseconds() ? time.getMilliseconds() : 0);
+    if (!_n2kSector.appendClock(logFile, wallClockMs, now, now)) {
+      return false;
+    }
+    _clockWritten = true;
+    _lastClockTime = now;
   }
+
+  NMEA2000Frame frame;
+  frame.pgn = msg.PGN;
+  frame.timestamp = msg.MsgTime;
+  frame.priority = msg.Priority;
+  frame.source = msg.Source;
+  frame.destination = msg.Destination;
+  frame.length = msg.DataLen;
+  memcpy(frame.data, msg.Data, msg.DataLen);
+  return _n2kSector.appendMessage(logFile, frame, now);
 }
 
 void SDLoggingService::updateReceived(const SKUpdate &update) {
@@ -235,14 +264,10 @@ void SDLoggingService::updateReceived(const SKUpdate &update) {
     return;
   }
 
-  StaticJsonBuffer<1024> jsonBuffer;
-  SKJSONVisitor jsonVisitor("self", jsonBuffer);
-  JsonObject &jsonData = jsonVisitor.processUpdate(update);
-
-  String jsonString;
-  jsonData.printTo(jsonString);
+  char json[1024];
+  _jsonWriter.write(update, json, sizeof(json));
 
-  receivedMessages.add(Loggable("I", jsonString, wallClock.now()));
+  receivedMessages.add(Loggable("I", json, wallClock.now()));
 }
 
 void SDLoggingService::rotateLogfile() {
@@ -250,6 +275,7 @@ void SDLoggingService::rotateLogfile() {
     return;
   }
 
+  _n2kSector.flush(logFile, millis());
   _freeSpaceAtBoot = _freeSpaceAtBoot - logFile.fileSize();
   logFile.close();
 }
@@ -26,10 +26,12 @@
 
 #include <SdFat.h>
 #include <KBoxLogging.h>
-#include "common/signalk/SKNMEAOutput.h"
+#include "common/nmea/NMEA2000LogFormat.h"
+#include "common/nmea/NMEAEncodedMessage.h"
 #include "common/signalk/SKNMEA2000Output.h"
 #include "common/signalk/SKSubscriber.h"
 #include "common/signalk/SKHub.h"
+#include "common/signalk/SKJSONWriter.h"
 #include "common/signalk/SKTime.h"
 #include "common/algo/List.h"
 #include "host/os/Task.h"
@@ -38,19 +40,25 @@
 class Loggable {
   public:
     Loggable(String s, String m, SKTime timestamp) : _source(s), _message(m), _timestamp(timestamp) {};
+    Loggable(String s, const NMEAEncodedMessage &m, SKTime timestamp) :
+      _source(s), _encodedMessage(m), _timestamp(timestamp) {};
     String _source;
     String _message;
+    // Repeated NMEA messages are shared with the other outputs instead of
+    // being copied in _message.
+    NMEAEncodedMessage _encodedMessage;
     SKTime _timestamp;
 };
 
-class SDLoggingService : public Task, public SKNMEAOutput, public SKNMEA2000Output, public SKSubscriber,
-  public KBoxLogger {
+class SDLoggingService : public Task, public NMEARepeater, public SKSubscriber,
+  public SKNMEA2000Output, public KBoxLogger {
   private:
     uint64_t _freeSpaceAtBoot;
     File logFile;
     bool cardReady = false;
     const SDLoggingConfig &_config;
     SKHub &_hub;
+    SKJSONWriter _jsonWriter;
     // Limit log size to 1 GB.
     static const uint32_t MaximumLogSize = 1024 * 1024 * 1024 * 1;
     // We will not log if free space is below 100 kB
@@ -62,6 +70,11 @@ class SDLoggingService : public Task, public SKNMEAOutput, public SKNMEA2000Outp
 
     LinkedList<Loggable> receivedMessages;
 
+    // Binary NMEA2000 records are written to the file one sector at a time.
+    NMEA2000LogSector _n2kSector;
+    bool _clockWritten = false;
+    uint32_t _lastClockTime = 0;
+
   public:
     SDLoggingService(const SDLoggingConfig &config, SKHub &hub);
     virtual ~SDLoggingService() = default;
@@ -76,8 +89,9 @@ class SDLoggingService : public Task, public SKNMEAOutput, public SKNMEA2000Outp
     bool isLogging();
     String getLogFileName();
 
-    bool write(const SKNMEASentence &nmeaSentence) override;
-    bool write(const tN2kMsg &m) override;
+    void repeat(const NMEAEncodedMessage &message) override;
+    // Binary logging of NMEA2000 messages
+    bool write(const tN2kMsg &msg) override;
     void updateReceived(const SKUpdate &update) override;
 
     void startLogging();
@@ -27,123 +27,115 @@
 #include <KBoxLogging.h>
 #include <Arduino.h>
 #include <KBoxHardware.h>
+#include "common/nmea/NMEADuplicateFilter.h"
 #include "common/signalk/SKNMEAConverter.h"
 #include "common/signalk/SKNMEAParser.h"
 
+// AIS targets received on both serial ports.
+static AISTargetTable aisTargets;
 
-// Linked list used to buffer messages
-static LinkedList<SKNMEASentence> *received2 = 0;
-static LinkedList<SKNMEASentence> *received3 = 0;
+// Sentences recently received on both serial ports.
+static NMEADuplicateFilter duplicateSentences;
 
-// This is called by yield() whenever data is available.
-// We move received data into a linked list of NMEA sentences.
-void serialEvent2() {
-  static uint8_t buffer[MAX_NMEA_SENTENCE_LENGTH];
-  static int index = 0;
+typedef NMEASentenceRing<16> SerialSentenceRing;
 
-  if (received2 == 0) {
-    return;
-  }
+/*
+ * Sentences received on one serial port.
+ *
+ * serialEvent2/3 (the producers) are called by yield() whenever data is
+ * available. They assemble the bytes in sentences and push them in the ring
+ * that SerialService::loop() (the consumer) empties.
+ *
+ * At 38400 baud, a port receives at most ~45 sentences per second so the
+ * ring can hold about 350ms of traffic while the other tasks are running.
+ */
+class SerialReceiver {
+  private:
+    HardwareSerial &_serial;
+    enum KBoxEvent _bufferOverflowEvent, _overflowEvent, _errorEvent;
+    char _buffer[SerialSentenceRing::MaxSentenceLength];
+    size_t _index = 0;
 
-  // 64 is the RX_BUFFER_SIZE defined in serial2.c (teensy3 framework)
-  if (Serial2.available() == 64) {
-    KBoxMetrics.event(KBoxEventNMEA1RXBufferOverflow);
-    DEBUG("serialEvent2 found a full rx buffer - we probably lost some data");
-  }
+  public:
+    SerialSentenceRing ring;
+    bool enabled = false;
 
-  while (Serial2.available()) {
-    buffer[index++]= (uint8_t) Serial2.read();
+    SerialReceiver(HardwareSerial &serial, enum KBoxEvent bufferOverflowEvent,
+                   enum KBoxEvent overflowEvent, enum KBoxEvent errorEvent) :
+      _serial(serial), _bufferOverflowEvent(bufferOverflowEvent),
+      _overflowEvent(overflowEvent), _errorEvent(errorEvent) {};
 
-    // Check if we are at the end of the buffer
-    // The -1 is because we need space to add a terminating NULL character.
-    if (index >= MAX_NMEA_SENTENCE_LENGTH - 1) {
-      buffer[MAX_NMEA_SENTENCE_LENGTH - 1] = 0;
-      DEBUG("Discarding incomplete sequence: %s", buffer);
-      index = 0;
-      KBoxMetrics.event(KBoxEventNMEA1RXError);
-    }
-    else {
-      // Check if we have reached end of sentence
-      if (buffer[index-1] == '\r' || buffer[index-1] == '\n') {
-        if (index > 1) {
-          // Only send message if it's greater than 0 bytes.
-          // And we know that index is < MAX_NMEA_SENTENCE_LENGTH
-          // because we tested buffer.
-          buffer[index-1] = 0;
-          SKNMEASentence s((char*)buffer);
-          received2->add(s);
-        }
-        // Start again from scratch
-        index = 0;
-      }
-    }
-  }
-}
+    void receive();
+};
 
-void serialEvent3() {
-  static uint8_t buffer[MAX_NMEA_SENTENCE_LENGTH];
-  static int index = 0;
-
-  if (received3 == 0) {
+void SerialReceiver::receive() {
+  if (!enabled) {
     return;
   }
 
-  // 64 is the RX_BUFFER_SIZE defined in serial3.c (teensy3 framework)
-  if (Serial3.available() == 64) {
-    KBoxMetrics.event(KBoxEventNMEA2RXBufferOverflow);
-    DEBUG("serialEvent3 found a full rx buffer - we probably lost some data");
+  // 64 is the RX_BUFFER_SIZE defined in serial2.c/serial3.c (teensy3 framework)
+  if (_serial.available() == 64) {
+    KBoxMetrics.event(_bufferOverflowEvent);
+    DEBUG("serialEvent found a full rx buffer - we probably lost some data");
   }
 
-  while (Serial3.available()) {
-    buffer[index++]= (uint8_t) Serial3.read();
+  while (_serial.available()) {
+    _buffer[_index++] = (char) _serial.read();
 
     // Check if we are at the end of the buffer
     // The -1 is because we need space to add a terminating NULL character.
-    if (index >= MAX_NMEA_SENTENCE_LENGTH - 1) {
-      buffer[MAX_NMEA_SENTENCE_LENGTH - 1] = 0;
-      DEBUG("Discarding incomplete sequence: %s", buffer);
-      index = 0;
-      KBoxMetrics.event(KBoxEventNMEA2RXError);
+    if (_index >= sizeof(_buffer) - 1) {
+      _buffer[sizeof(_buffer) - 1] = 0;
+      DEBUG("Discarding incomplete sequence: %s", _buffer);
+      _index = 0;
+      KBoxMetrics.event(_errorEvent);
     }
     else {
       // Check if we have reached end of sentence
-      if (buffer[index-1] == '\r' || buffer[index-1] == '\n') {
-        if (index > 1) {
-          // Only send message if it's greater than 0 bytes.
-          // And we know that index is < MAX_NMEA_SENTENCE_LENGTH
-          // because we tested buffer.
-          buffer[index-1] = 0;
-          SKNMEASentence s((char*)buffer);
-          received3->add(s);
+      if (_buffer[_index-1] == '\r' || _buffer[_index-1] == '\n') {
+        // Only queue sentences that are greater than 0 bytes.
+        if (_index > 1 && !ring.push(_buffer, _index - 1, millis())) {
+          KBoxMetrics.event(_overflowEvent);
         }
         // Start again from scratch
-        index = 0;
+        _index = 0;
       }
     }
   }
 }
 
-SerialService::SerialService(SerialConfig &config, SKHub &hub, HardwareSerial &s) : Task("NMEA Service"), _config(config), _hub(hub), stream(s) {
+static SerialReceiver receiver2(Serial2, KBoxEventNMEA1RXBufferOverflow,
+                                KBoxEventNMEA1RXOverflow, KBoxEventNMEA1RXError);
+static SerialReceiver receiver3(Serial3, KBoxEventNMEA2RXBufferOverflow,
+                                KBoxEventNMEA2RXOverflow, KBoxEventNMEA2RXError);
+
+void serialEvent2() {
+  receiver2.receive();
+}
+
+void serialEvent3() {
+  receiver3.receive();
+}
+
+SerialService::SerialService(SerialConfig &config, SKHub &hub, HardwareSerial &s) : Task("NMEA Service"), _config(config), _hub(hub), stream(s), _receiver(0), _txScheduler(0), _parser(config.nmeaParser), _aisParser(aisTargets) {
   if (&s == &Serial2) {
-    if (_config.inputMode == SerialModeNMEA) {
-      received2 = &receiveQueue;
-    }
+    _receiver = &receiver2;
     _taskName = "Serial Service 1";
     _rxValidEvent = KBoxEventNMEA1RX;
     _rxErrorEvent = KBoxEventNMEA1RXError;
-    _txValidEvent = KBoxEventNMEA1TX;
-    _txOverflowEvent = KBoxEventNMEA1TXOverflow;
+    _rxDuplicateEvent = KBoxEventNMEA1RXDuplicate;
+    _txScheduler = new NMEAOutputScheduler(config.nmeaOutput, config.baudRate, KBoxEventNMEA1TX,
+                                           KBoxEventNMEA1TXOverflow, KBoxEventNMEA1TXCoalesced);
     _skSourceInput = SKSourceInputNMEA0183_1;
   }
   if (&s == &Serial3) {
-    if (_config.inputMode == SerialModeNMEA) {
-      received3 = &receiveQueue;
-    }
+    _receiver = &receiver3;
     _taskName = "Serial Service 2";
     _rxValidEvent = KBoxEventNMEA2RX;
     _rxErrorEvent = KBoxEventNMEA2RXError;
-    _txValidEvent = KBoxEventNMEA2TX;
-    _txOverflowEvent = KBoxEventNMEA2TXOverflow;
+    _rxDuplicateEvent = KBoxEventNMEA2RXDuplicate;
+    _txScheduler = new NMEAOutputScheduler(config.nmeaOutput, config.baudRate, KBoxEventNMEA2TX,
+                                           KBoxEventNMEA2TXOverflow, KBoxEventNMEA2TXCoalesced);
     _skSourceInput = SKSourceInputNMEA0183_2;
   }
 }
@@ -168,67 +160,97 @@ void SerialService::setup() {
           _config.outputMode == SerialModeNMEA ? "true" : "false");
   }
 
-  _hub.subscribe(this);
+  _hub.subscribe(this, SKNMEAConverter::subscriptionFilter(_config.nmeaConverter));
+
+  if (_receiver && _config.inputMode == SerialModeNMEA) {
+    // Allocate the String used to pass sentences to the repeaters once.
+    _rxSentence.reserve(SerialSentenceRing::MaxSentenceLength);
+    _receiver->enabled = true;
+  }
 }
 
 void SerialService::loop() {
-  if (receiveQueue.size() == 0) {
+  if (_txScheduler) {
+    _txScheduler->flush(stream, stream.availableForWrite(), millis());
+  }
+
+  if (_receiver == 0 || _receiver->ring.size() == 0) {
     return;
   }
   // Send all queue sentences
   DEBUG("Serial[%i]: Found %i sentences waiting",
         _skSourceInput == SKSourceInputNMEA0183_1 ? 1 : 2,
-        receiveQueue.size());
-  for (auto it = receiveQueue.begin(); it != receiveQueue.end(); it++) {
-    if (it->isValid()) {
+        _receiver->ring.size());
+
+  const SerialSentenceRing::Slot *slot;
+  while ((slot = _receiver->ring.peek()) != nullptr) {
+    _rxSentence = slot->sentence;
+    uint32_t received = slot->timestamp;
+    _receiver->ring.pop();
+
+    if (_rxSentence.isValid()) {
       KBoxMetrics.event(_rxValidEvent);
 
-      // Repeat the sentence to all registered repeaters.
-      for (auto repeater = _repeaters.begin(); repeater != _repeaters.end(); repeater++) {
-        (*repeater)->write(*it);
+      // The same instrument connected to both ports: the other port already
+      // repeated and parsed this sentence.
+      if (_config.suppressDuplicates
+          && duplicateSentences.isDuplicate(_skSourceInput, _rxSentence.c_str(), _rxSentence.length(), received)) {
+        KBoxMetrics.event(_rxDuplicateEvent);
+        continue;
+      }
+
+      // Repeat the sentence to all registered repeaters. It is copied once
+      // and shared by all of them.
+      if (_repeaters.size() > 0) {
+        NMEAEncodedMessage message = NMEAEncodedMessage::fromSentence(_rxSentence.c_str(), _rxSentence.length());
+        if (message.isValid()) {
+          for (auto repeater = _repeaters.begin(); repeater != _repeaters.end(); repeater++) {
+            (*repeater)->repeat(message);
+          }
+        }
       }
 
-      SKNMEAParser p;
       //FIXME: Get the time properly here!
-      const SKUpdate &update = p.parse(_skSourceInput, *it, SKTime(0));
-      if (update.getSize() > 0) {
-        _hub.publish(update);
+      if (_rxSentence[0] == '!') {
+        if (_config.nmeaParser.ais) {
+          const SKUpdate &aisUpdate = _aisParser.parse(_skSourceInput, _rxSentence, SKTime(0), received);
+          if (aisUpdate.getSize() > 0) {
+            _hub.publish(aisUpdate);
+          }
+        }
+      }
+      else if (_parser.parse(_skSourceInput, _rxSentence, SKTime(0), _update) && _update.getSize() > 0) {
+        _hub.publish(_update);
       }
     }
     else {
-      DEBUG("Invalid NMEA sentence: %s", (*it).c_str());
+      DEBUG("Invalid NMEA sentence: %s", _rxSentence.c_str());
       KBoxMetrics.event(_rxErrorEvent);
     }
   }
-  // FIXME: the current linked list implementation would probably continue to
-  // work if some data is added while we are running this loop but it would be
-  // best if we had a clearer contract or a better way to manage this.
-  receiveQueue.clear();
 }
 
 void SerialService::updateReceived(const SKUpdate &update) {
-  if (_config.outputMode == SerialModeNMEA) {
+  if (_config.outputMode == SerialModeNMEA && _txScheduler) {
     SKNMEAConverter nmeaConverter(_config.nmeaConverter);
     nmeaConverter.convert(update, *this);
+
+    // Start sending right away if the port is idle.
+    _txScheduler->flush(stream, stream.availableForWrite(), millis());
   }
 }
 
-bool SerialService::write(const SKNMEASentence &nmeaSentence) {
-  DEBUG("Writing NMEA to Serial[%i] output: %s",
+/*
+ * Sentences are not written directly: they wait in the scheduler until there
+ * is room for them on the port.
+ */
+bool SerialService::write(const NMEAFixedSentence &nmeaSentence) {
+  DEBUG("Queuing NMEA for Serial[%i] output: %s",
         _skSourceInput == SKSourceInputNMEA0183_1 ? 1 : 2,
         nmeaSentence.c_str());
-  if ((size_t)stream.availableForWrite() >= nmeaSentence.length() + 2) {
-    stream.write(nmeaSentence.c_str());
-    stream.write("\r\n");
-    KBoxMetrics.event(_txValidEvent);
-    return true;
-  }
-  else {
-    KBoxMetrics.event(_txOverflowEvent);
-    return false;
-  }
+  return _txScheduler->enqueue(nmeaSentence.c_str(), nmeaSentence.length(), millis());
 }
 
-void SerialService::addRepeater(SKNMEAOutput &repeater) {
+void SerialService::addRepeater(NMEARepeater &repeater) {
   _repeaters.add(&repeater);
 }
\ No newline at end of file
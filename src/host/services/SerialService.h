@@ -24,28 +24,37 @@
 #pragma once
 
 #include "common/algo/List.h"
+#include "common/nmea/NMEAEncodedMessage.h"
+#include "common/nmea/NMEAOutputScheduler.h"
+#include "common/nmea/NMEASentenceRing.h"
 #include "common/signalk/SKSubscriber.h"
 #include "common/signalk/SKNMEAOutput.h"
 #include "common/stats/KBoxMetrics.h"
 #include "common/signalk/SKSource.h"
 #include "common/signalk/SKHub.h"
+#include "common/signalk/SKAISParser.h"
+#include "common/signalk/SKNMEAParser.h"
+#include "common/signalk/SKNMEASentence.h"
 #include "host/os/Task.h"
 #include "host/config/SerialConfig.h"
 
-// Defined by the NMEA Standard
-#define MAX_NMEA_SENTENCE_LENGTH 83
-
 class HardwareSerial;
+class SerialReceiver;
 
 class SerialService : public Task, public SKSubscriber, private SKNMEAOutput {
   private:
     SerialConfig &_config;
     SKHub &_hub;
     HardwareSerial& stream;
-    LinkedList<SKNMEASentence> receiveQueue;
-    enum KBoxEvent _rxValidEvent, _rxErrorEvent, _txValidEvent, _txOverflowEvent;
+    SerialReceiver *_receiver;
+    SKNMEASentence _rxSentence;
+    NMEAOutputScheduler *_txScheduler;
+    enum KBoxEvent _rxValidEvent, _rxErrorEvent, _rxDuplicateEvent;
     SKSourceInput _skSourceInput;
-    LinkedList<SKNMEAOutput*> _repeaters;
+    LinkedList<NMEARepeater*> _repeaters;
+    SKNMEAParser _parser;
+    SKAISParser _aisParser;
+    SKUpdateStatic<SKNMEAParser::MaxValuesPerUpdate> _update;
 
   public:
     SerialService(SerialConfig &_config, SKHub &hub, HardwareSerial&s);
@@ -53,7 +62,7 @@ class SerialService : public Task, public SKSubscriber, private SKNMEAOutput {
     void setup();
     void loop();
     void updateReceived(const SKUpdate&) override;
-    bool write(const SKNMEASentence& nmeaSentence) override;
-    void addRepeater(SKNMEAOutput &repeater);
+    bool write(const NMEAFixedSentence& nmeaSentence) override;
+    void addRepeater(NMEARepeater &repeater);
 };
 
@@ -35,7 +35,7 @@
 #include "common/signalk/SKUpdate.h"
 
 TimeService::TimeService(SKHub &skHub) {
-  skHub.subscribe(this);
+  skHub.subscribe(this, SKSubscriptionFilter().addPath(SKPathNavigationDatetime));
 }
 
 void TimeService::updateReceived(const SKUpdate &update) {
@@ -25,7 +25,6 @@
 #include <Arduino.h>
 #include <KBoxLogging.h>
 #include <KBoxHardware.h>
-#include <Seasmart.h>
 #include "common/comms/Kommand.h"
 #include "common/stats/KBoxMetrics.h"
 #include "common/signalk/SKNMEAConverter.h"
@@ -46,7 +45,8 @@ USBService::USBService(GC &gc, SKHub &hub) : Task("USBService"), _slip(Serial, 2
 
 void USBService::setup() {
   Serial.setTimeout(0);
-  _skHub.subscribe(this);
+  SKNMEAConverterConfig config;
+  _skHub.subscribe(this, SKNMEAConverter::subscriptionFilter(config));
 }
 
 void USBService::log(enum KBoxLoggingLevel level, const char *fname, int lineno, const char *fmt, va_list fmtargs) {
@@ -126,7 +126,7 @@ void USBService::loopConnectedFrame() {
 
     KommandHandler *handlers[] = { &_pingHandler, &_screenshotHandler,
                                    &_fileReadHandler, &_fileWriteHandler,
-                                   &_rebootHandler,
+                                   &_rebootHandler, &_busStatsHandler,
                                    nullptr };
     if (KommandHandler::handleKommandWithHandlers(handlers, kr, _slip)) {
       KBoxMetrics.event(KBoxEventUSBValidKommand);
@@ -221,7 +221,7 @@ void USBService::updateReceived(const SKUpdate& u) {
   }
 }
 
-bool USBService::write(const SKNMEASentence &nmeaSentence) {
+bool USBService::write(const NMEAFixedSentence &nmeaSentence) {
   if (_state != ConnectedNMEAInterface) {
     return true;
   }
@@ -230,21 +230,11 @@ bool USBService::write(const SKNMEASentence &nmeaSentence) {
   return true;
 }
 
-bool USBService::write(const tN2kMsg &msg) {
+void USBService::repeat(const NMEAEncodedMessage &message) {
   if (_state != ConnectedNMEAInterface) {
-    return true;
-  }
-
-  if (msg.DataLen > 500) {
-    return false;
+    return;
   }
 
-  char pcdin[30 + msg.DataLen * 2];
-  if (N2kToSeasmart(msg, millis(), pcdin, sizeof(pcdin)) < sizeof(pcdin)) {
-    Serial.println(pcdin);
-    return true;
-  } else {
-    return false;
-  }
+  Serial.println(message.c_str());
 }
 
@@ -26,12 +26,13 @@
 
 #include <KBoxLogging.h>
 #include <KBoxLoggerStream.h>
-#include <common/signalk/SKNMEA2000Output.h>
 #include "common/comms/SlipStream.h"
 #include "common/ui/GC.h"
 #include "common/comms/SlipStream.h"
+#include "common/comms/KommandHandlerNMEA2000BusStats.h"
 #include "common/comms/KommandHandlerPing.h"
 #include "common/comms/KommandHandlerScreenshot.h"
+#include "common/nmea/NMEAEncodedMessage.h"
 #include "common/signalk/SKHub.h"
 #include "common/signalk/SKSubscriber.h"
 #include "common/signalk/SKNMEAOutput.h"
@@ -41,7 +42,7 @@
 #include "host/comms/KommandHandlerReboot.h"
 
 class USBService : public Task, public KBoxLogger, public SKSubscriber,
-                   public SKNMEAOutput, public SKNMEA2000Output {
+                   public SKNMEAOutput, public NMEARepeater {
   private:
     static const size_t MaxLogFrameSize = 256;
 
@@ -53,6 +54,7 @@ class USBService : public Task, public KBoxLogger, public SKSubscriber,
     KommandHandlerFileRead _fileReadHandler;
     KommandHandlerFileWrite _fileWriteHandler;
     KommandHandlerReboot _rebootHandler;
+    KommandHandlerNMEA2000BusStats _busStatsHandler;
 
     enum USBConnectionState{
       ConnectedDebug,
@@ -79,6 +81,13 @@ class USBService : public Task, public KBoxLogger, public SKSubscriber,
              const char *fmt, va_list args) override;
     void updateReceived(const SKUpdate& u);
 
-    bool write(const SKNMEASentence &nmeaSentence);
-    bool write(const tN2kMsg&);
+    bool write(const NMEAFixedSentence &nmeaSentence);
+    void repeat(const NMEAEncodedMessage &message) override;
+
+    /**
+     * Statistics returned by KommandNMEA2000BusStats.
+     */
+    void setNMEA2000BusStats(const NMEA2000BusStats &stats) {
+      _busStatsHandler.setBusStats(stats);
+    };
 };
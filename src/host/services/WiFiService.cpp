@@ -26,14 +26,13 @@
 
 #include <KBoxLogging.h>
 #include <KBoxHardware.h>
-#include <Seasmart.h>
 #include "common/signalk/SKNMEAConverter.h"
-#include "common/signalk/SKJSONVisitor.h"
 #include "common/stats/KBoxMetrics.h"
 
 WiFiService::WiFiService(const WiFiConfig &config, SKHub &skHub, GC &gc) :
   Task("WiFi"), _config(config), _hub(skHub), _slip(WiFiSerial, 2048),
-  _wifiStatusHandler(*this), _espState(ESPState::ESPStarting), _dhcpClients(0)
+  _wifiStatusHandler(*this), _espState(ESPState::ESPStarting), _dhcpClients(0), _signalkClients(0),
+  _jsonWriter(config.vesselURN)
 {
   // We will need gc at some point to be able to take screenshot
 }
@@ -58,7 +57,13 @@ void WiFiService::loop() {
 
     KommandHandler *handlers[] = { &_pingHandler, &_wifiLogHandler,
                                    &_wifiStatusHandler, 0 };
-    if (KommandHandler::handleKommandWithHandlers(handlers, kr, _slip)) {
+    if (kr.getKommandIdentifier() == KommandSKUnknownReference) {
+      // The ESP lost a source or index definition: send them all again.
+      _deltaEncoder.reset();
+      KBoxMetrics.event(KBoxEventWiFiRxValidKommand);
+      KBoxMetrics.event(KBoxEventWiFiSKDefinitionsRequested);
+    }
+    else if (KommandHandler::handleKommandWithHandlers(handlers, kr, _slip)) {
       if (kr.getKommandIdentifier() == KommandErr) {
         KBoxMetrics.event(KBoxEventWiFiRxErrorFrame);
       }
@@ -97,7 +102,7 @@ void WiFiService::loop() {
   }
 }
 
-void WiFiService::sendKommand(Kommand &k) {
+void WiFiService::sendKommand(const Kommand &k) {
   _slip.writeFrame(k.getBytes(), k.getSize());
   KBoxMetrics.event(KBoxEventWiFiTxFrame);
 }
@@ -115,17 +120,29 @@ void WiFiService::updateReceived(const SKUpdate& u) {
   // The converter will call this->write(NMEASentence) for every generated sentence
   nmeaConverter.convert(u, *this);
 
-  // Now send in JSON format
-  StaticJsonBuffer<1024> jsonBuffer;
-  SKJSONVisitor jsonVisitor(_config.vesselURN, jsonBuffer);
-  JsonObject &jsonData = jsonVisitor.processUpdate(u);
+  // The ESP reports the number of SignalK clients every 500ms. Do not bother
+  // sending SignalK data when nobody is listening.
+  if (_signalkClients == 0) {
+    return;
+  }
+
+  // Now send in binary format. The ESP will convert it to JSON.
+  if (_deltaEncoder.encode(u, *this)) {
+    return;
+  }
+
+  // Updates that do not fit in a KommandSKDelta are sent in JSON format
   FixedSizeKommand<1024> k(KommandSKData);
-  jsonData.printTo(k);
+  _jsonWriter.write(u, k);
   k.write(0);
   sendKommand(k);
 }
 
-bool WiFiService::write(const SKNMEASentence& sentence) {
+void WiFiService::write(Kommand &k) {
+  sendKommand(k);
+}
+
+bool WiFiService::write(const NMEAFixedSentence& sentence) {
   // NMEA Sentences should always be 82 bytes or less
   FixedSizeKommand<100> k(KommandNMEASentence);
   k.appendNullTerminatedString(sentence.c_str());
@@ -133,22 +150,9 @@ bool WiFiService::write(const SKNMEASentence& sentence) {
   return true;
 }
 
-bool WiFiService::write(const tN2kMsg& msg) {
-  // PCDIN sentences should have a similar size as NMEA sentences.
-  FixedSizeKommand<500> k(KommandNMEASentence);
-
-  if (msg.DataLen > 500) {
-    return false;
-  }
-
-  char pcdin[30 + msg.DataLen * 2];
-  if (N2kToSeasmart(msg, millis(), pcdin, sizeof(pcdin)) < 500) {
-    k.appendNullTerminatedString(pcdin);
-    sendKommand(k);
-    return true;
-  } else {
-    return false;
-  }
+void WiFiService::repeat(const NMEAEncodedMessage& message) {
+  // The message already is a KommandNMEASentence.
+  sendKommand(message);
 }
 
 void WiFiService::wiFiStatusUpdated(const ESPState &state, uint16_t dhcpClients,
@@ -157,10 +161,13 @@ void WiFiService::wiFiStatusUpdated(const ESPState &state, uint16_t dhcpClients,
   _espState = state;
   _clientAddress = ipAddress;
   _dhcpClients = dhcpClients;
+  _signalkClients = signalkClients;
 
   switch (state) {
     case ESPState::ESPStarting:
     case ESPState::ESPReady:
+      // The ESP has (re)started and does not know our sources and indexes.
+      _deltaEncoder.reset();
       sendConfiguration();
       break;
 
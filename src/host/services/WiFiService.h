@@ -24,13 +24,15 @@
 #pragma once
 
 #include "common/ui/GC.h"
+#include "common/nmea/NMEAEncodedMessage.h"
 #include "common/signalk/SKNMEAOutput.h"
-#include "common/signalk/SKNMEA2000Output.h"
 #include "common/signalk/SKHub.h"
+#include "common/signalk/SKJSONWriter.h"
 #include "common/signalk/SKSubscriber.h"
 #include "common/comms/Kommand.h"
 #include "common/comms/SlipStream.h"
 #include "common/comms/KommandHandlerPing.h"
+#include "common/comms/SKBinaryDelta.h"
 #include "host/os/Task.h"
 #include "host/comms/KommandHandlerWiFiLog.h"
 #include "host/comms/KommandHandlerWiFiStatus.h"
@@ -40,8 +42,8 @@
  * Manages connection to the ESP module.
  */
 class WiFiService : public Task, public SKSubscriber,
-                    public SKNMEAOutput, public SKNMEA2000Output,
-                    private WiFiStatusObserver {
+                    public SKNMEAOutput, public NMEARepeater,
+                    private WiFiStatusObserver, private SKBinaryDeltaOutput {
   private:
     const WiFiConfig &_config;
     SKHub &_hub;
@@ -50,9 +52,12 @@ class WiFiService : public Task, public SKSubscriber,
     KommandHandlerWiFiLog _wifiLogHandler;
     KommandHandlerWiFiStatus _wifiStatusHandler;
     ESPState _espState;
+    SKBinaryDeltaEncoder _deltaEncoder;
 
     IPAddress _clientAddress;
     uint16_t _dhcpClients;
+    uint16_t _signalkClients;
+    SKJSONWriter _jsonWriter;
 
   public:
     WiFiService(const WiFiConfig &config, SKHub &skHub, GC &gc);
@@ -61,8 +66,8 @@ class WiFiService : public Task, public SKSubscriber,
     void loop();
     void updateReceived(const SKUpdate&) override;
 
-    bool write(const SKNMEASentence& s) override;
-    bool write(const tN2kMsg& m) override;
+    bool write(const NMEAFixedSentence& s) override;
+    void repeat(const NMEAEncodedMessage& message) override;
 
     const bool clientInterfaceEnabled() const;
     const String clientInterfaceNetworkName() const;
@@ -80,7 +85,10 @@ class WiFiService : public Task, public SKSubscriber,
                            uint16_t tcpClients, uint16_t signalkClients,
                            const IPAddress &ipAddress) override;
 
+    // SKBinaryDeltaOutput
+    void write(Kommand &k) override;
+
     void sendConfiguration();
-    void sendKommand(Kommand &k);
+    void sendKommand(const Kommand &k);
 };
 
@@ -32,11 +32,10 @@
 #include <string>
 #include <ctime>
 #include <WString.h>
-#include <ArduinoJson.h>
 #include <Seasmart.h>
 #include "common/signalk/SKNMEAParser.h"
 #include "common/signalk/SKNMEA2000Parser.h"
-#include "common/signalk/SKJSONVisitor.h"
+#include "common/signalk/SKJSONWriter.h"
 
 SKNMEAParser nmeaParser = SKNMEAParser();
 SKNMEA2000Parser nmea2000Parser = SKNMEA2000Parser();
@@ -64,15 +63,15 @@ const SKUpdate& parseInputLine(std::string line) {
 const char *vesselURN = "urn:mrn:kbox:validation-tests";
 
 int main(int argc, char **argv) {
-  DynamicJsonBuffer jsonBuffer;
-  SKJSONVisitor v = SKJSONVisitor(vesselURN, jsonBuffer);
+  SKJSONWriter writer(vesselURN);
+  char json[4096];
 
   for (std::string line; std::getline(std::cin, line); ) {
     const SKUpdate& u = parseInputLine(line);
 
     std::cerr << "Update contains: " << u.getSize() << " values and uses " << u.getSizeBytes() << " bytes." << std::endl;
-    JsonObject &o = v.processUpdate(u);
-    std::cout << o << std::endl;
+    writer.write(u, json, sizeof(json));
+    std::cout << json << std::endl;
   }
 }
 
@@ -83,12 +82,10 @@ extern "C" {
   char jsonStringBuffer[4096];
 
   const char *sktoolConvert(const char *line) {
-    DynamicJsonBuffer jsonBuffer;
-    SKJSONVisitor v = SKJSONVisitor("urn:mrn:kbox:sktooljs", jsonBuffer);
+    static const SKJSONWriter writer("urn:mrn:kbox:sktooljs");
 
     const SKUpdate& u = parseInputLine(line);
-    JsonObject &o = v.processUpdate(u);
-    o.printTo(jsonStringBuffer, sizeof(jsonStringBuffer));
+    writer.write(u, jsonStringBuffer, sizeof(jsonStringBuffer));
     return jsonStringBuffer;
   }
 }
@@ -0,0 +1,70 @@
+/*
+     __  __     ______     ______     __  __
+    /\ \/ /    /\  == \   /\  __ \   /\_\_\_\
+    \ \  _"-.  \ \  __<   \ \ \/\ \  \/_/\_\/_
+     \ \_\ \_\  \ \_____\  \ \_____\   /\_\/\_\
+       \/_/\/_/   \/_____/   \/_____/   \/_/\/_/
+
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+
+/**
+ * Counts the heap allocations made while the tests are running so that a test
+ * can verify that a code path does not use the heap.
+ *
+ *     KBoxTestAllocations allocations;
+ *     parser.parse(...);
+ *     unsigned long count = allocations.total();
+ *     CHECK( count == 0 );
+ *
+ * Note that Catch allocates memory in CHECK() so the counter must be read
+ * before.
+ */
+class KBoxTestAllocations {
+  private:
+    unsigned long _objects;
+    unsigned long _strings;
+
+  public:
+    /**
+     * Start counting allocations from now.
+     */
+    KBoxTestAllocations();
+
+    /**
+     * Number of calls to operator new since this object was created.
+     */
+    unsigned long objects() const;
+
+    /**
+     * Number of String buffer allocations since this object was created.
+     */
+    unsigned long strings() const;
+
+    /**
+     * Total number of heap allocations since this object was created.
+     */
+    unsigned long total() const;
+};
@@ -34,3 +34,6 @@
 #include <Print.h>
 #include <inttypes.h>
 #include <math.h>
+
+// Defined in teensy_compat.c
+extern "C" uint32_t millis();
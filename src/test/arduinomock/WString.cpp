@@ -21,6 +21,9 @@
 
 #include "WString.h"
 
+// Number of buffer allocations made by String objects. Used by the tests to
+// verify that some code does not use the heap. See KBoxTestAllocations.h.
+unsigned long kboxTestStringAllocations = 0;
 
 /*********************************************/
 /*  Constructors                             */
@@ -139,6 +142,7 @@ unsigned char String::reserve(unsigned int size)
 
 unsigned char String::changeBuffer(unsigned int maxStrLen)
 {
+	kboxTestStringAllocations++;
 	char *newbuffer = (char *)realloc(buffer, maxStrLen + 1);
 	if (newbuffer) {
 		buffer = newbuffer;
@@ -45,6 +45,7 @@ TEST_CASE("KommandReader") {
     CHECK(kr.read8() == 0);
     CHECK(kr.read16() == 0);
     CHECK(kr.read32() == 0);
+    CHECK(kr.read64() == 0);
     CHECK(kr.readNullTerminatedString() == nullptr);
 
     CHECK(kr.dataIndex() == 0);
@@ -80,6 +81,20 @@ TEST_CASE("KommandReader") {
     CHECK(kr.dataIndex() == 11);
   }
 
+  SECTION("Kommand with 64 bits values") {
+    FixedSizeKommand<16> k(KommandSKDelta);
+    k.append64(0x8877665544332211);
+    k.append64(0xffffffff00000001);
+
+    KommandReader kr = KommandReader(k.getBytes(), k.getSize());
+    CHECK(kr.getKommandIdentifier() == KommandSKDelta);
+    CHECK(kr.dataSize() == 16);
+    CHECK(kr.read64() == 0x8877665544332211);
+    CHECK(kr.read64() == 0xffffffff00000001);
+    CHECK(kr.read64() == 0);
+    CHECK(kr.dataIndex() == 16);
+  }
+
   SECTION("Kommand with invalid string") {
     const uint8_t frame[] = {0x2a, 0x00,
                              'a', 'b', 'c', 'd'
@@ -0,0 +1,197 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <vector>
+#include "../KBoxTest.h"
+#include "common/comms/SKBinaryDelta.h"
+#include "common/signalk/SKUnits.h"
+#include "common/signalk/SKUpdateStatic.h"
+
+class TestDeltaOutput : public SKBinaryDeltaOutput {
+  public:
+    std::vector<std::vector<uint8_t>> kommands;
+
+    void write(Kommand &k) override {
+      kommands.push_back(std::vector<uint8_t>(k.getBytes(), k.getBytes() + k.getSize()));
+    };
+
+    uint16_t identifier(int i) const {
+      return KommandReader(kommands[i].data(), kommands[i].size()).getKommandIdentifier();
+    };
+
+    bool decode(SKBinaryDeltaDecoder &decoder, SKUpdate &update) {
+      bool result = true;
+      for (auto k : kommands) {
+        KommandReader kr(k.data(), k.size());
+        if (kr.getKommandIdentifier() == KommandSKDelta) {
+          result = decoder.decodeDelta(kr, update) && result;
+        }
+        else {
+          result = decoder.decodeDefinition(kr) && result;
+        }
+      }
+      return result;
+    };
+};
+
+TEST_CASE("SKBinaryDelta") {
+  SKBinaryDeltaEncoder encoder;
+  SKBinaryDeltaDecoder decoder;
+  TestDeltaOutput output;
+
+  SKUpdateStatic<5> update;
+  update.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "II", "RMC"));
+  update.setTimestamp(SKTime(1497793875, 420));
+  update.setNavigationSpeedOverGround(4.2);
+  update.setNavigationPosition(SKTypePosition(37.81, -122.42, SKDoubleNAN));
+  update.setNavigationAttitude(SKTypeAttitude(0.1, -0.2, 1.3));
+  update.setNavigationDatetime(SKTime(1497793875));
+  update.setElectricalBatteriesVoltage("engine", 12.6);
+
+  SECTION("Round trip") {
+    CHECK( encoder.encode(update, output) );
+
+    SKUpdateStatic<5> decoded;
+    CHECK( output.decode(decoder, decoded) );
+
+    CHECK( decoded.getSource() == update.getSource() );
+    CHECK( decoded.getTimestamp() == update.getTimestamp() );
+    REQUIRE( decoded.getSize() == update.getSize() );
+    for (int i = 0; i < update.getSize(); i++) {
+      CHECK( decoded.getPath(i) == update.getPath(i) );
+      CHECK( decoded.getValue(i).getType() == update.getValue(i).getType() );
+    }
+    CHECK( decoded.getNavigationSpeedOverGround() == 4.2 );
+    CHECK( decoded.getNavigationPosition().latitude == 37.81 );
+    CHECK( decoded.getNavigationPosition().longitude == -122.42 );
+    CHECK( decoded.getNavigationAttitude().yaw == 1.3 );
+    CHECK( decoded.getNavigationDatetime() == SKTime(1497793875) );
+    CHECK( decoded.getElectricalBatteriesVoltage("engine") == 12.6 );
+  }
+
+  SECTION("Sources and indexes are defined once") {
+    CHECK( encoder.encode(update, output) );
+    REQUIRE( output.kommands.size() == 3 );
+    CHECK( output.identifier(0) == KommandSKSource );
+    CHECK( output.identifier(1) == KommandSKIndex );
+    CHECK( output.identifier(2) == KommandSKDelta );
+
+    output.kommands.clear();
+    CHECK( encoder.encode(update, output) );
+    REQUIRE( output.kommands.size() == 1 );
+    CHECK( output.identifier(0) == KommandSKDelta );
+
+    // The delta alone is much smaller than the JSON for the same update.
+    CHECK( output.kommands[0].size() < 150 );
+
+    output.kommands.clear();
+    encoder.reset();
+    CHECK( encoder.encode(update, output) );
+    CHECK( output.kommands.size() == 3 );
+  }
+
+  SECTION("NMEA2000 and sensor sources") {
+    SKUpdateStatic<1> n2k;
+    n2k.setSource(SKSource::sourceForNMEA2000(SKSourceInputNMEA2000, 128267, 3, 42));
+    n2k.setEnvironmentDepthBelowTransducer(12.3);
+    SKUpdateStatic<1> imu;
+    imu.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxIMU));
+    imu.setNavigationHeadingMagnetic(1.2);
+
+    CHECK( encoder.encode(n2k, output) );
+    CHECK( encoder.encode(imu, output) );
+
+    SKUpdateStatic<1> decoded;
+    std::vector<std::vector<uint8_t>> all = output.kommands;
+    output.kommands.assign(all.begin(), all.begin() + 2);
+    CHECK( output.decode(decoder, decoded) );
+    CHECK( decoded.getSource() == n2k.getSource() );
+    CHECK( decoded.getSource().getPGN() == 128267 );
+    CHECK( decoded.getSource().getSourceAddress() == 42 );
+
+    output.kommands.assign(all.begin() + 2, all.end());
+    CHECK( output.decode(decoder, decoded) );
+    CHECK( decoded.getSource() == imu.getSource() );
+    CHECK( decoded.getNavigationHeadingMagnetic() == 1.2 );
+  }
+
+  SECTION("Updates that can not be encoded") {
+    SKContext context("urn:mrn:imo:mmsi:123456789");
+    SKUpdateStatic<1> other(context);
+    other.setNavigationSpeedOverGround(1);
+    CHECK( !encoder.encode(other, output) );
+
+    SKUpdateStatic<SKBinaryDeltaEncoder::MaxValues + 1> large;
+    for (int i = 0; i <= SKBinaryDeltaEncoder::MaxValues; i++) {
+      large.setValue(SKPath(SKPathElectricalBatteriesVoltage, (SKIndexId)(i + 1)), SKValue(i));
+    }
+    CHECK( !encoder.encode(large, output) );
+    CHECK( output.kommands.size() == 0 );
+  }
+
+  SECTION("Decoder rejects deltas it can not resolve") {
+    CHECK( encoder.encode(update, output) );
+    SKUpdateStatic<5> decoded;
+
+    // Without the source and index definitions
+    KommandReader delta(output.kommands[2].data(), output.kommands[2].size());
+    CHECK( !decoder.decodeDelta(delta, decoded) );
+
+    // Truncated delta
+    output.kommands[2].pop_back();
+    CHECK( !output.decode(decoder, decoded) );
+
+    // Too many values for the update
+    output.kommands.clear();
+    CHECK( encoder.encode(update, output) );
+    SKUpdateStatic<2> small;
+    KommandReader fullDelta(output.kommands[0].data(), output.kommands[0].size());
+    CHECK( !decoder.decodeDelta(fullDelta, small) );
+    CHECK( !decoder.missingDefinition() );
+  }
+
+  SECTION("Lost definitions are detected and sent again") {
+    CHECK( encoder.encode(update, output) );
+    REQUIRE( output.kommands.size() == 3 );
+    SKUpdateStatic<5> decoded;
+
+    // The index definition is lost on the way
+    output.kommands.erase(output.kommands.begin() + 1);
+    CHECK( !output.decode(decoder, decoded) );
+    CHECK( decoder.missingDefinition() );
+
+    // Until the encoder is reset, deltas can not be decoded
+    output.kommands.clear();
+    CHECK( encoder.encode(update, output) );
+    CHECK( !output.decode(decoder, decoded) );
+    CHECK( decoder.missingDefinition() );
+
+    output.kommands.clear();
+    encoder.reset();
+    CHECK( encoder.encode(update, output) );
+    CHECK( output.decode(decoder, decoded) );
+    CHECK( !decoder.missingDefinition() );
+    CHECK( decoded.getElectricalBatteriesVoltage("engine") == 12.6 );
+  }
+}
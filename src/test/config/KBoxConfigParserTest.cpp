@@ -47,12 +47,16 @@ TEST_CASE("KBoxConfigParser") {
     CHECK( config.serial1Config.outputMode == SerialModeNMEA );
     CHECK( config.serial2Config.baudRate == 4800 );
     CHECK( config.serial2Config.outputMode == SerialModeNMEA );
+    CHECK( config.serial2Config.nmeaOutput.hdm.maxRate == 10 );
     CHECK( config.nmea2000Config.txEnabled == true );
     CHECK( config.nmea2000Config.rxEnabled == true );
+    CHECK( config.nmea2000Config.output.maxBusLoad == 20 );
     CHECK( config.wifiConfig.enabled == true );
     CHECK( config.wifiConfig.vesselURN == "urn:mrn:kbox:unit-testing" );
     CHECK( config.sdLoggingConfig.enabled == true );
     CHECK( config.sdLoggingConfig.logWithoutTime == false );
+    CHECK( config.skHubConfig.queueEnabled == false );
+    CHECK( config.serial1Config.suppressDuplicates == true );
   }
 
   SECTION("No input") {
@@ -113,6 +117,39 @@ TEST_CASE("KBoxConfigParser") {
     CHECK( nmeaConfig.mwv == false );
   }
 
+  SECTION("NMEA Parser Config") {
+    const char *jsonConfig = "{ 'serial2': { 'nmeaParser': { 'rmc': false, 'vtg': false } } }";
+
+    JsonObject &root = jsonBuffer.parseObject(jsonConfig);
+
+    CHECK( root.success() );
+
+    kboxConfigParser.parseKBoxConfig(root, config);
+
+    CHECK( config.serial1Config.nmeaParser.rmc == true );
+    CHECK( config.serial2Config.nmeaParser.rmc == false );
+    CHECK( config.serial2Config.nmeaParser.mwv == true );
+    CHECK( config.serial2Config.nmeaParser.vtg == false );
+    CHECK( config.serial2Config.nmeaParser.hdg == true );
+  }
+
+  SECTION("NMEA Output Config") {
+    const char *jsonConfig = "{ 'serial1': { 'nmeaOutput': "
+      "   { 'xdr': { 'priority': 3, 'maxRate': 5 }, 'hdm': { 'priority': 9 } } } }";
+
+    JsonObject &root = jsonBuffer.parseObject(jsonConfig);
+
+    CHECK( root.success() );
+
+    kboxConfigParser.parseKBoxConfig(root, config);
+
+    CHECK( config.serial1Config.nmeaOutput.xdr.priority == 3 );
+    CHECK( config.serial1Config.nmeaOutput.xdr.maxRate == 5 );
+    // Values out of range are ignored
+    CHECK( config.serial1Config.nmeaOutput.hdm.priority == 1 );
+    CHECK( config.serial1Config.nmeaOutput.dbt.priority == 2 );
+  }
+
   SECTION("WiFi config") {
     const char *jsonConfig = "{ 'client': "
       "   { 'enabled': true, ssid: 'network', 'password': 'secret' }"
@@ -174,4 +211,57 @@ TEST_CASE("KBoxConfigParser") {
     CHECK(!sdLoggingConfig.enabled);
     CHECK(sdLoggingConfig.logWithoutTime);
   }
+
+  SECTION("SKHubConfig") {
+    const char *jsonConfig = "{ 'queueEnabled': true, 'queueSize': 64, 'dispatchBudget': 50 }";
+    JsonObject &root = jsonBuffer.parseObject(jsonConfig);
+
+    CHECK(root.success());
+
+    kboxConfigParser.defaultConfig(config);
+    kboxConfigParser.parseSKHubConfig(root, config.skHubConfig);
+
+    CHECK(config.skHubConfig.queueEnabled);
+    CHECK(config.skHubConfig.queueSize == 64);
+    // Out of range, default value is kept
+    CHECK(config.skHubConfig.dispatchBudget == 2000);
+    CHECK(!config.skHubConfig.multiplexer.enabled);
+  }
+
+  SECTION("SKSourceMultiplexerConfig") {
+    const char *jsonConfig = "{ 'multiplexer': { 'enabled': true, 'sourceTimeout': 5000, "
+      "'nmea1Priority': 5, 'nmea2000Priority': 12 } }";
+    JsonObject &root = jsonBuffer.parseObject(jsonConfig);
+
+    CHECK(root.success());
+
+    kboxConfigParser.defaultConfig(config);
+    kboxConfigParser.parseSKHubConfig(root, config.skHubConfig);
+
+    CHECK(config.skHubConfig.multiplexer.enabled);
+    CHECK(config.skHubConfig.multiplexer.sourceTimeout == 5000);
+    CHECK(config.skHubConfig.multiplexer.nmea1Priority == 5);
+    CHECK(config.skHubConfig.multiplexer.nmea2Priority == 2);
+    // Out of range, default value is kept
+    CHECK(config.skHubConfig.multiplexer.nmea2000Priority == 3);
+  }
+
+  SECTION("NMEA2000 Output Config") {
+    const char *jsonConfig = "{ 'nmea2000': { 'output': { 'maxBusLoad': 30, "
+      "'maxRate': { '127257': 5, '130306': 200, '127250': 0 } } } }";
+    JsonObject &root = jsonBuffer.parseObject(jsonConfig);
+
+    CHECK(root.success());
+
+    kboxConfigParser.defaultConfig(config);
+    kboxConfigParser.parseKBoxConfig(root, config);
+
+    CHECK(config.nmea2000Config.output.maxBusLoad == 30);
+    CHECK(config.nmea2000Config.output.pgns[0].pgn == 127257);
+    CHECK(config.nmea2000Config.output.pgns[0].maxRate == 5);
+    // Out of range rates are ignored
+    CHECK(config.nmea2000Config.output.pgns[1].pgn == 127250);
+    CHECK(config.nmea2000Config.output.pgns[1].maxRate == 0);
+    CHECK(config.nmea2000Config.output.pgns[2].pgn == 0);
+  }
 }
@@ -0,0 +1,172 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "common/nmea/AISFragmentAssembler.h"
+#include "common/nmea/AISPayload.h"
+#include "common/nmea/NMEASentenceReader.h"
+#include "../KBoxTest.h"
+
+TEST_CASE("AISPayload") {
+  AISPayload payload;
+
+  SECTION("Position report") {
+    const char *armoured = "15M67FC000G?ufbE`FepT@3n00Sa";
+    CHECK( payload.append(armoured, strlen(armoured), 0) );
+    CHECK( payload.getLength() == 168 );
+    CHECK( payload.getMessageType() == 1 );
+    CHECK( payload.getMMSI() == 366053209 );
+    CHECK( payload.getSigned(61, 28) == -73404971 );
+    CHECK( payload.getSigned(89, 27) == 22681271 );
+    CHECK( payload.getUnsigned(116, 12) == 2193 );
+    CHECK( payload.getUnsigned(128, 9) == 1 );
+  }
+
+  SECTION("Fill bits are discarded") {
+    CHECK( payload.append("88888888880", 11, 2) );
+    CHECK( payload.getLength() == 64 );
+  }
+
+  SECTION("Bits after the end read as 0") {
+    CHECK( payload.append("w", 1, 0) );
+    CHECK( payload.getUnsigned(0, 6) == 63 );
+    CHECK( payload.getUnsigned(0, 12) == 63 << 6 );
+    CHECK( payload.getUnsigned(100, 30) == 0 );
+  }
+
+  SECTION("Fragments are concatenated") {
+    const char *first = "55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8";
+    CHECK( payload.append(first, strlen(first), 0) );
+    CHECK( payload.append("88888888880", 11, 2) );
+    CHECK( payload.getLength() == 424 );
+    CHECK( payload.getMessageType() == 5 );
+    CHECK( payload.getMMSI() == 351759000 );
+
+    char name[21];
+    CHECK( payload.getString(112, 20, name, sizeof(name)) == 11 );
+    CHECK( strcmp(name, "EVER DIADEM") == 0 );
+
+    char callsign[8];
+    CHECK( payload.getString(70, 7, callsign, sizeof(callsign)) == 5 );
+    CHECK( strcmp(callsign, "3FOF8") == 0 );
+
+    SECTION("Strings are truncated to the buffer") {
+      char shortName[5];
+      CHECK( payload.getString(112, 20, shortName, sizeof(shortName)) == 4 );
+      CHECK( strcmp(shortName, "EVER") == 0 );
+    }
+  }
+
+  SECTION("Invalid characters") {
+    CHECK( payload.append("15M", 3, 0) );
+    CHECK( !payload.append("1X", 2, 0) );
+    CHECK( !payload.append("1~", 2, 0) );
+    CHECK( payload.getLength() == 18 );
+  }
+
+  SECTION("Payload too long") {
+    char armoured[AISPayload::MaxBits / 6 + 2];
+    memset(armoured, '0', sizeof(armoured));
+    CHECK( !payload.append(armoured, sizeof(armoured), 0) );
+    CHECK( payload.append(armoured, sizeof(armoured) - 2, 0) );
+    CHECK( !payload.append(armoured, 1, 0) );
+    CHECK( payload.getLength() == 1008 );
+  }
+}
+
+TEST_CASE("AISFragmentAssembler") {
+  AISFragmentAssembler assembler;
+  NMEASentenceReader single("!AIVDM,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5C");
+  NMEASentenceReader first("!AIVDM,2,1,1,A,55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8,0*1C");
+  NMEASentenceReader second("!AIVDM,2,2,1,A,88888888880,2*25");
+
+  SECTION("Single fragment") {
+    const AISPayload *p = assembler.add(single, 0);
+    REQUIRE( p != nullptr );
+    CHECK( p->getMMSI() == 366053209 );
+  }
+
+  SECTION("Two fragments") {
+    CHECK( assembler.add(first, 0) == nullptr );
+    const AISPayload *p = assembler.add(second, 100);
+    REQUIRE( p != nullptr );
+    CHECK( p->getMMSI() == 351759000 );
+    CHECK( p->getLength() == 424 );
+    CHECK( assembler.dropped() == 0 );
+  }
+
+  SECTION("Single fragment between two fragments") {
+    CHECK( assembler.add(first, 0) == nullptr );
+    CHECK( assembler.add(single, 10) != nullptr );
+    CHECK( assembler.add(second, 20) != nullptr );
+  }
+
+  SECTION("Fragment received too late") {
+    CHECK( assembler.add(first, 0) == nullptr );
+    CHECK( assembler.add(second, AISFragmentAssembler::FragmentTimeout + 1) == nullptr );
+    CHECK( assembler.dropped() == 2 );
+  }
+
+  SECTION("Fragments out of order") {
+    CHECK( assembler.add(second, 0) == nullptr );
+    CHECK( assembler.add(first, 10) == nullptr );
+    CHECK( assembler.dropped() == 1 );
+
+    // The first fragment is still waiting for the second one.
+    CHECK( assembler.add(second, 20) != nullptr );
+  }
+
+  SECTION("Same sequence id on another channel") {
+    NMEASentenceReader otherChannel("!AIVDM,2,2,1,B,88888888880,2*26");
+    CHECK( assembler.add(first, 0) == nullptr );
+    CHECK( assembler.add(otherChannel, 10) == nullptr );
+    CHECK( assembler.add(second, 20) != nullptr );
+  }
+
+  SECTION("Too many pending messages") {
+    char sentence[100];
+    for (int i = 0; i <= AISFragmentAssembler::MaxPendingMessages; i++) {
+      // Sequence ids 2, 3, ... so that sequence 1 is the oldest.
+      if (i == 0) {
+        CHECK( assembler.add(first, 0) == nullptr );
+        continue;
+      }
+      String body = String("AIVDM,2,1,") + String(i + 1) + ",A,55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8,0";
+      uint8_t checksum = 0;
+      for (unsigned int j = 0; j < body.length(); j++) {
+        checksum ^= body[j];
+      }
+      snprintf(sentence, sizeof(sentence), "!%s*%02X", body.c_str(), checksum);
+      CHECK( assembler.add(NMEASentenceReader(sentence), i) == nullptr );
+    }
+    CHECK( assembler.dropped() == 1 );
+    CHECK( assembler.add(second, 100) == nullptr );
+  }
+
+  SECTION("Invalid fragment numbers") {
+    CHECK( assembler.add(NMEASentenceReader("!AIVDM,1,2,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5F"), 0) == nullptr );
+    CHECK( assembler.dropped() == 1 );
+  }
+}
@@ -0,0 +1,81 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <string.h>
+#include "common/nmea/AISTargetTable.h"
+#include "../KBoxTest.h"
+
+TEST_CASE("AISTargetTable") {
+  AISTargetTable table;
+
+  SECTION("New targets") {
+    CHECK( table.size() == 0 );
+    CHECK( table.find(366053209) == nullptr );
+
+    AISTarget &target = table.touch(366053209, 1000);
+    CHECK( table.size() == 1 );
+    CHECK( target.mmsi == 366053209 );
+    CHECK( target.lastSeen == 1000 );
+    CHECK( target.name[0] == '\0' );
+    CHECK( table.find(366053209) == &target );
+  }
+
+  SECTION("Known targets are updated") {
+    AISTarget &target = table.touch(366053209, 1000);
+    strcpy(target.name, "EVER DIADEM");
+
+    CHECK( &table.touch(366053209, 2000) == &target );
+    CHECK( table.size() == 1 );
+    CHECK( target.lastSeen == 2000 );
+    CHECK( strcmp(target.name, "EVER DIADEM") == 0 );
+  }
+
+  SECTION("The least recently seen target is replaced") {
+    int capacity = AISTargetTable::Capacity;
+    for (int i = 0; i < capacity; i++) {
+      table.touch(100 + i, 1000 + i);
+    }
+    // Target 100 is now the most recent, 101 the oldest.
+    table.touch(100, 5000);
+
+    AISTarget &target = table.touch(999, 6000);
+    CHECK( table.size() == capacity );
+    CHECK( table.evictions() == 1 );
+    CHECK( target.mmsi == 999 );
+    CHECK( table.find(101) == nullptr );
+    CHECK( table.find(100) != nullptr );
+    CHECK( table.find(102) != nullptr );
+  }
+
+  SECTION("Replacement works when millis() wraps") {
+    int capacity = AISTargetTable::Capacity;
+    for (int i = 0; i < capacity; i++) {
+      table.touch(100 + i, 0xfffffff0 + i);
+    }
+    table.touch(100, 10);
+    table.touch(999, 20);
+    CHECK( table.find(101) == nullptr );
+    CHECK( table.find(100) != nullptr );
+  }
+}
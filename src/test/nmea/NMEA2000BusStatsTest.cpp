@@ -0,0 +1,158 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common/nmea/NMEA2000BusStats.h"
+#include "../KBoxTest.h"
+
+TEST_CASE("NMEA2000BusStats") {
+  NMEA2000BusStats stats;
+
+  SECTION("New entries") {
+    CHECK( stats.size() == 0 );
+    CHECK( stats.find(127250, 3) == nullptr );
+
+    stats.record(127250, 3, 8, 1000);
+    CHECK( stats.size() == 1 );
+    CHECK( stats.messages() == 1 );
+
+    const NMEA2000BusStatsEntry *entry = stats.find(127250, 3);
+    REQUIRE( entry != nullptr );
+    CHECK( entry->pgn == 127250 );
+    CHECK( entry->source == 3 );
+    CHECK( entry->messages == 1 );
+    CHECK( entry->bytes == 8 );
+    CHECK( entry->lastSeen == 1000 );
+    CHECK( entry->rate(1000) == 0 );
+  }
+
+  SECTION("PGNs and sources are counted separately") {
+    stats.record(127250, 3, 8, 1000);
+    stats.record(127250, 3, 8, 1100);
+    stats.record(127250, 4, 8, 1100);
+    stats.record(128267, 3, 8, 1200);
+
+    CHECK( stats.size() == 3 );
+    CHECK( stats.messages() == 4 );
+    CHECK( stats.find(127250, 3)->messages == 2 );
+    CHECK( stats.find(127250, 3)->bytes == 16 );
+    CHECK( stats.find(127250, 4)->messages == 1 );
+    CHECK( stats.find(128267, 3)->messages == 1 );
+  }
+
+  SECTION("Rate") {
+    for (uint32_t t = 0; t <= 10000; t += 100) {
+      stats.record(127250, 3, 8, 10000 + t);
+    }
+    const NMEA2000BusStatsEntry *entry = stats.find(127250, 3);
+    CHECK( entry->rate(20000) == Approx(10) );
+
+    // The rate goes down when the device goes quiet.
+    CHECK( entry->rate(20500) == Approx(2) );
+
+    // And follows a new rate.
+    for (uint32_t t = 0; t < 30000; t += 1000) {
+      stats.record(127250, 3, 8, 21000 + t);
+    }
+    CHECK( entry->rate(50000) < 1.1 );
+    CHECK( entry->rate(50000) > 0.9 );
+  }
+
+  SECTION("Busiest entries") {
+    for (uint32_t t = 0; t < 1000; t += 10) {
+      stats.record(127245, 1, 8, 1000 + t);
+      if (t % 100 == 0) {
+        stats.record(130306, 2, 8, 1000 + t);
+      }
+      if (t % 50 == 0) {
+        stats.record(129025, 3, 8, 1000 + t);
+      }
+    }
+    stats.record(126996, 4, 134, 1500);
+
+    const NMEA2000BusStatsEntry *busiest[3];
+    CHECK( stats.busiest(busiest, 3, 2000) == 3 );
+    CHECK( busiest[0]->pgn == 127245 );
+    CHECK( busiest[1]->pgn == 129025 );
+    CHECK( busiest[2]->pgn == 130306 );
+
+    const NMEA2000BusStatsEntry *all[10];
+    CHECK( stats.busiest(all, 10, 2000) == 4 );
+    CHECK( all[3]->pgn == 126996 );
+  }
+
+  SECTION("The least recently seen entry in the probed slots is replaced") {
+    // Fill the table more than it can hold. Every new entry must find a place.
+    int capacity = NMEA2000BusStats::Capacity;
+    int count = capacity * 2;
+    for (int i = 0; i < count; i++) {
+      stats.record(60928, i, 8, 1000 + i);
+      CHECK( stats.find(60928, i) != nullptr );
+    }
+    CHECK( stats.size() <= capacity );
+    CHECK( stats.size() + stats.evictions() == count );
+    CHECK( stats.messages() == count );
+  }
+
+  SECTION("Stale entries expire") {
+    for (int i = 0; i < 40; i++) {
+      stats.record(60928, i, 8, 1000);
+    }
+    for (int i = 0; i < 40; i += 2) {
+      stats.record(60928, i, 8, 50000);
+    }
+
+    stats.expire(70000);
+    CHECK( stats.size() == 20 );
+    CHECK( stats.evictions() == 0 );
+    for (int i = 0; i < 40; i++) {
+      if (i % 2 == 0) {
+        CHECK( stats.find(60928, i) != nullptr );
+      }
+      else {
+        CHECK( stats.find(60928, i) == nullptr );
+      }
+    }
+
+    stats.expire(120000);
+    CHECK( stats.size() == 0 );
+  }
+
+  SECTION("Bus load") {
+    CHECK( stats.busLoad(1000) == 0 );
+
+    // 100 single frame messages in one second: 100 * 154 bits.
+    for (uint32_t t = 0; t < 1000; t += 10) {
+      stats.record(127250, 3, 8, 1000 + t);
+    }
+    // The second is not complete.
+    CHECK( stats.busLoad(1500) == 0 );
+    CHECK( stats.busLoad(2000) == 6 );
+
+    stats.record(127250, 3, 8, 2000);
+    CHECK( stats.busLoad(2500) == 6 );
+
+    // Nothing received for a while.
+    CHECK( stats.busLoad(4000) == 0 );
+  }
+}
@@ -0,0 +1,159 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "../KBoxTest.h"
+#include "common/nmea/NMEA2000FrameRing.h"
+#include "common/nmea/NMEA2000Ingress.h"
+#include "common/stats/KBoxMetrics.h"
+
+static NMEA2000Frame frame(uint32_t pgn, uint8_t length, uint8_t fill = 0) {
+  NMEA2000Frame f;
+  f.pgn = pgn;
+  f.timestamp = 1000 + pgn;
+  f.priority = 2;
+  f.source = 42;
+  f.destination = 255;
+  f.length = length;
+  memset(f.data, fill, length);
+  return f;
+}
+
+TEST_CASE("NMEA2000FrameRing") {
+  NMEA2000FrameRing<256> ring;
+  NMEA2000Frame out;
+  size_t header = NMEA2000FrameRing<256>::HeaderLength;
+
+  SECTION("empty ring") {
+    CHECK( ring.size() == 0 );
+    CHECK( !ring.pop(out) );
+  }
+
+  SECTION("frames come out in order and intact") {
+    CHECK( ring.push(frame(127250, 8, 0xaa)) );
+    CHECK( ring.push(frame(129029, 43, 0x55)) );
+    CHECK( ring.size() == 2 );
+
+    CHECK( ring.pop(out) );
+    CHECK( out.pgn == 127250 );
+    CHECK( out.timestamp == 1000 + 127250 );
+    CHECK( out.priority == 2 );
+    CHECK( out.source == 42 );
+    CHECK( out.destination == 255 );
+    CHECK( out.length == 8 );
+    CHECK( out.data[0] == 0xaa );
+    CHECK( out.data[7] == 0xaa );
+
+    CHECK( ring.pop(out) );
+    CHECK( out.pgn == 129029 );
+    CHECK( out.length == 43 );
+    CHECK( out.data[42] == 0x55 );
+    CHECK( ring.size() == 0 );
+  }
+
+  SECTION("frames only use the room they need") {
+    int fits = 256 / (header + 8);
+    for (int i = 0; i < fits; i++) {
+      CHECK( ring.push(frame(i, 8)) );
+    }
+    CHECK( !ring.push(frame(fits, 8)) );
+    CHECK( ring.overflows() == 1 );
+    CHECK( ring.size() == fits );
+  }
+
+  SECTION("frames wrap around the end of the ring") {
+    for (int i = 0; i < 100; i++) {
+      uint8_t length = (i * 7) % 60;
+      CHECK( ring.push(frame(i, length, i)) );
+      CHECK( ring.pop(out) );
+      CHECK( out.pgn == (uint32_t)i );
+      CHECK( out.length == length );
+      for (int j = 0; j < length; j++) {
+        if (out.data[j] != i) {
+          FAIL("corrupted data");
+        }
+      }
+    }
+    CHECK( ring.overflows() == 0 );
+  }
+
+  SECTION("frames longer than a fast packet are refused") {
+    NMEA2000Frame f = frame(1, 0);
+    f.length = NMEA2000Frame::MaxDataLength + 1;
+    CHECK( !ring.push(f) );
+    CHECK( ring.size() == 0 );
+  }
+}
+
+TEST_CASE("NMEA2000Ingress") {
+  NMEA2000Ingress ingress;
+  NMEA2000Frame out;
+
+  SECTION("navigation PGNs have their own lane") {
+    CHECK( NMEA2000Ingress::laneForPGN(127250) == NMEA2000IngressLaneNavigation );
+    CHECK( NMEA2000Ingress::laneForPGN(129025) == NMEA2000IngressLaneNavigation );
+    CHECK( NMEA2000Ingress::laneForPGN(130306) == NMEA2000IngressLaneNavigation );
+    CHECK( NMEA2000Ingress::laneForPGN(129038) == NMEA2000IngressLaneOther );
+    CHECK( NMEA2000Ingress::laneForPGN(126996) == NMEA2000IngressLaneOther );
+  }
+
+  SECTION("navigation frames are processed first") {
+    CHECK( ingress.push(frame(129038, 27)) );
+    CHECK( ingress.push(frame(127250, 8)) );
+    CHECK( ingress.push(frame(128267, 8)) );
+    CHECK( ingress.push(frame(129025, 8)) );
+    CHECK( ingress.size() == 4 );
+
+    CHECK( ingress.pop(out) );
+    CHECK( out.pgn == 127250 );
+    CHECK( ingress.pop(out) );
+    CHECK( out.pgn == 129025 );
+    CHECK( ingress.pop(out) );
+    CHECK( out.pgn == 129038 );
+    CHECK( ingress.pop(out) );
+    CHECK( out.pgn == 128267 );
+    CHECK( !ingress.pop(out) );
+  }
+
+  SECTION("a full lane does not push out the other one") {
+    uint32_t navigationOverflows = KBoxMetrics.countEvent(KBoxEventNMEA2000IngressNavigationOverflow);
+    uint32_t otherOverflows = KBoxMetrics.countEvent(KBoxEventNMEA2000IngressOtherOverflow);
+
+    int dropped = 0;
+    for (int i = 0; i < 200; i++) {
+      if (!ingress.push(frame(129038, 27))) {
+        dropped++;
+      }
+    }
+    CHECK( dropped > 0 );
+    CHECK( ingress.push(frame(127250, 8)) );
+
+    CHECK( ingress.overflows(NMEA2000IngressLaneOther) == (uint32_t)dropped );
+    CHECK( ingress.overflows(NMEA2000IngressLaneNavigation) == 0 );
+    CHECK( KBoxMetrics.countEvent(KBoxEventNMEA2000IngressOtherOverflow) == otherOverflows + dropped );
+    CHECK( KBoxMetrics.countEvent(KBoxEventNMEA2000IngressNavigationOverflow) == navigationOverflows );
+
+    CHECK( ingress.pop(out) );
+    CHECK( out.pgn == 127250 );
+  }
+}
@@ -0,0 +1,201 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Print.h>
+#include "../KBoxTest.h"
+#include "common/nmea/NMEA2000LogFormat.h"
+
+static NMEA2000Frame frame(uint32_t pgn, uint32_t timestamp, uint8_t length) {
+  NMEA2000Frame f;
+  f.pgn = pgn;
+  f.timestamp = timestamp;
+  f.priority = 2;
+  f.source = 35;
+  f.destination = 255;
+  f.length = length;
+  for (int i = 0; i < length; i++) {
+    f.data[i] = i;
+  }
+  return f;
+}
+
+TEST_CASE("NMEA2000LogFormat") {
+  NMEA2000LogWriter writer;
+  NMEA2000LogReader reader;
+  uint8_t buffer[512];
+  size_t length;
+  uint64_t wallClockMs = 0;
+  uint32_t uptimeMs = 0;
+  NMEA2000Frame out;
+  uint8_t clockMarker = NMEA2000LogWriter::ClockMarker;
+  uint8_t messageMarker = NMEA2000LogWriter::MessageMarker;
+
+  SECTION("clock record") {
+    size_t written = writer.writeClock(buffer, sizeof(buffer), 1528211815123ULL, 4200);
+    CHECK( written == 1 + 6 + 2 );
+    CHECK( buffer[0] == clockMarker );
+
+    CHECK( reader.read(buffer, written, length, wallClockMs, uptimeMs, out) == NMEA2000LogReader::Clock );
+    CHECK( length == written );
+    CHECK( wallClockMs == 1528211815123ULL );
+    CHECK( uptimeMs == 4200 );
+  }
+
+  SECTION("single frame message") {
+    size_t clockLength = writer.writeClock(buffer, sizeof(buffer), 1528211815123ULL, 4200);
+    uint8_t *message = buffer + clockLength;
+    size_t written = writer.writeMessage(message, sizeof(buffer) - clockLength, frame(130306, 4250, 8));
+    // Marker, 50ms, PGN, priority, source, destination, length and data
+    CHECK( written == 1 + 1 + 3 + 3 + 1 + 8 );
+    CHECK( message[0] == messageMarker );
+
+    CHECK( reader.read(buffer, clockLength, length, wallClockMs, uptimeMs, out) == NMEA2000LogReader::Clock );
+    CHECK( reader.read(message, written, length, wallClockMs, uptimeMs, out) == NMEA2000LogReader::Message );
+    CHECK( length == written );
+    CHECK( out.pgn == 130306 );
+    CHECK( out.timestamp == 4250 );
+    CHECK( out.priority == 2 );
+    CHECK( out.source == 35 );
+    CHECK( out.destination == 255 );
+    CHECK( out.length == 8 );
+    CHECK( out.data[7] == 7 );
+  }
+
+  SECTION("sequence of records with time going back") {
+    size_t written = 0;
+    written += writer.writeClock(buffer + written, sizeof(buffer) - written, 1000000, 100);
+    written += writer.writeMessage(buffer + written, sizeof(buffer) - written, frame(127250, 150, 8));
+    written += writer.writeMessage(buffer + written, sizeof(buffer) - written, frame(129029, 140, 43));
+    written += writer.writeMessage(buffer + written, sizeof(buffer) - written, frame(59904, 20150, 3));
+
+    uint32_t pgns[] = { 127250, 129029, 59904 };
+    uint32_t times[] = { 150, 140, 20150 };
+    size_t position = 0;
+    CHECK( reader.read(buffer, written, length, wallClockMs, uptimeMs, out) == NMEA2000LogReader::Clock );
+    position += length;
+    for (int i = 0; i < 3; i++) {
+      CHECK( reader.read(buffer + position, written - position, length, wallClockMs, uptimeMs, out)
+             == NMEA2000LogReader::Message );
+      CHECK( out.pgn == pgns[i] );
+      CHECK( out.timestamp == times[i] );
+      position += length;
+    }
+    CHECK( position == written );
+  }
+
+  SECTION("truncated records are incomplete") {
+    size_t written = writer.writeMessage(buffer, sizeof(buffer), frame(129029, 1000, 43));
+    for (size_t i = 0; i < written; i++) {
+      NMEA2000LogReader r;
+      CHECK( r.read(buffer, i, length, wallClockMs, uptimeMs, out) == NMEA2000LogReader::Incomplete );
+    }
+  }
+
+  SECTION("records that do not fit are not written") {
+    size_t written = writer.writeMessage(buffer, 20, frame(129029, 1000, 43));
+    CHECK( written == 0 );
+    written = writer.writeClock(buffer, 4, 1528211815123ULL, 4200);
+    CHECK( written == 0 );
+  }
+
+  SECTION("text is not a record") {
+    const char *line = "1528211815123;P;$PCDIN,01F11A,000C9E34,00,0000000000000000*5E";
+    CHECK( reader.read((const uint8_t*)line, strlen(line), length, wallClockMs, uptimeMs, out)
+           == NMEA2000LogReader::Invalid );
+  }
+}
+
+/* Keeps the size of every write, like the sectors written to the SD card. */
+class SectorFile : public Print {
+  public:
+    std::vector<size_t> writes;
+
+    using Print::write;
+
+    size_t write(uint8_t b) override {
+      return write(&b, 1);
+    };
+
+    size_t write(const uint8_t *buffer, size_t size) override {
+      writes.push_back(size);
+      return size;
+    };
+};
+
+TEST_CASE("NMEA2000LogSector") {
+  NMEA2000LogSector sector;
+  SectorFile file;
+  size_t sectorSize = NMEA2000LogSector::Size;
+  uint32_t flushInterval = NMEA2000LogSector::FlushInterval;
+
+  sector.reset(0);
+  CHECK( sector.appendClock(file, 1528211815123ULL, 0, 0) );
+
+  SECTION("full sectors are written as soon as they are full") {
+    uint32_t now = 0;
+    for (int i = 0; i < 100; i++) {
+      CHECK( sector.appendMessage(file, frame(129029, now, 43), now) );
+      now += 5;
+      sector.poll(file, now);
+    }
+    REQUIRE( file.writes.size() > 1 );
+    for (size_t i = 0; i < file.writes.size(); i++) {
+      CHECK( file.writes[i] > sectorSize - NMEA2000LogWriter::MaxMessageLength );
+      CHECK( file.writes[i] <= sectorSize );
+    }
+  }
+
+  SECTION("a partial sector is written after FlushInterval") {
+    CHECK( sector.appendMessage(file, frame(129025, 10, 8), 10) );
+    sector.poll(file, flushInterval - 1);
+    CHECK( file.writes.size() == 0 );
+    CHECK( sector.length() > 0 );
+
+    sector.poll(file, flushInterval);
+    REQUIRE( file.writes.size() == 1 );
+    CHECK( sector.length() == 0 );
+
+    // The interval starts again after each write.
+    CHECK( sector.appendMessage(file, frame(129025, 1100, 8), 1100) );
+    sector.poll(file, flushInterval + 500);
+    CHECK( file.writes.size() == 1 );
+  }
+
+  SECTION("flush writes the sector now") {
+    CHECK( sector.appendMessage(file, frame(129025, 10, 8), 10) );
+    sector.flush(file, 20);
+    REQUIRE( file.writes.size() == 1 );
+    sector.flush(file, 30);
+    CHECK( file.writes.size() == 1 );
+  }
+
+  SECTION("reset drops the records not written") {
+    CHECK( sector.appendMessage(file, frame(129025, 10, 8), 10) );
+    sector.reset(20);
+    CHECK( sector.length() == 0 );
+    sector.flush(file, 30);
+    CHECK( file.writes.size() == 0 );
+  }
+}
@@ -0,0 +1,218 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <N2kMsg.h>
+#include <N2kMessages.h>
+#include "common/algo/List.h"
+#include "common/nmea/NMEA2000OutputScheduler.h"
+#include "../KBoxTest.h"
+
+class MockBus : public SKNMEA2000Output {
+  public:
+    LinkedList<tN2kMsg> sent;
+    bool accept = true;
+
+    bool write(const tN2kMsg &msg) override {
+      if (accept) {
+        sent.add(msg);
+      }
+      return accept;
+    };
+};
+
+/*
+ * A message whose first byte is the given value and the others are 0xff.
+ */
+static tN2kMsg message(uint32_t pgn, uint8_t priority, uint8_t first = 0, int length = 8) {
+  tN2kMsg msg;
+  msg.SetPGN(pgn);
+  msg.Priority = priority;
+  msg.AddByte(first);
+  for (int i = 1; i < length; i++) {
+    msg.AddByte(0xff);
+  }
+  return msg;
+}
+
+static tN2kMsg wind(uint8_t reference) {
+  tN2kMsg msg = message(130306, 2, 0, 5);
+  msg.AddByte(reference);
+  return msg;
+}
+
+static int countEvents(enum KBoxEvent e) {
+  return KBoxMetrics.countEvent(e);
+}
+
+TEST_CASE("NMEA2000OutputScheduler") {
+  NMEA2000OutputSchedulerConfig config;
+  // No bus budget unless the test needs one
+  config.maxBusLoad = 0;
+  MockBus bus;
+  NMEA2000OutputScheduler scheduler(config, bus);
+  int maxMessages = NMEA2000OutputScheduler::MaxMessages;
+
+  int dropped = countEvents(KBoxEventNMEA2000TXDropped);
+  int coalesced = countEvents(KBoxEventNMEA2000TXCoalesced);
+
+  SECTION("Messages are sent on flush") {
+    CHECK( scheduler.write(message(127250, 2, 42)) );
+    CHECK( bus.sent.size() == 0 );
+    CHECK( scheduler.pending() == 1 );
+
+    CHECK( scheduler.flush(0) == 1 );
+    CHECK( bus.sent.size() == 1 );
+    const tN2kMsg &msg = *bus.sent.begin();
+    CHECK( msg.PGN == 127250 );
+    CHECK( msg.Priority == 2 );
+    CHECK( msg.DataLen == 8 );
+    CHECK( msg.Data[0] == 42 );
+    CHECK( scheduler.pending() == 0 );
+  }
+
+  SECTION("Only the last message of each value is sent") {
+    CHECK( scheduler.enqueue(message(127257, 3, 1), 0) );
+    CHECK( scheduler.enqueue(message(127257, 3, 2), 10) );
+    CHECK( countEvents(KBoxEventNMEA2000TXCoalesced) == coalesced + 1 );
+
+    CHECK( scheduler.flush(20) == 1 );
+    CHECK( bus.sent.begin()->Data[0] == 2 );
+  }
+
+  SECTION("Batteries and wind references are different values") {
+    CHECK( scheduler.enqueue(message(127508, 6, 0), 0) );
+    CHECK( scheduler.enqueue(message(127508, 6, 1), 0) );
+    CHECK( scheduler.enqueue(wind(N2kWind_Apparent), 0) );
+    CHECK( scheduler.enqueue(wind(N2kWind_True_water), 0) );
+    CHECK( scheduler.pending() == 4 );
+    CHECK( countEvents(KBoxEventNMEA2000TXCoalesced) == coalesced );
+  }
+
+  SECTION("Standard transmission interval") {
+    // Attitude is sent every second.
+    CHECK( scheduler.enqueue(message(127257, 3, 1), 0) );
+    CHECK( scheduler.flush(0) == 1 );
+    for (int t = 50; t < 1000; t += 50) {
+      CHECK( scheduler.enqueue(message(127257, 3, t / 50), t) );
+      CHECK( scheduler.flush(t) == 0 );
+    }
+    CHECK( scheduler.flush(1000) == 1 );
+    CHECK( bus.sent.size() == 2 );
+    CHECK( (++bus.sent.begin())->Data[0] == 19 );
+  }
+
+  SECTION("Configured maximum rate") {
+    config.pgns[0].pgn = 127257;
+    config.pgns[0].maxRate = 10;
+
+    CHECK( scheduler.enqueue(message(127257, 3), 0) );
+    CHECK( scheduler.flush(0) == 1 );
+    CHECK( scheduler.enqueue(message(127257, 3), 50) );
+    CHECK( scheduler.flush(50) == 0 );
+    CHECK( scheduler.flush(100) == 1 );
+  }
+
+  SECTION("Lower priority numbers are sent first") {
+    CHECK( scheduler.enqueue(message(127508, 6), 0) );
+    CHECK( scheduler.enqueue(message(130306, 2), 1) );
+    CHECK( scheduler.enqueue(message(127257, 3), 2) );
+    CHECK( scheduler.flush(10) == 3 );
+
+    auto it = bus.sent.begin();
+    CHECK( (it++)->PGN == 130306 );
+    CHECK( (it++)->PGN == 127257 );
+    CHECK( (it++)->PGN == 127508 );
+  }
+
+  SECTION("Messages refused by the bus stay queued") {
+    CHECK( scheduler.enqueue(message(127250, 2), 0) );
+    bus.accept = false;
+    CHECK( scheduler.flush(0) == 0 );
+    CHECK( scheduler.pending() == 1 );
+
+    bus.accept = true;
+    CHECK( scheduler.flush(5) == 1 );
+    CHECK( scheduler.pending() == 0 );
+  }
+
+  SECTION("Bus budget") {
+    // 10% of 250kbit/s is 25 bits per millisecond. A single frame message
+    // needs 154 bits, the longest fast packet 4928 and the budget starts
+    // with 5120.
+    uint32_t bits = NMEA2000OutputScheduler::messageBits(8);
+    CHECK( bits == 154 );
+    bits = NMEA2000OutputScheduler::messageBits(223);
+    CHECK( bits == 4928 );
+    config.maxBusLoad = 10;
+
+    CHECK( scheduler.enqueue(message(129029, 3, 0, 223), 0) );
+    CHECK( scheduler.enqueue(message(127250, 2), 0) );
+    CHECK( scheduler.enqueue(message(127257, 3), 0) );
+    CHECK( scheduler.flush(0) == 1 );
+    CHECK( scheduler.pending() == 1 );
+
+    // 38 bits left
+    CHECK( scheduler.flush(4) == 0 );
+    CHECK( scheduler.flush(5) == 1 );
+
+    // Fast packets that do not fit are dropped
+    CHECK( !scheduler.enqueue(message(129029, 3, 0, 223), 10) );
+    CHECK( countEvents(KBoxEventNMEA2000TXDropped) == dropped + 1 );
+    CHECK( bus.sent.size() == 3 );
+  }
+
+  SECTION("Bus load of the last second") {
+    for (int i = 0; i < 10; i++) {
+      CHECK( scheduler.enqueue(message(65280 + i, 6, 0, 223), 10) );
+    }
+    CHECK( bus.sent.size() == 10 );
+    CHECK( scheduler.busLoad() == 0 );
+    scheduler.flush(1010);
+    // 10 messages of 32 frames: 49280 bits
+    CHECK( scheduler.busLoad() == 19 );
+    scheduler.flush(3000);
+    CHECK( scheduler.busLoad() == 0 );
+  }
+
+  SECTION("Less important messages are dropped when too many are waiting") {
+    for (int i = 0; i < maxMessages; i++) {
+      CHECK( scheduler.enqueue(message(65280 + i, 6), i) );
+    }
+    // Not more important than the waiting ones: dropped
+    CHECK( !scheduler.enqueue(message(65280 + maxMessages, 6), 100) );
+    CHECK( countEvents(KBoxEventNMEA2000TXDropped) == dropped + 1 );
+
+    // More important: replaces the oldest waiting message
+    CHECK( scheduler.enqueue(message(127250, 2), 100) );
+    CHECK( countEvents(KBoxEventNMEA2000TXDropped) == dropped + 2 );
+    CHECK( scheduler.flush(200) == maxMessages );
+    CHECK( bus.sent.begin()->PGN == 127250 );
+  }
+
+  SECTION("Fast packets are not held") {
+    CHECK( scheduler.enqueue(message(129029, 3, 0, 43), 0) );
+    CHECK( bus.sent.size() == 1 );
+    CHECK( scheduler.pending() == 0 );
+  }
+}
@@ -0,0 +1,63 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "../KBoxTest.h"
+#include "common/nmea/NMEADuplicateFilter.h"
+
+static const char *rmc = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A";
+static const char *rmc2 = "$GPRMC,123520,A,4807.039,N,01131.000,E,022.4,084.4,230394,003.1,W*63";
+
+TEST_CASE("NMEADuplicateFilter") {
+  NMEADuplicateFilter filter(500);
+
+  SECTION("same sentence on another input within the window") {
+    CHECK( !filter.isDuplicate(1, rmc, strlen(rmc), 1000) );
+    CHECK( filter.isDuplicate(2, rmc, strlen(rmc), 1005) );
+    CHECK( !filter.isDuplicate(2, rmc2, strlen(rmc2), 1010) );
+    CHECK( filter.isDuplicate(1, rmc2, strlen(rmc2), 1012) );
+  }
+
+  SECTION("same sentence on the same input is not a duplicate") {
+    CHECK( !filter.isDuplicate(1, rmc, strlen(rmc), 1000) );
+    CHECK( !filter.isDuplicate(1, rmc, strlen(rmc), 1100) );
+    CHECK( filter.isDuplicate(2, rmc, strlen(rmc), 1550) );
+  }
+
+  SECTION("sentences are forgotten after the window") {
+    CHECK( !filter.isDuplicate(1, rmc, strlen(rmc), 1000) );
+    CHECK( !filter.isDuplicate(2, rmc, strlen(rmc), 1500) );
+    CHECK( filter.isDuplicate(1, rmc, strlen(rmc), 1600) );
+  }
+
+  SECTION("oldest sentences are forgotten when the table is full") {
+    int capacity = NMEADuplicateFilter::Capacity;
+    CHECK( !filter.isDuplicate(1, rmc, strlen(rmc), 1000) );
+    char sentence[20];
+    for (int i = 0; i < capacity; i++) {
+      snprintf(sentence, sizeof(sentence), "$IIXDR,%i", i);
+      CHECK( !filter.isDuplicate(1, sentence, strlen(sentence), 1001) );
+    }
+    CHECK( !filter.isDuplicate(2, rmc, strlen(rmc), 1002) );
+  }
+}
@@ -0,0 +1,104 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <string.h>
+#include "common/comms/Kommand.h"
+#include "common/nmea/NMEAEncodedMessage.h"
+#include "common/algo/List.h"
+#include "../KBoxTest.h"
+
+class RecordingRepeater : public NMEARepeater {
+  public:
+    LinkedList<NMEAEncodedMessage> messages;
+
+    void repeat(const NMEAEncodedMessage &message) override {
+      messages.add(message);
+    };
+};
+
+TEST_CASE("NMEAEncodedMessage") {
+  const char *sentence = "$IIHDM,12.3,M*2F";
+
+  SECTION("Invalid message") {
+    NMEAEncodedMessage message;
+    CHECK( !message.isValid() );
+    CHECK( message.references() == 0 );
+  }
+
+  SECTION("NMEA0183 sentence") {
+    NMEAEncodedMessage message = NMEAEncodedMessage::fromSentence(sentence, strlen(sentence));
+    REQUIRE( message.isValid() );
+    CHECK( message.getType() == NMEAEncodedMessage::NMEA0183 );
+    CHECK( message.length() == 16 );
+    CHECK( strcmp(message.c_str(), sentence) == 0 );
+
+    SECTION("is a KommandNMEASentence") {
+      const Kommand &k = message;
+      REQUIRE( k.getSize() == 2 + 16 + 1 );
+      CHECK( k.getBytes()[0] == KommandNMEASentence );
+      CHECK( k.getBytes()[1] == 0 );
+      CHECK( memcmp(k.getBytes() + 2, sentence, 17) == 0 );
+    }
+  }
+
+  SECTION("Text written in the buffer") {
+    NMEAEncodedMessage message = NMEAEncodedMessage::allocate(NMEAEncodedMessage::NMEA2000, 40);
+    REQUIRE( message.isValid() );
+    CHECK( message.capacity() == 40 );
+    CHECK( message.length() == 0 );
+    CHECK( strcmp(message.c_str(), "") == 0 );
+
+    strcpy(message.getBuffer(), "$PCDIN,01F11A,000C9E34,00,00*5E");
+    message.setLength(31);
+    CHECK( message.getType() == NMEAEncodedMessage::NMEA2000 );
+    CHECK( strcmp(message.c_str(), "$PCDIN,01F11A,000C9E34,00,00*5E") == 0 );
+    CHECK( message.getSize() == 34 );
+
+    message.setLength(100);
+    CHECK( message.length() == 40 );
+  }
+
+  SECTION("Copies share the same text") {
+    NMEAEncodedMessage message = NMEAEncodedMessage::fromSentence(sentence, strlen(sentence));
+    RecordingRepeater r1, r2, r3;
+    r1.repeat(message);
+    r2.repeat(message);
+    r3.repeat(message);
+
+    CHECK( message.references() == 4 );
+    CHECK( r1.messages.begin()->c_str() == message.c_str() );
+    CHECK( r3.messages.begin()->c_str() == message.c_str() );
+
+    r2.messages.clear();
+    CHECK( message.references() == 3 );
+
+    NMEAEncodedMessage other = NMEAEncodedMessage::fromSentence("$IIDPT,2.40,0.00*5A", 19);
+    other = message;
+    CHECK( message.references() == 4 );
+    other = other;
+    CHECK( message.references() == 4 );
+    other = NMEAEncodedMessage();
+    CHECK( message.references() == 3 );
+  }
+}
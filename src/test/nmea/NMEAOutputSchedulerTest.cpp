@@ -0,0 +1,191 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <Print.h>
+#include <stdio.h>
+#include "common/nmea/NMEAOutputScheduler.h"
+#include "../KBoxTest.h"
+
+class PrintedLines : public Print {
+  public:
+    String printed;
+
+    size_t write(uint8_t b) override {
+      printed += (char)b;
+      return 1;
+    };
+};
+
+static int countEvents(enum KBoxEvent e) {
+  return KBoxMetrics.countEvent(e);
+}
+
+TEST_CASE("NMEAOutputScheduler") {
+  NMEAOutputSchedulerConfig config;
+  // No baud rate limit unless the test needs one
+  NMEAOutputScheduler scheduler(config, 0, KBoxEventNMEA1TX, KBoxEventNMEA1TXOverflow, KBoxEventNMEA1TXCoalesced);
+  PrintedLines out;
+  int maxSentences = NMEAOutputScheduler::MaxSentences;
+
+  int sent = countEvents(KBoxEventNMEA1TX);
+  int dropped = countEvents(KBoxEventNMEA1TXOverflow);
+  int coalesced = countEvents(KBoxEventNMEA1TXCoalesced);
+
+  SECTION("Sentences are written with <CR><LF>") {
+    CHECK( scheduler.enqueue("$IIHDM,12.3,M*2F", 16, 0) );
+    CHECK( scheduler.pending() == 1 );
+    CHECK( scheduler.flush(out, 1000, 0) == 1 );
+    CHECK( out.printed == "$IIHDM,12.3,M*2F\r\n" );
+    CHECK( scheduler.pending() == 0 );
+    CHECK( countEvents(KBoxEventNMEA1TX) == sent + 1 );
+  }
+
+  SECTION("Only the last sentence of each type is sent") {
+    CHECK( scheduler.enqueue("$IIHDM,12.3,M*2F", 16, 0) );
+    CHECK( scheduler.enqueue("$IIHDM,12.4,M*28", 16, 10) );
+    CHECK( scheduler.enqueue("$IIHDM,12.5,M*29", 16, 20) );
+    CHECK( scheduler.pending() == 1 );
+    CHECK( scheduler.flush(out, 1000, 30) == 1 );
+    CHECK( out.printed == "$IIHDM,12.5,M*29\r\n" );
+    CHECK( countEvents(KBoxEventNMEA1TXCoalesced) == coalesced + 2 );
+    CHECK( countEvents(KBoxEventNMEA1TXOverflow) == dropped );
+  }
+
+  SECTION("True and apparent wind are different sentences") {
+    CHECK( scheduler.enqueue("$IIMWV,90.0,R,5.00,M,A*03", 25, 0) );
+    CHECK( scheduler.enqueue("$IIMWV,80.0,T,4.00,M,A*09", 25, 0) );
+    CHECK( scheduler.pending() == 2 );
+  }
+
+  SECTION("Transducers with different names are different sentences") {
+    CHECK( scheduler.enqueue("$IIXDR,V,12.42,V,Supply*56", 26, 0) );
+    CHECK( scheduler.enqueue("$IIXDR,V,13.10,V,Engine*0B", 26, 0) );
+    CHECK( scheduler.enqueue("$IIXDR,V,12.40,V,Supply*54", 26, 0) );
+    CHECK( scheduler.pending() == 2 );
+    CHECK( countEvents(KBoxEventNMEA1TXCoalesced) == coalesced + 1 );
+  }
+
+  SECTION("Higher priorities are sent first") {
+    CHECK( scheduler.enqueue("$IIXDR,A,1.0,D,PTCH,A,2.0,D,ROLL*63", 35, 0) );
+    CHECK( scheduler.enqueue("$IIHDM,12.3,M*2F", 16, 10) );
+    CHECK( scheduler.enqueue("$IIDPT,2.40,0.00*5A", 19, 20) );
+
+    CHECK( scheduler.flush(out, 40, 30) == 2 );
+    CHECK( out.printed == "$IIDPT,2.40,0.00*5A\r\n$IIHDM,12.3,M*2F\r\n" );
+    CHECK( scheduler.pending() == 1 );
+  }
+
+  SECTION("Oldest sentence first when priorities are equal") {
+    CHECK( scheduler.enqueue("$IIMWV,90.0,R,5.00,M,A*03", 25, 0) );
+    CHECK( scheduler.enqueue("$IIDPT,2.40,0.00*5A", 19, 10) );
+    CHECK( scheduler.enqueue("$IIMWV,91.0,R,5.00,M,A*02", 25, 20) );
+    CHECK( scheduler.flush(out, 30, 30) == 1 );
+    CHECK( out.printed == "$IIMWV,91.0,R,5.00,M,A*02\r\n" );
+  }
+
+  SECTION("Sentences wait for room in the UART") {
+    CHECK( scheduler.enqueue("$IIHDM,12.3,M*2F", 16, 0) );
+    CHECK( scheduler.flush(out, 17, 0) == 0 );
+    CHECK( out.printed == "" );
+    CHECK( scheduler.flush(out, 18, 10) == 1 );
+    CHECK( countEvents(KBoxEventNMEA1TXOverflow) == dropped );
+  }
+
+  SECTION("Maximum rate") {
+    config.hdm.maxRate = 2;
+    NMEAOutputScheduler limited(config, 0, KBoxEventNMEA1TX, KBoxEventNMEA1TXOverflow, KBoxEventNMEA1TXCoalesced);
+
+    CHECK( limited.enqueue("$IIHDM,12.3,M*2F", 16, 0) );
+    CHECK( limited.flush(out, 1000, 0) == 1 );
+
+    CHECK( limited.enqueue("$IIHDM,12.4,M*28", 16, 100) );
+    CHECK( limited.enqueue("$IIDPT,2.40,0.00*5A", 19, 100) );
+    CHECK( limited.flush(out, 1000, 100) == 1 );
+    CHECK( limited.enqueue("$IIHDM,12.5,M*29", 16, 200) );
+    CHECK( limited.flush(out, 1000, 499) == 0 );
+    CHECK( limited.flush(out, 1000, 500) == 1 );
+    CHECK( out.printed == "$IIHDM,12.3,M*2F\r\n$IIDPT,2.40,0.00*5A\r\n$IIHDM,12.5,M*29\r\n" );
+  }
+
+  SECTION("Baud rate budget") {
+    // 4800 baud is 480 bytes per second. Two full sentences can be sent in a
+    // burst.
+    NMEAOutputScheduler slow(config, 4800, KBoxEventNMEA1TX, KBoxEventNMEA1TXOverflow, KBoxEventNMEA1TXCoalesced);
+    char sentence[80];
+    for (int i = 0; i < 8; i++) {
+      // 26 characters + <CR><LF>
+      snprintf(sentence, sizeof(sentence), "$IIXDR,V,12.42,V,Batt%i*00", i);
+      CHECK( slow.enqueue(sentence, strlen(sentence), 0) );
+    }
+    CHECK( slow.flush(out, 1000, 0) == 6 );
+    CHECK( slow.flush(out, 1000, 10) == 0 );
+    // 28 bytes need 58.3ms
+    CHECK( slow.flush(out, 1000, 59) == 1 );
+    CHECK( slow.flush(out, 1000, 1000) == 1 );
+    CHECK( slow.pending() == 0 );
+  }
+
+  SECTION("Less important sentences are dropped when too many are waiting") {
+    char sentence[80];
+    for (int i = 0; i < maxSentences; i++) {
+      snprintf(sentence, sizeof(sentence), "$IIXDR,V,12.42,V,Batt%i*00", i);
+      CHECK( scheduler.enqueue(sentence, strlen(sentence), i) );
+    }
+    CHECK( !scheduler.enqueue("$IIXDR,V,12.42,V,Other*00", 25, 100) );
+    CHECK( countEvents(KBoxEventNMEA1TXOverflow) == dropped + 1 );
+
+    CHECK( scheduler.enqueue("$IIDPT,2.40,0.00*5A", 19, 100) );
+    CHECK( countEvents(KBoxEventNMEA1TXOverflow) == dropped + 2 );
+    CHECK( scheduler.pending() == maxSentences );
+
+    // The oldest XDR was replaced.
+    CHECK( scheduler.flush(out, 1000, 200) == maxSentences );
+    CHECK( out.printed.indexOf("Batt0") < 0 );
+    CHECK( out.printed.indexOf("Batt1") > 0 );
+    CHECK( out.printed.startsWith("$IIDPT") );
+  }
+
+  SECTION("Sentences that were sent make room for new ones") {
+    char sentence[80];
+    for (int i = 0; i < maxSentences; i++) {
+      snprintf(sentence, sizeof(sentence), "$IIXDR,V,12.42,V,Batt%i*00", i);
+      CHECK( scheduler.enqueue(sentence, strlen(sentence), i) );
+    }
+    CHECK( scheduler.flush(out, 1000, 100) == maxSentences );
+    CHECK( scheduler.enqueue("$IIXDR,V,12.42,V,Other*00", 25, 100) );
+    CHECK( countEvents(KBoxEventNMEA1TXOverflow) == dropped );
+  }
+
+  SECTION("Invalid sentences are dropped") {
+    CHECK( !scheduler.enqueue("IIHDM,12.3,M*2F", 15, 0) );
+    CHECK( !scheduler.enqueue("", 0, 0) );
+    String tooLong = "$IIXDR,";
+    while (tooLong.length() < NMEAFixedSentence::Capacity) {
+      tooLong += "A";
+    }
+    CHECK( !scheduler.enqueue(tooLong.c_str(), tooLong.length(), 0) );
+    CHECK( countEvents(KBoxEventNMEA1TXOverflow) == dropped + 3 );
+    CHECK( scheduler.pending() == 0 );
+  }
+}
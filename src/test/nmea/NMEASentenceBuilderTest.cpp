@@ -24,10 +24,12 @@
 
 #include "../KBoxTest.h"
 #include "common/nmea/NMEASentenceBuilder.h"
+#include "../KBoxTestAllocations.h"
+#include <stdlib.h>
 
 TEST_CASE("generating an empty sentence") {
   NMEASentenceBuilder sb("GG", "ABC", 0);
-  REQUIRE( sb.toNMEA() == "$GGABC*40" );
+  REQUIRE( sb.toSentence().toString() == "$GGABC*40" );
 }
 
 TEST_CASE("generating a sentence with one string and one float") {
@@ -35,7 +37,7 @@ TEST_CASE("generating a sentence with one string and one float") {
   sb.setField(1, 1.03403303, 5);
   sb.setField(2, "toto");
 
-  REQUIRE( sb.toNMEA() == "$GGABC,1.03403,toto*6B" );
+  REQUIRE( sb.toSentence().toString() == "$GGABC,1.03403,toto*6B" );
 }
 
 TEST_CASE("test a real nmea sentence to make sure the checksum is properly generated") {
@@ -54,5 +56,84 @@ TEST_CASE("test a real nmea sentence to make sure the checksum is properly gener
   sb.setField(11, "");
   sb.setField(12, "D");
 
-  REQUIRE( sb.toNMEA() == "$GPRMC,003516.000,A,3751.6035,N,12228.8065,W,0.01,0.00,030416,,,D*79" );
+  REQUIRE( sb.toSentence().toString() == "$GPRMC,003516.000,A,3751.6035,N,12228.8065,W,0.01,0.00,030416,,,D*79" );
+}
+
+TEST_CASE("fields are appended in order and skipped fields are empty") {
+  NMEASentenceBuilder sb("II", "DPT", 3);
+  sb.setField(2, "b");
+  sb.setField(1, "a");
+  sb.setField(2, "c");
+  sb.setField(4, "d");
+
+  CHECK( sb.toSentence().toString() == "$IIDPT,,b,*0E" );
+  CHECK( !sb.hasOverflowed() );
+}
+
+TEST_CASE("fields that do not fit are left empty") {
+  NMEASentenceBuilder sb("GG", "ABC", 3);
+  String longValue;
+  for (int i = 0; i < 90; i++) {
+    longValue += "x";
+  }
+  sb.setField(1, "a");
+  sb.setField(2, longValue);
+  sb.setField(3, "b");
+
+  CHECK( sb.toSentence().toString() == "$GGABC,a,,b*6F" );
+  CHECK( sb.hasOverflowed() );
+  const size_t capacity = NMEAFixedSentence::Capacity;
+  CHECK( sb.toSentence().length() < capacity );
+}
+
+TEST_CASE("formatting floats like String(float, precision)") {
+  static const float values[] = {
+    0, -0.0, 0.05, 0.15, 0.25, 0.5, 1.5, 2.5, -0.001, -0.05, 9.995, 99.95,
+    1.03403303, 1013.25, 359.99, 0.000001, 16777216, 123456789.0, 1e10, -1e10,
+    NAN, INFINITY, -INFINITY
+  };
+
+  for (float v : values) {
+    for (int precision = 0; precision <= 10; precision++) {
+      NMEASentenceBuilder sb("GG", "ABC", 1);
+      sb.setField(1, v, precision);
+      NMEASentenceBuilder expected("GG", "ABC", 1);
+      expected.setField(1, String(v, precision));
+      INFO( "value: " << String(v, precision).c_str() << " precision: " << precision );
+      CHECK( sb.toSentence().toString() == expected.toSentence().toString() );
+    }
+  }
+
+  srand(42);
+  int mismatches = 0;
+  for (int i = 0; i < 100000; i++) {
+    float v = (float)rand() / RAND_MAX * 2000 - 1000;
+    if (i % 2) {
+      v /= 1000;
+    }
+    int precision = i % 6;
+    NMEASentenceBuilder sb("GG", "ABC", 1);
+    sb.setField(1, v, precision);
+    NMEASentenceBuilder expected("GG", "ABC", 1);
+    expected.setField(1, String(v, precision));
+    if (sb.toSentence() != expected.toSentence().c_str()) {
+      mismatches++;
+    }
+  }
+  CHECK( mismatches == 0 );
+}
+
+TEST_CASE("building a sentence does not allocate memory") {
+  KBoxTestAllocations allocations;
+  NMEASentenceBuilder sb("II", "MWV", 5);
+  sb.setField(1, 271.3f, 1);
+  sb.setField(2, "R");
+  sb.setField(3, 12.47f, 2);
+  sb.setField(4, "M");
+  sb.setField(5, "A");
+  const NMEAFixedSentence &sentence = sb.toSentence();
+  size_t allocated = allocations.total();
+
+  CHECK( allocated == 0 );
+  CHECK( sentence == "$IIMWV,271.3,R,12.47,M,A*39" );
 }
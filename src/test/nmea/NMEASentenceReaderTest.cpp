@@ -24,7 +24,11 @@
 
 #include "common/nmea/NMEASentenceReader.h"
 #include "../KBoxTest.h"
+#include "../KBoxTestAllocations.h"
 #include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 // We have a conflict here between KBox which uses math.h and Catch which uses cmath
 #define isnan(x) std::isnan(x)
@@ -123,5 +127,158 @@ TEST_CASE("NMEASentenceReader") {
     CHECK( isnan(r.getFieldAsLatLon(4)) );
 
   }
-}
 
+  SECTION("Fields are views on the sentence") {
+    String sentence("$GPRMC,144629.20,A,5156.91111,N,00434.80385,E,0.295,,011113,,,A*78");
+
+    KBoxTestAllocations allocations;
+    NMEASentenceReader r(sentence);
+    bool valid = r.isValid();
+    NMEAField talker = r.getTalkerId();
+    NMEAField code = r.getSentenceCode();
+    NMEAField time = r.getField(1);
+    NMEAField empty = r.getField(8);
+    NMEAField last = r.getField(12);
+    double latitude = r.getFieldAsLatLon(3);
+    unsigned long count = allocations.total();
+
+    CHECK( count == 0 );
+    CHECK( valid );
+    CHECK( talker == "GP" );
+    CHECK( code == "RMC" );
+    CHECK( time == "144629.20" );
+    CHECK( time.getData() == sentence.c_str() + 7 );
+    CHECK( empty.isEmpty() );
+    CHECK( last == "A" );
+    CHECK( r.getField(13).isEmpty() );
+    CHECK( latitude == Approx(51.9485185) );
+
+    char buffer[5];
+    CHECK( time.copyTo(buffer, sizeof(buffer)) == 4 );
+    CHECK( String(buffer) == "1446" );
+    CHECK( time.toString() == "144629.20" );
+  }
+
+  SECTION("Address field") {
+    NMEASentenceReader r("$PGRME,15.0,M,45.0,M,25.0,M*1C");
+
+    CHECK( r.getField(0) == "PGRME" );
+    CHECK( r.getTalkerId() == "PG" );
+    CHECK( r.getSentenceCode() == "RME" );
+  }
+
+  SECTION("Last field without checksum separator") {
+    NMEASentenceReader r("$GPDPT,1.2,0.3");
+
+    CHECK( ! r.isValid() );
+    CHECK( r.countFields() == 2 );
+    CHECK( r.getFieldAsDouble(1) == 1.2 );
+    CHECK( isnan(r.getFieldAsDouble(2)) );
+  }
+
+  SECTION("Checksum is verified with the fields") {
+    NMEASentenceReader valid("$IIDPT,0.90,1.2*7A");
+    NMEASentenceReader invalid("$IIDPT,0.90,1.3*7A");
+    NMEASentenceReader shortChecksum("$IIDPT,0.90,1.2*7");
+
+    CHECK( valid.isValid() );
+    CHECK( ! invalid.isValid() );
+    CHECK( ! shortChecksum.isValid() );
+  }
+
+  SECTION("More than MaxFields fields") {
+    const int maxFields = NMEASentenceReader::MaxFields;
+    String sentence("$XXTST");
+    for (int i = 1; i <= maxFields + 2; i++) {
+      sentence += ",";
+      sentence += i;
+    }
+    sentence += "*";
+
+    NMEASentenceReader r(sentence);
+    CHECK( r.countFields() == maxFields );
+    CHECK( r.getFieldAsDouble(1) == 1 );
+    CHECK( r.getFieldAsDouble(maxFields) == maxFields );
+    CHECK( r.getField(maxFields) == "40" );
+    CHECK( r.getField(maxFields + 1).isEmpty() );
+  }
+
+  SECTION("Numbers are decoded exactly like strtod()") {
+    const char *numbers[] = {
+      "0", "-0", "+0", "0.0", "-0.000", "1", "0.1", "0.295", "5156.91111", "00434.80385",
+      "-10.6", "4916.45", "12311.12", "054.7", "020.3", "0.90", "1.2", "168.1", "5.6",
+      "30.0", "3750.1128", "12225.5299", "101325", "1013.25", "0.00001", "123456789.123456",
+      "9007199254740991", "9007199254740993", "0.1234567890123456789", "1.", ".5", "-.5",
+      "1e3", "1E-2", "0x1A", " 12", "12abc", "abc", ".", "-", "+", "1.2.3", "inf", "nan"
+    };
+
+    for (const char *number : numbers) {
+      String sentence = String("$XXTST,") + number + ",N*";
+      NMEASentenceReader r(sentence);
+      double expected = strtod(number, 0);
+      double value = r.getFieldAsDouble(1);
+
+      INFO( number );
+      CHECK( memcmp(&value, &expected, sizeof(double)) == 0 );
+    }
+  }
+
+  SECTION("Random numbers are decoded exactly like strtod()") {
+    uint32_t seed = 42;
+    int mismatches = 0;
+
+    for (int i = 0; i < 100000; i++) {
+      // Numbers with up to 16 digits and up to 10 decimals
+      char number[32];
+      int n = 0;
+      seed = seed * 1103515245 + 12345;
+      if (seed & 0x10000) {
+        number[n++] = '-';
+      }
+      int digits = 1 + (seed >> 20) % 16;
+      int dot = (seed >> 8) % 11;
+      for (int d = 0; d < digits; d++) {
+        seed = seed * 1103515245 + 12345;
+        if (d == digits - dot && dot > 0) {
+          number[n++] = '.';
+        }
+        number[n++] = '0' + (seed >> 16) % 10;
+      }
+      number[n] = '\0';
+
+      char sentence[64];
+      snprintf(sentence, sizeof(sentence), "$XXTST,%s*", number);
+      NMEASentenceReader r(sentence);
+      double expected = strtod(number, 0);
+      double value = r.getFieldAsDouble(1);
+      if (memcmp(&value, &expected, sizeof(double)) != 0) {
+        mismatches++;
+      }
+    }
+    CHECK( mismatches == 0 );
+  }
+
+  SECTION("Angles are decoded like before") {
+    const char *angles[] = {
+      "5156.91111", "00434.80385", "3750.1128", "12225.5299", "4916.45", "12311.12",
+      "2832.1834", "08101.0536", "002.1834", "1.0536", "0000.0000", "8959.9999", "17959.99999"
+    };
+
+    for (const char *angle : angles) {
+      String sentence = String("$XXTST,") + angle + ",N*";
+      NMEASentenceReader r(sentence);
+
+      // Previous implementation
+      String value(angle);
+      int degreesDigits = value.indexOf('.') - 2;
+      if (degreesDigits < 0) {
+        degreesDigits = 0;
+      }
+      double expected = value.substring(0, degreesDigits).toInt() + strtod(value.substring(degreesDigits).c_str(), 0) / 60;
+      double latlon = r.getFieldAsLatLon(1);
+
+      INFO( angle );
+      CHECK( memcmp(&latlon, &expected, sizeof(double)) == 0 );
+    }
+  }
+}
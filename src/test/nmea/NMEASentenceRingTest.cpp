@@ -0,0 +1,118 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "../KBoxTest.h"
+#include "../KBoxTestAllocations.h"
+#include "common/nmea/NMEASentenceRing.h"
+
+static bool push(NMEASentenceRing<4> &ring, const char *s, uint32_t timestamp = 0) {
+  return ring.push(s, strlen(s), timestamp);
+}
+
+TEST_CASE("NMEASentenceRing") {
+  NMEASentenceRing<4> ring;
+
+  SECTION("empty ring") {
+    CHECK( ring.size() == 0 );
+    CHECK( ring.peek() == nullptr );
+    ring.pop();
+    CHECK( ring.size() == 0 );
+  }
+
+  SECTION("sentences come out in order with their timestamp") {
+    CHECK( push(ring, "$IIDPT,0.90,1.2*7A", 42) );
+    CHECK( push(ring, "$WIMWV,168.1,R,5.6,K,A*2B", 43) );
+    CHECK( ring.size() == 2 );
+
+    const NMEASentenceRing<4>::Slot *slot = ring.peek();
+    REQUIRE( slot != nullptr );
+    CHECK( strcmp(slot->sentence, "$IIDPT,0.90,1.2*7A") == 0 );
+    CHECK( slot->length == strlen("$IIDPT,0.90,1.2*7A") );
+    CHECK( slot->timestamp == 42 );
+    ring.pop();
+
+    slot = ring.peek();
+    REQUIRE( slot != nullptr );
+    CHECK( strcmp(slot->sentence, "$WIMWV,168.1,R,5.6,K,A*2B") == 0 );
+    CHECK( slot->timestamp == 43 );
+    ring.pop();
+
+    CHECK( ring.peek() == nullptr );
+  }
+
+  SECTION("overflow") {
+    for (int i = 0; i < 4; i++) {
+      CHECK( push(ring, "$A") );
+    }
+    CHECK( ! push(ring, "$B") );
+    CHECK( ! push(ring, "$C") );
+    CHECK( ring.size() == 4 );
+    CHECK( ring.overflows() == 2 );
+
+    // Dropped sentences do not replace the ones already queued.
+    CHECK( strcmp(ring.peek()->sentence, "$A") == 0 );
+
+    ring.pop();
+    CHECK( push(ring, "$D") );
+    CHECK( ring.overflows() == 2 );
+  }
+
+  SECTION("sentences longer than the NMEA maximum are rejected") {
+    char sentence[NMEASentenceRing<4>::MaxSentenceLength + 1];
+    memset(sentence, 'A', sizeof(sentence));
+
+    CHECK( ring.push(sentence, sizeof(sentence) - 2, 0) );
+    CHECK( ! ring.push(sentence, sizeof(sentence) - 1, 0) );
+    CHECK( ring.size() == 1 );
+    CHECK( ring.overflows() == 0 );
+  }
+
+  SECTION("wraps around without allocating memory") {
+    KBoxTestAllocations allocations;
+    bool ok = true;
+    char expected[8];
+
+    // More than 65536 sentences to also wrap the 16 bits counters
+    for (uint32_t i = 0; i < 70000; i++) {
+      char sentence[8];
+      snprintf(sentence, sizeof(sentence), "$%u", (unsigned)i);
+      ok = ok && ring.push(sentence, strlen(sentence), i);
+      if (i % 3 == 2) {
+        for (int j = 0; j < 3; j++) {
+          snprintf(expected, sizeof(expected), "$%u", (unsigned)(i - 2 + j));
+          ok = ok && ring.peek() != nullptr && strcmp(ring.peek()->sentence, expected) == 0
+            && ring.peek()->timestamp == i - 2 + j;
+          ring.pop();
+        }
+      }
+    }
+    unsigned long count = allocations.total();
+
+    CHECK( ok );
+    CHECK( count == 0 );
+    CHECK( ring.overflows() == 0 );
+  }
+}
@@ -0,0 +1,128 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <string.h>
+#include "common/signalk/SKAISParser.h"
+#include "common/signalk/SKUnits.h"
+#include "../KBoxTest.h"
+
+// We have a conflict here between KBox which uses math.h and Catch which uses cmath
+#define isnan(x) std::isnan(x)
+
+TEST_CASE("SKAISParser") {
+  AISTargetTable targets;
+  SKAISParser p(targets);
+
+  SECTION("Invalid sentences") {
+    CHECK( p.parse(SKSourceInputNMEA0183_1, "mambo jumbo", SKTime(0), 0).getSize() == 0 );
+    CHECK( p.parse(SKSourceInputNMEA0183_1, "!AIVDM,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5D", SKTime(0), 0).getSize() == 0 );
+    CHECK( p.parse(SKSourceInputNMEA0183_1, "$SDDBT,8.1,f,2.4,M,1.3,F*0B", SKTime(0), 0).getSize() == 0 );
+    CHECK( targets.size() == 0 );
+  }
+
+  SECTION("Our own vessel (VDO) is ignored") {
+    CHECK( p.parse(SKSourceInputNMEA0183_1, "!AIVDO,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5E", SKTime(0), 0).getSize() == 0 );
+    CHECK( targets.size() == 0 );
+  }
+
+  SECTION("Class A position report") {
+    const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "!AIVDM,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5C", SKTime(0), 1000);
+
+    CHECK( update.getSize() == 5 );
+    CHECK( update.getContext() != SKContextSelf );
+    CHECK( update.getContext().getURN() == "urn:mrn:imo:mmsi:366053209" );
+    CHECK( strcmp(update.getSource().getTalker(), "AI") == 0 );
+    CHECK( strcmp(update.getSource().getSentence(), "VDM") == 0 );
+
+    CHECK( update.getNavigationPosition().latitude == Approx(37.802118).epsilon(0.000001) );
+    CHECK( update.getNavigationPosition().longitude == Approx(-122.341618).epsilon(0.000001) );
+    CHECK( update.getNavigationCourseOverGroundTrue() == Approx(SKDegToRad(219.3)) );
+    CHECK( update.getNavigationSpeedOverGround() == 0 );
+    CHECK( update.getNavigationHeadingTrue() == Approx(SKDegToRad(1)) );
+    CHECK( update.getNavigationRateOfTurn() == 0 );
+
+    REQUIRE( targets.size() == 1 );
+    CHECK( targets[0].mmsi == 366053209 );
+    CHECK( targets[0].lastSeen == 1000 );
+    CHECK( !targets[0].classB );
+  }
+
+  SECTION("Class A static data") {
+    CHECK( p.parse(SKSourceInputNMEA0183_1, "!AIVDM,2,1,1,A,55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8,0*1C", SKTime(0), 0).getSize() == 0 );
+    CHECK( targets.size() == 0 );
+
+    // Static data is only kept in the target table.
+    CHECK( p.parse(SKSourceInputNMEA0183_1, "!AIVDM,2,2,1,A,88888888880,2*25", SKTime(0), 10).getSize() == 0 );
+
+    const AISTarget *target = targets.find(351759000);
+    REQUIRE( target != nullptr );
+    CHECK( strcmp(target->name, "EVER DIADEM") == 0 );
+    CHECK( strcmp(target->callsign, "3FOF8") == 0 );
+    CHECK( target->shipType == 70 );
+    CHECK( target->length == 295 );
+    CHECK( target->beam == 32 );
+    CHECK( target->draught == 122 );
+    CHECK( isnan(target->latitude) );
+  }
+
+  SECTION("Class B position report") {
+    const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "!AIVDM,1,1,,A,B52K>;h00Fc>jpUlNV@ikwpUoP06,0*4C", SKTime(0), 0);
+
+    // Heading is not available.
+    CHECK( update.getSize() == 3 );
+    CHECK( update.getContext().getURN() == "urn:mrn:imo:mmsi:338087471" );
+    CHECK( update.getNavigationPosition().latitude == Approx(40.68454).epsilon(0.000001) );
+    CHECK( update.getNavigationPosition().longitude == Approx(-74.0721317).epsilon(0.000001) );
+    CHECK( update.getNavigationCourseOverGroundTrue() == Approx(SKDegToRad(79.6)) );
+    CHECK( update.getNavigationSpeedOverGround() == Approx(SKKnotToMs(0.1)) );
+    CHECK( !update.hasNavigationHeadingTrue() );
+
+    REQUIRE( targets.size() == 1 );
+    CHECK( targets[0].classB );
+  }
+
+  SECTION("Class B static data") {
+    CHECK( p.parse(SKSourceInputNMEA0183_1, "!AIVDM,1,1,,A,H42O55i18tMET00000000000000,2*6D", SKTime(0), 0).getSize() == 0 );
+    CHECK( p.parse(SKSourceInputNMEA0183_1, "!AIVDM,1,1,,A,H42O55lti4hhhilD3nink000?050,0*40", SKTime(0), 0).getSize() == 0 );
+
+    const AISTarget *target = targets.find(271041815);
+    REQUIRE( target != nullptr );
+    CHECK( target->classB );
+    CHECK( strcmp(target->name, "PROGUY") == 0 );
+    CHECK( strcmp(target->callsign, "TC6163") == 0 );
+    CHECK( target->shipType == 60 );
+    CHECK( target->length == 15 );
+    CHECK( target->beam == 5 );
+  }
+
+  SECTION("The context follows the last target") {
+    const SKUpdate &first = p.parse(SKSourceInputNMEA0183_1, "!AIVDM,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5C", SKTime(0), 0);
+    CHECK( first.getContext().getURN() == "urn:mrn:imo:mmsi:366053209" );
+
+    const SKUpdate &second = p.parse(SKSourceInputNMEA0183_1, "!AIVDM,1,1,,A,B52K>;h00Fc>jpUlNV@ikwpUoP06,0*4C", SKTime(0), 0);
+    CHECK( second.getContext().getURN() == "urn:mrn:imo:mmsi:338087471" );
+    CHECK( targets.size() == 2 );
+  }
+}
@@ -0,0 +1,196 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "../KBoxTest.h"
+#include "common/signalk/SKDataModel.h"
+#include "common/signalk/SKUpdateStatic.h"
+#include "../KBoxTestAllocations.h"
+
+class CountingDataModelVisitor : public SKDataModelVisitor {
+  public:
+    int count = 0;
+
+    void visit(const SKDataModelEntry &entry) override {
+      count++;
+    };
+};
+
+TEST_CASE("SKDataModel") {
+  SKDataModel model(4);
+  SKSource gps = SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "GP", "RMC");
+  SKSource n2k = SKSource::sourceForNMEA2000(SKSourceInputNMEA2000, 129026, 2, 42);
+
+  SKUpdateStatic<2> u1;
+  u1.setSource(gps);
+  u1.setTimestamp(SKTime(1000));
+  u1.setNavigationSpeedOverGround(4.2);
+  u1.setNavigationCourseOverGroundTrue(1.2);
+
+  CHECK( model.getSize() == 0 );
+  CHECK( model.getSequence() == 0 );
+  CHECK( model.getLatest(SKPathNavigationSpeedOverGround) == nullptr );
+
+  SECTION("Store latest values") {
+    model.updateReceived(u1);
+
+    CHECK( model.getSize() == 2 );
+    CHECK( model.getSequence() == 1 );
+
+    const SKDataModelEntry *e = model.get(SKPathNavigationSpeedOverGround, gps);
+    REQUIRE( e != nullptr );
+    CHECK( e->value == 4.2 );
+    CHECK( e->source == gps );
+    CHECK( e->timestamp == SKTime(1000) );
+    CHECK( e->sequence == 1 );
+    CHECK( model.get(SKPathNavigationSpeedOverGround, n2k) == nullptr );
+
+    SKUpdateStatic<1> u2;
+    u2.setSource(gps);
+    u2.setTimestamp(SKTime(1001));
+    u2.setNavigationSpeedOverGround(4.5);
+    model.updateReceived(u2);
+
+    CHECK( model.getSize() == 2 );
+    e = model.get(SKPathNavigationSpeedOverGround, gps);
+    CHECK( e->value == 4.5 );
+    CHECK( e->timestamp == SKTime(1001) );
+    CHECK( e->sequence == 2 );
+  }
+
+  SECTION("Latest value across sources") {
+    SKUpdateStatic<1> u2;
+    u2.setSource(n2k);
+    u2.setNavigationSpeedOverGround(5.0);
+
+    model.updateReceived(u1);
+    model.updateReceived(u2);
+
+    CHECK( model.getSize() == 3 );
+    CHECK( model.getLatest(SKPathNavigationSpeedOverGround)->value == 5.0 );
+    CHECK( model.getLatest(SKPathNavigationSpeedOverGround)->source == n2k );
+
+    model.updateReceived(u1);
+    CHECK( model.getLatest(SKPathNavigationSpeedOverGround)->value == 4.2 );
+  }
+
+  SECTION("Indexed paths") {
+    SKUpdateStatic<2> u2;
+    u2.setElectricalBatteriesVoltage("engine", 12.1);
+    u2.setElectricalBatteriesVoltage("house", 12.6);
+    model.updateReceived(u2);
+
+    CHECK( model.getLatest(SKPath(SKPathElectricalBatteriesVoltage, "engine"))->value == 12.1 );
+    CHECK( model.getLatest(SKPath(SKPathElectricalBatteriesVoltage, "house"))->value == 12.6 );
+    CHECK( model.getLatest(SKPath(SKPathElectricalBatteriesVoltage, "dc3")) == nullptr );
+  }
+
+  SECTION("Changed since") {
+    model.updateReceived(u1);
+    uint32_t seen = model.getSequence();
+
+    CountingDataModelVisitor all;
+    model.accept(all);
+    CHECK( all.count == 2 );
+
+    CountingDataModelVisitor changed;
+    model.acceptChangedSince(changed, seen);
+    CHECK( changed.count == 0 );
+
+    SKUpdateStatic<1> u2;
+    u2.setSource(gps);
+    u2.setNavigationCourseOverGroundTrue(1.3);
+    model.updateReceived(u2);
+
+    model.acceptChangedSince(changed, seen);
+    CHECK( changed.count == 1 );
+  }
+
+  SECTION("Updates about other vessels are ignored") {
+    model.updateReceived(u1);
+
+    SKContext target("urn:mrn:imo:mmsi:366053209");
+    SKUpdateStatic<2> ais(target);
+    ais.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "AI", "VDM"));
+    ais.setTimestamp(SKTime(1001));
+    ais.setNavigationSpeedOverGround(12.3);
+    ais.setNavigationCourseOverGroundTrue(0.5);
+    model.updateReceived(ais);
+
+    CHECK( model.getSize() == 2 );
+    CHECK( model.getSequence() == 1 );
+    CHECK( model.getLatest(SKPathNavigationSpeedOverGround)->value.getNumberValue() == 4.2 );
+    CHECK( model.get(SKPathNavigationSpeedOverGround, ais.getSource()) == nullptr );
+  }
+
+  SECTION("Full model") {
+    SKUpdateStatic<2> u2;
+    u2.setSource(n2k);
+    u2.setNavigationSpeedOverGround(5.0);
+    u2.setNavigationCourseOverGroundTrue(1.0);
+    SKUpdateStatic<1> u3;
+    u3.setNavigationHeadingMagnetic(2.0);
+
+    model.updateReceived(u1);
+    model.updateReceived(u2);
+    model.updateReceived(u3);
+
+    CHECK( model.getSize() == 4 );
+    CHECK( model.getDroppedCount() == 1 );
+    CHECK( model.getLatest(SKPathNavigationHeadingMagnetic) == nullptr );
+
+    // Existing entries are still updated
+    model.updateReceived(u1);
+    CHECK( model.getDroppedCount() == 1 );
+    CHECK( model.getLatest(SKPathNavigationSpeedOverGround)->value == 4.2 );
+
+    model.clear();
+    CHECK( model.getSize() == 0 );
+    model.updateReceived(u3);
+    CHECK( model.getLatest(SKPathNavigationHeadingMagnetic)->value == 2.0 );
+  }
+
+  SECTION("No allocation when receiving updates") {
+    KBoxTestAllocations allocations;
+    model.updateReceived(u1);
+    model.updateReceived(u1);
+    unsigned long count = allocations.total();
+
+    CHECK( count == 0 );
+  }
+}
+
+TEST_CASE("SKDataModel capacity") {
+  uint16_t maxCapacity = SKDataModel::MaxCapacity;
+
+  SKDataModel largest(maxCapacity);
+  CHECK( largest.getCapacity() == maxCapacity );
+
+  SKDataModel tooLarge(40000);
+  CHECK( tooLarge.getCapacity() == maxCapacity );
+
+  SKUpdateStatic<1> u;
+  u.setNavigationSpeedOverGround(4.2);
+  tooLarge.updateReceived(u);
+  CHECK( tooLarge.getLatest(SKPathNavigationSpeedOverGround) != nullptr );
+}
@@ -24,15 +24,19 @@
 
 #include "../KBoxTest.h"
 #include "common/signalk/SKHub.h"
+#include "common/signalk/SKSourceMultiplexer.h"
 #include "common/signalk/SKSubscriber.h"
 #include "common/signalk/SKUpdateStatic.h"
+#include "common/stats/KBoxMetrics.h"
 
 class TestSubscriber : public SKSubscriber {
   public:
     bool notified = false;
+    int count = 0;
 
     void updateReceived(const SKUpdate& s) {
       notified = true;
+      count++;
     };
 };
 
@@ -49,3 +53,254 @@ TEST_CASE("SKHub") {
     CHECK( sub.notified );
   }
 }
+
+TEST_CASE("SKHub with filters") {
+  SKHub hub;
+  TestSubscriber all;
+  TestSubscriber depth;
+  TestSubscriber batteries;
+  TestSubscriber notNMEA2000;
+  TestSubscriber onlyIMU;
+  TestSubscriber nothing;
+
+  hub.subscribe(&all);
+  hub.subscribe(&depth, SKSubscriptionFilter().addPath(SKPathEnvironmentDepthBelowTransducer));
+  hub.subscribe(&batteries, SKSubscriptionFilter().addPath(SKPathElectricalBatteriesVoltage));
+  hub.subscribe(&notNMEA2000, SKSubscriptionFilter::allPaths().excludeSourceInput(SKSourceInputNMEA2000));
+  hub.subscribe(&onlyIMU, SKSubscriptionFilter::allPaths().addSourceInput(SKSourceInputKBoxIMU));
+  hub.subscribe(&nothing, SKSubscriptionFilter());
+
+  SECTION("path filter") {
+    SKUpdateStatic<2> update;
+    update.setEnvironmentDepthBelowTransducer(4.2);
+    update.setNavigationHeadingMagnetic(1);
+
+    hub.publish(update);
+
+    CHECK( all.count == 1 );
+    CHECK( depth.count == 1 );
+    CHECK( batteries.count == 0 );
+    CHECK( notNMEA2000.count == 1 );
+    CHECK( onlyIMU.count == 0 );
+    CHECK( nothing.count == 0 );
+  }
+
+  SECTION("indexed paths match all indexes") {
+    SKUpdateStatic<2> update;
+    update.setElectricalBatteriesVoltage("house", 12.4);
+    update.setElectricalBatteriesVoltage("engine", 12.6);
+
+    hub.publish(update);
+
+    CHECK( depth.count == 0 );
+    CHECK( batteries.count == 1 );
+  }
+
+  SECTION("source filter") {
+    SKUpdateStatic<1> update;
+    update.setSource(SKSource::sourceForNMEA2000(SKSourceInputNMEA2000, 128267, 3, 42));
+    update.setEnvironmentDepthBelowTransducer(4.2);
+
+    hub.publish(update);
+
+    CHECK( depth.count == 1 );
+    CHECK( notNMEA2000.count == 0 );
+    CHECK( onlyIMU.count == 0 );
+
+    SKUpdateStatic<1> imuUpdate;
+    imuUpdate.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxIMU));
+    imuUpdate.setNavigationHeadingMagnetic(1);
+
+    hub.publish(imuUpdate);
+
+    CHECK( notNMEA2000.count == 1 );
+    CHECK( onlyIMU.count == 1 );
+  }
+
+  SECTION("empty update only goes to unfiltered subscribers") {
+    SKUpdateStatic<0> update;
+
+    hub.publish(update);
+
+    CHECK( all.count == 1 );
+    CHECK( notNMEA2000.count == 0 );
+  }
+}
+
+TEST_CASE("SKHub subscribers limit") {
+  SKHub hub;
+  TestSubscriber subs[SKHub::MaxSubscribers + 1];
+
+  for (int i = 0; i < SKHub::MaxSubscribers; i++) {
+    CHECK( hub.subscribe(&subs[i]) );
+  }
+  CHECK( !hub.subscribe(&subs[SKHub::MaxSubscribers]) );
+
+  SKUpdateStatic<0> update;
+  hub.publish(update);
+
+  CHECK( subs[0].count == 1 );
+  CHECK( subs[SKHub::MaxSubscribers - 1].count == 1 );
+  CHECK( subs[SKHub::MaxSubscribers].count == 0 );
+}
+
+class RecordingSubscriber : public SKSubscriber {
+  public:
+    int count = 0;
+    double lastSpeed = 0;
+    SKSource lastSource = SKSourceUnknown;
+
+    void updateReceived(const SKUpdate& u) {
+      count++;
+      lastSpeed = u.getNavigationSpeedOverGround();
+      lastSource = u.getSource();
+    };
+};
+
+TEST_CASE("SKHub queued mode") {
+  SKHub hub;
+  RecordingSubscriber sub;
+  TestSubscriber depth;
+  hub.subscribe(&sub, SKSubscriptionFilter().addPath(SKPathNavigationSpeedOverGround));
+  hub.subscribe(&depth, SKSubscriptionFilter().addPath(SKPathEnvironmentDepthBelowTransducer));
+  hub.enableQueue(2);
+
+  CHECK( hub.isQueued() );
+
+  SKSource gps = SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "GP", "RMC");
+  SKUpdateStatic<1> update;
+  update.setSource(gps);
+  update.setNavigationSpeedOverGround(4.2);
+
+  SECTION("updates are delivered by dispatchQueued") {
+    hub.publish(update);
+    CHECK( sub.count == 0 );
+    CHECK( hub.getQueueDepth() == 1 );
+
+    // The queue keeps a copy of the update
+    update.setNavigationSpeedOverGround(5.0);
+    hub.publish(update);
+
+    CHECK( hub.dispatchQueued() );
+    CHECK( sub.count == 1 );
+    CHECK( sub.lastSpeed == 4.2 );
+    CHECK( sub.lastSource == gps );
+    CHECK( hub.dispatchQueued() );
+    CHECK( sub.lastSpeed == 5.0 );
+    CHECK( !hub.dispatchQueued() );
+    CHECK( hub.getQueueDepth() == 0 );
+    CHECK( hub.getQueueHighWaterMark() == 2 );
+    CHECK( depth.count == 0 );
+  }
+
+  SECTION("updates without recipients are not queued") {
+    SKUpdateStatic<1> heading;
+    heading.setNavigationHeadingMagnetic(1.0);
+    hub.publish(heading);
+
+    CHECK( hub.getQueueDepth() == 0 );
+  }
+
+  SECTION("updates are dropped when the queue is full") {
+    uint32_t dropped = KBoxMetrics.countEvent(KBoxEventSKHubQueueDropped);
+    hub.publish(update);
+    hub.publish(update);
+    hub.publish(update);
+
+    CHECK( hub.getQueueDepth() == 2 );
+    CHECK( KBoxMetrics.countEvent(KBoxEventSKHubQueueDropped) == dropped + 1 );
+
+    while (hub.dispatchQueued()) {
+    }
+    CHECK( sub.count == 2 );
+  }
+
+  SECTION("updates for other contexts are delivered immediately") {
+    SKContext otherBoat("urn:mrn:imo:mmsi:123456789");
+    SKUpdateStatic<1> other(otherBoat);
+    other.setNavigationSpeedOverGround(3.0);
+    hub.publish(other);
+
+    CHECK( sub.count == 1 );
+    CHECK( hub.getQueueDepth() == 0 );
+  }
+}
+
+TEST_CASE("SKHub with a multiplexer") {
+  SKSourceMultiplexerConfig config;
+  SKSourceMultiplexer mux(config);
+  SKHub hub;
+  RecordingSubscriber sub;
+  TestSubscriber depth;
+  hub.subscribe(&sub);
+  hub.subscribe(&depth, SKSubscriptionFilter().addPath(SKPathEnvironmentDepthBelowTransducer));
+  hub.setMultiplexer(&mux);
+
+  SKUpdateStatic<1> n2k;
+  n2k.setSource(SKSource::sourceForNMEA2000(SKSourceInputNMEA2000, 129026, 2, 12));
+  n2k.setNavigationSpeedOverGround(4.2);
+  hub.publish(n2k);
+
+  SECTION("updates with only suppressed values are not delivered") {
+    SKUpdateStatic<1> nmea;
+    nmea.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "GP", "VTG"));
+    nmea.setNavigationSpeedOverGround(4.3);
+    hub.publish(nmea);
+
+    CHECK( sub.count == 1 );
+    CHECK( mux.suppressed() == 1 );
+  }
+
+  SECTION("suppressed values are removed from updates") {
+    SKSource nmeaSource = SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "II", "XXX");
+    SKUpdateStatic<2> nmea;
+    nmea.setSource(nmeaSource);
+    nmea.setNavigationSpeedOverGround(4.3);
+    nmea.setEnvironmentDepthBelowTransducer(12.0);
+    hub.publish(nmea);
+
+    CHECK( sub.count == 2 );
+    CHECK( sub.lastSource == nmeaSource );
+    CHECK( sub.lastSpeed != 4.3 );
+    CHECK( depth.count == 1 );
+  }
+
+  SECTION("updates too large to be filtered are delivered unchanged") {
+    SKUpdateStatic<SKHub::SelectedUpdateMaxValues + 1> large;
+    large.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "II", "XXX"));
+    large.setNavigationSpeedOverGround(4.3);
+    for (int i = 0; i < SKHub::SelectedUpdateMaxValues; i++) {
+      large.setValue(SKPath(SKPathElectricalBatteriesVoltage, (SKIndexId)(i + 1)), SKValue(12.0));
+    }
+    uint32_t notFiltered = KBoxMetrics.countEvent(KBoxEventSKHubUpdateNotFiltered);
+    hub.publish(large);
+
+    CHECK( sub.count == 2 );
+    CHECK( sub.lastSpeed == 4.3 );
+    CHECK( KBoxMetrics.countEvent(KBoxEventSKHubUpdateNotFiltered) == notFiltered + 1 );
+  }
+}
+
+TEST_CASE("SKSubscriptionFilter") {
+  SKSubscriptionFilter filter;
+
+  CHECK( !filter.matchesPath(SKPathNavigationAttitude) );
+  CHECK( filter.matchesSourceInput(SKSourceInputNMEA2000) );
+
+  filter.addPath(SKPathNavigationAttitude);
+  CHECK( filter.matchesPath(SKPathNavigationAttitude) );
+  CHECK( !filter.matchesPath(SKPathNavigationHeadingMagnetic) );
+
+  filter.addSourceInput(SKSourceInputKBoxIMU);
+  CHECK( filter.matchesSourceInput(SKSourceInputKBoxIMU) );
+  CHECK( !filter.matchesSourceInput(SKSourceInputNMEA2000) );
+
+  SKUpdateStatic<1> update;
+  update.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxIMU));
+  update.setNavigationAttitude(SKTypeAttitude(0, 0, 0));
+  CHECK( filter.matches(update) );
+
+  SKSubscriptionFilter all = SKSubscriptionFilter::allPaths();
+  CHECK( all.matchesPath(SKPathElectricalBatteriesVoltage) );
+  CHECK( all.matchesPath(SKPathEnvironmentDepthBelowKeel) );
+}
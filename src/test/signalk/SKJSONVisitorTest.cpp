@@ -31,6 +31,8 @@
 #include <ArduinoJson.h>
 #include "common/signalk/SKUpdateStatic.h"
 #include "common/signalk/SKJSONVisitor.h"
+#include "common/signalk/SKJSONWriter.h"
+#include "common/signalk/SKUnits.h"
 #include "../KBoxTest.h"
 
 TEST_CASE("SKJSONVisitor") {
@@ -114,3 +116,42 @@ TEST_CASE("SKJSONVisitor") {
 
   }
 }
+
+TEST_CASE("SKJSONWriter output is identical to SKJSONVisitor") {
+  DynamicJsonBuffer jsonBuffer;
+  SKJSONVisitor jsonVisitor("urn:mrn:kbox:unit-test", jsonBuffer);
+  SKJSONWriter writer("urn:mrn:kbox:unit-test");
+  SKUpdateStatic<8> update;
+
+  update.setTimestamp(SKTime(1524764848, 102));
+  update.setNavigationPosition(SKTypePosition(37.81, -122.42, SKDoubleNAN));
+  update.setNavigationAttitude(SKTypeAttitude(0.1, SKDoubleNAN, -1.3));
+  update.setNavigationDatetime(SKTime(1524764848));
+  update.setNavigationSpeedOverGround(0.000001);
+  update.setEnvironmentDepthBelowKeel(123456789.0);
+  update.setEnvironmentOutsideTemperature(1.0 / 3);
+  update.setElectricalBatteriesVoltage("engine", 12.6);
+
+  const SKSource sources[] = {
+    SKSourceUnknown,
+    SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "II", "XDR"),
+    SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_2, "GP", "RMC"),
+    SKSource::sourceForNMEA2000(SKSourceInputNMEA2000, 129025, 2, 42),
+    SKSource::sourceForKBoxSensor(SKSourceInputKBoxIMU),
+    SKSource::sourceForKBoxSensor(SKSourceInputKBoxADC),
+    SKSource::sourceForKBoxSensor(SKSourceInputKBoxBarometer)
+  };
+
+  for (const SKSource &source : sources) {
+    update.setSource(source);
+
+    char expected[1024];
+    jsonBuffer.clear();
+    jsonVisitor.processUpdate(update).printTo(expected, sizeof(expected));
+
+    char actual[1024];
+    writer.write(update, actual, sizeof(actual));
+
+    CHECK( std::string(actual) == std::string(expected) );
+  }
+}
@@ -0,0 +1,135 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "../KBoxTest.h"
+#include "../KBoxTestAllocations.h"
+#include "common/signalk/SKJSONWriter.h"
+#include "common/signalk/SKUnits.h"
+#include "common/signalk/SKUpdateStatic.h"
+
+static std::string toJSON(const SKJSONWriter &writer, const SKUpdate &update) {
+  char buffer[1024];
+  writer.write(update, buffer, sizeof(buffer));
+  return std::string(buffer);
+}
+
+TEST_CASE("SKJSONWriter") {
+  SKJSONWriter writer("urn:mrn:kbox:unit-test");
+  SKUpdateStatic<5> update;
+
+  SECTION("empty update") {
+    CHECK( toJSON(writer, update) == "{\"context\":\"vessels.urn:mrn:kbox:unit-test\","
+           "\"updates\":[{\"source\":{\"label\":\"unknown\",\"type\":\"unknown\"},\"values\":[]}]}" );
+  }
+
+  SECTION("empty update with a timestamp") {
+    update.setTimestamp(SKTime(409516200));
+
+    CHECK( toJSON(writer, update) == "{\"context\":\"vessels.urn:mrn:kbox:unit-test\","
+           "\"updates\":[{\"source\":{\"label\":\"unknown\",\"type\":\"unknown\"},"
+           "\"timestamp\":\"1982-12-23T18:30:00Z\",\"values\":[]}]}" );
+  }
+
+  SECTION("update from one source at one time") {
+    update.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "II", "XDR"));
+    update.setElectricalBatteriesVoltage("starter", 12.0);
+    update.setTimestamp(SKTime(409516200, 42));
+
+    CHECK( toJSON(writer, update) == "{\"context\":\"vessels.urn:mrn:kbox:unit-test\","
+           "\"updates\":[{\"source\":{\"label\":\"NMEA0183.2\",\"type\":\"NMEA0183\",\"talker\":\"II\",\"sentence\":\"XDR\"},"
+           "\"timestamp\":\"1982-12-23T18:30:00.042Z\","
+           "\"values\":[{\"path\":\"electrical.batteries.starter.voltage\",\"value\":12}]}]}" );
+  }
+
+  SECTION("all types of values") {
+    update.setSource(SKSource::sourceForNMEA2000(SKSourceInputNMEA2000, 129025, 2, 42));
+    update.setNavigationPosition(SKTypePosition(37.81, -122.42, SKDoubleNAN));
+    update.setNavigationAttitude(SKTypeAttitude(SKDoubleNAN, 0.1, -1.3));
+    update.setNavigationDatetime(SKTime(1524764848, 102));
+    update.setEnvironmentDepthBelowTransducer(4.2);
+    update.setValue(SKPathNavigationLog, SKValueNone);
+
+    CHECK( toJSON(writer, update) == "{\"context\":\"vessels.urn:mrn:kbox:unit-test\","
+           "\"updates\":[{\"source\":{\"label\":\"NMEA2000\",\"type\":\"NMEA2000\",\"pgn\":129025,\"src\":\"42\",\"priority\":2},"
+           "\"values\":["
+           "{\"path\":\"navigation.position\",\"value\":{\"latitude\":37.81,\"longitude\":-122.42}},"
+           "{\"path\":\"navigation.attitude\",\"value\":{\"pitch\":0.1,\"yaw\":-1.3}},"
+           "{\"path\":\"navigation.datetime\",\"value\":\"2018-04-26T17:47:28.102Z\"},"
+           "{\"path\":\"environment.depth.belowTransducer\",\"value\":4.2},"
+           "{\"path\":\"navigation.log\",\"value\":{}}]}]}" );
+  }
+
+  SECTION("numbers are formatted like ArduinoJson") {
+    update.setNavigationSpeedOverGround(0.25);
+    update.setEnvironmentDepthBelowKeel(123456789.0);
+    update.setEnvironmentDepthBelowSurface(0.000001);
+    update.setEnvironmentOutsidePressure(101325);
+    update.setEnvironmentOutsideTemperature(1.0 / 3);
+
+    CHECK( toJSON(writer, update) == "{\"context\":\"vessels.urn:mrn:kbox:unit-test\","
+           "\"updates\":[{\"source\":{\"label\":\"unknown\",\"type\":\"unknown\"},\"values\":["
+           "{\"path\":\"navigation.speedOverGround\",\"value\":0.25},"
+           "{\"path\":\"environment.depth.belowKeel\",\"value\":1.23456789e8},"
+           "{\"path\":\"environment.depth.belowSurface\",\"value\":1e-6},"
+           "{\"path\":\"environment.outside.pressure\",\"value\":101325},"
+           "{\"path\":\"environment.outside.temperature\",\"value\":0.333333333}]}]}" );
+  }
+
+  SECTION("other vessels and escaped strings") {
+    SKContext context("urn:mrn:imo:mmsi:\"123\"");
+    SKUpdateStatic<1> other(context);
+    other.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxIMU));
+    other.setElectricalBatteriesVoltage("a\\b", 1.5);
+
+    CHECK( toJSON(writer, other) == "{\"context\":\"vessels.urn:mrn:imo:mmsi:\\\"123\\\"\","
+           "\"updates\":[{\"source\":{\"label\":\"KBox.IMU\"},"
+           "\"values\":[{\"path\":\"electrical.batteries.a\\\\b.voltage\",\"value\":1.5}]}]}" );
+  }
+
+  SECTION("vessel URN can be changed") {
+    writer.setVesselURN("urn:mrn:kbox:other");
+    CHECK( toJSON(writer, update).find("\"vessels.urn:mrn:kbox:other\"") != std::string::npos );
+  }
+
+  SECTION("output is truncated to the buffer") {
+    char buffer[20];
+    size_t len = writer.write(update, buffer, sizeof(buffer));
+    CHECK( len == 19 );
+    CHECK( std::string(buffer) == "{\"context\":\"vessels" );
+  }
+
+  SECTION("writing does not allocate memory") {
+    update.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_2, "GP", "RMC"));
+    update.setTimestamp(SKTime(1524764848, 102));
+    update.setNavigationPosition(SKTypePosition(37.81, -122.42, 12));
+    update.setElectricalBatteriesVoltage("engine", 12.6);
+
+    char buffer[1024];
+    KBoxTestAllocations allocations;
+    size_t len = writer.write(update, buffer, sizeof(buffer));
+    unsigned long count = allocations.total();
+    CHECK( count == 0 );
+    CHECK( len == strlen(buffer) );
+  }
+}
@@ -25,8 +25,11 @@
 #include <N2kMsg.h>
 #include <N2kMessages.h>
 #include "../KBoxTest.h"
+#include "../KBoxTestAllocations.h"
 #include "common/signalk/SKUnits.h"
+#include "common/signalk/SKNMEA2000Descriptors.h"
 #include "common/signalk/SKNMEA2000Parser.h"
+#include "common/stats/KBoxMetrics.h"
 
 TEST_CASE("SKNMEA2000Parser: Basic tests") {
   SKNMEA2000Parser p;
@@ -193,4 +196,238 @@ TEST_CASE("SKNMEA2000Parser: Basic tests") {
     CHECK( update.getEnvironmentWindSpeedTrue() == 12.4 );
     CHECK( update.getEnvironmentWindAngleTrueWater() == Approx(SKDegToRad(-175)).epsilon(0.0001) );
   }
+
+  SECTION("127251: Rate of turn") {
+    SetN2kRateOfTurn(msg, 0, -0.02);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 1 );
+    CHECK( update.getNavigationRateOfTurn() == Approx(-0.02).epsilon(0.001) );
+  }
+
+  SECTION("127258: Magnetic variation") {
+    SetN2kMagneticVariation(msg, 0, N2kmagvar_WMM2015, 17647, SKDegToRad(-3));
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 1 );
+    CHECK( update.getNavigationMagneticVariation() == Approx(SKDegToRad(-3)).epsilon(0.0001) );
+  }
+
+  SECTION("127488: Engine revolutions") {
+    SetN2kEngineParamRapid(msg, 1, 1800, N2kDoubleNA, N2kInt8NA);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 1 );
+    CHECK( update.getPropulsionRevolutions("1") == Approx(30) );
+  }
+
+  SECTION("127505: Fuel tank level and capacity") {
+    SetN2kFluidLevel(msg, 0, N2kft_Fuel, 62.5, 200);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 2 );
+    CHECK( update.getTanksCurrentLevel("fuel.0") == Approx(0.625) );
+    CHECK( update.getTanksCapacity("fuel.0") == Approx(0.2) );
+  }
+
+  SECTION("127505: Unsupported fluid type") {
+    SetN2kFluidLevel(msg, 0, N2kft_Unavailable, 50, 100);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 0 );
+  }
+
+  SECTION("127508: House battery status") {
+    SetN2kDCBatStatus(msg, 1, 12.8, -4.5, 298.15, 0);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 3 );
+    CHECK( update.getElectricalBatteriesVoltage("house") == Approx(12.8) );
+    CHECK( update.getElectricalBatteriesCurrent("house") == Approx(-4.5) );
+    CHECK( update.getElectricalBatteriesTemperature("house") == Approx(298.15) );
+  }
+
+  SECTION("127508: Numbered battery without current") {
+    SetN2kDCBatStatus(msg, 3, 25.2, N2kDoubleNA, N2kDoubleNA, 0);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 1 );
+    CHECK( update.getElectricalBatteriesVoltage("3") == Approx(25.2) );
+  }
+
+  SECTION("Instances can not fill the index table") {
+    SKIndexTable saved = skIndexTable;
+    char name[16];
+    for (int i = skIndexTable.inputSize(); i < SKIndexTable::MaxInputIndexes; i++) {
+      snprintf(name, sizeof(name), "n2k%i", i);
+      skIndexTable.internInput(name);
+    }
+    int size = skIndexTable.size();
+    uint32_t full = KBoxMetrics.countEvent(KBoxEventSKIndexTableFull);
+
+    SetN2kEngineParamRapid(msg, 200, 1800, N2kDoubleNA, N2kInt8NA);
+    CHECK( p.parse(SKSourceInputNMEA2000, msg, SKTime(0)).getSize() == 0 );
+    SetN2kFluidLevel(msg, 200, N2kft_Fuel, 62.5, 200);
+    CHECK( p.parse(SKSourceInputNMEA2000, msg, SKTime(0)).getSize() == 0 );
+    SetN2kDCBatStatus(msg, 200, 25.2, N2kDoubleNA, N2kDoubleNA, 0);
+    CHECK( p.parse(SKSourceInputNMEA2000, msg, SKTime(0)).getSize() == 0 );
+
+    CHECK( skIndexTable.size() == size );
+    CHECK( KBoxMetrics.countEvent(KBoxEventSKIndexTableFull) == full + 3 );
+
+    // The engine and house batteries are not input names.
+    SetN2kDCBatStatus(msg, 1, 12.8, N2kDoubleNA, N2kDoubleNA, 0);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getElectricalBatteriesVoltage("house") == Approx(12.8) );
+
+    skIndexTable = saved;
+  }
+
+  SECTION("128275: Distance log") {
+    SetN2kDistanceLog(msg, 17647, 3600, 1852000, 18520);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 2 );
+    CHECK( update.getNavigationLog() == 1852000 );
+    CHECK( update.getNavigationTripLog() == 18520 );
+  }
+
+  SECTION("129283: Cross track error") {
+    SetN2kXTE(msg, 0, N2kxtem_Autonomous, false, 120.5);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 1 );
+    CHECK( update.getNavigationCourseRhumblineCrossTrackError() == Approx(120.5) );
+  }
+
+  SECTION("129283: Cross track error after navigation terminated") {
+    SetN2kXTE(msg, 0, N2kxtem_Autonomous, true, 120.5);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 0 );
+  }
+
+  SECTION("130310: Outside environmental parameters") {
+    SetN2kOutsideEnvironmentalParameters(msg, 0, 290.15, 295.15, 101300);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 3 );
+    CHECK( update.getEnvironmentWaterTemperature() == Approx(290.15) );
+    CHECK( update.getEnvironmentOutsideTemperature() == Approx(295.15) );
+    CHECK( update.getEnvironmentOutsidePressure() == Approx(101300) );
+  }
+
+  SECTION("130314: Atmospheric pressure") {
+    SetN2kPressure(msg, 0, 0, N2kps_Atmospheric, 101250);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 1 );
+    CHECK( update.getEnvironmentOutsidePressure() == Approx(101250) );
+  }
+
+  SECTION("130314: Other pressures are ignored") {
+    SetN2kPressure(msg, 0, 0, N2kps_Water, 200000);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 0 );
+  }
+
+  SECTION("130316: Inside temperature") {
+    SetN2kTemperatureExt(msg, 0, 0, N2kts_InsideTemperature, 293.15);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 1 );
+    CHECK( update.getEnvironmentInsideTemperature() == Approx(293.15) );
+  }
+
+  SECTION("130577: Direction data, true referenced") {
+    msg.SetPGN(130577L);
+    msg.Priority = 3;
+    msg.AddByte(0x0f | (N2khr_true << 4));
+    msg.AddByte(0);
+    msg.Add2ByteUDouble(SKDegToRad(90), 0.0001);
+    msg.Add2ByteUDouble(3.2, 0.01);
+    msg.Add2ByteUDouble(SKDegToRad(85), 0.0001);
+    msg.Add2ByteUDouble(3.5, 0.01);
+    msg.Add2ByteUDouble(SKDegToRad(180), 0.0001);
+    msg.Add2ByteUDouble(0.4, 0.01);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 6 );
+    CHECK( update.getNavigationCourseOverGroundTrue() == Approx(SKDegToRad(90)).epsilon(0.001) );
+    CHECK( update.getNavigationHeadingTrue() == Approx(SKDegToRad(85)).epsilon(0.001) );
+    CHECK( update.getEnvironmentCurrentSetTrue() == Approx(SKDegToRad(180)).epsilon(0.001) );
+    CHECK( update.getNavigationSpeedOverGround() == Approx(3.2) );
+    CHECK( update.getNavigationSpeedThroughWater() == Approx(3.5) );
+    CHECK( update.getEnvironmentCurrentDrift() == Approx(0.4) );
+  }
+
+  SECTION("130577: Truncated direction data") {
+    msg.SetPGN(130577L);
+    msg.AddByte(0);
+    msg.AddByte(0);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 0 );
+  }
+
+  SECTION("130578: Vessel speed components") {
+    msg.SetPGN(130578L);
+    msg.Priority = 2;
+    msg.Add2ByteDouble(4.25, 0.001);
+    msg.Add2ByteDouble(-0.15, 0.001);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 2 );
+    CHECK( update.getNavigationSpeedThroughWater() == Approx(4.25) );
+    CHECK( update.getNavigationSpeedThroughWaterTransverse() == Approx(-0.15) );
+  }
+
+  SECTION("Unknown PGN is counted") {
+    uint32_t unknown = KBoxMetrics.countEvent(KBoxEventNMEA2000UnknownPGN);
+    msg.SetPGN(65280L);
+    msg.AddByte(0);
+    const SKUpdate &update = p.parse(SKSourceInputNMEA2000, msg, SKTime(0));
+    CHECK( update.getSize() == 0 );
+    CHECK( KBoxMetrics.countEvent(KBoxEventNMEA2000UnknownPGN) == unknown + 1 );
+  }
+}
+
+TEST_CASE("SKNMEA2000Descriptors") {
+  SECTION("descriptors are sorted") {
+    for (size_t i = 1; i < skNMEA2000PGNDescriptorsCount; i++) {
+      CHECK( skNMEA2000PGNDescriptors[i - 1].pgn < skNMEA2000PGNDescriptors[i].pgn );
+    }
+  }
+
+  SECTION("every descriptor is found") {
+    for (size_t i = 0; i < skNMEA2000PGNDescriptorsCount; i++) {
+      const SKNMEA2000PGNDescriptor *descriptor = skNMEA2000FindPGN(skNMEA2000PGNDescriptors[i].pgn);
+      CHECK( descriptor == &skNMEA2000PGNDescriptors[i] );
+    }
+  }
+
+  SECTION("other PGNs are rejected") {
+    CHECK( skNMEA2000FindPGN(0) == 0 );
+    CHECK( skNMEA2000FindPGN(59904) == 0 );
+    CHECK( skNMEA2000FindPGN(126993) == 0 );
+    CHECK( skNMEA2000FindPGN(129029) == 0 );
+    CHECK( skNMEA2000FindPGN(130579) == 0 );
+    CHECK( skNMEA2000FindPGN(0xffffffff) == 0 );
+  }
+}
+
+TEST_CASE("SKNMEA2000Parser: parse into caller-owned update") {
+  SKNMEA2000Parser parser;
+  SKUpdateStatic<SKNMEA2000Parser::MaxValuesPerUpdate> update;
+  tN2kMsg depthMsg;
+  tN2kMsg windMsg;
+  SetN2kWaterDepth(depthMsg, 0, 4.2, -0.5);
+  SetN2kWindSpeed(windMsg, 0, 5, 1, N2kWind_Apparent);
+
+  SECTION("values from previous message are cleared") {
+    CHECK( parser.parse(SKSourceInputNMEA2000, depthMsg, SKTime(0), update) );
+    CHECK( update.getSize() == 3 );
+
+    CHECK( parser.parse(SKSourceInputNMEA2000, windMsg, SKTime(0), update) );
+    CHECK( update.getSize() == 2 );
+    CHECK( !update.hasEnvironmentDepthBelowTransducer() );
+    CHECK( update.getEnvironmentWindSpeedApparent() == 5 );
+  }
+
+  SECTION("no heap allocation") {
+    KBoxTestAllocations allocations;
+
+    for (int i = 0; i < 10; i++) {
+      parser.parse(SKSourceInputNMEA2000, depthMsg, SKTime(0), update);
+      parser.parse(SKSourceInputNMEA2000, windMsg, SKTime(0), update);
+    }
+
+    // Read the counter before CHECK() which allocates memory.
+    unsigned long total = allocations.total();
+    CHECK( total == 0 );
+  }
 }
@@ -25,13 +25,15 @@
 #include "common/algo/List.h"
 #include "common/signalk/SKUnits.h"
 #include "common/signalk/SKNMEAConverter.h"
+#include "common/signalk/SKNMEASentence.h"
 #include "common/signalk/SKUpdateStatic.h"
 #include "../KBoxTest.h"
+#include "../KBoxTestAllocations.h"
 
 class NMEAOut : public LinkedList<SKNMEASentence>, public SKNMEAOutput {
   public:
-    bool write(const SKNMEASentence& s) override {
-      add(s);
+    bool write(const NMEAFixedSentence& s) override {
+      add(SKNMEASentence(s.c_str()));
       return true;
     };
 
@@ -255,4 +257,76 @@ TEST_CASE("SKNMEAConverterTest") {
       }
     }
   }
+
+  SECTION("Updates about other vessels") {
+    SKContext other("urn:mrn:imo:mmsi:366053209");
+    SKUpdateStatic<1> u(other);
+    u.setNavigationHeadingMagnetic(SKDegToRad(42));
+    converter.convert(u, out);
+    CHECK( out.size() == 0 );
+  }
+}
+
+class NMEACounter : public SKNMEAOutput {
+  public:
+    int count = 0;
+
+    bool write(const NMEAFixedSentence& s) override {
+      count++;
+      return true;
+    };
+};
+
+TEST_CASE("SKNMEAConverter: no heap allocation") {
+  SKNMEAConverterConfig config;
+  SKNMEAConverter converter(config);
+  NMEACounter out;
+
+  SKUpdateStatic<6> u;
+  u.setEnvironmentDepthBelowTransducer(4.2);
+  u.setNavigationHeadingMagnetic(SKDegToRad(271));
+  u.setEnvironmentWindAngleApparent(SKDegToRad(-42));
+  u.setEnvironmentWindSpeedApparent(7.1);
+  u.setElectricalBatteriesVoltage("engine", 12.42);
+  u.setNavigationAttitude(SKTypeAttitude(0.1, 0.2, SKDoubleNAN));
+
+  KBoxTestAllocations allocations;
+  converter.convert(u, out);
+
+  // Read the counter before CHECK() which allocates memory.
+  unsigned long count = allocations.total();
+  CHECK( count == 0 );
+  CHECK( out.count >= 5 );
+}
+
+TEST_CASE("SKNMEAConverter: subscription filter") {
+  SKNMEAConverterConfig config;
+
+  SECTION("default config") {
+    SKSubscriptionFilter filter = SKNMEAConverter::subscriptionFilter(config);
+    CHECK( filter.matchesPath(SKPathEnvironmentDepthBelowTransducer) );
+    CHECK( filter.matchesPath(SKPathNavigationHeadingMagnetic) );
+    CHECK( filter.matchesPath(SKPathEnvironmentWindAngleApparent) );
+    CHECK( filter.matchesPath(SKPathEnvironmentWindAngleTrueWater) );
+    CHECK( filter.matchesPath(SKPathSteeringRudderAngle) );
+    CHECK( filter.matchesPath(SKPathNavigationAttitude) );
+    CHECK( filter.matchesPath(SKPathElectricalBatteriesVoltage) );
+    CHECK( filter.matchesPath(SKPathEnvironmentOutsidePressure) );
+    CHECK( !filter.matchesPath(SKPathNavigationSpeedOverGround) );
+  }
+
+  SECTION("disabled sentences are not subscribed") {
+    config.dpt = false;
+    config.hdm = false;
+    config.mwv = false;
+    SKSubscriptionFilter filter = SKNMEAConverter::subscriptionFilter(config);
+    CHECK( !filter.matchesPath(SKPathEnvironmentDepthBelowTransducer) );
+    CHECK( !filter.matchesPath(SKPathNavigationHeadingMagnetic) );
+    CHECK( !filter.matchesPath(SKPathEnvironmentWindAngleApparent) );
+    CHECK( filter.matchesPath(SKPathSteeringRudderAngle) );
+
+    config.dbt = true;
+    filter = SKNMEAConverter::subscriptionFilter(config);
+    CHECK( filter.matchesPath(SKPathEnvironmentDepthBelowTransducer) );
+  }
 }
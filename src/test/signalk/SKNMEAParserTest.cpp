@@ -23,8 +23,11 @@
 */
 
 #include "../KBoxTest.h"
+#include "../KBoxTestAllocations.h"
 #include "common/signalk/SKUnits.h"
 #include "common/signalk/SKNMEAParser.h"
+#include "common/signalk/SKNMEADescriptors.h"
+#include "common/stats/KBoxMetrics.h"
 
 SKNMEAParser p;
 
@@ -237,6 +240,230 @@ TEST_CASE("SKNMEAParser") {
 
       CHECK(update.getEnvironmentOutsideTemperature() == SKCelsiusToKelvin(30));
     }
+
+    SECTION("XDR with all measurements decoded") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1,
+                                       "$IIXDR,A,-2.5,D,PTCH,A,10.3,D,ROLL,C,21.5,C,AIRTEMP,P,1.0132,B,Barometer,U,12.6,V,house*2E",
+                                       SKTime(0));
+
+      CHECK(update.getSize() == 4);
+      CHECK(update.getNavigationAttitude().pitch == SKDegToRad(-2.5));
+      CHECK(update.getNavigationAttitude().roll == SKDegToRad(10.3));
+      CHECK(update.getNavigationAttitude().yaw == SKDoubleNAN);
+      CHECK(update.getEnvironmentOutsideTemperature() == SKCelsiusToKelvin(21.5));
+      CHECK(update.getEnvironmentOutsidePressure() == Approx(101320));
+      CHECK(update.getElectricalBatteriesVoltage("house") == 12.6);
+    }
+
+    SECTION("XDR with unknown measurements") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$IIXDR,G,1,,FOO,U,12.6,V,*66", SKTime(0));
+
+      // Battery voltage without a name can not be indexed.
+      CHECK(update.getSize() == 0);
+    }
+
+    SECTION("XDR names can not fill the index table") {
+      SKIndexTable saved = skIndexTable;
+      skIndexTable.internInput("house");
+      char name[16];
+      for (int i = skIndexTable.inputSize(); i < SKIndexTable::MaxInputIndexes; i++) {
+        snprintf(name, sizeof(name), "xdr%i", i);
+        skIndexTable.internInput(name);
+      }
+      int size = skIndexTable.size();
+      uint32_t full = KBoxMetrics.countEvent(KBoxEventSKIndexTableFull);
+
+      const SKUpdate &unknown = p.parse(SKSourceInputNMEA0183_1, "$IIXDR,U,12.6,V,fridge*4D", SKTime(0));
+      CHECK(unknown.getSize() == 0);
+      CHECK(skIndexTable.size() == size);
+      CHECK(KBoxMetrics.countEvent(KBoxEventSKIndexTableFull) == full + 1);
+
+      const SKUpdate &known = p.parse(SKSourceInputNMEA0183_1, "$IIXDR,U,12.6,V,house*32", SKTime(0));
+      CHECK(known.getElectricalBatteriesVoltage("house") == 12.6);
+
+      skIndexTable = saved;
+    }
+  }
+
+  SECTION("Heading") {
+    SECTION("HDG") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$IIHDG,98.3,0.0,E,12.6,W*5C", SKTime(0));
+
+      CHECK(update.getSize() == 2);
+      CHECK(update.getNavigationHeadingMagnetic() == SKDegToRad(98.3));
+      CHECK(update.getNavigationMagneticVariation() == SKDegToRad(-12.6));
+    }
+
+    SECTION("HDT") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$IIHDT,274.07,T*14", SKTime(0));
+
+      CHECK(update.getSize() == 1);
+      CHECK(update.getNavigationHeadingTrue() == SKDegToRad(274.07));
+    }
+  }
+
+  SECTION("Water") {
+    SECTION("MTW") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$IIMTW,17.9,C*1C", SKTime(0));
+
+      CHECK(update.getSize() == 1);
+      CHECK(update.getEnvironmentWaterTemperature() == SKCelsiusToKelvin(17.9));
+    }
+
+    SECTION("VHW with only speed in knots used") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$IIVHW,,T,,M,6.35,N,11.76,K*64", SKTime(0));
+
+      CHECK(update.getSize() == 1);
+      CHECK(update.getNavigationSpeedThroughWater() == SKKnotToMs(6.35));
+    }
+
+    SECTION("VLW") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$IIVLW,1234.5,N,12.3,N*4C", SKTime(0));
+
+      CHECK(update.getSize() == 2);
+      CHECK(update.getNavigationLog() == SKNauticalMileToMeter(1234.5));
+      CHECK(update.getNavigationTripLog() == SKNauticalMileToMeter(12.3));
+    }
+  }
+
+  SECTION("GPS") {
+    SECTION("VTG") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48", SKTime(0));
+
+      CHECK(update.getSize() == 2);
+      CHECK(update.getNavigationCourseOverGroundTrue() == SKDegToRad(54.7));
+      CHECK(update.getNavigationSpeedOverGround() == SKKnotToMs(5.5));
+    }
+
+    SECTION("GLL") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$GPGLL,4916.45,N,12311.12,W,225444,A*31", SKTime(0));
+
+      CHECK(update.getSize() == 1);
+      CHECK(update.getNavigationPosition().latitude == Approx(49.2741666667));
+      CHECK(update.getNavigationPosition().longitude == Approx(-123.1853333333));
+    }
+
+    SECTION("GLL with invalid status") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$GPGLL,4916.45,N,12311.12,W,225444,V*26", SKTime(0));
+
+      CHECK(update.getSize() == 0);
+    }
+  }
+
+  SECTION("Wind") {
+    SECTION("VWR to port") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$IIVWR,45.0,L,12.6,N,6.5,M,23.3,K*62", SKTime(0));
+
+      CHECK(update.getSize() == 2);
+      CHECK(update.getEnvironmentWindAngleApparent() == SKDegToRad(-45.0));
+      CHECK(update.getEnvironmentWindSpeedApparent() == SKKnotToMs(12.6));
+    }
+
+    SECTION("MWD") {
+      const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$IIMWD,270.0,T,255.5,M,12.0,N,6.2,M*71", SKTime(0));
+
+      CHECK(update.getSize() == 2);
+      CHECK(update.getEnvironmentWindDirectionTrue() == SKDegToRad(270.0));
+      CHECK(update.getEnvironmentWindDirectionMagnetic() == SKDegToRad(255.5));
+    }
+  }
+
+  SECTION("RSA with only the starboard sensor valid") {
+    const SKUpdate &update = p.parse(SKSourceInputNMEA0183_1, "$IIRSA,10.5,A,,V*4D", SKTime(0));
+
+    CHECK(update.getSize() == 1);
+    CHECK(update.getSteeringRudderAngle() == SKDegToRad(10.5));
+  }
+}
+
+TEST_CASE("SKNMEAParser: field descriptors") {
+  SECTION("are sorted by sentence") {
+    for (size_t i = 1; i < skNMEAFieldDescriptorsCount; i++) {
+      CHECK( skNMEAFieldDescriptors[i - 1].sentence <= skNMEAFieldDescriptors[i].sentence );
+    }
+  }
+
+  SECTION("XDR descriptors with a name come first") {
+    bool anyName = false;
+    for (size_t i = skNMEAXDRDescriptorsCount; i > 0; i--) {
+      if (skNMEAXDRDescriptors[i - 1].name == nullptr) {
+        CHECK( !anyName );
+      }
+      else {
+        anyName = true;
+      }
+    }
   }
 }
 
+TEST_CASE("SKNMEAParser: parse into caller-owned update") {
+  SKNMEAParser parser;
+  SKUpdateStatic<SKNMEAParser::MaxValuesPerUpdate> update;
+
+  SECTION("values from previous sentence are cleared") {
+    CHECK( parser.parse(SKSourceInputNMEA0183_1, "$IIDPT,0.90,1.2*7A", SKTime(0), update) );
+    CHECK( update.getSize() == 3 );
+
+    CHECK( parser.parse(SKSourceInputNMEA0183_2, "$SDDBT,8.1,f,2.4,M,1.3,F*0B", SKTime(42), update) );
+    CHECK( update.getSize() == 1 );
+    CHECK( update.getSource().getInput() == SKSourceInputNMEA0183_2 );
+    CHECK( update.getTimestamp() == SKTime(42) );
+    CHECK( update.getEnvironmentDepthBelowTransducer() == 2.4 );
+
+    CHECK( !parser.parse(SKSourceInputNMEA0183_1, "mambo jumbo", SKTime(0), update) );
+    CHECK( update.getSize() == 0 );
+    CHECK( update.getSource() == SKSourceUnknown );
+  }
+
+  SECTION("sentences disabled in the config") {
+    SKNMEAParserConfig config;
+    config.rmc = false;
+    SKNMEAParser parser(config);
+    SKUpdateStatic<SKNMEAParser::MaxValuesPerUpdate> update;
+
+    CHECK( !parser.parse(SKSourceInputNMEA0183_1, "$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68", SKTime(0), update) );
+    CHECK( parser.parse(SKSourceInputNMEA0183_1, "$IIDPT,0.90,1.2*7A", SKTime(0), update) );
+  }
+
+  SECTION("talker parsers") {
+    SKNMEAParser parser;
+    SKUpdateStatic<SKNMEAParser::MaxValuesPerUpdate> update;
+
+    // Ignore depth from the GPS and parse MWV sent with the DPT code by II
+    CHECK( parser.setTalkerParser("GP", "DPT", nullptr) );
+    CHECK( parser.setTalkerParser("II", "DPT", SKNMEAParser::parseMWV) );
+
+    CHECK( !parser.parse(SKSourceInputNMEA0183_1, "$GPDPT,0.90,1.2*6D", SKTime(0), update) );
+    CHECK( parser.parse(SKSourceInputNMEA0183_1, "$SDDPT,0.90,1.2*6D", SKTime(0), update) );
+    CHECK( update.getEnvironmentDepthBelowTransducer() == 0.9 );
+    CHECK( parser.parse(SKSourceInputNMEA0183_1, "$IIDPT,168.1,R,5.6,K,A*39", SKTime(0), update) );
+    CHECK( update.hasEnvironmentWindAngleApparent() );
+
+    // Replace an existing talker parser
+    CHECK( parser.setTalkerParser("GP", "DPT", SKNMEAParser::parseDPT) );
+    CHECK( parser.parse(SKSourceInputNMEA0183_1, "$GPDPT,0.90,1.2*6D", SKTime(0), update) );
+
+    CHECK( parser.setTalkerParser("GP", "RMC", nullptr) );
+    CHECK( parser.setTalkerParser("GN", "RMC", nullptr) );
+    CHECK( !parser.setTalkerParser("GL", "RMC", nullptr) );
+  }
+
+  SECTION("no heap allocation") {
+    // Sentences are received in Strings so they are created before counting.
+    String rmc("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68");
+    String dpt("$IIDPT,0.90,1.2*7A");
+    String mwv("$WIMWV,168.1,R,5.6,K,A*2B");
+    String xdr("$WIXDR,C,030.0,C,,*51");
+
+    KBoxTestAllocations allocations;
+
+    parser.parse(SKSourceInputNMEA0183_1, rmc, SKTime(0), update);
+    parser.parse(SKSourceInputNMEA0183_1, dpt, SKTime(0), update);
+    parser.parse(SKSourceInputNMEA0183_1, mwv, SKTime(0), update);
+    parser.parse(SKSourceInputNMEA0183_1, xdr, SKTime(0), update);
+
+    // Read the counter before CHECK() which allocates memory.
+    unsigned long count = allocations.total();
+    CHECK( count == 0 );
+  }
+}
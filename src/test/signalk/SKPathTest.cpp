@@ -30,6 +30,9 @@
 
 #include "../KBoxTest.h"
 #include "common/signalk/SKPath.h"
+#include "common/signalk/SKUpdateStatic.h"
+#include "common/stats/KBoxMetrics.h"
+#include "../KBoxTestAllocations.h"
 
 TEST_CASE("SKPath") {
   SECTION("non-indexed paths") {
@@ -52,7 +55,7 @@ TEST_CASE("SKPath") {
     SKPath p2 = SKPath(SKPathElectricalBatteriesVoltage, "engine");
     CHECK( p != p2 );
     CHECK( p2.isIndexed() );
-    CHECK( p2.getIndex() == "engine" );
+    CHECK( String(p2.getIndex()) == "engine" );
     CHECK( p2.getStaticPath() == SKPathElectricalBatteriesVoltage );
     CHECK( p2.toString() == "electrical.batteries.engine.voltage" );
 
@@ -61,3 +64,100 @@ TEST_CASE("SKPath") {
   }
 }
 
+
+TEST_CASE("SKIndexTable") {
+  SKIndexTable table;
+
+  SECTION("intern and find") {
+    CHECK( table.find("engine") == SKIndexInvalid );
+
+    SKIndexId engine = table.intern("engine");
+    SKIndexId house = table.intern("house");
+    CHECK( engine != SKIndexInvalid );
+    CHECK( house != SKIndexInvalid );
+    CHECK( engine != house );
+    CHECK( table.intern("engine") == engine );
+    CHECK( table.find("house") == house );
+    CHECK( table.size() == 2 );
+
+    CHECK( String(table.name(engine)) == "engine" );
+    CHECK( String(table.name(SKIndexInvalid)) == "" );
+  }
+
+  SECTION("invalid names") {
+    CHECK( table.intern("") == SKIndexInvalid );
+    CHECK( table.intern(nullptr) == SKIndexInvalid );
+    CHECK( table.intern("a-very-long-battery-name-1") == SKIndexInvalid );
+    CHECK( table.size() == 0 );
+  }
+
+  SECTION("table full") {
+    char name[16];
+    for (int i = 0; i < SKIndexTable::MaxIndexes; i++) {
+      snprintf(name, sizeof(name), "bat%i", i);
+      CHECK( table.intern(name) != SKIndexInvalid );
+    }
+    uint32_t full = KBoxMetrics.countEvent(KBoxEventSKIndexTableFull);
+    CHECK( table.intern("one-more") == SKIndexInvalid );
+    CHECK( KBoxMetrics.countEvent(KBoxEventSKIndexTableFull) == full + 1 );
+    CHECK( table.find("bat0") != SKIndexInvalid );
+  }
+
+  SECTION("names from the inputs can not fill the table") {
+    char name[16];
+    for (int i = 0; i < SKIndexTable::MaxInputIndexes; i++) {
+      snprintf(name, sizeof(name), "xdr%i", i);
+      CHECK( table.internInput(name) != SKIndexInvalid );
+    }
+    uint32_t full = KBoxMetrics.countEvent(KBoxEventSKIndexTableFull);
+    CHECK( table.internInput("one-more") == SKIndexInvalid );
+    CHECK( KBoxMetrics.countEvent(KBoxEventSKIndexTableFull) == full + 1 );
+
+    // Known names are still found and KBox can still intern its own names.
+    CHECK( table.internInput("xdr0") == table.find("xdr0") );
+    CHECK( table.intern("engine") != SKIndexInvalid );
+    int maxInputs = SKIndexTable::MaxInputIndexes;
+    CHECK( table.inputSize() == maxInputs );
+  }
+}
+
+TEST_CASE("Looking for an indexed value does not intern its index") {
+  SKUpdateStatic<2> update;
+  int size = skIndexTable.size();
+
+  CHECK( !update.hasElectricalBatteriesVoltage("not-a-battery") );
+  CHECK( update.getElectricalBatteriesVoltage("not-a-battery") == 0 );
+  CHECK( skIndexTable.find("not-a-battery") == SKIndexInvalid );
+  CHECK( skIndexTable.size() == size );
+
+  update.setElectricalBatteriesVoltage("not-a-battery", 12.1);
+  CHECK( update.hasElectricalBatteriesVoltage("not-a-battery") );
+  CHECK( update.getElectricalBatteriesVoltage("not-a-battery") == 12.1 );
+  CHECK( skIndexTable.size() == size + 1 );
+}
+
+TEST_CASE("SKPath with interned index") {
+  SKPath p(SKPathElectricalBatteriesVoltage, "engine");
+  SKIndexId engine = skIndexTable.find("engine");
+
+  CHECK( engine != SKIndexInvalid );
+  CHECK( p.getIndexId() == engine );
+  CHECK( p == SKPath(SKPathElectricalBatteriesVoltage, engine) );
+  CHECK( SKPath(SKPathElectricalBatteriesVoltage, SKIndexInvalid) == SKPathInvalid );
+
+  SECTION("no allocation when copying and comparing") {
+    SKUpdateStatic<2> u;
+    KBoxTestAllocations allocations;
+    u.setElectricalBatteriesVoltage(engine, 12.2);
+    u.setElectricalBatteriesVoltage("engine", 12.3);
+    bool found = u.hasElectricalBatteriesVoltage("engine");
+    SKPath copy = p;
+    bool equal = (copy == p);
+    unsigned long count = allocations.total();
+
+    CHECK( found );
+    CHECK( equal );
+    CHECK( u.getSize() == 1 );
+    CHECK( count == 0 );
+  }
+}
@@ -0,0 +1,145 @@
+/*
+  The MIT License
+
+  Copyright (c) 2018 Thomas Sarlandie thomas@sarlandie.net
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "../KBoxTest.h"
+#include "common/signalk/SKSourceMultiplexer.h"
+#include "common/signalk/SKUpdateStatic.h"
+#include "common/stats/KBoxMetrics.h"
+
+static SKUpdateStatic<2> positionFrom(SKSourceInput input) {
+  SKUpdateStatic<2> update;
+  if (input == SKSourceInputNMEA2000) {
+    update.setSource(SKSource::sourceForNMEA2000(input, 129025, 2, 12));
+  }
+  else {
+    update.setSource(SKSource::sourceForNMEA0183(input, "GP", "RMC"));
+  }
+  update.setNavigationPosition(SKTypePosition(48.85, 2.35, 0));
+  update.setNavigationSpeedOverGround(3.2);
+  return update;
+}
+
+TEST_CASE("SKSourceMultiplexer") {
+  SKSourceMultiplexerConfig config;
+  config.sourceTimeout = 3000;
+  SKSourceMultiplexer mux(config);
+
+  SKUpdateStatic<2> nmea1 = positionFrom(SKSourceInputNMEA0183_1);
+  SKUpdateStatic<2> nmea2 = positionFrom(SKSourceInputNMEA0183_2);
+  SKUpdateStatic<2> n2k = positionFrom(SKSourceInputNMEA2000);
+
+  SECTION("first input to send a path gets it") {
+    CHECK( mux.suppressedValues(nmea1, 1000) == 0 );
+    CHECK( mux.preferredInput(SKPathNavigationPosition) == SKSourceInputNMEA0183_1 );
+    CHECK( mux.preferredInput(SKPathNavigationCourseOverGroundTrue) == SKSourceInputUnknown );
+  }
+
+  SECTION("inputs with the same priority do not steal paths") {
+    uint32_t events = KBoxMetrics.countEvent(KBoxEventSKSourceSuppressed);
+
+    CHECK( mux.suppressedValues(nmea1, 1000) == 0 );
+    CHECK( mux.suppressedValues(nmea2, 1010) == 0x3 );
+    CHECK( mux.suppressedValues(nmea1, 2000) == 0 );
+    CHECK( mux.suppressedValues(nmea2, 2010) == 0x3 );
+
+    CHECK( mux.suppressed() == 4 );
+    CHECK( KBoxMetrics.countEvent(KBoxEventSKSourceSuppressed) == events + 4 );
+    CHECK( mux.preferredInput(SKPathNavigationPosition) == SKSourceInputNMEA0183_1 );
+  }
+
+  SECTION("higher priority input takes over immediately") {
+    CHECK( mux.suppressedValues(nmea1, 1000) == 0 );
+    CHECK( mux.suppressedValues(n2k, 1010) == 0 );
+    CHECK( mux.suppressedValues(nmea1, 1020) == 0x3 );
+    CHECK( mux.preferredInput(SKPathNavigationSpeedOverGround) == SKSourceInputNMEA2000 );
+    CHECK( mux.failovers() == 0 );
+  }
+
+  SECTION("fails over when the preferred input goes quiet") {
+    uint32_t events = KBoxMetrics.countEvent(KBoxEventSKSourceFailover);
+
+    CHECK( mux.suppressedValues(n2k, 1000) == 0 );
+    CHECK( mux.suppressedValues(nmea1, 3999) == 0x3 );
+    CHECK( mux.suppressedValues(nmea1, 4000) == 0 );
+    CHECK( mux.preferredInput(SKPathNavigationPosition) == SKSourceInputNMEA0183_1 );
+    CHECK( mux.failovers() == 2 );
+    CHECK( KBoxMetrics.countEvent(KBoxEventSKSourceFailover) == events + 2 );
+
+    // And back to the preferred input as soon as it returns
+    CHECK( mux.suppressedValues(n2k, 4500) == 0 );
+    CHECK( mux.suppressedValues(nmea1, 4600) == 0x3 );
+  }
+
+  SECTION("paths are selected independently") {
+    SKUpdateStatic<1> sog;
+    sog.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_2, "GP", "VTG"));
+    sog.setNavigationSpeedOverGround(3.1);
+
+    CHECK( mux.suppressedValues(sog, 1000) == 0 );
+    CHECK( mux.suppressedValues(nmea1, 1010) == 0x2 );
+  }
+
+  SECTION("indexed paths") {
+    SKUpdateStatic<2> adc;
+    adc.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxADC));
+    adc.setElectricalBatteriesVoltage("house", 12.4);
+    adc.setElectricalBatteriesVoltage("engine", 12.6);
+
+    SKUpdateStatic<1> bmv;
+    bmv.setSource(SKSource::sourceForNMEA2000(SKSourceInputNMEA2000, 127508, 6, 33));
+    bmv.setElectricalBatteriesVoltage("house", 12.41);
+
+    CHECK( mux.suppressedValues(bmv, 1000) == 0 );
+    CHECK( mux.suppressedValues(adc, 1010) == 0x1 );
+    CHECK( mux.preferredInput(SKPath(SKPathElectricalBatteriesVoltage, "engine")) == SKSourceInputKBoxADC );
+  }
+
+  SECTION("indexed paths table forgets the oldest path") {
+    // Ids do not need to be interned to be compared.
+    int maxIndexedPaths = SKSourceMultiplexer::MaxIndexedPaths;
+    SKUpdateStatic<1> update;
+    for (int i = 0; i <= maxIndexedPaths; i++) {
+      update.clear();
+      update.setSource(SKSource::sourceForKBoxSensor(SKSourceInputKBoxADC));
+      update.setValue(SKPath(SKPathElectricalBatteriesVoltage, (SKIndexId)(i + 1)), 12);
+      CHECK( mux.suppressedValues(update, 1000 + i) == 0 );
+    }
+    CHECK( mux.preferredInput(SKPath(SKPathElectricalBatteriesVoltage, (SKIndexId)1)) == SKSourceInputUnknown );
+    CHECK( mux.preferredInput(SKPath(SKPathElectricalBatteriesVoltage, (SKIndexId)2)) == SKSourceInputKBoxADC );
+  }
+
+  SECTION("updates from unknown inputs or about other vessels are not filtered") {
+    CHECK( mux.suppressedValues(n2k, 1000) == 0 );
+
+    SKUpdateStatic<1> unknown;
+    unknown.setNavigationPosition(SKTypePosition(48.85, 2.35, 0));
+    CHECK( mux.suppressedValues(unknown, 1010) == 0 );
+
+    SKContext other("urn:mrn:imo:mmsi:227006760");
+    SKUpdateStatic<1> ais(other);
+    ais.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "AI", "VDM"));
+    ais.setNavigationPosition(SKTypePosition(48.85, 2.35, 0));
+    CHECK( mux.suppressedValues(ais, 1020) == 0 );
+  }
+}
@@ -69,6 +69,22 @@ TEST_CASE("SKUpdateStatic") {
     CHECK( u.getSource() == s );
   }
 
+  SECTION("Clear") {
+    u.setSource(SKSource::sourceForNMEA0183(SKSourceInputNMEA0183_1, "GP", "RMC"));
+    u.setTimestamp(SKTime(42));
+    u.setValue(SKPathNavigationSpeedOverGround, 1.3);
+    u.setValue(SKPathNavigationCourseOverGroundTrue, 3.3);
+
+    u.clear();
+
+    CHECK( u.getSize() == 0 );
+    CHECK( ! u.hasNavigationSpeedOverGround() );
+    CHECK( u.getSource() == SKSourceUnknown );
+    CHECK( u.getTimestamp() == SKTime() );
+    CHECK( u.setValue(SKPathNavigationPosition, SKTypePosition(2.2, 3.3, 4.4)) );
+    CHECK( u.getSize() == 1 );
+  }
+
   SECTION("Specify a different context") {
     SKContext differentContext("mrn:xxx");
 
@@ -114,5 +130,29 @@ TEST_CASE("SKUpdateStatic") {
 
     CHECK( countingVisitor.counter == 3 );
   }
+
+  SECTION("Indexed values mixed with other values") {
+    SKUpdateStatic<4> u;
+
+    CHECK( u.setElectricalBatteriesVoltage("engine", 12.1) );
+    CHECK( u.setNavigationSpeedOverGround(4.2) );
+    CHECK( u.setElectricalBatteriesVoltage("house", 12.2) );
+    CHECK( u.setElectricalBatteriesVoltage("engine", 12.5) );
+
+    CHECK( u.getSize() == 3 );
+    CHECK( u.getElectricalBatteriesVoltage("engine") == 12.5 );
+    CHECK( u.getElectricalBatteriesVoltage("house") == 12.2 );
+    CHECK( ! u.hasElectricalBatteriesVoltage("dc3") );
+    CHECK( u.getNavigationSpeedOverGround() == 4.2 );
+    CHECK( u.getPath(2) == SKPath(SKPathElectricalBatteriesVoltage, "house") );
+
+    u.clear();
+    CHECK( ! u.hasElectricalBatteriesVoltage("engine") );
+    CHECK( u[SKPath(SKPathElectricalBatteriesVoltage, "house")] == SKValueNone );
+
+    CHECK( u.setElectricalBatteriesVoltage("house", 13.0) );
+    CHECK( u.getPath(0) == SKPath(SKPathElectricalBatteriesVoltage, "house") );
+    CHECK( u.getElectricalBatteriesVoltage("house") == 13.0 );
+  }
 };
 
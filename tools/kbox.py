@@ -99,6 +99,8 @@ class KBox(object):
     KommandReboot = 0x33
     KommandWiFiStatus = 0x50
     KommandWiFiConfiguration = 0x51
+    KommandNMEA2000BusStats = 0x60
+    KommandNMEA2000BusStatsReply = 0x61
 
     def __init__(self, port, debug = False):
         self._port = serial.Serial(port)
@@ -235,6 +237,32 @@ class KBox(object):
         payload = "H0LDFA57" + '\0'
         self.command(KBox.KommandReboot, payload)
 
+    def read_bus_stats(self):
+        """
+        Reads the NMEA2000 traffic by PGN and source, busiest first.
+
+        Returns a tuple (busLoad, messages, evictions, entries) where entries
+        is a list of (pgn, source, messages, bytes, rate, age) tuples.
+        """
+        self.command(KBox.KommandNMEA2000BusStats)
+        data = self.readCommand(KBox.KommandNMEA2000BusStatsReply)
+        (busLoad, messages, evictions, count) = struct.unpack('<BIIB', data[0:10])
+        entries = []
+        for i in range(0, count):
+            offset = 10 + i * 19
+            (pgn, source, entryMessages, entryBytes, rate, age) = struct.unpack('<IBIIHI', data[offset:offset + 19])
+            entries.append((pgn, source, entryMessages, entryBytes, rate / 100.0, age))
+
+        return (busLoad, messages, evictions, entries)
+
+    def printBusStats(self, stats):
+        (busLoad, messages, evictions, entries) = stats
+        print("Bus load: {}% Messages: {} Evictions: {}".format(busLoad, messages, evictions))
+        print("{:>8} {:>4} {:>8} {:>10} {:>10} {:>8}".format("PGN", "Src", "Msg/s", "Messages", "Bytes", "Age (s)"))
+        for (pgn, source, entryMessages, entryBytes, rate, age) in entries:
+            print("{:>8} {:>4} {:>8.2f} {:>10} {:>10} {:>8.1f}".format(pgn, source, rate, entryMessages,
+                                                                      entryBytes, age / 1000.0))
+
     def captureScreen(self, startY = 0):
         """
         Sends a command to capture screen from line startY. The number of lines
@@ -402,6 +430,7 @@ def main():
     subparsers.add_parser("ping")
     subparsers.add_parser("logs")
     subparsers.add_parser("reboot")
+    subparsers.add_parser("n2kstats")
 
     screenshot_parser = subparsers.add_parser("screenshot")
     screenshot_parser.add_argument("filename", default = 'screenshot.png')
@@ -454,6 +483,8 @@ def main():
             kbox.printLog(log)
     elif args.command == "reboot":
         kbox.reboot()
+    elif args.command == "n2kstats":
+        kbox.printBusStats(kbox.read_bus_stats())
     elif args.command == "screenshot":
         image = kbox.takeScreenshot()
         image.save(args.filename)
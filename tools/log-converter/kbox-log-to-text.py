@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+
+"""
+Converts a KBox log file with binary NMEA2000 records (logNMEA2000Binary)
+back to the text format: each record becomes a "P" line with a $PCDIN
+sentence, exactly as KBox writes them when binary logging is disabled. All
+the other lines are copied unchanged.
+
+The file is read as a stream so it works on large logs and in a pipe:
+
+    kbox-log-to-text.py < KBOX-0042.log > KBOX-0042.txt
+
+See src/common/nmea/NMEA2000LogFormat.h for the format of the records.
+"""
+
+import argparse
+import sys
+
+MESSAGE_MARKER = 0xB2
+CLOCK_MARKER = 0xB3
+MAX_DATA_LENGTH = 223
+
+
+class Incomplete(Exception):
+    pass
+
+
+class Reader:
+    def __init__(self, stream):
+        self.stream = stream
+        self.buffer = b""
+        self.position = 0
+
+    def fill(self, count):
+        while len(self.buffer) - self.position < count:
+            chunk = self.stream.read(65536)
+            if not chunk:
+                return False
+            self.buffer = self.buffer[self.position:] + chunk
+            self.position = 0
+        return True
+
+    def peek(self):
+        if not self.fill(1):
+            return None
+        return self.buffer[self.position]
+
+    def byte(self):
+        if not self.fill(1):
+            raise Incomplete()
+        b = self.buffer[self.position]
+        self.position += 1
+        return b
+
+    def bytes(self, count):
+        if not self.fill(count):
+            raise Incomplete()
+        data = self.buffer[self.position:self.position + count]
+        self.position += count
+        return data
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            b = self.byte()
+            value |= (b & 0x7f) << shift
+            shift += 7
+            if not b & 0x80:
+                return value
+
+    def line(self):
+        while True:
+            end = self.buffer.find(b"\n", self.position)
+            if end >= 0:
+                line = self.buffer[self.position:end + 1]
+                self.position = end + 1
+                return line
+            if not self.fill(len(self.buffer) - self.position + 1):
+                line = self.buffer[self.position:]
+                self.position = len(self.buffer)
+                return line
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def pcdin(pgn, timestamp, source, data):
+    sentence = "PCDIN,%06X,%08X,%02X,%s" % (pgn, timestamp, source, data.hex().upper())
+    checksum = 0
+    for c in sentence.encode("ascii"):
+        checksum ^= c
+    return "$%s*%02X" % (sentence, checksum)
+
+
+def convert(stream, out):
+    reader = Reader(stream)
+    wall_clock = 0
+    uptime = 0
+    last_time = 0
+
+    try:
+        while True:
+            marker = reader.peek()
+            if marker is None:
+                break
+
+            if marker == CLOCK_MARKER:
+                reader.byte()
+                wall_clock = reader.varint()
+                uptime = reader.varint()
+                last_time = uptime
+            elif marker == MESSAGE_MARKER:
+                reader.byte()
+                timestamp = (last_time + unzigzag(reader.varint())) & 0xffffffff
+                pgn = reader.varint()
+                reader.byte()  # priority
+                source = reader.byte()
+                reader.byte()  # destination
+                length = reader.varint()
+                if length > MAX_DATA_LENGTH:
+                    sys.stderr.write("Invalid NMEA2000 record (length %d)\n" % length)
+                    return 1
+                data = reader.bytes(length)
+                last_time = timestamp
+
+                # Messages can be received a little before the clock record.
+                elapsed = (timestamp - uptime) & 0xffffffff
+                if elapsed >= 0x80000000:
+                    elapsed -= 0x100000000
+                time = wall_clock + elapsed
+                out.write(b"%d;P;%s\r\n" % (time, pcdin(pgn, timestamp, source, data).encode("ascii")))
+            else:
+                out.write(reader.line())
+    except Incomplete:
+        # KBox was probably turned off while writing the last sector.
+        sys.stderr.write("Ignoring truncated record at the end of the file\n")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert binary NMEA2000 records of a KBox log to text")
+    parser.add_argument('input', nargs='?', type=argparse.FileType('rb'), default=sys.stdin.buffer)
+    parser.add_argument('--output', type=argparse.FileType('wb'), default=sys.stdout.buffer)
+    args = parser.parse_args()
+
+    sys.exit(convert(args.input, args.output))
+
+
+if __name__ == '__main__':
+    main()